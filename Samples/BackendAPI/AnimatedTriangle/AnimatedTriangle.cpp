@@ -122,6 +122,8 @@ void AnimatedTriangle::OnRender()
     preTexBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::RENDER_TARGET;
     preTexBarrier.hResouce     = m_backBuffers[ bufferNdx ].hBackBuffer;
     preTexBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    preTexBarrier.pSrcQueue    = nullptr;
+    preTexBarrier.pDstQueue    = nullptr;
 
     BIGOS::Driver::Backend::BarierDesc preBarrier;
     preBarrier.textureBarrierCount = 1;
@@ -212,6 +214,8 @@ void AnimatedTriangle::OnRender()
     postTexBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::PRESENT;
     postTexBarrier.hResouce     = m_backBuffers[ bufferNdx ].hBackBuffer;
     postTexBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    postTexBarrier.pSrcQueue    = nullptr;
+    postTexBarrier.pDstQueue    = nullptr;
 
     BIGOS::Driver::Backend::BarierDesc postBarrier;
     postBarrier.textureBarrierCount = 1;
@@ -423,6 +427,7 @@ BIGOS::RESULT AnimatedTriangle::CreateApplicationResources()
     vbDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::VERTEX_BUFFER );
     vbDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     vbDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    vbDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     vbDesc.size.width      = 3 /* triangle */ * 8 /* position (4) + color (4) */ * sizeof( float );
     vbDesc.size.height     = 1;
     vbDesc.size.depth      = 1;
@@ -486,6 +491,7 @@ BIGOS::RESULT AnimatedTriangle::CreateApplicationResources()
     cbDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::CONSTANT_BUFFER );
     cbDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     cbDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    cbDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     cbDesc.size.width      = sizeof( m_constantBufferData );
     cbDesc.size.height     = 1;
     cbDesc.size.depth      = 1;
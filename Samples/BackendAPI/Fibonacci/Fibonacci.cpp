@@ -146,6 +146,7 @@ BIGOS::RESULT Fibonacci::CreateApplicationResources()
     sbDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::READ_WRITE_STORAGE_BUFFER );
     sbDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     sbDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    sbDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     sbDesc.size.width      = sizeof( m_storageBufferData );
     sbDesc.size.height     = 1;
     sbDesc.size.depth      = 1;
@@ -339,6 +340,8 @@ BIGOS::RESULT Fibonacci::RecordComputeCommandBuffer()
     preDispatchBarrier.hResouce           = m_hStorageBuffer;
     preDispatchBarrier.bufferRange.offset = 0;
     preDispatchBarrier.bufferRange.size   = sizeof( m_storageBufferData );
+    preDispatchBarrier.pSrcQueue          = nullptr;
+    preDispatchBarrier.pDstQueue          = nullptr;
 
     BIGOS::Driver::Backend::BarierDesc preBarrier;
     preBarrier.textureBarrierCount = 0;
@@ -384,6 +387,8 @@ BIGOS::RESULT Fibonacci::RecordComputeCommandBuffer()
     postDispatchBarrier.hResouce           = m_hStorageBuffer;
     postDispatchBarrier.bufferRange.offset = 0;
     postDispatchBarrier.bufferRange.size   = sizeof( m_storageBufferData );
+    postDispatchBarrier.pSrcQueue          = nullptr;
+    postDispatchBarrier.pDstQueue          = nullptr;
 
     BIGOS::Driver::Backend::BarierDesc postBarrier;
     postBarrier.textureBarrierCount = 0;
@@ -146,6 +146,8 @@ void IndirectCube::OnRender()
     preTexBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::RENDER_TARGET;
     preTexBarrier.hResouce     = m_backBuffers[ bufferNdx ].hBackBuffer;
     preTexBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    preTexBarrier.pSrcQueue    = nullptr;
+    preTexBarrier.pDstQueue    = nullptr;
 
     BIGOS::Driver::Backend::BarierDesc preBarrier;
     preBarrier.textureBarrierCount = 1;
@@ -254,6 +256,8 @@ void IndirectCube::OnRender()
     postTexBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::PRESENT;
     postTexBarrier.hResouce     = m_backBuffers[ bufferNdx ].hBackBuffer;
     postTexBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    postTexBarrier.pSrcQueue    = nullptr;
+    postTexBarrier.pDstQueue    = nullptr;
 
     BIGOS::Driver::Backend::BarierDesc postBarrier;
     postBarrier.textureBarrierCount = 1;
@@ -449,6 +453,7 @@ BIGOS::RESULT IndirectCube::LoadAssets()
     uploadBufferDesc.resourceType    = BIGOS::Driver::Backend::ResourceTypes::BUFFER;
     uploadBufferDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     uploadBufferDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    uploadBufferDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     uploadBufferDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::TRANSFER_SRC );
     if( BGS_FAILED( m_pAPIDevice->CreateResource( uploadBufferDesc, &m_hUploadBuffer ) ) )
     {
@@ -496,7 +501,7 @@ BIGOS::RESULT IndirectCube::LoadAssets()
     pCurr += sizeof( INDEX_DATA );
     BIGOS::Memory::Copy( &INDIRECT_DATA, sizeof( INDIRECT_DATA ), pCurr, sizeof( INDIRECT_DATA ) );
     pCurr += 1024;
-    BIGOS::Memory::Copy( pTextureData, textureSize, pCurr, textureSize );
+    BIGOS::Memory::StreamCopy( pTextureData, textureSize, pCurr, textureSize );
     if( BGS_FAILED( m_pAPIDevice->UnmapResource( mapUpload ) ) )
     {
         return BIGOS::Results::FAIL;
@@ -569,6 +574,7 @@ BIGOS::RESULT IndirectCube::CreateApplicationResources()
     vbDesc.resourceType    = BIGOS::Driver::Backend::ResourceTypes::BUFFER;
     vbDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     vbDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    vbDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     vbDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::VERTEX_BUFFER ) |
                            BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::TRANSFER_DST );
     if( BGS_FAILED( m_pAPIDevice->CreateResource( vbDesc, &m_hVertexBuffer ) ) )
@@ -587,6 +593,7 @@ BIGOS::RESULT IndirectCube::CreateApplicationResources()
     ibDesc.resourceType    = BIGOS::Driver::Backend::ResourceTypes::BUFFER;
     ibDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     ibDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    ibDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     ibDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::INDEX_BUFFER ) |
                            BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::TRANSFER_DST );
     if( BGS_FAILED( m_pAPIDevice->CreateResource( ibDesc, &m_hIndexBuffer ) ) )
@@ -605,6 +612,7 @@ BIGOS::RESULT IndirectCube::CreateApplicationResources()
     indDesc.resourceType    = BIGOS::Driver::Backend::ResourceTypes::BUFFER;
     indDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     indDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    indDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     indDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::INDIRECT_BUFFER ) |
                             BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::TRANSFER_DST );
     if( BGS_FAILED( m_pAPIDevice->CreateResource( indDesc, &m_hIndirectBuffer ) ) )
@@ -662,6 +670,7 @@ BIGOS::RESULT IndirectCube::CreateApplicationResources()
     cbDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::CONSTANT_BUFFER );
     cbDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     cbDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    cbDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     cbDesc.size.width      = sizeof( m_constantBufferData );
     cbDesc.size.height     = 1;
     cbDesc.size.depth      = 1;
@@ -719,6 +728,7 @@ BIGOS::RESULT IndirectCube::CreateApplicationResources()
     dsBuffDesc.resourceType         = BIGOS::Driver::Backend::ResourceTypes::TEXTURE_2D;
     dsBuffDesc.sampleCount          = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     dsBuffDesc.sharingMode          = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    dsBuffDesc.flags                = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     dsBuffDesc.resourceUsage        = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::DEPTH_STENCIL_TARGET );
     dsBuffDesc.depthStencilClrValue = depthVal;
     if( BGS_FAILED( m_pAPIDevice->CreateResource( dsBuffDesc, &m_hDephtStencilTarget ) ) )
@@ -777,6 +787,7 @@ BIGOS::RESULT IndirectCube::CreateApplicationResources()
     texDesc.resourceType    = BIGOS::Driver::Backend::ResourceTypes::TEXTURE_2D;
     texDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     texDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    texDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     texDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::SAMPLED_TEXTURE ) |
                             BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::TRANSFER_DST );
     if( BGS_FAILED( m_pAPIDevice->CreateResource( texDesc, &m_hTexture ) ) )
@@ -956,6 +967,8 @@ BIGOS::RESULT IndirectCube::UploadResourceData()
     preCpyBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::TRANSFER_DST;
     preCpyBarrier.hResouce     = m_hTexture;
     preCpyBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    preCpyBarrier.pSrcQueue    = nullptr;
+    preCpyBarrier.pDstQueue    = nullptr;
 
     BIGOS::Driver::Backend::BarierDesc barrier;
     barrier.textureBarrierCount = 1;
@@ -967,13 +980,14 @@ BIGOS::RESULT IndirectCube::UploadResourceData()
     pCpyCmdBuffer->Barrier( barrier );
 
     BIGOS::Driver::Backend::CopyBufferTextureDesc cpyBuffTexDesc;
-    cpyBuffTexDesc.hBuffer       = m_hUploadBuffer;
-    cpyBuffTexDesc.hTexture      = m_hTexture;
-    cpyBuffTexDesc.bufferOffset  = 1024;
-    cpyBuffTexDesc.textureOffset = { 0, 0, 0 };
-    cpyBuffTexDesc.size          = { TEXTURE_WIDTH, TEXTURE_HEIGHT, 1 };
-    cpyBuffTexDesc.textureFormat = BIGOS::Driver::Backend::Formats::R8G8B8A8_UNORM;
-    cpyBuffTexDesc.textureRange  = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    cpyBuffTexDesc.hBuffer        = m_hUploadBuffer;
+    cpyBuffTexDesc.hTexture       = m_hTexture;
+    cpyBuffTexDesc.bufferOffset   = 1024;
+    cpyBuffTexDesc.bufferRowPitch = 0;
+    cpyBuffTexDesc.textureOffset  = { 0, 0, 0 };
+    cpyBuffTexDesc.size           = { TEXTURE_WIDTH, TEXTURE_HEIGHT, 1 };
+    cpyBuffTexDesc.textureFormat  = BIGOS::Driver::Backend::Formats::R8G8B8A8_UNORM;
+    cpyBuffTexDesc.textureRange   = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
     pCpyCmdBuffer->CopyBuferToTexture( cpyBuffTexDesc );
 
     BIGOS::Driver::Backend::TextureBarrierDesc postCpyBarrier;
@@ -985,6 +999,8 @@ BIGOS::RESULT IndirectCube::UploadResourceData()
     postCpyBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::SHADER_READ_ONLY;
     postCpyBarrier.hResouce     = m_hTexture;
     postCpyBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    postCpyBarrier.pSrcQueue    = nullptr;
+    postCpyBarrier.pDstQueue    = nullptr;
 
     barrier.pTextureBarriers = &postCpyBarrier;
     pCpyCmdBuffer->Barrier( barrier );
@@ -999,6 +1015,8 @@ BIGOS::RESULT IndirectCube::UploadResourceData()
     dsvBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::DEPTH_STENCIL_WRITE;
     dsvBarrier.hResouce     = m_hDephtStencilTarget;
     dsvBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::DEPTH ) | BGS_FLAG( TextureComponentFlagBits::STENCIL ), 0, 1, 0, 1 };
+    dsvBarrier.pSrcQueue    = nullptr;
+    dsvBarrier.pDstQueue    = nullptr;
 
     barrier.pTextureBarriers = &dsvBarrier;
     pCpyCmdBuffer->Barrier( barrier );
@@ -136,6 +136,8 @@ void RotatedQuads::OnRender()
     preTexBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::RENDER_TARGET;
     preTexBarrier.hResouce     = m_backBuffers[ bufferNdx ].hBackBuffer;
     preTexBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    preTexBarrier.pSrcQueue    = nullptr;
+    preTexBarrier.pDstQueue    = nullptr;
 
     BIGOS::Driver::Backend::BarierDesc preBarrier;
     preBarrier.textureBarrierCount = 1;
@@ -238,6 +240,8 @@ void RotatedQuads::OnRender()
     postTexBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::PRESENT;
     postTexBarrier.hResouce     = m_backBuffers[ bufferNdx ].hBackBuffer;
     postTexBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    postTexBarrier.pSrcQueue    = nullptr;
+    postTexBarrier.pDstQueue    = nullptr;
 
     BIGOS::Driver::Backend::BarierDesc postBarrier;
     postBarrier.textureBarrierCount = 1;
@@ -416,6 +420,7 @@ BIGOS::RESULT RotatedQuads::LoadAssets()
     uploadBufferDesc.resourceType    = BIGOS::Driver::Backend::ResourceTypes::BUFFER;
     uploadBufferDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     uploadBufferDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    uploadBufferDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     uploadBufferDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::TRANSFER_SRC );
     if( BGS_FAILED( m_pAPIDevice->CreateResource( uploadBufferDesc, &m_hUploadBuffer ) ) )
     {
@@ -531,6 +536,7 @@ BIGOS::RESULT RotatedQuads::CreateApplicationResources()
     vbDesc.resourceType    = BIGOS::Driver::Backend::ResourceTypes::BUFFER;
     vbDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     vbDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    vbDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     vbDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::VERTEX_BUFFER ) |
                            BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::TRANSFER_DST );
     if( BGS_FAILED( m_pAPIDevice->CreateResource( vbDesc, &m_hVertexBuffer ) ) )
@@ -549,6 +555,7 @@ BIGOS::RESULT RotatedQuads::CreateApplicationResources()
     ibDesc.resourceType    = BIGOS::Driver::Backend::ResourceTypes::BUFFER;
     ibDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     ibDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    ibDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     ibDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::INDEX_BUFFER ) |
                            BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::TRANSFER_DST );
     if( BGS_FAILED( m_pAPIDevice->CreateResource( ibDesc, &m_hIndexBuffer ) ) )
@@ -598,6 +605,7 @@ BIGOS::RESULT RotatedQuads::CreateApplicationResources()
     cbDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::CONSTANT_BUFFER );
     cbDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     cbDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    cbDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     cbDesc.size.width      = sizeof( m_constantBufferData );
     cbDesc.size.height     = 1;
     cbDesc.size.depth      = 1;
@@ -655,6 +663,7 @@ BIGOS::RESULT RotatedQuads::CreateApplicationResources()
     dsBuffDesc.resourceType         = BIGOS::Driver::Backend::ResourceTypes::TEXTURE_2D;
     dsBuffDesc.sampleCount          = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     dsBuffDesc.sharingMode          = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    dsBuffDesc.flags                = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     dsBuffDesc.resourceUsage        = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::DEPTH_STENCIL_TARGET );
     dsBuffDesc.depthStencilClrValue = depthVal;
     if( BGS_FAILED( m_pAPIDevice->CreateResource( dsBuffDesc, &m_hDephtStencilTarget ) ) )
@@ -806,6 +815,8 @@ BIGOS::RESULT RotatedQuads::UploadResourceData()
     dsvBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::DEPTH_STENCIL_WRITE;
     dsvBarrier.hResouce     = m_hDephtStencilTarget;
     dsvBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::DEPTH ) | BGS_FLAG( TextureComponentFlagBits::STENCIL ), 0, 1, 0, 1 };
+    dsvBarrier.pSrcQueue    = nullptr;
+    dsvBarrier.pDstQueue    = nullptr;
 
     BIGOS::Driver::Backend::BarierDesc barrier;
     barrier.textureBarrierCount = 1;
@@ -116,6 +116,8 @@ void TexturedQuad::OnRender()
     preTexBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::RENDER_TARGET;
     preTexBarrier.hResouce     = m_backBuffers[ bufferNdx ].hBackBuffer;
     preTexBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    preTexBarrier.pSrcQueue    = nullptr;
+    preTexBarrier.pDstQueue    = nullptr;
 
     BIGOS::Driver::Backend::BarierDesc preBarrier;
     preBarrier.textureBarrierCount = 1;
@@ -220,6 +222,8 @@ void TexturedQuad::OnRender()
     postTexBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::PRESENT;
     postTexBarrier.hResouce     = m_backBuffers[ bufferNdx ].hBackBuffer;
     postTexBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    postTexBarrier.pSrcQueue    = nullptr;
+    postTexBarrier.pDstQueue    = nullptr;
 
     BIGOS::Driver::Backend::BarierDesc postBarrier;
     postBarrier.textureBarrierCount = 1;
@@ -406,6 +410,7 @@ BIGOS::RESULT TexturedQuad::LoadAssets()
     uploadBufferDesc.resourceType    = BIGOS::Driver::Backend::ResourceTypes::BUFFER;
     uploadBufferDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     uploadBufferDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    uploadBufferDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     uploadBufferDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::TRANSFER_SRC );
     if( BGS_FAILED( m_pAPIDevice->CreateResource( uploadBufferDesc, &m_hUploadBuffer ) ) )
     {
@@ -451,7 +456,7 @@ BIGOS::RESULT TexturedQuad::LoadAssets()
     pCurr += sizeof( VERTEX_DATA );
     BIGOS::Memory::Copy( INDEX_DATA, sizeof( INDEX_DATA ), pCurr, sizeof( INDEX_DATA ) );
     pCurr = static_cast<BIGOS::byte_t*>( pHostAccess ) + 512;
-    BIGOS::Memory::Copy( pTextureData, textureSize, pCurr, textureSize );
+    BIGOS::Memory::StreamCopy( pTextureData, textureSize, pCurr, textureSize );
 
     if( BGS_FAILED( m_pAPIDevice->UnmapResource( mapUpload ) ) )
     {
@@ -526,6 +531,7 @@ BIGOS::RESULT TexturedQuad::CreateApplicationResources()
     vbDesc.resourceType    = BIGOS::Driver::Backend::ResourceTypes::BUFFER;
     vbDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     vbDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    vbDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     vbDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::VERTEX_BUFFER ) |
                            BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::TRANSFER_DST );
     if( BGS_FAILED( m_pAPIDevice->CreateResource( vbDesc, &m_hVertexBuffer ) ) )
@@ -544,6 +550,7 @@ BIGOS::RESULT TexturedQuad::CreateApplicationResources()
     ibDesc.resourceType    = BIGOS::Driver::Backend::ResourceTypes::BUFFER;
     ibDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     ibDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    ibDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     ibDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::INDEX_BUFFER ) |
                            BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::TRANSFER_DST );
     if( BGS_FAILED( m_pAPIDevice->CreateResource( ibDesc, &m_hIndexBuffer ) ) )
@@ -595,6 +602,7 @@ BIGOS::RESULT TexturedQuad::CreateApplicationResources()
     textureDesc.resourceType    = BIGOS::Driver::Backend::ResourceTypes::TEXTURE_2D;
     textureDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
     textureDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    textureDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
     textureDesc.resourceUsage   = BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::SAMPLED_TEXTURE ) |
                                 BGS_FLAG( BIGOS::Driver::Backend::ResourceUsageFlagBits::TRANSFER_DST );
     if( BGS_FAILED( m_pAPIDevice->CreateResource( textureDesc, &m_hTexture ) ) )
@@ -771,6 +779,8 @@ BIGOS::RESULT TexturedQuad::UploadResourceData()
     preCpyBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::TRANSFER_DST;
     preCpyBarrier.hResouce     = m_hTexture;
     preCpyBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    preCpyBarrier.pSrcQueue    = nullptr;
+    preCpyBarrier.pDstQueue    = nullptr;
 
     BIGOS::Driver::Backend::BarierDesc barrier;
     barrier.textureBarrierCount = 1;
@@ -782,13 +792,14 @@ BIGOS::RESULT TexturedQuad::UploadResourceData()
     pCpyCmdBuffer->Barrier( barrier );
 
     BIGOS::Driver::Backend::CopyBufferTextureDesc cpyBuffTexDesc;
-    cpyBuffTexDesc.hBuffer       = m_hUploadBuffer;
-    cpyBuffTexDesc.hTexture      = m_hTexture;
-    cpyBuffTexDesc.bufferOffset  = 512;
-    cpyBuffTexDesc.textureOffset = { 0, 0, 0 };
-    cpyBuffTexDesc.size          = { 256, 256, 1 };
-    cpyBuffTexDesc.textureFormat = BIGOS::Driver::Backend::Formats::R8G8B8A8_UNORM;
-    cpyBuffTexDesc.textureRange  = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    cpyBuffTexDesc.hBuffer        = m_hUploadBuffer;
+    cpyBuffTexDesc.hTexture       = m_hTexture;
+    cpyBuffTexDesc.bufferOffset   = 512;
+    cpyBuffTexDesc.bufferRowPitch = 0;
+    cpyBuffTexDesc.textureOffset  = { 0, 0, 0 };
+    cpyBuffTexDesc.size           = { 256, 256, 1 };
+    cpyBuffTexDesc.textureFormat  = BIGOS::Driver::Backend::Formats::R8G8B8A8_UNORM;
+    cpyBuffTexDesc.textureRange   = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
     pCpyCmdBuffer->CopyBuferToTexture( cpyBuffTexDesc );
 
     BIGOS::Driver::Backend::TextureBarrierDesc postCpyBarrier;
@@ -800,6 +811,8 @@ BIGOS::RESULT TexturedQuad::UploadResourceData()
     postCpyBarrier.dstLayout    = BIGOS::Driver::Backend::TextureLayouts::SHADER_READ_ONLY;
     postCpyBarrier.hResouce     = m_hTexture;
     postCpyBarrier.textureRange = { BGS_FLAG( TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+    postCpyBarrier.pSrcQueue    = nullptr;
+    postCpyBarrier.pDstQueue    = nullptr;
 
     barrier.pTextureBarriers = &postCpyBarrier;
     pCpyCmdBuffer->Barrier( barrier );
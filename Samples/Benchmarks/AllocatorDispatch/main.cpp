@@ -0,0 +1,125 @@
+#include "Core/CoreTypes.h"
+
+#include "BIGOS/BigosEngine.h"
+#include "Core/Containers/Array.h"
+#include "Core/Memory/MemorySystem.h"
+#include "Core/Utils/Timer.h"
+
+#include <cstdio>
+
+// Per call cost of Memory helpers and array growth when allocator type is known only at runtime (IAllocator*, virtual call with
+// callsite arguments) and when it is known at compile time (AllocatorPolicy of concrete type, inlined for LinearAllocator, direct
+// call for PoolAllocator). Both columns run the same code on the same allocator object.
+
+using namespace BIGOS;
+
+constexpr size_t BATCH_SIZE      = 1024;
+constexpr size_t BATCH_COUNT     = 16 * 1024;
+constexpr size_t ARRAY_SIZE      = 256;
+constexpr size_t ARRAY_REPEATS   = 64 * 1024;
+constexpr double NANOSEC_PER_SEC = 1000000000.0;
+
+struct TestObject
+{
+    uint64_t data[ 8 ];
+};
+
+// Returns ns per AllocateObject and FreeObject pair, linear allocator is rewound after every batch
+template<class AllocatorT>
+static double MeasureObjects( AllocatorT* pAllocator, Core::Memory::LinearAllocator* pLinearAllocator, uint64_t* pChecksum )
+{
+    TestObject* pObjects[ BATCH_SIZE ];
+
+    Core::Utils::Timer timer;
+    for( size_t batchNdx = 0; batchNdx < BATCH_COUNT; ++batchNdx )
+    {
+        const Core::Memory::LinearAllocatorMarker marker = pLinearAllocator != nullptr ? pLinearAllocator->GetMarker() : 0;
+        for( size_t ndx = 0; ndx < BATCH_SIZE; ++ndx )
+        {
+            pObjects[ ndx ] = nullptr;
+            Core::Memory::AllocateObject( pAllocator, &pObjects[ ndx ] );
+            *pChecksum += reinterpret_cast<uintptr_t>( pObjects[ ndx ] );
+        }
+        for( size_t ndx = 0; ndx < BATCH_SIZE; ++ndx )
+        {
+            Core::Memory::FreeObject( pAllocator, &pObjects[ ndx ] );
+        }
+        if( pLinearAllocator != nullptr )
+        {
+            pLinearAllocator->FreeToMarker( marker );
+        }
+    }
+    const double seconds = timer.Elapsed();
+
+    return seconds * NANOSEC_PER_SEC / static_cast<double>( BATCH_SIZE * BATCH_COUNT );
+}
+
+// Returns ns per push_back of scratch array growing from empty to ARRAY_SIZE elements
+template<class AllocatorT>
+static double MeasureArray( AllocatorT* pAllocator, Core::Memory::LinearAllocator* pLinearAllocator, uint64_t* pChecksum )
+{
+    Core::Utils::Timer timer;
+    for( size_t repeatNdx = 0; repeatNdx < ARRAY_REPEATS; ++repeatNdx )
+    {
+        const Core::Memory::LinearAllocatorMarker marker = pLinearAllocator->GetMarker();
+        {
+            Core::Containers::Array<uint32_t, AllocatorT> values( pAllocator );
+            for( uint32_t ndx = 0; ndx < ARRAY_SIZE; ++ndx )
+            {
+                values.push_back( ndx );
+            }
+            *pChecksum += values.back();
+        }
+        pLinearAllocator->FreeToMarker( marker );
+    }
+    const double seconds = timer.Elapsed();
+
+    return seconds * NANOSEC_PER_SEC / static_cast<double>( ARRAY_SIZE * ARRAY_REPEATS );
+}
+
+int main()
+{
+    BigosEngineDesc engineDesc;
+    BigosEngine*    pEngine = nullptr;
+    if( BGS_FAILED( CreateBigosEngine( engineDesc, &pEngine ) ) )
+    {
+        printf( "Failed to create engine.\n" );
+        return -1;
+    }
+    Core::Memory::MemorySystem& memorySystem = pEngine->GetMemorySystem();
+
+    Core::Memory::AllocatorDesc poolDesc;
+    poolDesc.type     = Core::Memory::AllocatorTypes::POOL;
+    poolDesc.capacity = 0;
+
+    Core::Memory::IAllocator* pPool = nullptr;
+    if( BGS_FAILED( memorySystem.CreateAllocator( poolDesc, &pPool ) ) )
+    {
+        printf( "Failed to create pool allocator.\n" );
+        DestroyBigosEngine( &pEngine );
+        return -1;
+    }
+    Core::Memory::PoolAllocator*   pPoolAllocator    = static_cast<Core::Memory::PoolAllocator*>( pPool );
+    Core::Memory::LinearAllocator* pFrameAllocator   = memorySystem.GetFrameAllocator();
+    Core::Memory::LinearAllocator* pScratchAllocator = memorySystem.GetThreadScratchAllocator();
+
+    // Volatile pointers keep compiler from seeing through IAllocator* and devirtualizing the calls
+    Core::Memory::IAllocator* volatile pDynamicFrame   = pFrameAllocator;
+    Core::Memory::IAllocator* volatile pDynamicPool    = pPoolAllocator;
+    Core::Memory::IAllocator* volatile pDynamicScratch = pScratchAllocator;
+
+    uint64_t checksum = 0;
+    printf( "%-36s | %12s %12s\n", "Operation", "IAllocator*", "Concrete*" );
+    printf( "%-36s | %12.2f %12.2f\n", "Linear AllocateObject + FreeObject", MeasureObjects( pDynamicFrame, pFrameAllocator, &checksum ),
+            MeasureObjects( pFrameAllocator, pFrameAllocator, &checksum ) );
+    printf( "%-36s | %12.2f %12.2f\n", "Pool AllocateObject + FreeObject", MeasureObjects( pDynamicPool, nullptr, &checksum ),
+            MeasureObjects( pPoolAllocator, nullptr, &checksum ) );
+    printf( "%-36s | %12.2f %12.2f\n", "Scratch Array push_back", MeasureArray( pDynamicScratch, pScratchAllocator, &checksum ),
+            MeasureArray( pScratchAllocator, pScratchAllocator, &checksum ) );
+    printf( "Time in ns per call (checksum %llu).\n", static_cast<unsigned long long>( checksum ) );
+
+    memorySystem.DestroyAllocator( &pPool );
+    DestroyBigosEngine( &pEngine );
+
+    return 0;
+}
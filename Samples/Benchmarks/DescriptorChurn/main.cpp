@@ -0,0 +1,306 @@
+#include "Core/CoreTypes.h"
+
+#include "Core/Utils/Timer.h"
+#include "Driver/Backend/D3D12/D3D12BindingAllocators.h"
+
+#include <cstdio>
+#include <thread>
+
+// Descriptor index churn on a 1M entry heap. Streaming frees the oldest descriptors and allocates new ones, so freed index walks
+// through the whole heap. Hierarchical bitmap (D3D12 backend PoolAllocator) is compared with linear scan from index 0 it replaced,
+// at several fill levels. Then 1M allocate / free pairs run from 1 to 8 threads, and table ranges of 8 descriptors are churned.
+// Before timing, random range allocations and frees are checked against bit by bit first fit search.
+
+using namespace BIGOS;
+
+constexpr uint32_t HEAP_SIZE         = 1024U * 1024U;
+constexpr uint32_t CHURN_COUNT       = 1024U * 1024U;
+constexpr uint32_t SCAN_CHURN_COUNT  = 4U * 1024U; // Linear scan is O(n), fewer operations keep run time sane
+constexpr uint32_t MAX_THREAD_COUNT  = 8;
+constexpr uint32_t TABLE_SIZE        = 8;
+constexpr uint32_t TABLE_CHURN_COUNT = 16U * 1024U;
+constexpr uint32_t VERIFY_HEAP_COUNT = 256;
+constexpr uint32_t VERIFY_OP_COUNT   = 512;
+
+struct RandomGenerator
+{
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    uint32_t Next()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<uint32_t>( state >> 32 );
+    }
+};
+
+// Allocator replaced by the hierarchical bitmap
+class LinearScanAllocator
+{
+public:
+    void Create( uint32_t capacity ) { m_used.assign( capacity, BGS_FALSE ); }
+
+    RESULT Allocate( uint32_t* pNdx )
+    {
+        for( uint32_t ndx = 0; ndx < m_used.size(); ++ndx )
+        {
+            if( !m_used[ ndx ] )
+            {
+                m_used[ ndx ] = BGS_TRUE;
+                *pNdx         = ndx;
+                return Results::OK;
+            }
+        }
+
+        return Results::NO_MEMORY;
+    }
+
+    void Free( uint32_t ndx ) { m_used[ ndx ] = BGS_FALSE; }
+
+    // Same result as count allocations on empty heap, without quadratic cost
+    void AllocateFirst( uint32_t count, uint32_t* pNdxs )
+    {
+        for( uint32_t ndx = 0; ndx < count; ++ndx )
+        {
+            m_used[ ndx ] = BGS_TRUE;
+            pNdxs[ ndx ]  = ndx;
+        }
+    }
+
+private:
+    HeapArray<bool_t> m_used;
+};
+
+static void Fill( Driver::Backend::PoolAllocator* pAllocator, uint32_t count, uint32_t* pNdxs )
+{
+    for( uint32_t ndx = 0; ndx < count; ++ndx )
+    {
+        pAllocator->Allocate( &pNdxs[ ndx ] );
+    }
+}
+
+static void Fill( LinearScanAllocator* pAllocator, uint32_t count, uint32_t* pNdxs ) { pAllocator->AllocateFirst( count, pNdxs ); }
+
+// Fills heap to fillCount entries, then frees the oldest entry and allocates a new one churnCount times. Returns ns per pair.
+template<class AllocatorT>
+static double MeasureChurn( AllocatorT* pAllocator, HeapArray<uint32_t>* pRing, uint32_t fillCount, uint32_t churnCount )
+{
+    Fill( pAllocator, fillCount, pRing->data() );
+
+    Core::Utils::Timer timer;
+    for( uint32_t ndx = 0; ndx < churnCount; ++ndx )
+    {
+        uint32_t& slot = ( *pRing )[ ndx % fillCount ];
+        pAllocator->Free( slot );
+        if( BGS_FAILED( pAllocator->Allocate( &slot ) ) )
+        {
+            return -1.0;
+        }
+    }
+    const double seconds = timer.Elapsed();
+
+    for( uint32_t ndx = 0; ndx < fillCount; ++ndx )
+    {
+        pAllocator->Free( ( *pRing )[ ndx ] );
+    }
+
+    return seconds * 1000000000.0 / churnCount;
+}
+
+// First free run of count bits, UINT32_MAX if there is none
+static uint32_t FindFirstFit( const HeapArray<bool_t>& used, uint32_t count )
+{
+    uint32_t runSize = 0;
+    for( uint32_t ndx = 0; ndx < used.size(); ++ndx )
+    {
+        runSize = used[ ndx ] ? 0 : runSize + 1;
+        if( runSize == count )
+        {
+            return ndx + 1 - count;
+        }
+    }
+
+    return UINT32_MAX;
+}
+
+// Heaps of random capacity, so runs start, end and cross word boundaries at every offset. Mostly short ranges with some longer
+// than a word, and single frees that punch holes into earlier ranges.
+static bool_t VerifyRangeFirstFit()
+{
+    RandomGenerator random;
+    for( uint32_t heapNdx = 0; heapNdx < VERIFY_HEAP_COUNT; ++heapNdx )
+    {
+        const uint32_t                 capacity = 1 + random.Next() % 2048;
+        Driver::Backend::PoolAllocator allocator;
+        if( BGS_FAILED( allocator.Create( capacity ) ) )
+        {
+            return BGS_FALSE;
+        }
+        HeapArray<bool_t> used( capacity, BGS_FALSE );
+
+        bool_t matches = BGS_TRUE;
+        for( uint32_t opNdx = 0; ( opNdx < VERIFY_OP_COUNT ) && matches; ++opNdx )
+        {
+            if( random.Next() % 2 )
+            {
+                const uint32_t count       = 1 + random.Next() % ( random.Next() % 4 == 0 ? 160 : 12 );
+                const uint32_t expectedNdx = FindFirstFit( used, count );
+                uint32_t       firstNdx    = 0;
+                const RESULT   res         = allocator.AllocateRange( count, &firstNdx );
+                if( expectedNdx == UINT32_MAX )
+                {
+                    matches = res == Results::NO_MEMORY;
+                    continue;
+                }
+                matches = BGS_SUCCESS( res ) && ( firstNdx == expectedNdx );
+                for( uint32_t ndx = expectedNdx; ( ndx < expectedNdx + count ) && matches; ++ndx )
+                {
+                    used[ ndx ] = BGS_TRUE;
+                }
+            }
+            else
+            {
+                const uint32_t ndx = random.Next() % capacity;
+                if( used[ ndx ] )
+                {
+                    allocator.Free( ndx );
+                    used[ ndx ] = BGS_FALSE;
+                }
+            }
+        }
+        allocator.Destroy();
+
+        if( !matches )
+        {
+            printf( "AllocateRange differs from first fit on heap of %u descriptors.\n", capacity );
+            return BGS_FALSE;
+        }
+    }
+
+    return BGS_TRUE;
+}
+
+static bool_t ChurnThread( Driver::Backend::PoolAllocator* pAllocator, uint32_t churnCount )
+{
+    uint32_t ring[ 64 ];
+    for( uint32_t ndx = 0; ndx < 64; ++ndx )
+    {
+        if( BGS_FAILED( pAllocator->Allocate( &ring[ ndx ] ) ) )
+        {
+            return BGS_FALSE;
+        }
+    }
+    for( uint32_t ndx = 0; ndx < churnCount; ++ndx )
+    {
+        uint32_t& slot = ring[ ndx % 64 ];
+        pAllocator->Free( slot );
+        if( BGS_FAILED( pAllocator->Allocate( &slot ) ) )
+        {
+            return BGS_FALSE;
+        }
+    }
+    for( uint32_t ndx = 0; ndx < 64; ++ndx )
+    {
+        pAllocator->Free( ring[ ndx ] );
+    }
+
+    return BGS_TRUE;
+}
+
+int main()
+{
+    const bool_t firstFitMatches = VerifyRangeFirstFit();
+    printf( "Random range allocations %s first fit search\n\n", firstFitMatches ? "match" : "DO NOT match" );
+
+    Driver::Backend::PoolAllocator bitmapAllocator;
+    if( BGS_FAILED( bitmapAllocator.Create( HEAP_SIZE ) ) )
+    {
+        printf( "Failed to create descriptor allocator.\n" );
+        return -1;
+    }
+    LinearScanAllocator scanAllocator;
+    scanAllocator.Create( HEAP_SIZE );
+
+    HeapArray<uint32_t> ring( HEAP_SIZE );
+
+    // Filling whole heap with linear scan is quadratic, so it is measured only by churn below
+    Core::Utils::Timer fillTimer;
+    for( uint32_t ndx = 0; ndx < HEAP_SIZE; ++ndx )
+    {
+        bitmapAllocator.Allocate( &ring[ ndx ] );
+    }
+    const double fillSeconds = fillTimer.Elapsed();
+    uint32_t     spareNdx    = 0;
+    const bool_t isFull      = bitmapAllocator.Allocate( &spareNdx ) == Results::NO_MEMORY;
+    for( uint32_t ndx = 0; ndx < HEAP_SIZE; ++ndx )
+    {
+        bitmapAllocator.Free( ring[ ndx ] );
+    }
+    printf( "Filling %u descriptors: %.2f ms (%.2f ns per allocation), full heap %s\n\n", HEAP_SIZE, fillSeconds * 1000.0,
+            fillSeconds * 1000000000.0 / HEAP_SIZE, isFull ? "rejects allocation" : "DID NOT reject allocation" );
+
+    printf( "%8s | %14s %14s\n", "Fill", "Bitmap", "Linear scan" );
+    const uint32_t fillPercents[] = { 10, 50, 90, 99 };
+    for( uint32_t ndx = 0; ndx < 4; ++ndx )
+    {
+        const uint32_t fillCount = static_cast<uint32_t>( static_cast<uint64_t>( HEAP_SIZE ) * fillPercents[ ndx ] / 100 );
+        printf( "%7u%% | %14.2f %14.2f\n", fillPercents[ ndx ], MeasureChurn( &bitmapAllocator, &ring, fillCount, CHURN_COUNT ),
+                MeasureChurn( &scanAllocator, &ring, fillCount, SCAN_CHURN_COUNT ) );
+    }
+    printf( "Time in ns per free and allocation pair.\n\n" );
+
+    printf( "%8s | %12s %14s\n", "Threads", "Time [ms]", "ns per pair" );
+    for( uint32_t threadCount = 1; threadCount <= MAX_THREAD_COUNT; threadCount *= 2 )
+    {
+        bool_t             succeeded[ MAX_THREAD_COUNT ];
+        std::thread        threads[ MAX_THREAD_COUNT ];
+        Core::Utils::Timer timer;
+        for( uint32_t ndx = 0; ndx < threadCount; ++ndx )
+        {
+            threads[ ndx ] = std::thread(
+                [ &, ndx ]() { succeeded[ ndx ] = ChurnThread( &bitmapAllocator, CHURN_COUNT / threadCount ); } );
+        }
+        bool_t allSucceeded = BGS_TRUE;
+        for( uint32_t ndx = 0; ndx < threadCount; ++ndx )
+        {
+            threads[ ndx ].join();
+            allSucceeded = allSucceeded && succeeded[ ndx ];
+        }
+        const double seconds = timer.Elapsed();
+        if( !allSucceeded )
+        {
+            printf( "Allocation failed.\n" );
+            break;
+        }
+        printf( "%8u | %12.2f %14.2f\n", threadCount, seconds * 1000.0, seconds * 1000000000.0 / CHURN_COUNT );
+    }
+
+    // Half of heap is taken with every third descriptor freed, so tables have to skip single holes up to the free half
+    for( uint32_t ndx = 0; ndx < HEAP_SIZE / 2; ++ndx )
+    {
+        bitmapAllocator.Allocate( &ring[ ndx ] );
+    }
+    for( uint32_t ndx = 0; ndx < HEAP_SIZE / 2; ndx += 3 )
+    {
+        bitmapAllocator.Free( ring[ ndx ] );
+    }
+    Core::Utils::Timer tableTimer;
+    bool_t             tablesSucceeded = BGS_TRUE;
+    for( uint32_t ndx = 0; ( ndx < TABLE_CHURN_COUNT ) && tablesSucceeded; ++ndx )
+    {
+        uint32_t firstNdx = 0;
+        tablesSucceeded   = BGS_SUCCESS( bitmapAllocator.AllocateRange( TABLE_SIZE, &firstNdx ) ) && ( firstNdx == HEAP_SIZE / 2 );
+        if( tablesSucceeded )
+        {
+            bitmapAllocator.FreeRange( firstNdx, TABLE_SIZE );
+        }
+    }
+    const double tableSeconds = tableTimer.Elapsed();
+    printf( "\nTable of %u descriptors on half full heap: %.2f ns per allocation and free%s\n", TABLE_SIZE,
+            tableSeconds * 1000000000.0 / TABLE_CHURN_COUNT, tablesSucceeded ? "" : " (allocation failed or misplaced)" );
+
+    bitmapAllocator.Destroy();
+
+    return firstFitMatches && isFull && tablesSucceeded ? 0 : -1;
+}
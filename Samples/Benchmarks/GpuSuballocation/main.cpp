@@ -0,0 +1,227 @@
+#include "Core/CoreTypes.h"
+
+#include "BIGOS/BigosEngine.h"
+#include "Core/Utils/Timer.h"
+#include "Driver/Backend/API.h"
+#include "Driver/Frontend/DeviceMemorySystem.h"
+#include "Driver/Frontend/RenderSystem.h"
+
+#include <cstdio>
+#include <cstring>
+
+// Places buffers and textures of random sizes with DeviceMemorySystem, checks that every resource is aligned and that resources
+// sharing device memory do not overlap, then frees half of them and places them again to check that freed ranges are reused.
+// Prints resource count against device allocation count and placement time. Runs on software Vulkan adapter (lavapipe) by
+// default, "d3d12" argument switches the backend (WARP) and "hardware" drops the software adapter preference.
+
+using namespace BIGOS;
+using namespace BIGOS::Driver;
+
+constexpr uint32_t BUFFER_COUNT   = 2048;
+constexpr uint32_t TEXTURE_COUNT  = 256;
+constexpr uint32_t RESOURCE_COUNT = BUFFER_COUNT + TEXTURE_COUNT;
+
+struct PlacedResource
+{
+    Backend::ResourceHandle          hResource;
+    Frontend::DeviceMemoryAllocation memory;
+    uint64_t                         alignment;
+};
+
+static uint32_t s_failedCount = 0;
+static uint64_t s_random      = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t NextRandom()
+{
+    s_random ^= s_random << 13;
+    s_random ^= s_random >> 7;
+    s_random ^= s_random << 17;
+    return static_cast<uint32_t>( s_random >> 32 );
+}
+
+static void Check( bool_t condition, const char* pName )
+{
+    printf( "[%s] %s\n", condition ? "PASS" : "FAIL", pName );
+    if( !condition )
+    {
+        s_failedCount++;
+    }
+}
+
+static RESULT PlaceResource( Frontend::RenderSystem* pSystem, index_t ndx, PlacedResource* pPlaced )
+{
+    Backend::IDevice* pDevice = pSystem->GetDevice();
+
+    Backend::ResourceDesc resDesc;
+    resDesc.arrayLayerCount = 1;
+    resDesc.mipLevelCount   = 1;
+    resDesc.sampleCount     = Backend::SampleCount::COUNT_1;
+    resDesc.sharingMode     = Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+    resDesc.flags           = BGS_FLAG( Backend::ResourceFlagBits::NONE );
+
+    Backend::MEMORY_HEAP_USAGE heapUsage = Backend::MemoryHeapUsages::BUFFERS;
+    if( ndx < BUFFER_COUNT )
+    {
+        // 256 B - 256 KB
+        resDesc.format         = Backend::Formats::UNKNOWN;
+        resDesc.size           = { 256U << ( NextRandom() % 11 ), 1, 1 };
+        resDesc.resourceType   = Backend::ResourceTypes::BUFFER;
+        resDesc.resourceLayout = Backend::ResourceLayouts::LINEAR;
+        resDesc.resourceUsage  = BGS_FLAG( Backend::ResourceUsageFlagBits::READ_ONLY_STORAGE_BUFFER ) |
+                                BGS_FLAG( Backend::ResourceUsageFlagBits::TRANSFER_DST );
+    }
+    else
+    {
+        // 64 x 64 - 512 x 512
+        const uint32_t size    = 64U << ( NextRandom() % 4 );
+        resDesc.format         = Backend::Formats::R8G8B8A8_UNORM;
+        resDesc.size           = { size, size, 1 };
+        resDesc.resourceType   = Backend::ResourceTypes::TEXTURE_2D;
+        resDesc.resourceLayout = Backend::ResourceLayouts::OPTIMAL;
+        resDesc.resourceUsage  = BGS_FLAG( Backend::ResourceUsageFlagBits::SAMPLED_TEXTURE ) |
+                                BGS_FLAG( Backend::ResourceUsageFlagBits::TRANSFER_DST );
+        heapUsage              = Backend::MemoryHeapUsages::TEXTURES;
+    }
+    if( BGS_FAILED( pDevice->CreateResource( resDesc, &pPlaced->hResource ) ) )
+    {
+        return Results::FAIL;
+    }
+
+    Backend::ResourceAllocationInfo allocInfo;
+    pDevice->GetResourceAllocationInfo( pPlaced->hResource, &allocInfo );
+    pPlaced->alignment = allocInfo.alignment;
+
+    return pSystem->GetDeviceMemorySystem()->AllocateAndBind( pPlaced->hResource, Backend::MemoryHeapTypes::DEFAULT, heapUsage,
+                                                              &pPlaced->memory );
+}
+
+static void ReleaseResource( Frontend::RenderSystem* pSystem, PlacedResource* pPlaced )
+{
+    pSystem->GetDeviceMemorySystem()->Free( &pPlaced->memory );
+    pSystem->GetDevice()->DestroyResource( &pPlaced->hResource );
+}
+
+static bool_t CheckAlignment( const PlacedResource* pResources )
+{
+    for( index_t ndx = 0; ndx < RESOURCE_COUNT; ++ndx )
+    {
+        const PlacedResource& res = pResources[ ndx ];
+        if( ( res.alignment > 0 ) && ( res.memory.offset % res.alignment != 0 ) )
+        {
+            return BGS_FALSE;
+        }
+    }
+
+    return BGS_TRUE;
+}
+
+static bool_t CheckOverlaps( const PlacedResource* pResources )
+{
+    for( index_t ndx = 0; ndx < RESOURCE_COUNT; ++ndx )
+    {
+        const Frontend::DeviceMemoryAllocation& memory = pResources[ ndx ].memory;
+        for( index_t otherNdx = ndx + 1; otherNdx < RESOURCE_COUNT; ++otherNdx )
+        {
+            const Frontend::DeviceMemoryAllocation& other = pResources[ otherNdx ].memory;
+            if( ( memory.hMemory == other.hMemory ) && ( memory.offset < other.offset + other.size ) &&
+                ( other.offset < memory.offset + memory.size ) )
+            {
+                return BGS_FALSE;
+            }
+        }
+    }
+
+    return BGS_TRUE;
+}
+
+static void PrintStats( const char* pName, Frontend::DeviceMemorySystem* pMemorySystem, double seconds )
+{
+    printf( "%-10s | %10u %12u %14.2f %14.2f %12.2f\n", pName, RESOURCE_COUNT, pMemorySystem->GetDeviceAllocationCount(),
+            pMemorySystem->GetAllocatedSize() / ( 1024.0 * 1024.0 ), pMemorySystem->GetUsedSize() / ( 1024.0 * 1024.0 ),
+            seconds * 1000000.0 / RESOURCE_COUNT );
+}
+
+int main( int argc, char** argv )
+{
+    bool_t isD3D12  = BGS_FALSE;
+    bool_t software = BGS_TRUE;
+    for( int ndx = 1; ndx < argc; ++ndx )
+    {
+        isD3D12  = isD3D12 || ( strcmp( argv[ ndx ], "d3d12" ) == 0 );
+        software = software && ( strcmp( argv[ ndx ], "hardware" ) != 0 );
+    }
+
+    BigosEngineDesc engineDesc;
+    BigosEngine*    pEngine = nullptr;
+    if( BGS_FAILED( CreateBigosEngine( engineDesc, &pEngine ) ) )
+    {
+        printf( "Failed to create engine.\n" );
+        return -1;
+    }
+    Frontend::RenderSystem& renderSystem = pEngine->GetRenderSystem();
+
+    Frontend::DriverDesc driverDesc;
+    driverDesc.apiType     = isD3D12 ? Backend::APITypes::D3D12 : Backend::APITypes::VULKAN;
+    driverDesc.adapterType = software ? Backend::AdapterTypes::SOFTWARE : Backend::AdapterTypes::_MAX_ENUM;
+    driverDesc.debug       = false;
+    if( BGS_FAILED( renderSystem.InitializeDriver( driverDesc ) ) )
+    {
+        printf( "Failed to initialize %s driver.\n", isD3D12 ? "D3D12" : "Vulkan" );
+        DestroyBigosEngine( &pEngine );
+        return -1;
+    }
+    printf( "Adapter: %s\n\n", renderSystem.GetDevice()->GetDesc().pAdapter->GetInfo().description );
+
+    Frontend::DeviceMemorySystem* pMemorySystem = renderSystem.GetDeviceMemorySystem();
+    PlacedResource*               pResources    = new PlacedResource[ RESOURCE_COUNT ];
+
+    Core::Utils::Timer timer;
+    bool_t             placed = BGS_TRUE;
+    for( index_t ndx = 0; ( ndx < RESOURCE_COUNT ) && placed; ++ndx )
+    {
+        placed = BGS_SUCCESS( PlaceResource( &renderSystem, ndx, &pResources[ ndx ] ) );
+    }
+    const double placeSeconds = timer.Elapsed();
+    Check( placed, "Every resource is placed" );
+
+    if( placed )
+    {
+        const uint32_t deviceAllocationCount = pMemorySystem->GetDeviceAllocationCount();
+
+        printf( "\n%-10s | %10s %12s %14s %14s %12s\n", "Pass", "Resources", "Allocations", "Allocated [MB]", "Used [MB]", "us / res" );
+        PrintStats( "Initial", pMemorySystem, placeSeconds );
+
+        // Every other resource is replaced, new ones have different sizes and have to fit into freed ranges
+        for( index_t ndx = 0; ndx < RESOURCE_COUNT; ndx += 2 )
+        {
+            ReleaseResource( &renderSystem, &pResources[ ndx ] );
+        }
+        timer.Reset();
+        for( index_t ndx = 0; ( ndx < RESOURCE_COUNT ) && placed; ndx += 2 )
+        {
+            placed = BGS_SUCCESS( PlaceResource( &renderSystem, ndx, &pResources[ ndx ] ) );
+        }
+        const double replaceSeconds = timer.Elapsed();
+        PrintStats( "Replaced", pMemorySystem, replaceSeconds * 2.0 );
+        printf( "\n" );
+
+        Check( placed, "Every replaced resource is placed" );
+        Check( pMemorySystem->GetDeviceAllocationCount() < RESOURCE_COUNT / 16, "Resources share device allocations" );
+        Check( pMemorySystem->GetDeviceAllocationCount() <= deviceAllocationCount * 2, "Freed ranges are reused" );
+        Check( CheckAlignment( pResources ), "Every resource is placed at its required alignment" );
+        Check( CheckOverlaps( pResources ), "Resources sharing device memory do not overlap" );
+    }
+    printf( "%u check(s) failed.\n", s_failedCount );
+
+    for( index_t ndx = 0; ndx < RESOURCE_COUNT; ++ndx )
+    {
+        if( pResources[ ndx ].hResource != Backend::ResourceHandle() )
+        {
+            ReleaseResource( &renderSystem, &pResources[ ndx ] );
+        }
+    }
+    delete[] pResources;
+    DestroyBigosEngine( &pEngine );
+
+    return s_failedCount == 0 ? 0 : -1;
+}
@@ -0,0 +1,199 @@
+#include "Core/CoreTypes.h"
+
+#include "BIGOS/BigosEngine.h"
+#include "Core/Memory/MemorySystem.h"
+#include "Core/Utils/Timer.h"
+
+#include <cstdio>
+#include <thread>
+
+// Checks of LinearAllocator behaviour (alignment, nested markers, exhaustion, reset, frame and thread scratch allocators) followed
+// by allocate and free cost compared to SystemHeapAllocator for blocks from 16 B to 4 KB. Returns non zero if any check fails.
+
+using namespace BIGOS;
+
+constexpr size_t ARENA_SIZE  = 16U * 1024U * 1024U;
+constexpr size_t BATCH_SIZE  = 1024;
+constexpr size_t BATCH_COUNT = 4 * 1024;
+
+static uint32_t s_failedCount = 0;
+
+static void Check( bool_t condition, const char* pName )
+{
+    printf( "[%s] %s\n", condition ? "PASS" : "FAIL", pName );
+    if( !condition )
+    {
+        s_failedCount++;
+    }
+}
+
+static bool_t IsAligned( const void* pMem, size_t alignment ) { return ( reinterpret_cast<uintptr_t>( pMem ) & ( alignment - 1 ) ) == 0; }
+
+static void TestAlignment( Core::Memory::LinearAllocator* pArena )
+{
+    const Core::Memory::LinearAllocatorMarker marker = pArena->GetMarker();
+
+    bool_t aligned = BGS_TRUE;
+    for( size_t ndx = 0; ndx < 64; ++ndx )
+    {
+        void* pMem = nullptr;
+        aligned &= BGS_SUCCESS( pArena->Allocate( 1 + ndx % 7, &pMem ) ) && IsAligned( pMem, Core::Memory::LINEAR_ALLOCATOR_MIN_ALIGNMENT );
+    }
+    Check( aligned, "Allocate() returns blocks with minimal alignment" );
+
+    aligned = BGS_TRUE;
+    for( size_t alignment = 16; alignment <= 4096; alignment *= 2 )
+    {
+        void* pSmall = nullptr;
+        void* pMem   = nullptr;
+        aligned &= BGS_SUCCESS( pArena->Allocate( 3, &pSmall ) );
+        aligned &= BGS_SUCCESS( pArena->AllocateAligned( 24, alignment, &pMem ) ) && IsAligned( pMem, alignment );
+    }
+    Check( aligned, "AllocateAligned() honours alignment up to 4096" );
+
+    pArena->FreeToMarker( marker );
+}
+
+static void TestMarkers( Core::Memory::LinearAllocator* pArena )
+{
+    const Core::Memory::LinearAllocatorMarker outer = pArena->GetMarker();
+    void*                                     pA    = nullptr;
+    pArena->Allocate( 100, &pA );
+
+    const Core::Memory::LinearAllocatorMarker inner = pArena->GetMarker();
+    void*                                     pB    = nullptr;
+    void*                                     pC    = nullptr;
+    pArena->Allocate( 200, &pB );
+    pArena->Allocate( 300, &pC );
+
+    pArena->FreeToMarker( inner );
+    void* pReusedB = nullptr;
+    pArena->Allocate( 200, &pReusedB );
+    Check( ( pReusedB == pB ) && ( pArena->GetUsedSize() > inner ), "Inner marker releases only allocations made after it" );
+
+    pArena->FreeToMarker( outer );
+    void* pReusedA = nullptr;
+    pArena->Allocate( 100, &pReusedA );
+    Check( pReusedA == pA, "Outer marker releases nested allocations" );
+
+    pArena->FreeToMarker( outer );
+    Check( pArena->GetUsedSize() == outer, "Used size returns to marker" );
+}
+
+static void TestExhaustion( Core::Memory::LinearAllocator* pArena )
+{
+    const Core::Memory::LinearAllocatorMarker marker = pArena->GetMarker();
+
+    void* pMem = nullptr;
+    Check( ( pArena->Allocate( pArena->GetCapacity() - marker + 1, &pMem ) == Results::NO_MEMORY ) && ( pMem == nullptr ) &&
+               ( pArena->GetUsedSize() == marker ),
+           "Allocation above capacity fails and leaves arena untouched" );
+
+    Check( BGS_SUCCESS( pArena->Allocate( pArena->GetCapacity() - marker, &pMem ) ) && ( pArena->GetUsedSize() == pArena->GetCapacity() ),
+           "Allocation of remaining capacity succeeds" );
+
+    pArena->FreeToMarker( marker );
+}
+
+static void TestReset( Core::Memory::LinearAllocator* pArena )
+{
+    void* pMem = nullptr;
+    pArena->Allocate( 4096, &pMem );
+    const size_t peakSize = pArena->GetPeakSize();
+    pArena->Reset();
+    Check( ( pArena->GetUsedSize() == 0 ) && ( pArena->GetPeakSize() == peakSize ) && ( peakSize >= 4096 ),
+           "Reset() releases everything and keeps peak size" );
+}
+
+static void TestFrameAndScratch( Core::Memory::MemorySystem* pMemorySystem )
+{
+    Core::Memory::LinearAllocator* pFrameAllocator = pMemorySystem->GetFrameAllocator();
+    void*                          pMem            = nullptr;
+    pFrameAllocator->Allocate( 1024, &pMem );
+    pMemorySystem->NewFrame();
+    Check( pFrameAllocator->GetUsedSize() == 0, "NewFrame() resets frame allocator" );
+
+    Core::Memory::LinearAllocator* pMainScratch  = pMemorySystem->GetThreadScratchAllocator();
+    Core::Memory::LinearAllocator* pOtherScratch = nullptr;
+    std::thread                    worker( [ & ]() { pOtherScratch = pMemorySystem->GetThreadScratchAllocator(); } );
+    worker.join();
+    Check( ( pMainScratch != nullptr ) && ( pMainScratch == pMemorySystem->GetThreadScratchAllocator() ),
+           "Thread scratch allocator is the same for one thread" );
+    Check( ( pOtherScratch != nullptr ) && ( pOtherScratch != pMainScratch ), "Every thread gets its own scratch allocator" );
+}
+
+// Returns ns per allocation and free pair
+template<class AllocatorT>
+static double Measure( AllocatorT* pAllocator, Core::Memory::LinearAllocator* pArena, size_t size )
+{
+    byte_t* pBlocks[ BATCH_SIZE ];
+
+    Core::Utils::Timer timer;
+    for( size_t batchNdx = 0; batchNdx < BATCH_COUNT; ++batchNdx )
+    {
+        const Core::Memory::LinearAllocatorMarker marker = pArena->GetMarker();
+        for( size_t ndx = 0; ndx < BATCH_SIZE; ++ndx )
+        {
+            pBlocks[ ndx ] = nullptr;
+            Core::Memory::AllocateBytes( pAllocator, &pBlocks[ ndx ], size );
+            pBlocks[ ndx ][ 0 ] = static_cast<byte_t>( ndx );
+        }
+        for( size_t ndx = 0; ndx < BATCH_SIZE; ++ndx )
+        {
+            Core::Memory::Free( pAllocator, &pBlocks[ ndx ] );
+        }
+        pArena->FreeToMarker( marker );
+    }
+    const double seconds = timer.Elapsed();
+
+    return seconds * 1000000000.0 / static_cast<double>( BATCH_SIZE * BATCH_COUNT );
+}
+
+int main()
+{
+    BigosEngineDesc engineDesc;
+    BigosEngine*    pEngine = nullptr;
+    if( BGS_FAILED( CreateBigosEngine( engineDesc, &pEngine ) ) )
+    {
+        printf( "Failed to create engine.\n" );
+        return -1;
+    }
+    Core::Memory::MemorySystem& memorySystem = pEngine->GetMemorySystem();
+
+    Core::Memory::AllocatorDesc arenaDesc;
+    arenaDesc.type     = Core::Memory::AllocatorTypes::LINEAR;
+    arenaDesc.capacity = ARENA_SIZE;
+
+    Core::Memory::IAllocator* pAllocator = nullptr;
+    if( BGS_FAILED( memorySystem.CreateAllocator( arenaDesc, &pAllocator ) ) )
+    {
+        printf( "Failed to create linear allocator.\n" );
+        DestroyBigosEngine( &pEngine );
+        return -1;
+    }
+    Core::Memory::LinearAllocator* pArena = static_cast<Core::Memory::LinearAllocator*>( pAllocator );
+
+    TestAlignment( pArena );
+    TestMarkers( pArena );
+    TestExhaustion( pArena );
+    TestReset( pArena );
+    TestFrameAndScratch( &memorySystem );
+    printf( "%u check(s) failed.\n\n", s_failedCount );
+
+    // Volatile pointer keeps compiler from devirtualizing calls through IAllocator*
+    Core::Memory::IAllocator* volatile pDynamicArena = pArena;
+    Core::Memory::SystemHeapAllocator* pSystemHeap   = memorySystem.GetSystemHeapAllocator();
+
+    printf( "%10s | %12s %12s %12s\n", "Size [B]", "SystemHeap", "IAllocator*", "Linear*" );
+    for( size_t size = 16; size <= 4096; size *= 4 )
+    {
+        printf( "%10zu | %12.2f %12.2f %12.2f\n", size, Measure( pSystemHeap, pArena, size ), Measure( pDynamicArena, pArena, size ),
+                Measure( pArena, pArena, size ) );
+    }
+    printf( "Time in ns per allocation and free.\n" );
+
+    memorySystem.DestroyAllocator( &pAllocator );
+    DestroyBigosEngine( &pEngine );
+
+    return s_failedCount == 0 ? 0 : -1;
+}
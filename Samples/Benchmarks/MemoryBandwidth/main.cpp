@@ -0,0 +1,84 @@
+#include "Core/CoreTypes.h"
+
+#include "Core/Memory/Memory.h"
+#include "Core/Utils/Timer.h"
+
+#include <cstdio>
+#include <cstring>
+
+// Host copy and fill bandwidth of libc, Memory::Copy / Set (switch to streaming stores from STREAMING_COPY_MIN_SIZE up) and
+// Memory::StreamCopy / StreamSet, for blocks from 64 B to 256 MB. Every size moves about 1 GB, so small blocks run from cache.
+
+using namespace BIGOS;
+
+constexpr size_t MIN_SIZE       = 64;
+constexpr size_t MAX_SIZE       = 256U * 1024U * 1024U;
+constexpr size_t BYTES_PER_SIZE = 1024U * 1024U * 1024U;
+constexpr size_t MIN_REPEATS    = 4;
+
+using CopyFunc = void ( * )( const void* pSrc, void* pDst, size_t size );
+
+static void LibcCopy( const void* pSrc, void* pDst, size_t size ) { memcpy( pDst, pSrc, size ); }
+static void CoreCopy( const void* pSrc, void* pDst, size_t size ) { Core::Memory::Copy( pSrc, size, pDst, size ); }
+static void CoreStreamCopy( const void* pSrc, void* pDst, size_t size ) { Core::Memory::StreamCopy( pSrc, size, pDst, size ); }
+static void LibcSet( const void* pSrc, void* pDst, size_t size )
+{
+    pSrc;
+    memset( pDst, 0x5A, size );
+}
+static void CoreSet( const void* pSrc, void* pDst, size_t size )
+{
+    pSrc;
+    Core::Memory::Set( pDst, 0x5A, size );
+}
+static void CoreStreamSet( const void* pSrc, void* pDst, size_t size )
+{
+    pSrc;
+    Core::Memory::StreamSet( pDst, 0x5A, size );
+}
+
+// Returns GB/s of bytes written
+static double Measure( CopyFunc pFunc, const byte_t* pSrc, byte_t* pDst, size_t size )
+{
+    size_t repeats = BYTES_PER_SIZE / size;
+    repeats        = repeats > MIN_REPEATS ? repeats : MIN_REPEATS;
+
+    // Warm up, first touch of pages is not measured
+    pFunc( pSrc, pDst, size );
+
+    Core::Utils::Timer timer;
+    for( size_t ndx = 0; ndx < repeats; ++ndx )
+    {
+        pFunc( pSrc, pDst, size );
+    }
+    const double seconds = timer.Elapsed();
+
+    return seconds > 0.0 ? static_cast<double>( size ) * repeats / seconds / ( 1024.0 * 1024.0 * 1024.0 ) : 0.0;
+}
+
+int main()
+{
+    byte_t* pSrc = static_cast<byte_t*>( Core::Memory::MallocAligned( MAX_SIZE, 64 ) );
+    byte_t* pDst = static_cast<byte_t*>( Core::Memory::MallocAligned( MAX_SIZE, 64 ) );
+    if( ( pSrc == nullptr ) || ( pDst == nullptr ) )
+    {
+        printf( "Failed to allocate %zu MB buffers.\n", MAX_SIZE / ( 1024U * 1024U ) );
+        return -1;
+    }
+    memset( pSrc, 0xA5, MAX_SIZE );
+    memset( pDst, 0, MAX_SIZE );
+
+    printf( "%12s | %10s %10s %10s | %10s %10s %10s\n", "Size [B]", "memcpy", "Copy", "StreamCopy", "memset", "Set", "StreamSet" );
+    for( size_t size = MIN_SIZE; size <= MAX_SIZE; size *= 2 )
+    {
+        printf( "%12zu | %10.2f %10.2f %10.2f | %10.2f %10.2f %10.2f\n", size, Measure( LibcCopy, pSrc, pDst, size ),
+                Measure( CoreCopy, pSrc, pDst, size ), Measure( CoreStreamCopy, pSrc, pDst, size ), Measure( LibcSet, pSrc, pDst, size ),
+                Measure( CoreSet, pSrc, pDst, size ), Measure( CoreStreamSet, pSrc, pDst, size ) );
+    }
+    printf( "Bandwidth in GB/s.\n" );
+
+    Core::Memory::FreeAligned( pSrc );
+    Core::Memory::FreeAligned( pDst );
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include "Core/CoreTypes.h"
+
+#include "BIGOS/BigosEngine.h"
+#include "Core/Utils/Timer.h"
+#include "Driver/Backend/API.h"
+#include "Driver/Frontend/Pipeline.h"
+#include "Driver/Frontend/RenderSystem.h"
+#include "Driver/Frontend/Shader/Shader.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+// Times creation of a library of compute pipelines at application start, first without pipeline cache file (cold) and then with the
+// file saved at shutdown of the first run (warm). Every run creates engine and driver from scratch. Shaders are compiled before timer
+// starts, so only pipeline creation is measured. Software adapter (lavapipe, WARP) is used unless "hardware" is passed, "d3d12"
+// switches the backend from Vulkan.
+
+using namespace BIGOS;
+using namespace BIGOS::Driver;
+
+constexpr uint32_t PIPELINE_COUNT = 64;
+
+static const char* CACHE_PATH = "PipelineCacheBenchmark.bin";
+
+static const char* SHADER_SOURCE = "RWStructuredBuffer<float4> output : register( u0 );\n"
+                                   "static const uint SEED = %u;\n"
+                                   "[numthreads( 64, 1, 1 )]\n"
+                                   "void CSMain( uint3 id : SV_DispatchThreadID )\n"
+                                   "{\n"
+                                   "    float4 value = float4( id.x, SEED, 0.0f, 1.0f );\n"
+                                   "    [unroll] for( uint ndx = 0; ndx < 32; ++ndx )\n"
+                                   "    {\n"
+                                   "        value = sin( value * 1.7f + ndx ) * cos( value.yzwx + SEED );\n"
+                                   "    }\n"
+                                   "    output[ id.x ] = value;\n"
+                                   "}\n";
+
+static uint32_t s_failedCount = 0;
+
+static void Check( bool_t condition, const char* pName )
+{
+    printf( "[%s] %s\n", condition ? "PASS" : "FAIL", pName );
+    if( !condition )
+    {
+        s_failedCount++;
+    }
+}
+
+static RESULT CreateShaders( Frontend::RenderSystem* pSystem, HeapArray<Frontend::Shader*>* pShaders )
+{
+    char source[ 1024 ];
+    for( uint32_t ndx = 0; ndx < PIPELINE_COUNT; ++ndx )
+    {
+        snprintf( source, sizeof( source ), SHADER_SOURCE, ndx );
+
+        Frontend::ShaderDesc desc;
+        desc.source.pSourceCode = source;
+        desc.source.sourceSize  = static_cast<uint32_t>( strlen( source ) );
+        desc.type               = Backend::ShaderTypes::COMPUTE;
+        if( BGS_FAILED( pSystem->CreateShader( desc, &( *pShaders )[ ndx ] ) ) )
+        {
+            return Results::FAIL;
+        }
+    }
+
+    return Results::OK;
+}
+
+// Engine is destroyed at the end, which writes pipeline cache file
+static RESULT RunStartup( const Frontend::DriverDesc& driverDesc, double* pSeconds )
+{
+    BigosEngineDesc engineDesc;
+    BigosEngine*    pEngine = nullptr;
+    if( BGS_FAILED( CreateBigosEngine( engineDesc, &pEngine ) ) )
+    {
+        printf( "Failed to create engine.\n" );
+        return Results::FAIL;
+    }
+    Frontend::RenderSystem& renderSystem = pEngine->GetRenderSystem();
+    if( BGS_FAILED( renderSystem.InitializeDriver( driverDesc ) ) )
+    {
+        printf( "Failed to initialize %s driver.\n", driverDesc.apiType == Backend::APITypes::D3D12 ? "D3D12" : "Vulkan" );
+        DestroyBigosEngine( &pEngine );
+        return Results::FAIL;
+    }
+
+    HeapArray<Frontend::Shader*>   shaders( PIPELINE_COUNT, nullptr );
+    HeapArray<Frontend::Pipeline*> pipelines( PIPELINE_COUNT, nullptr );
+    bool_t                         succeeded = BGS_SUCCESS( CreateShaders( &renderSystem, &shaders ) );
+
+    Core::Utils::Timer timer;
+    for( uint32_t ndx = 0; ( ndx < PIPELINE_COUNT ) && succeeded; ++ndx )
+    {
+        Frontend::ComputePipelineDesc pipelineDesc;
+        pipelineDesc.pComputeShader = shaders[ ndx ];
+        succeeded                   = BGS_SUCCESS( renderSystem.CreatePipeline( pipelineDesc, &pipelines[ ndx ] ) );
+    }
+    *pSeconds = timer.Elapsed();
+
+    for( uint32_t ndx = 0; ndx < PIPELINE_COUNT; ++ndx )
+    {
+        if( pipelines[ ndx ] != nullptr )
+        {
+            renderSystem.DestroyPipeline( &pipelines[ ndx ] );
+        }
+        if( shaders[ ndx ] != nullptr )
+        {
+            renderSystem.DestroyShader( &shaders[ ndx ] );
+        }
+    }
+    DestroyBigosEngine( &pEngine );
+
+    return succeeded ? Results::OK : Results::FAIL;
+}
+
+static uint64_t GetCacheFileSize()
+{
+    std::ifstream file( CACHE_PATH, std::ios::binary | std::ios::ate );
+    const std::streamoff size = file.is_open() ? static_cast<std::streamoff>( file.tellg() ) : 0;
+
+    return size > 0 ? static_cast<uint64_t>( size ) : 0;
+}
+
+int main( int argc, char** argv )
+{
+    bool_t isD3D12  = BGS_FALSE;
+    bool_t software = BGS_TRUE;
+    for( int ndx = 1; ndx < argc; ++ndx )
+    {
+        isD3D12  = isD3D12 || ( strcmp( argv[ ndx ], "d3d12" ) == 0 );
+        software = software && ( strcmp( argv[ ndx ], "hardware" ) != 0 );
+    }
+
+    Frontend::DriverDesc driverDesc;
+    driverDesc.apiType            = isD3D12 ? Backend::APITypes::D3D12 : Backend::APITypes::VULKAN;
+    driverDesc.adapterType        = software ? Backend::AdapterTypes::SOFTWARE : Backend::AdapterTypes::_MAX_ENUM;
+    driverDesc.debug              = false;
+    driverDesc.pPipelineCachePath = CACHE_PATH;
+
+    // Cold start must not find file of earlier run
+    std::remove( CACHE_PATH );
+
+    double         coldSeconds   = 0.0;
+    const bool_t   coldSucceeded = BGS_SUCCESS( RunStartup( driverDesc, &coldSeconds ) );
+    const uint64_t cacheSize     = GetCacheFileSize();
+    double         warmSeconds   = 0.0;
+    const bool_t   warmSucceeded = coldSucceeded && BGS_SUCCESS( RunStartup( driverDesc, &warmSeconds ) );
+    std::remove( CACHE_PATH );
+
+    printf( "%u compute pipelines, cache file %.1f KB\n\n", PIPELINE_COUNT, cacheSize / 1024.0 );
+    printf( "%-6s | %10s %15s\n", "Start", "Time [ms]", "ms / pipeline" );
+    printf( "%-6s | %10.2f %15.3f\n", "Cold", coldSeconds * 1000.0, coldSeconds * 1000.0 / PIPELINE_COUNT );
+    if( warmSucceeded )
+    {
+        printf( "%-6s | %10.2f %15.3f\n", "Warm", warmSeconds * 1000.0, warmSeconds * 1000.0 / PIPELINE_COUNT );
+        printf( "Speedup %.2fx\n", warmSeconds > 0.0 ? coldSeconds / warmSeconds : 0.0 );
+    }
+    printf( "\n" );
+
+    Check( coldSucceeded && warmSucceeded, "Every pipeline is created in both runs" );
+    Check( cacheSize > 0, "Pipeline cache file is written at shutdown" );
+    Check( warmSucceeded && ( warmSeconds < coldSeconds ), "Pipelines are created faster with cache file loaded" );
+    printf( "%u check(s) failed.\n", s_failedCount );
+
+    return s_failedCount == 0 ? 0 : -1;
+}
@@ -0,0 +1,195 @@
+#include "Core/CoreTypes.h"
+
+#include "BIGOS/BigosEngine.h"
+#include "Core/Utils/Timer.h"
+#include "Driver/Backend/API.h"
+#include "Driver/Frontend/RenderSystem.h"
+#include "Driver/Frontend/Shader/AsyncShaderCompiler.h"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+// Compiles a library of compute shaders with synchronous RenderSystem::CreateShader and then with AsyncShaderCompiler from one
+// worker up to one worker per hardware thread. Every run compiles different sources, so shader cache never returns earlier results.
+// Prints time per run and speedup against single worker. "d3d12" argument switches the backend from Vulkan.
+
+using namespace BIGOS;
+using namespace BIGOS::Driver;
+
+constexpr uint32_t SHADER_COUNT  = 256;
+constexpr uint32_t MAX_RUN_COUNT = 16;
+
+static const char* SHADER_SOURCE = "RWStructuredBuffer<float4> output : register( u0 );\n"
+                                   "static const uint SEED = %u;\n"
+                                   "[numthreads( 64, 1, 1 )]\n"
+                                   "void CSMain( uint3 id : SV_DispatchThreadID )\n"
+                                   "{\n"
+                                   "    float4 value = float4( id.x, SEED, 0.0f, 1.0f );\n"
+                                   "    [unroll] for( uint ndx = 0; ndx < 32; ++ndx )\n"
+                                   "    {\n"
+                                   "        value = sin( value * 1.7f + ndx ) * cos( value.yzwx + SEED );\n"
+                                   "    }\n"
+                                   "    output[ id.x ] = value;\n"
+                                   "}\n";
+
+static uint32_t s_failedCount = 0;
+
+static void Check( bool_t condition, const char* pName )
+{
+    printf( "[%s] %s\n", condition ? "PASS" : "FAIL", pName );
+    if( !condition )
+    {
+        s_failedCount++;
+    }
+}
+
+static void BuildSources( uint32_t runNdx, HeapArray<String>* pSources )
+{
+    char source[ 1024 ];
+    for( uint32_t ndx = 0; ndx < SHADER_COUNT; ++ndx )
+    {
+        snprintf( source, sizeof( source ), SHADER_SOURCE, runNdx * SHADER_COUNT + ndx );
+        ( *pSources )[ ndx ] = source;
+    }
+}
+
+static Frontend::ShaderDesc GetShaderDesc( const String& source )
+{
+    Frontend::ShaderDesc desc;
+    desc.source.pSourceCode = source.c_str();
+    desc.source.sourceSize  = static_cast<uint32_t>( source.size() );
+    desc.type               = Backend::ShaderTypes::COMPUTE;
+
+    return desc;
+}
+
+static double CompileSync( Frontend::RenderSystem* pSystem, const HeapArray<String>& sources, bool_t* pSucceeded )
+{
+    *pSucceeded = BGS_TRUE;
+
+    Core::Utils::Timer timer;
+    for( index_t ndx = 0; ndx < sources.size(); ++ndx )
+    {
+        Frontend::Shader* pShader = nullptr;
+        if( BGS_FAILED( pSystem->CreateShader( GetShaderDesc( sources[ ndx ] ), &pShader ) ) )
+        {
+            *pSucceeded = BGS_FALSE;
+            continue;
+        }
+        pSystem->DestroyShader( &pShader );
+    }
+
+    return timer.Elapsed();
+}
+
+// Compiler and its workers are created before timer starts, so only compilation is measured
+static double CompileAsync( Frontend::RenderSystem* pSystem, uint32_t workerCount, const HeapArray<String>& sources, bool_t* pSucceeded )
+{
+    *pSucceeded = BGS_FALSE;
+
+    Frontend::AsyncShaderCompilerDesc compilerDesc;
+    compilerDesc.workerCount = workerCount;
+
+    Frontend::AsyncShaderCompiler* pCompiler = nullptr;
+    if( BGS_FAILED( pSystem->CreateAsyncShaderCompiler( compilerDesc, &pCompiler ) ) )
+    {
+        return 0.0;
+    }
+
+    HeapArray<index_t> jobs( sources.size() );
+    bool_t             succeeded = BGS_TRUE;
+    Core::Utils::Timer timer;
+    for( index_t ndx = 0; ndx < sources.size(); ++ndx )
+    {
+        succeeded = BGS_SUCCESS( pCompiler->CompileShader( GetShaderDesc( sources[ ndx ] ), &jobs[ ndx ] ) ) && succeeded;
+    }
+    for( index_t ndx = 0; ( ndx < sources.size() ) && succeeded; ++ndx )
+    {
+        Frontend::Shader* pShader = nullptr;
+        if( BGS_FAILED( pCompiler->GetShader( jobs[ ndx ], &pShader ) ) )
+        {
+            succeeded = BGS_FALSE;
+            continue;
+        }
+        pSystem->DestroyShader( &pShader );
+    }
+    const double seconds = timer.Elapsed();
+
+    pSystem->DestroyAsyncShaderCompiler( &pCompiler );
+    *pSucceeded = succeeded;
+
+    return seconds;
+}
+
+int main( int argc, char** argv )
+{
+    bool_t isD3D12 = BGS_FALSE;
+    for( int ndx = 1; ndx < argc; ++ndx )
+    {
+        isD3D12 = isD3D12 || ( strcmp( argv[ ndx ], "d3d12" ) == 0 );
+    }
+
+    BigosEngineDesc engineDesc;
+    BigosEngine*    pEngine = nullptr;
+    if( BGS_FAILED( CreateBigosEngine( engineDesc, &pEngine ) ) )
+    {
+        printf( "Failed to create engine.\n" );
+        return -1;
+    }
+    Frontend::RenderSystem& renderSystem = pEngine->GetRenderSystem();
+
+    Frontend::DriverDesc driverDesc;
+    driverDesc.apiType = isD3D12 ? Backend::APITypes::D3D12 : Backend::APITypes::VULKAN;
+    driverDesc.debug   = false;
+    if( BGS_FAILED( renderSystem.InitializeDriver( driverDesc ) ) )
+    {
+        printf( "Failed to initialize %s driver.\n", isD3D12 ? "D3D12" : "Vulkan" );
+        DestroyBigosEngine( &pEngine );
+        return -1;
+    }
+
+    // Can return 0, if it is not known
+    uint32_t threadCount = std::thread::hardware_concurrency();
+    threadCount          = threadCount > 0 ? threadCount : 1;
+    printf( "%u shaders, %u hardware threads\n\n", SHADER_COUNT, threadCount );
+
+    HeapArray<String> sources( SHADER_COUNT );
+    uint32_t          runNdx       = 0;
+    bool_t            allSucceeded = BGS_TRUE;
+
+    BuildSources( runNdx++, &sources );
+    const double syncSeconds = CompileSync( &renderSystem, sources, &allSucceeded );
+    printf( "%-12s | %10s %12s %8s\n", "Workers", "Time [ms]", "ms / shader", "Speedup" );
+    printf( "%-12s | %10.2f %12.3f %8s\n", "CreateShader", syncSeconds * 1000.0, syncSeconds * 1000.0 / SHADER_COUNT, "-" );
+
+    // Powers of two and hardware thread count itself
+    double singleSeconds = 0.0;
+    double lastSpeedup   = 0.0;
+    for( uint32_t workerCount = 1; ( workerCount <= threadCount ) && ( runNdx < MAX_RUN_COUNT ); )
+    {
+        bool_t succeeded;
+        BuildSources( runNdx++, &sources );
+        const double seconds = CompileAsync( &renderSystem, workerCount, sources, &succeeded );
+        allSucceeded         = allSucceeded && succeeded;
+        if( !succeeded )
+        {
+            printf( "%-12u | compilation failed\n", workerCount );
+            break;
+        }
+        singleSeconds = workerCount == 1 ? seconds : singleSeconds;
+        lastSpeedup   = seconds > 0.0 ? singleSeconds / seconds : 0.0;
+        printf( "%-12u | %10.2f %12.3f %8.2f\n", workerCount, seconds * 1000.0, seconds * 1000.0 / SHADER_COUNT, lastSpeedup );
+
+        workerCount = ( workerCount < threadCount ) && ( workerCount * 2 > threadCount ) ? threadCount : workerCount * 2;
+    }
+    printf( "\n" );
+
+    Check( allSucceeded, "Every shader compiles" );
+    Check( ( threadCount == 1 ) || ( lastSpeedup > 1.0 ), "Workers on every hardware thread compile faster than one worker" );
+    printf( "%u check(s) failed.\n", s_failedCount );
+
+    DestroyBigosEngine( &pEngine );
+
+    return s_failedCount == 0 ? 0 : -1;
+}
@@ -0,0 +1,187 @@
+#include "Core/CoreTypes.h"
+
+#include "BIGOS/BigosEngine.h"
+#include "Core/Memory/MemorySystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+// Long session of frontend object churn: blocks from 32 B to 64 KB (log uniform, like Buffer / Texture / Pipeline objects and
+// their arrays) are allocated and freed at random while live set size swings between low and high watermark. Prints latency
+// percentiles of allocation and free for TLSF and system heap, and TLSF reserved memory over used memory at checkpoints, which
+// stays bounded when fragmentation is bounded.
+
+using namespace BIGOS;
+
+constexpr uint32_t OPERATION_COUNT  = 4U * 1024U * 1024U;
+constexpr uint32_t CHECKPOINT_COUNT = 8;
+constexpr uint32_t MAX_LIVE_COUNT   = 8U * 1024U;
+constexpr uint32_t MIN_LIVE_COUNT   = 2U * 1024U;
+constexpr uint32_t MIN_BLOCK_SHIFT  = 5;
+constexpr uint32_t MAX_BLOCK_SHIFT  = 15;
+constexpr size_t   TLSF_POOL_SIZE   = 64U * 1024U * 1024U;
+
+using Clock = std::chrono::high_resolution_clock;
+
+struct RandomGenerator
+{
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    uint32_t Next()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<uint32_t>( state >> 32 );
+    }
+};
+
+struct LatencyStats
+{
+    HeapArray<uint32_t> allocNanos;
+    HeapArray<uint32_t> freeNanos;
+};
+
+static size_t RandomBlockSize( RandomGenerator* pRandom )
+{
+    const uint32_t shift = MIN_BLOCK_SHIFT + pRandom->Next() % ( MAX_BLOCK_SHIFT - MIN_BLOCK_SHIFT + 1 );
+    const size_t   base  = size_t( 1 ) << shift;
+    return base + pRandom->Next() % base;
+}
+
+static uint32_t Percentile( HeapArray<uint32_t>* pValues, double percentile )
+{
+    if( pValues->empty() )
+    {
+        return 0;
+    }
+    const size_t ndx = static_cast<size_t>( percentile * static_cast<double>( pValues->size() - 1 ) );
+    std::nth_element( pValues->begin(), pValues->begin() + ndx, pValues->end() );
+    return ( *pValues )[ ndx ];
+}
+
+// Same random sequence is replayed for every allocator, tlsf is nullptr for system heap
+template<class AllocatorT>
+static bool_t RunSession( AllocatorT* pAllocator, Core::Memory::TlsfAllocator* pTlsf, LatencyStats* pStats )
+{
+    HeapArray<byte_t*> live;
+    live.reserve( MAX_LIVE_COUNT );
+    pStats->allocNanos.reserve( OPERATION_COUNT );
+    pStats->freeNanos.reserve( OPERATION_COUNT );
+
+    RandomGenerator random;
+    bool_t          growing = BGS_TRUE;
+    for( uint32_t opNdx = 0; opNdx < OPERATION_COUNT; ++opNdx )
+    {
+        if( live.size() >= MAX_LIVE_COUNT )
+        {
+            growing = BGS_FALSE;
+        }
+        else if( live.size() <= MIN_LIVE_COUNT )
+        {
+            growing = BGS_TRUE;
+        }
+
+        // Live set drifts towards watermark, but allocations and frees stay interleaved
+        const bool_t allocate = live.empty() || ( random.Next() % 4 != 0 ? growing : !growing );
+        if( allocate )
+        {
+            const size_t size   = RandomBlockSize( &random );
+            byte_t*      pBlock = nullptr;
+
+            const Clock::time_point start = Clock::now();
+            const RESULT            res   = Core::Memory::AllocateBytes( pAllocator, &pBlock, size );
+            const Clock::time_point end   = Clock::now();
+            if( BGS_FAILED( res ) )
+            {
+                return BGS_FALSE;
+            }
+            pBlock[ 0 ] = static_cast<byte_t>( opNdx );
+            live.push_back( pBlock );
+            pStats->allocNanos.push_back( static_cast<uint32_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( end - start ).count() ) );
+        }
+        else
+        {
+            const size_t liveNdx = random.Next() % live.size();
+            byte_t*      pBlock  = live[ liveNdx ];
+            live[ liveNdx ]      = live.back();
+            live.pop_back();
+
+            const Clock::time_point start = Clock::now();
+            Core::Memory::Free( pAllocator, &pBlock );
+            const Clock::time_point end = Clock::now();
+            pStats->freeNanos.push_back( static_cast<uint32_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( end - start ).count() ) );
+        }
+
+        if( ( pTlsf != nullptr ) && ( ( opNdx + 1 ) % ( OPERATION_COUNT / CHECKPOINT_COUNT ) == 0 ) )
+        {
+            const size_t reservedSize = pTlsf->GetPoolCount() * pTlsf->GetPoolSize();
+            printf( "  after %8u ops: used %8.2f MB, reserved %8.2f MB, reserved / used %5.2f\n", opNdx + 1,
+                    pTlsf->GetUsedSize() / ( 1024.0 * 1024.0 ), reservedSize / ( 1024.0 * 1024.0 ),
+                    pTlsf->GetUsedSize() > 0 ? static_cast<double>( reservedSize ) / pTlsf->GetUsedSize() : 0.0 );
+        }
+    }
+
+    for( size_t ndx = 0; ndx < live.size(); ++ndx )
+    {
+        Core::Memory::Free( pAllocator, &live[ ndx ] );
+    }
+
+    return BGS_TRUE;
+}
+
+static void PrintStats( const char* pName, LatencyStats* pStats )
+{
+    printf( "%-12s %-6s | %8u %8u %8u %8u\n", pName, "alloc", Percentile( &pStats->allocNanos, 0.5 ), Percentile( &pStats->allocNanos, 0.99 ),
+            Percentile( &pStats->allocNanos, 0.999 ), Percentile( &pStats->allocNanos, 1.0 ) );
+    printf( "%-12s %-6s | %8u %8u %8u %8u\n", pName, "free", Percentile( &pStats->freeNanos, 0.5 ), Percentile( &pStats->freeNanos, 0.99 ),
+            Percentile( &pStats->freeNanos, 0.999 ), Percentile( &pStats->freeNanos, 1.0 ) );
+}
+
+int main()
+{
+    BigosEngineDesc engineDesc;
+    BigosEngine*    pEngine = nullptr;
+    if( BGS_FAILED( CreateBigosEngine( engineDesc, &pEngine ) ) )
+    {
+        printf( "Failed to create engine.\n" );
+        return -1;
+    }
+    Core::Memory::MemorySystem& memorySystem = pEngine->GetMemorySystem();
+
+    Core::Memory::AllocatorDesc tlsfDesc;
+    tlsfDesc.type     = Core::Memory::AllocatorTypes::TLSF;
+    tlsfDesc.capacity = TLSF_POOL_SIZE;
+
+    Core::Memory::IAllocator* pAllocator = nullptr;
+    if( BGS_FAILED( memorySystem.CreateAllocator( tlsfDesc, &pAllocator ) ) )
+    {
+        printf( "Failed to create TLSF allocator.\n" );
+        DestroyBigosEngine( &pEngine );
+        return -1;
+    }
+    Core::Memory::TlsfAllocator* pTlsf = static_cast<Core::Memory::TlsfAllocator*>( pAllocator );
+
+    LatencyStats tlsfStats;
+    LatencyStats heapStats;
+    printf( "TLSF session:\n" );
+    const bool_t tlsfSucceeded = RunSession( pTlsf, pTlsf, &tlsfStats );
+    const bool_t heapSucceeded = RunSession( memorySystem.GetSystemHeapAllocator(), nullptr, &heapStats );
+    if( tlsfSucceeded && heapSucceeded )
+    {
+        printf( "\n%-19s | %8s %8s %8s %8s\n", "Allocator", "p50", "p99", "p99.9", "max" );
+        PrintStats( "TLSF", &tlsfStats );
+        PrintStats( "SystemHeap", &heapStats );
+        printf( "Latency in ns, includes clock read overhead.\n" );
+    }
+    else
+    {
+        printf( "Allocation failed.\n" );
+    }
+
+    memorySystem.DestroyAllocator( &pAllocator );
+    DestroyBigosEngine( &pEngine );
+
+    return tlsfSucceeded && heapSucceeded ? 0 : -1;
+}
@@ -0,0 +1,180 @@
+#include "Core/CoreTypes.h"
+
+#include "BIGOS/BigosEngine.h"
+#include "Driver/Frontend/RenderSystem.h"
+#include "Driver/Frontend/SyncSystem.h"
+#include "Driver/Frontend/TransientResourcePool.h"
+
+#include <cstdio>
+#include <cstring>
+
+// Device memory saved by aliasing intermediate textures of a deferred frame with post processing, compared to placing them one
+// after another. Checks that textures used in the same pass never share memory. Pass "vulkan" as argument to run on Vulkan, D3D12
+// is used otherwise.
+
+using namespace BIGOS;
+using namespace BIGOS::Driver;
+
+struct FrameTexture
+{
+    const char*     pName;
+    Backend::FORMAT format;
+    uint32_t        divider; // Of frame resolution
+    bool_t          isDepth;
+    uint32_t        firstPass;
+    uint32_t        lastPass;
+};
+
+// Geometry, ambient occlusion, lighting, bloom down and up sampling, tone mapping, anti-aliasing
+static const FrameTexture FRAME_TEXTURES[] = {
+    { "Albedo", Backend::Formats::R8G8B8A8_UNORM, 1, BGS_FALSE, 0, 2 },
+    { "Normals", Backend::Formats::R16G16B16A16_FLOAT, 1, BGS_FALSE, 0, 2 },
+    { "Material", Backend::Formats::R8G8B8A8_UNORM, 1, BGS_FALSE, 0, 2 },
+    { "Depth", Backend::Formats::D32_FLOAT, 1, BGS_TRUE, 0, 2 },
+    { "AO", Backend::Formats::R8_UNORM, 2, BGS_FALSE, 1, 2 },
+    { "HDR", Backend::Formats::R16G16B16A16_FLOAT, 1, BGS_FALSE, 2, 5 },
+    { "BloomHalf", Backend::Formats::R16G16B16A16_FLOAT, 2, BGS_FALSE, 3, 4 },
+    { "BloomQuarter", Backend::Formats::R16G16B16A16_FLOAT, 4, BGS_FALSE, 3, 4 },
+    { "BloomResult", Backend::Formats::R16G16B16A16_FLOAT, 2, BGS_FALSE, 4, 5 },
+    { "LDR", Backend::Formats::R8G8B8A8_UNORM, 1, BGS_FALSE, 5, 6 },
+    { "AA", Backend::Formats::R8G8B8A8_UNORM, 1, BGS_FALSE, 6, 7 },
+};
+constexpr uint32_t FRAME_TEXTURE_COUNT = sizeof( FRAME_TEXTURES ) / sizeof( FRAME_TEXTURES[ 0 ] );
+
+static uint32_t s_failedCount = 0;
+
+static void Check( bool_t condition, const char* pName )
+{
+    printf( "[%s] %s\n", condition ? "PASS" : "FAIL", pName );
+    if( !condition )
+    {
+        s_failedCount++;
+    }
+}
+
+// Every pair of textures with overlapping pass ranges placed in the same heap has to occupy disjoint byte ranges
+static bool_t IsPlacementValid( const Frontend::TransientResourcePool* pPool )
+{
+    for( index_t ndx = 0; ndx < pPool->GetTextureCount(); ++ndx )
+    {
+        const Frontend::TransientTextureDesc& desc = pPool->GetDesc( ndx );
+        for( index_t otherNdx = ndx + 1; otherNdx < pPool->GetTextureCount(); ++otherNdx )
+        {
+            const Frontend::TransientTextureDesc& otherDesc = pPool->GetDesc( otherNdx );
+            if( ( pPool->GetHeapUsage( ndx ) != pPool->GetHeapUsage( otherNdx ) ) || ( otherDesc.lastPass < desc.firstPass ) ||
+                ( otherDesc.firstPass > desc.lastPass ) )
+            {
+                continue;
+            }
+            const uint64_t offset      = pPool->GetOffset( ndx );
+            const uint64_t otherOffset = pPool->GetOffset( otherNdx );
+            if( ( offset < otherOffset + pPool->GetSize( otherNdx ) ) && ( otherOffset < offset + pPool->GetSize( ndx ) ) )
+            {
+                printf( "%s and %s share memory while both are live.\n", FRAME_TEXTURES[ ndx ].pName, FRAME_TEXTURES[ otherNdx ].pName );
+                return BGS_FALSE;
+            }
+        }
+    }
+
+    return BGS_TRUE;
+}
+
+static RESULT MeasureResolution( Frontend::RenderSystem* pSystem, uint32_t width, uint32_t height )
+{
+    Frontend::TransientResourcePoolDesc poolDesc;
+    poolDesc.maxTextureCount = FRAME_TEXTURE_COUNT;
+
+    Frontend::TransientResourcePool* pPool = nullptr;
+    if( BGS_FAILED( pSystem->CreateTransientResourcePool( poolDesc, &pPool ) ) )
+    {
+        return Results::FAIL;
+    }
+
+    for( uint32_t ndx = 0; ndx < FRAME_TEXTURE_COUNT; ++ndx )
+    {
+        const FrameTexture& frameTex = FRAME_TEXTURES[ ndx ];
+
+        const Backend::ResourceUsageFlags targetUsage = frameTex.isDepth ? BGS_FLAG( Backend::ResourceUsageFlagBits::DEPTH_STENCIL_TARGET )
+                                                                         : BGS_FLAG( Backend::ResourceUsageFlagBits::COLOR_RENDER_TARGET );
+
+        Frontend::TransientTextureDesc texDesc;
+        texDesc.size            = { width / frameTex.divider, height / frameTex.divider, 1 };
+        texDesc.format          = frameTex.format;
+        texDesc.sampleCount     = Backend::SampleCount::COUNT_1;
+        texDesc.mipLevelCount   = 1;
+        texDesc.arrayLayerCount = 1;
+        texDesc.usage           = targetUsage | BGS_FLAG( Backend::ResourceUsageFlagBits::SAMPLED_TEXTURE );
+        texDesc.firstPass       = frameTex.firstPass;
+        texDesc.lastPass        = frameTex.lastPass;
+
+        index_t texNdx = 0;
+        if( BGS_FAILED( pPool->AddTexture( texDesc, &texNdx ) ) )
+        {
+            pSystem->DestroyTransientResourcePool( &pPool );
+            return Results::FAIL;
+        }
+    }
+    if( BGS_FAILED( pPool->Compile() ) )
+    {
+        pSystem->DestroyTransientResourcePool( &pPool );
+        return Results::FAIL;
+    }
+
+    const bool_t isValid = IsPlacementValid( pPool );
+
+    const double   toMB          = 1.0 / ( 1024.0 * 1024.0 );
+    const uint64_t unaliasedSize = pPool->GetUnaliasedSize();
+    const uint64_t heapSize      = pPool->GetHeapSize();
+    printf( "%5u x %-5u | %10.2f %10.2f %10.2f %7.1f%%\n", width, height, unaliasedSize * toMB, heapSize * toMB,
+            ( unaliasedSize - heapSize ) * toMB, unaliasedSize > 0 ? 100.0 * ( unaliasedSize - heapSize ) / unaliasedSize : 0.0 );
+
+    // Textures were never used by the GPU
+    pPool->Reset( Frontend::SyncPoint() );
+    pSystem->DestroyTransientResourcePool( &pPool );
+
+    return isValid ? Results::OK : Results::FAIL;
+}
+
+int main( int argc, char** argv )
+{
+    const bool_t isVulkan = ( argc > 1 ) && ( strcmp( argv[ 1 ], "vulkan" ) == 0 );
+
+    BigosEngineDesc engineDesc;
+    BigosEngine*    pEngine = nullptr;
+    if( BGS_FAILED( CreateBigosEngine( engineDesc, &pEngine ) ) )
+    {
+        printf( "Failed to create engine.\n" );
+        return -1;
+    }
+
+    Frontend::DriverDesc driverDesc;
+    driverDesc.apiType = isVulkan ? Backend::APITypes::VULKAN : Backend::APITypes::D3D12;
+    driverDesc.debug   = false;
+    if( BGS_FAILED( pEngine->GetRenderSystem().InitializeDriver( driverDesc ) ) )
+    {
+        printf( "Failed to initialize %s driver.\n", isVulkan ? "Vulkan" : "D3D12" );
+        DestroyBigosEngine( &pEngine );
+        return -1;
+    }
+
+    printf( "%13s | %10s %10s %10s %8s\n", "Resolution", "Unaliased", "Aliased", "Saved", "Saved" );
+    const uint32_t resolutions[][ 2 ] = { { 1280, 720 }, { 1920, 1080 }, { 2560, 1440 }, { 3840, 2160 } };
+    uint32_t       measuredCount      = 0;
+    for( uint32_t ndx = 0; ndx < 4; ++ndx )
+    {
+        if( BGS_FAILED( MeasureResolution( &pEngine->GetRenderSystem(), resolutions[ ndx ][ 0 ], resolutions[ ndx ][ 1 ] ) ) )
+        {
+            printf( "Failed to compile transient pool or placement is invalid.\n" );
+            break;
+        }
+        measuredCount++;
+    }
+    printf( "Sizes in MB.\n\n" );
+
+    Check( measuredCount == 4, "Transient pool compiles at every resolution and live textures never share memory" );
+    printf( "%u check(s) failed.\n", s_failedCount );
+
+    DestroyBigosEngine( &pEngine );
+
+    return s_failedCount == 0 ? 0 : -1;
+}
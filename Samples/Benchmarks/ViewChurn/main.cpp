@@ -0,0 +1,135 @@
+#include "Core/CoreTypes.h"
+
+#include "BIGOS/BigosEngine.h"
+#include "Core/Memory/MemorySystem.h"
+#include "Core/Utils/Timer.h"
+#include "Driver/Backend/API.h"
+#include "Driver/Frontend/Buffer.h"
+#include "Driver/Frontend/RenderSystem.h"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+// Creates and destroys 1M constant buffer views, in batches so that backend objects are recycled the way streaming does it, from
+// 1 to 8 threads sharing the work. Allocations that reached the system heap during churn show whether backend objects stay in
+// thread caches of the object pool allocator. Pass "vulkan" as argument to run on Vulkan, D3D12 is used otherwise.
+
+using namespace BIGOS;
+using namespace BIGOS::Driver;
+
+constexpr uint32_t TOTAL_VIEW_COUNT = 1024U * 1024U;
+constexpr uint32_t BATCH_SIZE       = 1024;
+constexpr uint32_t MAX_THREAD_COUNT = 8;
+constexpr uint32_t VIEW_SIZE        = 256;
+
+static bool_t ChurnViews( Backend::IDevice* pDevice, Backend::ResourceHandle hBuffer, uint32_t viewCount )
+{
+    Backend::ResourceViewHandle hViews[ BATCH_SIZE ];
+
+    Backend::BufferViewDesc viewDesc;
+    viewDesc.hResource    = hBuffer;
+    viewDesc.usage        = BGS_FLAG( Backend::ResourceViewUsageFlagBits::CONSTANT_BUFFER );
+    viewDesc.range.size   = VIEW_SIZE;
+    viewDesc.range.offset = 0;
+
+    for( uint32_t batchStart = 0; batchStart < viewCount; batchStart += BATCH_SIZE )
+    {
+        const uint32_t batchSize = viewCount - batchStart < BATCH_SIZE ? viewCount - batchStart : BATCH_SIZE;
+        for( uint32_t ndx = 0; ndx < batchSize; ++ndx )
+        {
+            if( BGS_FAILED( pDevice->CreateResourceView( viewDesc, &hViews[ ndx ] ) ) )
+            {
+                return BGS_FALSE;
+            }
+        }
+        for( uint32_t ndx = 0; ndx < batchSize; ++ndx )
+        {
+            pDevice->DestroyResourceView( &hViews[ ndx ] );
+        }
+    }
+
+    return BGS_TRUE;
+}
+
+int main( int argc, char** argv )
+{
+    const bool_t isVulkan = ( argc > 1 ) && ( strcmp( argv[ 1 ], "vulkan" ) == 0 );
+
+    BigosEngineDesc engineDesc;
+    BigosEngine*    pEngine = nullptr;
+    if( BGS_FAILED( CreateBigosEngine( engineDesc, &pEngine ) ) )
+    {
+        printf( "Failed to create engine.\n" );
+        return -1;
+    }
+    Frontend::RenderSystem&     renderSystem = pEngine->GetRenderSystem();
+    Core::Memory::MemorySystem& memorySystem = pEngine->GetMemorySystem();
+
+    Frontend::DriverDesc driverDesc;
+    driverDesc.apiType = isVulkan ? Backend::APITypes::VULKAN : Backend::APITypes::D3D12;
+    driverDesc.debug   = false;
+    if( BGS_FAILED( renderSystem.InitializeDriver( driverDesc ) ) )
+    {
+        printf( "Failed to initialize %s driver.\n", isVulkan ? "Vulkan" : "D3D12" );
+        DestroyBigosEngine( &pEngine );
+        return -1;
+    }
+
+    Frontend::BufferDesc bufferDesc;
+    bufferDesc.size  = VIEW_SIZE * BATCH_SIZE;
+    bufferDesc.usage = BGS_FLAG( Backend::ResourceUsageFlagBits::CONSTANT_BUFFER );
+
+    Frontend::Buffer* pBuffer = nullptr;
+    if( BGS_FAILED( renderSystem.CreateBuffer( bufferDesc, &pBuffer ) ) )
+    {
+        printf( "Failed to create buffer.\n" );
+        DestroyBigosEngine( &pEngine );
+        return -1;
+    }
+    Backend::IDevice*             pDevice = renderSystem.GetDevice();
+    const Backend::ResourceHandle hBuffer = pBuffer->GetResource();
+
+    // First pass fills thread caches, so measured passes show steady state
+    ChurnViews( pDevice, hBuffer, BATCH_SIZE );
+
+    printf( "%8s | %12s %14s %14s\n", "Threads", "Time [ms]", "ns per view", "Heap allocs" );
+    for( uint32_t threadCount = 1; threadCount <= MAX_THREAD_COUNT; threadCount *= 2 )
+    {
+        Core::Memory::MemoryInfo heapInfoBefore;
+        memorySystem.GetMemoryInfo( &heapInfoBefore );
+
+        bool_t             succeeded[ MAX_THREAD_COUNT ];
+        std::thread        threads[ MAX_THREAD_COUNT ];
+        const uint32_t     viewsPerThread = TOTAL_VIEW_COUNT / threadCount;
+        Core::Utils::Timer timer;
+        for( uint32_t ndx = 0; ndx < threadCount; ++ndx )
+        {
+            threads[ ndx ] = std::thread( [ &, ndx ]() { succeeded[ ndx ] = ChurnViews( pDevice, hBuffer, viewsPerThread ); } );
+        }
+        bool_t allSucceeded = BGS_TRUE;
+        for( uint32_t ndx = 0; ndx < threadCount; ++ndx )
+        {
+            threads[ ndx ].join();
+            allSucceeded = allSucceeded && succeeded[ ndx ];
+        }
+        const double seconds = timer.Elapsed();
+
+        Core::Memory::MemoryInfo heapInfoAfter;
+        memorySystem.GetMemoryInfo( &heapInfoAfter );
+
+        if( !allSucceeded )
+        {
+            printf( "Failed to create view.\n" );
+            break;
+        }
+        printf( "%8u | %12.2f %14.2f %14llu\n", threadCount, seconds * 1000.0, seconds * 1000000000.0 / TOTAL_VIEW_COUNT,
+                static_cast<unsigned long long>( heapInfoAfter.allocationCount - heapInfoBefore.allocationCount ) );
+    }
+    printf( "Views are created and destroyed in batches of %u, %u in total.\n", BATCH_SIZE, TOTAL_VIEW_COUNT );
+
+    renderSystem.DestroyBuffer( &pBuffer );
+    DestroyBigosEngine( &pEngine );
+
+    return 0;
+}
@@ -58,6 +58,8 @@ namespace BIGOS
         const char*               m_pName;
         Driver::Backend::API_TYPE m_apiType;
         bool_t                    m_running;
+        String                    m_shaderCachePath;   // Empty disables cache on disk
+        String                    m_pipelineCachePath; // Empty disables cache on disk
 
     private:
         Platform::Event::EventHandlerWraper<Platform::Event::WindowCloseEvent>  m_windowCloseHandler;
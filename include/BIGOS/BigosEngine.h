@@ -41,6 +41,7 @@ namespace BIGOS
         Platform::Input::InputSystem   m_inputSystem;
         Platform::WindowSystem         m_windowSystem;
         Driver::Frontend::RenderSystem m_renderSystem;
+        Core::Memory::IAllocator*      m_pRenderSystemAllocator;
     };
 
 } // namespace BIGOS
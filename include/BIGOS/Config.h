@@ -2,10 +2,21 @@
 
 #include <cstdint>
 
+#include "Core/CoreConfig.h"
+
 namespace BIGOS
 {
     namespace Config
     {
+        namespace Core
+        {
+            // Allocator settings used by Core itself are in Core/CoreConfig.h
+            namespace Memory
+            {
+                constexpr uint64_t RENDER_SYSTEM_HEAP_SIZE = 16U * 1024U * 1024U;
+            } // namespace Memory
+        } // namespace Core
+
         namespace Platform
         {
             namespace Input
@@ -33,6 +44,21 @@ namespace BIGOS
                 constexpr uint32_t MAX_COMMAND_BUFFER_TO_EXECUTE_COUNT = 8U;
             } // namespace Queue
 
+            namespace Memory
+            {
+                constexpr uint64_t DEVICE_MEMORY_BLOCK_SIZE      = 64U * 1024U * 1024U;
+                constexpr uint64_t DEVICE_MEMORY_BLOCK_ALIGNMENT = 64U * 1024U;         // Bigger alignments (MSAA) get dedicated memory
+                constexpr uint64_t CONSTANT_BUFFER_ALIGNMENT     = 256U;                // Max of D3D12 requirement and Vulkan offset alignments
+                constexpr uint32_t MAX_UPLOAD_RING_FRAME_COUNT   = 8U;
+                constexpr uint64_t STAGING_PAGE_SIZE             = 16U * 1024U * 1024U; // Bigger uploads get their own page
+                constexpr uint64_t TEXTURE_UPLOAD_ALIGNMENT      = 512U;                // Buffer offset required by texture copies
+                constexpr uint32_t TEXTURE_ROW_PITCH_ALIGNMENT   = 256U;                // Row pitch of texture data in buffers
+                constexpr uint32_t MAX_UPLOAD_BATCH_COUNT        = 4U;                  // Copy submissions in flight
+                constexpr uint64_t DEFRAGMENTATION_FRAME_BUDGET  = 8U * 1024U * 1024U;  // Bytes moved per frame
+                constexpr float    DEFRAGMENTATION_BLOCK_USAGE   = 0.5f;                // Only blocks used below that are emptied
+                constexpr uint32_t MAX_RESIDENCY_FRAME_COUNT     = 8U;                  // Frames tracked for completion
+            } // namespace Memory
+
             namespace Synchronization
             {
                 constexpr uint32_t MAX_SEMAPHORES_TO_WAIT_COUNT   = 16U;
@@ -42,6 +68,7 @@ namespace BIGOS
                 constexpr uint32_t MAX_GLOBAL_BARRIER_COUNT       = 16U;
                 constexpr uint32_t MAX_BUFFER_BARRIER_COUNT       = 16U;
                 constexpr uint32_t MAX_TEXTURE_BARRIER_COUNT      = 16U;
+                constexpr uint32_t MAX_SYNC_POINT_COUNT           = 64U * 1024U; // Per context, only address space is reserved
             } // namespace Synchronization
 
             namespace Shader
@@ -49,6 +76,7 @@ namespace BIGOS
                 constexpr uint32_t MAX_SHADER_ENTRY_POINT_NAME_LENGHT = 32U;
                 constexpr uint32_t MAX_SHADER_COMPILER_ARGUMENT_COUNT = 32U;
                 constexpr uint32_t MAX_SHADER_BINDING_NAME_LENGHT     = 32U;
+                constexpr uint32_t SHADER_CACHE_VERSION               = 1U; // Bump when shader cache file or reflection layout changes
             } // namespace Shader
 
             namespace Binding
@@ -57,6 +85,9 @@ namespace BIGOS
                 constexpr uint32_t MAX_SAMPLER_COUNT                   = 64U;
                 constexpr uint32_t MAX_RENDER_TARGET_VIEW_COUNT        = 32U;
                 constexpr uint32_t MAX_DEPTH_STENCIL_TARGET_VIEW_COUNT = 16U;
+                constexpr uint32_t MAX_TRANSIENT_BINDING_FRAME_COUNT   = 8U;
+                constexpr uint32_t BINDLESS_HEAP_COPY_COUNT            = 3U; // Frames in flight, each reads own copy of bindless heap
+                constexpr uint32_t BINDING_OBJECT_CACHE_BUCKET_COUNT   = 1024U;
 
             } // namespace Binding
 
@@ -73,7 +104,13 @@ namespace BIGOS
                 constexpr uint32_t MAX_VIEWPORT_COUNT           = 16U;
                 constexpr uint32_t MAX_BINDING_RANGE_COUNT      = 64U;
                 constexpr uint32_t MAX_IMMUTABLE_SAMPLER_COUNT  = 16U;
+                constexpr uint32_t PIPELINE_CACHE_VERSION       = 1U; // Bump when pipeline cache header changes
             } // namespace Pipeline
+
+            namespace Camera
+            {
+                constexpr uint32_t MAX_CAMERA_COUNT = 4096U; // Only address space is reserved
+            } // namespace Camera
         } // namespace Driver
     } // namespace Config
 } // namespace BIGOS
\ No newline at end of file
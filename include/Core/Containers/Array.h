@@ -0,0 +1,378 @@
+#pragma once
+#include "Core/CoreTypes.h"
+
+#include "Core/Memory/IAllocator.h"
+#include "Core/Memory/Memory.h"
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Containers
+        {
+            template<typename T, size_t N>
+            struct ArrayInlineStorage
+            {
+                T* GetData() { return reinterpret_cast<T*>( bytes ); }
+
+                alignas( T ) byte_t bytes[ N * sizeof( T ) ];
+            };
+
+            template<typename T>
+            struct ArrayInlineStorage<T, 0>
+            {
+                T* GetData() { return nullptr; }
+            };
+
+            // Dynamic array with storage taken from IAllocator (CRT heap when there is none). First N elements live inside the
+            // object, so small arrays never allocate. Interface is subset of std::vector, so HeapArray users switch without changes.
+            // Trivially copyable elements are relocated with a single memory copy when the array grows. Storage goes through
+            // AllocatorPolicy, so arrays declared with concrete allocator type (e.g. LinearAllocator for scratch) grow without
+            // virtual calls.
+            template<typename T, size_t N, class AllocatorT = Memory::IAllocator>
+            class SmallArray
+            {
+            public:
+                using value_type     = T;
+                using iterator       = T*;
+                using const_iterator = const T*;
+
+            public:
+                SmallArray()
+                    : m_pData( m_inline.GetData() )
+                    , m_size( 0 )
+                    , m_capacity( N )
+                    , m_pAllocator( nullptr )
+                    , m_inline()
+                {
+                }
+
+                explicit SmallArray( AllocatorT* pAllocator )
+                    : m_pData( m_inline.GetData() )
+                    , m_size( 0 )
+                    , m_capacity( N )
+                    , m_pAllocator( pAllocator )
+                    , m_inline()
+                {
+                }
+
+                SmallArray( const SmallArray& other )
+                    : m_pData( m_inline.GetData() )
+                    , m_size( 0 )
+                    , m_capacity( N )
+                    , m_pAllocator( other.m_pAllocator )
+                    , m_inline()
+                {
+                    CopyFrom( other );
+                }
+
+                SmallArray( SmallArray&& other )
+                    : m_pData( m_inline.GetData() )
+                    , m_size( 0 )
+                    , m_capacity( N )
+                    , m_pAllocator( other.m_pAllocator )
+                    , m_inline()
+                {
+                    MoveFrom( other );
+                }
+
+                ~SmallArray()
+                {
+                    clear();
+                    FreeStorage();
+                }
+
+                SmallArray& operator=( const SmallArray& other )
+                {
+                    if( this != &other )
+                    {
+                        clear();
+                        if( ( m_pAllocator == nullptr ) && ( m_pData == m_inline.GetData() ) )
+                        {
+                            m_pAllocator = other.m_pAllocator;
+                        }
+                        CopyFrom( other );
+                    }
+
+                    return *this;
+                }
+
+                SmallArray& operator=( SmallArray&& other )
+                {
+                    if( this != &other )
+                    {
+                        clear();
+                        if( ( other.m_pAllocator == m_pAllocator ) || ( m_pAllocator == nullptr ) )
+                        {
+                            FreeStorage();
+                            m_pAllocator = other.m_pAllocator;
+                            MoveFrom( other );
+                        }
+                        else
+                        {
+                            // Heap block can not change the owner, so elements are moved one by one
+                            if( BGS_FAILED( reserve( other.m_size ) ) )
+                            {
+                                std::abort();
+                            }
+                            MoveElements( other.m_pData, other.m_size, m_pData );
+                            m_size = other.m_size;
+                            other.clear();
+                        }
+                    }
+
+                    return *this;
+                }
+
+                // Allocator can be changed only while elements are stored inline
+                void SetAllocator( AllocatorT* pAllocator )
+                {
+                    BGS_ASSERT( m_pData == m_inline.GetData(), "Allocator can not be changed after array took memory from it." );
+                    if( m_pData == m_inline.GetData() )
+                    {
+                        m_pAllocator = pAllocator;
+                    }
+                }
+
+                AllocatorT* GetAllocator() const { return m_pAllocator; }
+
+                size_t size() const { return m_size; }
+                size_t capacity() const { return m_capacity; }
+                bool_t empty() const { return m_size == 0; }
+
+                T*       data() { return m_pData; }
+                const T* data() const { return m_pData; }
+
+                T& operator[]( size_t ndx )
+                {
+                    BGS_ASSERT( ndx < m_size, "Index (ndx) out of range." );
+                    return m_pData[ ndx ];
+                }
+                const T& operator[]( size_t ndx ) const
+                {
+                    BGS_ASSERT( ndx < m_size, "Index (ndx) out of range." );
+                    return m_pData[ ndx ];
+                }
+
+                T&       front() { return ( *this )[ 0 ]; }
+                const T& front() const { return ( *this )[ 0 ]; }
+                T&       back() { return ( *this )[ m_size - 1 ]; }
+                const T& back() const { return ( *this )[ m_size - 1 ]; }
+
+                iterator       begin() { return m_pData; }
+                const_iterator begin() const { return m_pData; }
+                iterator       end() { return m_pData + m_size; }
+                const_iterator end() const { return m_pData + m_size; }
+
+                void push_back( const T& value ) { emplace_back( value ); }
+                void push_back( T&& value ) { emplace_back( std::move( value ) ); }
+
+                // Process is aborted, if storage can not grow, use reserve() first to handle it
+                template<typename... ArgsT>
+                T& emplace_back( ArgsT&&... args )
+                {
+                    if( m_size == m_capacity )
+                    {
+                        // Arguments may point into the array, build element before old storage is released
+                        T value( std::forward<ArgsT>( args )... );
+                        if( BGS_FAILED( Grow( m_size + 1 ) ) )
+                        {
+                            std::abort();
+                        }
+
+                        return *::new( m_pData + m_size++ ) T( std::move( value ) );
+                    }
+
+                    return *::new( m_pData + m_size++ ) T( std::forward<ArgsT>( args )... );
+                }
+
+                void pop_back()
+                {
+                    BGS_ASSERT( m_size > 0, "Array is empty." );
+                    m_pData[ --m_size ].~T();
+                }
+
+                // Fails when allocator can not provide storage, array is left unchanged then
+                RESULT reserve( size_t capacity )
+                {
+                    if( capacity > m_capacity )
+                    {
+                        return Grow( capacity );
+                    }
+
+                    return Results::OK;
+                }
+
+                void resize( size_t size )
+                {
+                    if( BGS_FAILED( reserve( size ) ) )
+                    {
+                        std::abort();
+                    }
+                    for( ; m_size < size; ++m_size )
+                    {
+                        ::new( m_pData + m_size ) T();
+                    }
+                    while( m_size > size )
+                    {
+                        pop_back();
+                    }
+                }
+
+                void resize( size_t size, const T& value )
+                {
+                    if( BGS_FAILED( reserve( size ) ) )
+                    {
+                        std::abort();
+                    }
+                    for( ; m_size < size; ++m_size )
+                    {
+                        ::new( m_pData + m_size ) T( value );
+                    }
+                    while( m_size > size )
+                    {
+                        pop_back();
+                    }
+                }
+
+                // Gives heap storage back to the allocator when elements fit inside the object (always for empty array)
+                void shrink_to_fit()
+                {
+                    if( ( m_pData != m_inline.GetData() ) && ( m_size <= N ) )
+                    {
+                        MoveElements( m_pData, m_size, m_inline.GetData() );
+                        FreeStorage();
+                    }
+                }
+
+                void clear()
+                {
+                    if constexpr( !std::is_trivially_destructible<T>::value )
+                    {
+                        for( size_t ndx = 0; ndx < m_size; ++ndx )
+                        {
+                            m_pData[ ndx ].~T();
+                        }
+                    }
+                    m_size = 0;
+                }
+
+            private:
+                RESULT Grow( size_t minCapacity )
+                {
+                    size_t newCapacity = m_capacity < 4 ? 4 : m_capacity * 2;
+                    if( newCapacity < minCapacity )
+                    {
+                        newCapacity = minCapacity;
+                    }
+
+                    void* pMemory = nullptr;
+                    if( m_pAllocator != nullptr )
+                    {
+                        // Storage of all arrays is reported as one callsite, array does not know where it is used
+                        Memory::AllocatorPolicy<AllocatorT>::AllocateAligned( m_pAllocator, newCapacity * sizeof( T ), alignof( T ), &pMemory,
+                                                                              BGS_MEMORY_CALLSITE );
+                    }
+                    else
+                    {
+                        pMemory = Memory::MallocAligned( newCapacity * sizeof( T ), alignof( T ) );
+                    }
+                    if( pMemory == nullptr )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+
+                    T* pNewData = static_cast<T*>( pMemory );
+                    MoveElements( m_pData, m_size, pNewData );
+                    FreeStorage();
+
+                    m_pData    = pNewData;
+                    m_capacity = newCapacity;
+
+                    return Results::OK;
+                }
+
+                void FreeStorage()
+                {
+                    if( m_pData != m_inline.GetData() )
+                    {
+                        if( m_pAllocator != nullptr )
+                        {
+                            Memory::AllocatorPolicy<AllocatorT>::FreeAligned( m_pAllocator, reinterpret_cast<void**>( &m_pData ) );
+                        }
+                        else
+                        {
+                            Memory::FreeAligned( m_pData );
+                        }
+                    }
+                    m_pData    = m_inline.GetData();
+                    m_capacity = N;
+                }
+
+                // Relocates elements into uninitialized memory, sources are left destroyed
+                static void MoveElements( T* pSrc, size_t count, T* pDst )
+                {
+                    if constexpr( std::is_trivially_copyable<T>::value )
+                    {
+                        if( count > 0 )
+                        {
+                            Memory::Copy( pSrc, count * sizeof( T ), pDst, count * sizeof( T ) );
+                        }
+                    }
+                    else
+                    {
+                        for( size_t ndx = 0; ndx < count; ++ndx )
+                        {
+                            ::new( pDst + ndx ) T( std::move( pSrc[ ndx ] ) );
+                            pSrc[ ndx ].~T();
+                        }
+                    }
+                }
+
+                void CopyFrom( const SmallArray& other )
+                {
+                    if( BGS_FAILED( reserve( other.m_size ) ) )
+                    {
+                        std::abort();
+                    }
+                    for( ; m_size < other.m_size; ++m_size )
+                    {
+                        ::new( m_pData + m_size ) T( other.m_pData[ m_size ] );
+                    }
+                }
+
+                // Takes heap block of other array or moves its inline elements, other array is left empty
+                void MoveFrom( SmallArray& other )
+                {
+                    if( other.m_pData != other.m_inline.GetData() )
+                    {
+                        m_pData    = other.m_pData;
+                        m_capacity = other.m_capacity;
+                        m_size     = other.m_size;
+
+                        other.m_pData    = other.m_inline.GetData();
+                        other.m_capacity = N;
+                        other.m_size     = 0;
+                    }
+                    else
+                    {
+                        MoveElements( other.m_pData, other.m_size, m_pData );
+                        m_size       = other.m_size;
+                        other.m_size = 0;
+                    }
+                }
+
+            private:
+                T*                       m_pData;
+                size_t                   m_size;
+                size_t                   m_capacity;
+                AllocatorT*              m_pAllocator;
+                ArrayInlineStorage<T, N> m_inline;
+            };
+
+            template<typename T, class AllocatorT = Memory::IAllocator>
+            using Array = SmallArray<T, 0, AllocatorT>;
+
+        } // namespace Containers
+    }     // namespace Core
+} // namespace BIGOS
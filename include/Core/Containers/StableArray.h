@@ -0,0 +1,209 @@
+#pragma once
+#include "Core/CoreTypes.h"
+
+#include "Core/Memory/PageAllocator.h"
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Containers
+        {
+            // Dynamic array placed in virtual memory range reserved for maxCount elements in Create(). Growing only commits more
+            // pages, so elements are never moved or copied and pointers to them stay valid until they are removed. Interface is
+            // subset of std::vector. Not thread safe.
+            template<typename T>
+            class StableArray
+            {
+            public:
+                using value_type     = T;
+                using iterator       = T*;
+                using const_iterator = const T*;
+
+            public:
+                StableArray()
+                    : m_pages()
+                    , m_pData( nullptr )
+                    , m_size( 0 )
+                    , m_capacity( 0 )
+                    , m_maxCount( 0 )
+                {
+                }
+
+                StableArray( const StableArray& other ) = delete;
+                StableArray& operator=( const StableArray& other ) = delete;
+
+                ~StableArray() { Destroy(); }
+
+                RESULT Create( size_t maxCount )
+                {
+                    BGS_ASSERT( maxCount > 0, "Max element count (maxCount) must be greater than 0." );
+                    if( maxCount == 0 )
+                    {
+                        return Results::FAIL;
+                    }
+
+                    const RESULT res = m_pages.Create( maxCount * sizeof( T ) );
+                    if( BGS_FAILED( res ) )
+                    {
+                        return res;
+                    }
+                    m_pData    = reinterpret_cast<T*>( m_pages.GetBase() );
+                    m_maxCount = maxCount;
+
+                    return Results::OK;
+                }
+
+                void Destroy()
+                {
+                    clear();
+                    m_pages.Destroy();
+                    m_pData    = nullptr;
+                    m_capacity = 0;
+                    m_maxCount = 0;
+                }
+
+                size_t size() const { return m_size; }
+                size_t capacity() const { return m_capacity; }
+                size_t max_size() const { return m_maxCount; }
+                bool_t empty() const { return m_size == 0; }
+
+                T*       data() { return m_pData; }
+                const T* data() const { return m_pData; }
+
+                T& operator[]( size_t ndx )
+                {
+                    BGS_ASSERT( ndx < m_size, "Index (ndx) out of range." );
+                    return m_pData[ ndx ];
+                }
+                const T& operator[]( size_t ndx ) const
+                {
+                    BGS_ASSERT( ndx < m_size, "Index (ndx) out of range." );
+                    return m_pData[ ndx ];
+                }
+
+                T&       front() { return ( *this )[ 0 ]; }
+                const T& front() const { return ( *this )[ 0 ]; }
+                T&       back() { return ( *this )[ m_size - 1 ]; }
+                const T& back() const { return ( *this )[ m_size - 1 ]; }
+
+                iterator       begin() { return m_pData; }
+                const_iterator begin() const { return m_pData; }
+                iterator       end() { return m_pData + m_size; }
+                const_iterator end() const { return m_pData + m_size; }
+
+                void push_back( const T& value ) { emplace_back( value ); }
+                void push_back( T&& value ) { emplace_back( std::move( value ) ); }
+
+                // Storage does not move, so arguments pointing into the array stay valid while it grows. Process is aborted, if
+                // storage can not grow, use reserve() first to handle it
+                template<typename... ArgsT>
+                T& emplace_back( ArgsT&&... args )
+                {
+                    if( ( m_size == m_capacity ) && BGS_FAILED( Grow( m_size + 1 ) ) )
+                    {
+                        std::abort();
+                    }
+
+                    return *::new( m_pData + m_size++ ) T( std::forward<ArgsT>( args )... );
+                }
+
+                void pop_back()
+                {
+                    BGS_ASSERT( m_size > 0, "Array is empty." );
+                    m_pData[ --m_size ].~T();
+                }
+
+                // Fails when capacity is above max count or pages can not be committed
+                RESULT reserve( size_t capacity )
+                {
+                    if( capacity > m_capacity )
+                    {
+                        return Grow( capacity );
+                    }
+
+                    return Results::OK;
+                }
+
+                void resize( size_t size )
+                {
+                    if( BGS_FAILED( reserve( size ) ) )
+                    {
+                        std::abort();
+                    }
+                    for( ; m_size < size; ++m_size )
+                    {
+                        ::new( m_pData + m_size ) T();
+                    }
+                    while( m_size > size )
+                    {
+                        pop_back();
+                    }
+                }
+
+                // Gives pages past the last element back to the system
+                void shrink_to_fit()
+                {
+                    if( m_pData != nullptr )
+                    {
+                        m_pages.Decommit( m_size * sizeof( T ) );
+                        m_capacity = m_pages.GetCommittedSize() / sizeof( T );
+                    }
+                }
+
+                void clear()
+                {
+                    if constexpr( !std::is_trivially_destructible<T>::value )
+                    {
+                        for( size_t ndx = 0; ndx < m_size; ++ndx )
+                        {
+                            m_pData[ ndx ].~T();
+                        }
+                    }
+                    m_size = 0;
+                }
+
+            private:
+                RESULT Grow( size_t minCapacity )
+                {
+                    BGS_ASSERT( m_pData != nullptr, "Array is not created." );
+                    if( ( m_pData == nullptr ) || ( minCapacity > m_maxCount ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+
+                    size_t newCapacity = m_capacity * 2;
+                    if( newCapacity < minCapacity )
+                    {
+                        newCapacity = minCapacity;
+                    }
+                    if( newCapacity > m_maxCount )
+                    {
+                        newCapacity = m_maxCount;
+                    }
+
+                    // Whole pages are committed, so capacity can end up above requested count
+                    if( BGS_FAILED( m_pages.Commit( newCapacity * sizeof( T ) ) ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+                    m_capacity = m_pages.GetCommittedSize() / sizeof( T );
+                    if( m_capacity > m_maxCount )
+                    {
+                        m_capacity = m_maxCount;
+                    }
+
+                    return Results::OK;
+                }
+
+            private:
+                Memory::PageAllocator m_pages;
+                T*                    m_pData;
+                size_t                m_size;
+                size_t                m_capacity;
+                size_t                m_maxCount;
+            };
+
+        } // namespace Containers
+    }     // namespace Core
+} // namespace BIGOS
@@ -0,0 +1,120 @@
+#pragma once
+#include "Core/CoreTypes.h"
+
+#include "Core/Containers/Array.h"
+#include "Core/Utils/String.h"
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Containers
+        {
+            // Null terminated string with storage taken from IAllocator. Strings up to 15 characters are kept inside the object.
+            class String
+            {
+            public:
+                String()
+                    : m_chars()
+                {
+                    m_chars.push_back( '\0' );
+                }
+
+                explicit String( Memory::IAllocator* pAllocator )
+                    : m_chars( pAllocator )
+                {
+                    m_chars.push_back( '\0' );
+                }
+
+                String( const char* pStr, Memory::IAllocator* pAllocator = nullptr )
+                    : m_chars( pAllocator )
+                {
+                    m_chars.push_back( '\0' );
+                    append( pStr );
+                }
+
+                String( const String& other ) = default;
+                String( String&& other )
+                    : m_chars( std::move( other.m_chars ) )
+                {
+                    other.m_chars.push_back( '\0' );
+                }
+                ~String() = default;
+
+                String& operator=( const String& other ) = default;
+                String& operator=( String&& other )
+                {
+                    if( this != &other )
+                    {
+                        m_chars = std::move( other.m_chars );
+                        other.m_chars.push_back( '\0' );
+                    }
+
+                    return *this;
+                }
+                String& operator=( const char* pStr )
+                {
+                    clear();
+                    return append( pStr );
+                }
+
+                String& operator+=( const char* pStr ) { return append( pStr ); }
+                String& operator+=( const String& other ) { return append( other.c_str(), other.size() ); }
+                String& operator+=( char c ) { return append( &c, 1 ); }
+
+                bool operator==( const char* pStr ) const { return Utils::String::Compare( c_str(), pStr ) != BGS_FALSE; }
+                bool operator==( const String& other ) const
+                {
+                    return ( size() == other.size() ) && ( Memory::Compare( c_str(), other.c_str(), size() + 1 ) == 0 );
+                }
+                bool operator!=( const char* pStr ) const { return !( *this == pStr ); }
+                bool operator!=( const String& other ) const { return !( *this == other ); }
+
+                String& append( const char* pStr ) { return append( pStr, Utils::String::Length( pStr ) ); }
+                String& append( const char* pStr, size_t length )
+                {
+                    BGS_ASSERT( ( pStr != nullptr ) || ( length == 0 ), "String (pStr) must be a valid pointer." );
+                    if( length > 0 )
+                    {
+                        const size_t oldSize = size();
+                        m_chars.resize( oldSize + length + 1 );
+                        Memory::Copy( pStr, length, m_chars.data() + oldSize, length );
+                        m_chars[ oldSize + length ] = '\0';
+                    }
+
+                    return *this;
+                }
+
+                void clear()
+                {
+                    m_chars.clear();
+                    m_chars.push_back( '\0' );
+                }
+                void reserve( size_t length ) { m_chars.reserve( length + 1 ); }
+
+                void                SetAllocator( Memory::IAllocator* pAllocator ) { m_chars.SetAllocator( pAllocator ); }
+                Memory::IAllocator* GetAllocator() const { return m_chars.GetAllocator(); }
+
+                const char* c_str() const { return m_chars.data(); }
+                const char* data() const { return m_chars.data(); }
+                size_t      size() const { return m_chars.size() - 1; }
+                size_t      length() const { return m_chars.size() - 1; }
+                bool        empty() const { return m_chars.size() == 1; }
+
+                char& operator[]( size_t ndx )
+                {
+                    BGS_ASSERT( ndx < size(), "Index (ndx) out of range." );
+                    return m_chars[ ndx ];
+                }
+                const char& operator[]( size_t ndx ) const
+                {
+                    BGS_ASSERT( ndx < size(), "Index (ndx) out of range." );
+                    return m_chars[ ndx ];
+                }
+
+            private:
+                SmallArray<char, 16> m_chars;
+            };
+        } // namespace Containers
+    }     // namespace Core
+} // namespace BIGOS
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+// Settings of the Core module. Core can not include BIGOS/Config.h, it is above Core in the layers, that header includes this one.
+namespace BIGOS
+{
+    namespace Config
+    {
+        namespace Core
+        {
+            namespace Memory
+            {
+                constexpr uint64_t FRAME_ALLOCATOR_SIZE   = 4U * 1024U * 1024U;
+                constexpr uint64_t SCRATCH_ALLOCATOR_SIZE = 1U * 1024U * 1024U; // Per thread
+                // Copies and fills from that size up bypass caches (bigger than what stays in L2 anyway)
+                constexpr uint64_t STREAMING_COPY_MIN_SIZE = 2U * 1024U * 1024U;
+            } // namespace Memory
+        } // namespace Core
+    } // namespace Config
+} // namespace BIGOS
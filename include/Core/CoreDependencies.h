@@ -1,11 +1,17 @@
 // TODO: Add <> includes
 #include <cstdint>
+#include <cstdlib>
 
 // TODO: Remove after own implementation
 #include <array>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
 #include <string>
 #include <vector>
 #include <memory>
 #include <functional>
 #include <regex>
-#include <mutex>
\ No newline at end of file
+#include <mutex>
+#include <thread>
+#include <condition_variable>
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+#include "Core/CoreTypes.h"
+#include "Core/Memory/MemoryTypes.h"
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            // Always on usage counters of a single allocator. Only relaxed atomics are used, so updating them on every allocation
+            // is cheap and sampling them once per frame does not stall allocating threads.
+            class AllocatorTelemetry final
+            {
+            public:
+                AllocatorTelemetry()
+                    : m_usage( 0 )
+                    , m_peakUsage( 0 )
+                    , m_allocatedSize( 0 )
+                    , m_allocationCount( 0 )
+                    , m_freeCount( 0 )
+                {
+                }
+                ~AllocatorTelemetry() = default;
+
+                void OnAllocate( size_t size )
+                {
+                    const uint64_t usage = m_usage.fetch_add( size, std::memory_order_relaxed ) + size;
+                    m_allocatedSize.fetch_add( size, std::memory_order_relaxed );
+                    m_allocationCount.fetch_add( 1, std::memory_order_relaxed );
+
+                    uint64_t peakUsage = m_peakUsage.load( std::memory_order_relaxed );
+                    while( ( usage > peakUsage ) && !m_peakUsage.compare_exchange_weak( peakUsage, usage, std::memory_order_relaxed ) )
+                    {
+                    }
+                }
+
+                void OnFree( size_t size )
+                {
+                    m_usage.fetch_sub( size, std::memory_order_relaxed );
+                    m_freeCount.fetch_add( 1, std::memory_order_relaxed );
+                }
+
+                // Returns memory without matching Free() call, like linear allocator reset
+                void OnRelease( size_t size ) { m_usage.fetch_sub( size, std::memory_order_relaxed ); }
+
+                // Variants for allocators that are not thread safe or update counters under their own lock. Plain loads and stores
+                // avoid locked read-modify-write instructions, readers on other threads still see consistent values.
+                void OnAllocateExclusive( size_t size )
+                {
+                    const uint64_t usage = m_usage.load( std::memory_order_relaxed ) + size;
+                    m_usage.store( usage, std::memory_order_relaxed );
+                    m_allocatedSize.store( m_allocatedSize.load( std::memory_order_relaxed ) + size, std::memory_order_relaxed );
+                    m_allocationCount.store( m_allocationCount.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+                    if( usage > m_peakUsage.load( std::memory_order_relaxed ) )
+                    {
+                        m_peakUsage.store( usage, std::memory_order_relaxed );
+                    }
+                }
+
+                void OnFreeExclusive( size_t size )
+                {
+                    m_usage.store( m_usage.load( std::memory_order_relaxed ) - size, std::memory_order_relaxed );
+                    m_freeCount.store( m_freeCount.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+                }
+
+                void OnReleaseExclusive( size_t size )
+                {
+                    m_usage.store( m_usage.load( std::memory_order_relaxed ) - size, std::memory_order_relaxed );
+                }
+
+                void GetMemoryInfo( MemoryInfo* pInfo ) const
+                {
+                    BGS_ASSERT( pInfo != nullptr );
+
+                    pInfo->usage           = m_usage.load( std::memory_order_relaxed );
+                    pInfo->peakUsage       = m_peakUsage.load( std::memory_order_relaxed );
+                    pInfo->allocatedSize   = m_allocatedSize.load( std::memory_order_relaxed );
+                    pInfo->allocationCount = m_allocationCount.load( std::memory_order_relaxed );
+                    pInfo->freeCount       = m_freeCount.load( std::memory_order_relaxed );
+                }
+
+            private:
+                Atomic<uint64_t> m_usage;
+                Atomic<uint64_t> m_peakUsage;
+                Atomic<uint64_t> m_allocatedSize;
+                Atomic<uint64_t> m_allocationCount;
+                Atomic<uint64_t> m_freeCount;
+            };
+        } // namespace Memory
+    }     // namespace Core
+} // namespace BIGOS
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "Core/Memory/MemoryTypes.h"
 
+#include "Core/Memory/AllocatorTelemetry.h"
 #include "Core/Memory/Memory.h"
 
 namespace BIGOS
@@ -9,7 +10,8 @@ namespace BIGOS
     {
         namespace Memory
         {
-            // TODO: Do we need that interface or we can just use template allocators.
+            // Runtime polymorphic allocator. Memory helpers dispatch through AllocatorPolicy, so code that knows concrete allocator
+            // type at compile time skips the virtual call (and gets fast path inlined where allocator provides one).
             class BGS_API BGS_API_INTERFACE IAllocator
             {
                 friend class MemorySystem;
@@ -17,15 +19,19 @@ namespace BIGOS
             public:
                 virtual ~IAllocator() = default;
 
-                virtual RESULT Allocate( size_t size, void** ppMemory, const char* pFile = __FILE__, uint32_t line = __LINE__ ) = 0;
-                virtual RESULT AllocateAligned( size_t size, size_t alignment, void** ppMemory, const char* pFile = __FILE__,
-                                                uint32_t line = __LINE__ )                                                      = 0;
-                virtual void   Free( void** ppMemory )                                                                          = 0;
-                virtual void   FreeAligned( void** ppMemory )                                                                   = 0;
+                virtual RESULT Allocate( size_t size, void** ppMemory, const char* pFile = nullptr, uint32_t line = 0 )                          = 0;
+                virtual RESULT AllocateAligned( size_t size, size_t alignment, void** ppMemory, const char* pFile = nullptr, uint32_t line = 0 ) = 0;
+                virtual void   Free( void** ppMemory )                                                                                           = 0;
+                virtual void   FreeAligned( void** ppMemory )                                                                                    = 0;
+
+                void GetMemoryInfo( MemoryInfo* pInfo ) const { m_telemetry.GetMemoryInfo( pInfo ); }
 
             protected:
                 virtual RESULT Create( const AllocatorDesc& desc ) = 0;
                 virtual void   Destroy()                           = 0;
+
+            protected:
+                AllocatorTelemetry m_telemetry;
             };
         } // namespace Memory
     }     // namespace Core
@@ -0,0 +1,76 @@
+#pragma once
+#include "Core/CoreTypes.h"
+#include "Core/Memory/MemoryTypes.h"
+
+#include "Core/Memory/IAllocator.h"
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            constexpr size_t LINEAR_ALLOCATOR_MIN_ALIGNMENT = alignof( std::max_align_t );
+
+            // Bump pointer arena. Individual frees are no-ops, memory is reclaimed by Reset() (once per frame) or by rewinding
+            // to a marker taken earlier with GetMarker(). Markers can be nested as long as they are released in LIFO order.
+            // Not thread safe.
+            class BGS_API LinearAllocator final : public IAllocator
+            {
+                friend class MemorySystem;
+
+            public:
+                LinearAllocator();
+                virtual ~LinearAllocator() = default;
+
+                BGS_FORCEINLINE RESULT Allocate( size_t size, void** ppMemory, const char* pFile = nullptr, uint32_t line = 0 ) override;
+                BGS_FORCEINLINE RESULT AllocateAligned( size_t size, size_t alignment, void** ppMemory, const char* pFile = nullptr,
+                                                        uint32_t line = 0 ) override;
+                BGS_FORCEINLINE void   Free( void** ppMemory ) override;
+                BGS_FORCEINLINE void   FreeAligned( void** ppMemory ) override;
+
+                // Non virtual fast path, AllocatorPolicy<LinearAllocator> calls it directly
+                BGS_FORCEINLINE RESULT AllocateBlock( size_t size, size_t alignment, void** ppMemory );
+                BGS_FORCEINLINE void   FreeBlock( void** ppMemory );
+
+                LinearAllocatorMarker GetMarker() const { return m_offset; }
+                void                  FreeToMarker( LinearAllocatorMarker marker );
+                void                  Reset();
+
+                size_t GetCapacity() const { return m_capacity; }
+                size_t GetUsedSize() const { return m_offset; }
+                size_t GetPeakSize() const { return m_peakOffset; }
+
+            protected:
+                RESULT Create( const AllocatorDesc& desc ) override;
+                void   Destroy() override;
+
+            private:
+                byte_t*       m_pMemory;
+                size_t        m_capacity;
+                size_t        m_offset;
+                size_t        m_peakOffset;
+                MemorySystem* m_pParent;
+            };
+
+            template<>
+            struct AllocatorPolicy<LinearAllocator>
+            {
+                // Linear allocations are not tracked, callsite is not needed
+                static BGS_FORCEINLINE RESULT Allocate( LinearAllocator* pAllocator, size_t size, void** ppMemory, const char*, uint32_t )
+                {
+                    return pAllocator->AllocateBlock( size, LINEAR_ALLOCATOR_MIN_ALIGNMENT, ppMemory );
+                }
+                static BGS_FORCEINLINE RESULT AllocateAligned( LinearAllocator* pAllocator, size_t size, size_t alignment, void** ppMemory,
+                                                               const char*, uint32_t )
+                {
+                    return pAllocator->AllocateBlock( size, alignment, ppMemory );
+                }
+                static BGS_FORCEINLINE void Free( LinearAllocator* pAllocator, void** ppMemory ) { pAllocator->FreeBlock( ppMemory ); }
+                static BGS_FORCEINLINE void FreeAligned( LinearAllocator* pAllocator, void** ppMemory ) { pAllocator->FreeBlock( ppMemory ); }
+            };
+        } // namespace Memory
+    }     // namespace Core
+} // namespace BIGOS
+
+#include "Core/Memory/LinearAllocator.inl"
@@ -0,0 +1,43 @@
+#include "Core/Memory/LinearAllocator.h"
+
+BIGOS::Core::RESULT BIGOS::Core::Memory::LinearAllocator::AllocateBlock( size_t size, size_t alignment, void** ppMemory )
+{
+    BGS_ASSERT( ( ppMemory != nullptr ) && ( *ppMemory == nullptr ) );
+    BGS_ASSERT( size > 0, "Block size must be greater than 0." );
+    BGS_ASSERT( ( alignment & ( alignment - 1 ) ) == 0, "Alignment must be the power of 2." );
+
+    if( alignment < LINEAR_ALLOCATOR_MIN_ALIGNMENT )
+    {
+        alignment = LINEAR_ALLOCATOR_MIN_ALIGNMENT;
+    }
+
+    const uintptr_t currAddress   = reinterpret_cast<uintptr_t>( m_pMemory ) + m_offset;
+    const size_t    alignedOffset = m_offset + ( ( ( currAddress + alignment - 1 ) & ~( alignment - 1 ) ) - currAddress );
+    if( ( alignedOffset > m_capacity ) || ( size > m_capacity - alignedOffset ) )
+    {
+        *ppMemory = nullptr;
+        return Results::NO_MEMORY;
+    }
+
+    m_telemetry.OnAllocateExclusive( alignedOffset + size - m_offset );
+
+    *ppMemory = m_pMemory + alignedOffset;
+    m_offset  = alignedOffset + size;
+    if( m_offset > m_peakOffset )
+    {
+        m_peakOffset = m_offset;
+    }
+
+    return Results::OK;
+}
+
+void BIGOS::Core::Memory::LinearAllocator::FreeBlock( void** ppMemory )
+{
+    BGS_ASSERT( ( ppMemory != nullptr ) && ( *ppMemory != nullptr ) );
+    BGS_ASSERT( ( static_cast<byte_t*>( *ppMemory ) >= m_pMemory ) && ( static_cast<byte_t*>( *ppMemory ) < m_pMemory + m_capacity ),
+                "Memory block (*ppMemory) was not allocated by this allocator." );
+
+    // Memory is reclaimed on Reset() or FreeToMarker()
+    m_telemetry.OnFreeExclusive( 0 );
+    *ppMemory = nullptr;
+}
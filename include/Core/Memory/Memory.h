@@ -13,12 +13,13 @@ namespace BIGOS
 #    error
 #endif // ( BGS_VISUAL_STUDIO )
 
-            BGS_FORCEINLINE void* Malloc( size_t size );
-            BGS_FORCEINLINE void* MallocAligned( size_t size, size_t alignment );
-            BGS_FORCEINLINE void* Realloc( void* pMem, size_t size );
-            BGS_FORCEINLINE void* ReallocAligned( void* pMem, size_t size, size_t alignment );
-            BGS_FORCEINLINE void  Free( void* pMem );
-            BGS_FORCEINLINE void  FreeAligned( void* pMem );
+            BGS_FORCEINLINE void*  Malloc( size_t size );
+            BGS_FORCEINLINE void*  MallocAligned( size_t size, size_t alignment );
+            BGS_FORCEINLINE void*  Realloc( void* pMem, size_t size );
+            BGS_FORCEINLINE void*  ReallocAligned( void* pMem, size_t size, size_t alignment );
+            BGS_FORCEINLINE void   Free( void* pMem );
+            BGS_FORCEINLINE void   FreeAligned( void* pMem );
+            BGS_FORCEINLINE size_t Size( void* pMem ); // Only for blocks from Malloc() and Realloc()
 
 #if( BGS_MEMORY_DEBUG )
 
@@ -35,13 +36,40 @@ namespace BIGOS
             BGS_FORCEINLINE void    Set( void* pDst, int32_t val, size_t size );
             BGS_FORCEINLINE int32_t Compare( const void* pMem1, const void* pMem2, size_t size );
 
+            // Copy and Set for destination that CPU does not read back soon (write combined mapped GPU memory, large uploads).
+            // Blocks above few hundred bytes are written with non temporal SIMD stores that bypass caches, AVX or SSE2 kernel is
+            // chosen at runtime. Copy() and Set() switch to them on their own for blocks bigger than STREAMING_COPY_MIN_SIZE.
+            BGS_API void StreamCopy( const void* pSrc, size_t srcSize, void* pDst, size_t dstSize );
+            BGS_API void StreamSet( void* pDst, int32_t val, size_t size );
+
+            // Compile time allocator policy used by the helpers below. Default one calls allocator member functions, which is
+            // a virtual call for IAllocator and a direct call for final allocator types. Allocators with fast path defined in
+            // header specialize it, so allocation known at compile time is inlined into the caller.
+            template<class AllocatorT>
+            struct AllocatorPolicy
+            {
+                static BGS_FORCEINLINE RESULT Allocate( AllocatorT* pAllocator, size_t size, void** ppMemory, const char* pFile, uint32_t line )
+                {
+                    return pAllocator->Allocate( size, ppMemory, pFile, line );
+                }
+                static BGS_FORCEINLINE RESULT AllocateAligned( AllocatorT* pAllocator, size_t size, size_t alignment, void** ppMemory,
+                                                               const char* pFile, uint32_t line )
+                {
+                    return pAllocator->AllocateAligned( size, alignment, ppMemory, pFile, line );
+                }
+                static BGS_FORCEINLINE void Free( AllocatorT* pAllocator, void** ppMemory ) { pAllocator->Free( ppMemory ); }
+                static BGS_FORCEINLINE void FreeAligned( AllocatorT* pAllocator, void** ppMemory ) { pAllocator->FreeAligned( ppMemory ); }
+            };
+
+            // File and line of the caller are recorded by debug allocations. Default arguments would be resolved here, so callers
+            // use BGS_ALLOCATE* macros defined below, which pass BGS_MEMORY_CALLSITE. Nullptr file means unknown callsite.
             template<typename T, class AllocatorT>
-            BGS_FORCEINLINE RESULT Allocate( AllocatorT* pAllocator, T** ppMem )
+            BGS_FORCEINLINE RESULT Allocate( AllocatorT* pAllocator, T** ppMem, const char* pFile = nullptr, uint32_t line = 0 )
             {
                 BGS_ASSERT( ( ppMem != nullptr ) && ( *ppMem == nullptr ) );
                 BGS_ASSERT( pAllocator != nullptr );
 
-                return pAllocator->Allocate( sizeof( T ), ppMem );
+                return AllocatorPolicy<AllocatorT>::Allocate( pAllocator, sizeof( T ), reinterpret_cast<void**>( ppMem ), pFile, line );
             }
 
             template<typename T, class AllocatorT>
@@ -50,7 +78,7 @@ namespace BIGOS
                 BGS_ASSERT( ( ppMem != nullptr ) && ( *ppMem != nullptr ) );
                 BGS_ASSERT( pAllocator != nullptr );
 
-                return pAllocator->Free( reinterpret_cast<void**>( ppMem ) );
+                AllocatorPolicy<AllocatorT>::Free( pAllocator, reinterpret_cast<void**>( ppMem ) );
             }
 
             template<typename T, typename... ArgsT>
@@ -61,14 +89,15 @@ namespace BIGOS
                 return ::new( pMem ) T( args... );
             }
 
+            // Callsite goes first, because constructor arguments take the end of parameter list
             template<typename T, class AllocatorT, typename... ArgsT>
-            BGS_FORCEINLINE RESULT AllocateObject( AllocatorT* pAllocator, T** ppObj, ArgsT&&... args )
+            BGS_FORCEINLINE RESULT AllocateObjectAt( const char* pFile, uint32_t line, AllocatorT* pAllocator, T** ppObj, ArgsT&&... args )
             {
                 BGS_ASSERT( ( ppObj != nullptr ) && ( *ppObj == nullptr ) );
                 BGS_ASSERT( pAllocator != nullptr );
 
                 void* pMem = nullptr;
-                if( BGS_SUCCESS( pAllocator->Allocate( sizeof( T ), &pMem ) ) )
+                if( BGS_SUCCESS( AllocatorPolicy<AllocatorT>::Allocate( pAllocator, sizeof( T ), &pMem, pFile, line ) ) )
                 {
                     *ppObj = CreateObject<T>( pMem, args... );
                     return Results::OK;
@@ -79,6 +108,12 @@ namespace BIGOS
                 return Results::NO_MEMORY;
             }
 
+            template<typename T, class AllocatorT, typename... ArgsT>
+            BGS_FORCEINLINE RESULT AllocateObject( AllocatorT* pAllocator, T** ppObj, ArgsT&&... args )
+            {
+                return AllocateObjectAt( nullptr, 0, pAllocator, ppObj, args... );
+            }
+
             template<typename T, class AllocatorT>
             BGS_FORCEINLINE void FreeObject( AllocatorT* pAllocator, T** ppObj )
             {
@@ -88,18 +123,20 @@ namespace BIGOS
                 if( *ppObj != nullptr )
                 {
                     ( *ppObj )->~T();
-                    pAllocator->Free( reinterpret_cast<void**>( ppObj ) );
+                    AllocatorPolicy<AllocatorT>::Free( pAllocator, reinterpret_cast<void**>( ppObj ) );
                 }
             }
 
             template<typename T, class AllocatorT>
-            BGS_FORCEINLINE RESULT AllocateArray( AllocatorT* pAllocator, T** ppFirst, uint32_t elemCount, size_t alignment )
+            BGS_FORCEINLINE RESULT AllocateArray( AllocatorT* pAllocator, T** ppFirst, uint32_t elemCount, size_t alignment,
+                                                  const char* pFile = nullptr, uint32_t line = 0 )
             {
                 BGS_ASSERT( ( ppFirst != nullptr ) && ( *ppFirst == nullptr ) );
                 BGS_ASSERT( pAllocator != nullptr );
                 
                 void* pMem = nullptr;
-                if( BGS_SUCCESS( pAllocator->AllocateAligned( elemCount * sizeof( T ), alignment, & pMem ) ) )
+                const size_t size = elemCount * sizeof( T );
+                if( BGS_SUCCESS( AllocatorPolicy<AllocatorT>::AllocateAligned( pAllocator, size, alignment, &pMem, pFile, line ) ) )
                 {
                     *ppFirst = static_cast<T*>( pMem );
                     return Results::OK;
@@ -116,17 +153,18 @@ namespace BIGOS
                 BGS_ASSERT( ( ppMem != nullptr ) && ( *ppMem != nullptr ) );
                 BGS_ASSERT( pAllocator != nullptr );
 
-                pAllocator->FreeAligned( reinterpret_cast<void**>( ppMem ) );
+                AllocatorPolicy<AllocatorT>::FreeAligned( pAllocator, reinterpret_cast<void**>( ppMem ) );
             }
 
             template<class AllocatorT>
-            BGS_FORCEINLINE RESULT AllocateBytes( AllocatorT* pAllocator, byte_t** ppBytes, size_t size )
+            BGS_FORCEINLINE RESULT AllocateBytes( AllocatorT* pAllocator, byte_t** ppBytes, size_t size, const char* pFile = nullptr,
+                                                  uint32_t line = 0 )
             {
                 BGS_ASSERT( ( ppBytes != nullptr ) && ( *ppBytes == nullptr ) );
                 BGS_ASSERT( pAllocator != nullptr );
 
                 void* pMem = nullptr;
-                if( BGS_SUCCESS( pAllocator->Allocate( size, &pMem ) ) )
+                if( BGS_SUCCESS( AllocatorPolicy<AllocatorT>::Allocate( pAllocator, size, &pMem, pFile, line ) ) )
                 {
                     *ppBytes = static_cast<byte_t*>( pMem );
                     return Results::OK;
@@ -136,6 +174,21 @@ namespace BIGOS
 
                 return Results::NO_MEMORY;
             }
+
+// Release builds do not record callsites, so file name strings are not compiled in and nothing is computed for them
+#if( BGS_MEMORY_DEBUG )
+#    define BGS_MEMORY_CALLSITE __FILE__, __LINE__
+#else
+#    define BGS_MEMORY_CALLSITE nullptr, 0
+#endif // ( BGS_MEMORY_DEBUG )
+
+#define BGS_ALLOCATE( _pAllocator, _ppMem ) ::BIGOS::Core::Memory::Allocate( ( _pAllocator ), ( _ppMem ), BGS_MEMORY_CALLSITE )
+#define BGS_ALLOCATE_OBJECT( ... )          ::BIGOS::Core::Memory::AllocateObjectAt( BGS_MEMORY_CALLSITE, __VA_ARGS__ )
+#define BGS_ALLOCATE_BYTES( _pAllocator, _ppBytes, _size ) \
+    ::BIGOS::Core::Memory::AllocateBytes( ( _pAllocator ), ( _ppBytes ), ( _size ), BGS_MEMORY_CALLSITE )
+#define BGS_ALLOCATE_ARRAY( _pAllocator, _ppFirst, _elemCount, _alignment ) \
+    ::BIGOS::Core::Memory::AllocateArray( ( _pAllocator ), ( _ppFirst ), ( _elemCount ), ( _alignment ), BGS_MEMORY_CALLSITE )
+
         } // namespace Memory
     }     // namespace Core
 } // namespace BIGOS
@@ -1,5 +1,6 @@
 #include "Core/Memory/MemoryTypes.h"
 
+#include "Core/CoreConfig.h"
 #include "Core/Memory/Memory.h"
 
 void* BIGOS::Core::Memory::Malloc( size_t size )
@@ -58,6 +59,17 @@ void BIGOS::Core::Memory::FreeAligned( void* pMem )
     return _aligned_free( pMem );
 }
 
+size_t BIGOS::Core::Memory::Size( void* pMem )
+{
+    BGS_ASSERT( pMem != nullptr, "Memory block (pMem) must be valid pointer." );
+
+#if( BGS_VISUAL_STUDIO )
+    return _msize( pMem );
+#else
+#    error
+#endif // ( BGS_VISUAL_STUDIO )
+}
+
 #if( BGS_MEMORY_DEBUG )
 
 void* BIGOS::Core::Memory::MallocDebug( size_t size )
@@ -127,6 +139,11 @@ void BIGOS::Core::Memory::Copy( const void* pSrc, size_t srcSize, void* pDst, si
     BGS_ASSERT( pDst != nullptr, "Memory block (pDst) must be valid pointer." );
     BGS_ASSERT( srcSize > 0, "Block size (dstSize) must be greater than 0." );
 
+    if( srcSize >= Config::Core::Memory::STREAMING_COPY_MIN_SIZE )
+    {
+        return StreamCopy( pSrc, srcSize, pDst, dstSize );
+    }
+
 #if( BGS_VISUAL_STUDIO )
     memcpy_s( pDst, dstSize, pSrc, srcSize );
 #else
@@ -139,6 +156,11 @@ void BIGOS::Core::Memory::Set( void* pDst, int32_t val, size_t size )
     BGS_ASSERT( pDst != nullptr, "Memory block (pDst) must be valid pointer." );
     BGS_ASSERT( size > 0, "Block size must be greater than 0." );
 
+    if( size >= Config::Core::Memory::STREAMING_COPY_MIN_SIZE )
+    {
+        return StreamSet( pDst, val, size );
+    }
+
     memset( pDst, val, size );
 }
 
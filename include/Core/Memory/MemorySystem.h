@@ -3,8 +3,11 @@
 #include "Core/Memory/MemoryTypes.h"
 
 #include "Core/Memory/IAllocator.h"
+#include "Core/Memory/LinearAllocator.h"
 #include "Core/Memory/Memory.h"
+#include "Core/Memory/PoolAllocator.h"
 #include "Core/Memory/SystemHeapAllocator.h"
+#include "Core/Memory/TlsfAllocator.h"
 
 namespace BIGOS
 {
@@ -12,6 +15,10 @@ namespace BIGOS
     {
         namespace Memory
         {
+#if( BGS_MEMORY_DEBUG )
+            struct MemoryTracker;
+#endif // ( BGS_MEMORY_DEBUG )
+
             class BGS_API MemorySystem final
             {
                 friend class BigosFramework;
@@ -22,12 +29,33 @@ namespace BIGOS
                 MemorySystem();
                 ~MemorySystem() = default;
 
+                RESULT CreateAllocator( const AllocatorDesc& desc, IAllocator** ppAllocator );
+                void   DestroyAllocator( IAllocator** ppAllocator );
+
+                // Releases all transient allocations made from the frame allocator. Call once per frame.
+                void NewFrame();
+
+                // Every other allocator takes its backing memory from the system heap, so its counters are the engine total.
+                void GetMemoryInfo( MemoryInfo* pInfo ) const { m_systemHeapAllocator.GetMemoryInfo( pInfo ); }
+                // Same as GetMemoryInfo(), but allocated size and allocation and free counts cover only the last frame.
+                const MemoryInfo& GetFrameMemoryInfo() const { return m_frameMemoryInfo; }
+                // Writes up to maxCount entries, system heap first and then allocators in creation order. Returns written count.
+                uint32_t GetAllocatorMemoryInfo( AllocatorMemoryInfo* pInfos, uint32_t maxCount ) const;
+                uint32_t GetAllocatorCount() const { return static_cast<uint32_t>( m_allocators.size() ) + 1; }
+
                 SystemHeapAllocator* GetSystemHeapAllocator() { return &m_systemHeapAllocator; }
+                // Frame allocator is not thread safe, only main thread can use it
+                LinearAllocator* GetFrameAllocator() { return m_pFrameAllocator; }
+                // Linear allocator of calling thread, created on first use. Meant for scratch memory released with marker before
+                // function returns, so it is safe for code that runs on any thread. Nullptr if allocator can not be created.
+                LinearAllocator* GetThreadScratchAllocator();
 
                 const MemorySystemDesc& GetDesc() { return m_desc; }
 
 #if( BGS_MEMORY_DEBUG )
-                const MemoryBlockInfoArray& GetMemoryBlockInfo() const { return m_memoryBlockInfos; };
+                // Writes up to maxCount callsites with the biggest live size, sorted in descending order. Returns written count.
+                uint32_t GetMemoryBlockInfo( MemoryCallsiteInfo* pInfos, uint32_t maxCount ) const;
+                uint64_t GetLiveBlockCount() const;
 #endif // ( BGS_MEMORY_DEBUG )
 
             protected:
@@ -35,18 +63,23 @@ namespace BIGOS
                 void   Destroy();
 
 #if( BGS_MEMORY_DEBUG )
-                void Register( const MemoryBlockInfo* pDebugInfo );
-                void Deregister( const MemoryBlockInfo* pDebugInfo );
+                void Register( MemoryBlockInfo* pDebugInfo );
+                void Deregister( MemoryBlockInfo* pDebugInfo );
 #endif // ( BGS_MEMORY_DEBUG
 
             private:
                 MemorySystemDesc    m_desc;
                 AllocatorArray      m_allocators;
                 SystemHeapAllocator m_systemHeapAllocator;
+                LinearAllocator*    m_pFrameAllocator;
+                mutable Mutex       m_allocatorMutex; // Guards allocator array, scratch allocators are created from any thread
+                uint64_t            m_generation;     // Tells thread scratch allocators of previous memory system apart
+                MemoryInfo          m_lastMemoryInfo;
+                MemoryInfo          m_frameMemoryInfo;
 
 #if( BGS_MEMORY_DEBUG )
 
-                MemoryBlockInfoArray m_memoryBlockInfos;
+                MemoryTracker* m_pTracker;
 
 #endif // ( BGS_MEMORY_DEBUG )
                 BigosEngine* m_pParent;
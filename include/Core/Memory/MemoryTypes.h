@@ -10,12 +10,19 @@ namespace BIGOS
             class MemorySystem;
             class IAllocator;
             class SystemHeapAllocator;
+            class LinearAllocator;
+            class PoolAllocator;
+            class TlsfAllocator;
 
-            using AllocatorArray = HeapArray<IAllocator*>;
+            using AllocatorArray        = HeapArray<IAllocator*>;
+            using LinearAllocatorMarker = size_t;
 
             enum class AllocatorTypes : uint8_t
             {
                 SYSTEM_HEAP,
+                LINEAR,
+                POOL,
+                TLSF,
                 // TODO: Add during development
                 _LAST_ENUM,
             };
@@ -29,11 +36,29 @@ namespace BIGOS
             struct AllocatorDesc
             {
                 MemorySystem*  pParent;
+                size_t         capacity; // Size of the backing memory block, ignored by SYSTEM_HEAP
                 ALLOCATOR_TYPE type;
             };
 
+            struct MemoryInfo
+            {
+                uint64_t usage;           // Bytes currently handed out
+                uint64_t peakUsage;       // Highest usage seen since creation
+                uint64_t allocatedSize;   // Bytes allocated in total, sample twice to get allocation rate
+                uint64_t allocationCount; // Allocations made in total
+                uint64_t freeCount;       // Frees made in total
+            };
+
+            struct AllocatorMemoryInfo
+            {
+                const IAllocator* pAllocator;
+                MemoryInfo        info;
+            };
+
 #if( BGS_MEMORY_DEBUG )
 
+            struct MemoryCallsiteEntry;
+
             enum class AllocationBlockTypes : uint32_t
             {
                 NORMAL,
@@ -50,14 +75,20 @@ namespace BIGOS
                 size_t                alignment;
                 uint32_t              line;
                 ALLOCATION_BLOCK_TYPE allocType;
+                // Filled by the memory system on register, intrusive links of the live block set and owning callsite
+                MemoryBlockInfo*      pPrev;
+                MemoryBlockInfo*      pNext;
+                MemoryCallsiteEntry*  pCallsite;
             };
 
-            using MemoryBlockInfoArray = HeapArray<const MemoryBlockInfo*>;
-
-            struct MemoryInfo
+            // Live allocations aggregated per pFile/line
+            struct MemoryCallsiteInfo
             {
-                uint64_t usage;
-                // TODO: Add during development
+                const char* pFile;
+                uint32_t    line;
+                uint64_t    liveSize;
+                uint64_t    liveCount;
+                uint64_t    allocationCount;
             };
 
 #endif // ( BGS_MEMORY_DEBUG )
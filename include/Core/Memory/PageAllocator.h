@@ -0,0 +1,46 @@
+#pragma once
+#include "Core/CoreTypes.h"
+#include "Core/Memory/MemoryTypes.h"
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            // Operating system virtual memory. Reserved range takes only address space, pages have to be committed before use.
+            BGS_API size_t GetPageSize();
+            BGS_API void*  ReservePages( size_t size );
+            BGS_API bool_t CommitPages( void* pMem, size_t size );
+            BGS_API void   DecommitPages( void* pMem, size_t size );
+            BGS_API void   ReleasePages( void* pMem, size_t size );
+
+            // Single contiguous range of virtual memory reserved up front and backed by physical pages on demand. Base address never
+            // changes, so data built on it can grow up to the reserved size without being moved or copied. Not thread safe.
+            class BGS_API PageAllocator
+            {
+            public:
+                PageAllocator();
+                ~PageAllocator() = default;
+
+                RESULT Create( size_t reserveSize );
+                void   Destroy();
+
+                // Makes sure first size bytes of range are committed
+                RESULT Commit( size_t size );
+                // Returns pages past first size bytes to the system, their content is lost
+                void Decommit( size_t size );
+
+                byte_t* GetBase() const { return m_pBase; }
+                size_t  GetReservedSize() const { return m_reservedSize; }
+                size_t  GetCommittedSize() const { return m_committedSize; }
+
+            private:
+                byte_t* m_pBase;
+                size_t  m_reservedSize;
+                size_t  m_committedSize;
+                size_t  m_pageSize;
+            };
+        } // namespace Memory
+    }     // namespace Core
+} // namespace BIGOS
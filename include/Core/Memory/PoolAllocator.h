@@ -0,0 +1,55 @@
+#pragma once
+#include "Core/CoreTypes.h"
+#include "Core/Memory/MemoryTypes.h"
+
+#include "Core/Memory/IAllocator.h"
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            struct PoolThreadCache;
+            struct PoolThreadCacheGuard;
+
+            // Size class pool for small, frequently created and destroyed objects. Every thread gets its own cache of free
+            // blocks, so allocations and frees on the owning thread do not synchronize. Blocks freed by other threads are pushed
+            // to the owner's lock free remote list and picked up on its next refill. Requests bigger than the largest size class
+            // (2 KB) or with alignment above 16 bytes fall back to the system heap. Cache of exiting thread keeps its blocks and is
+            // adopted by the next thread which needs a cache.
+            class BGS_API PoolAllocator final : public IAllocator
+            {
+                friend class MemorySystem;
+                friend struct PoolThreadCacheGuard;
+
+            public:
+                PoolAllocator();
+                virtual ~PoolAllocator() = default;
+
+                BGS_FORCEINLINE RESULT Allocate( size_t size, void** ppMemory, const char* pFile = nullptr, uint32_t line = 0 ) override;
+                BGS_FORCEINLINE RESULT AllocateAligned( size_t size, size_t alignment, void** ppMemory, const char* pFile = nullptr,
+                                                        uint32_t line = 0 ) override;
+                BGS_FORCEINLINE void   Free( void** ppMemory ) override;
+                BGS_FORCEINLINE void   FreeAligned( void** ppMemory ) override;
+
+            protected:
+                RESULT Create( const AllocatorDesc& desc ) override;
+                void   Destroy() override;
+
+            private:
+                PoolThreadCache* GetThreadCache( bool_t create );
+                RESULT           RefillCache( PoolThreadCache* pCache, uint32_t sizeClassNdx );
+                RESULT           AllocateFallback( size_t size, size_t alignment, void** ppMemory, const char* pFile, uint32_t line );
+
+            private:
+                HeapArray<PoolThreadCache*> m_threadCaches;
+                HeapArray<PoolThreadCache*> m_orphanedCaches; // Left by exited threads
+                Mutex                       m_mutex;
+                uint64_t                    m_generation;
+                uint32_t                    m_slotNdx;
+                MemorySystem*               m_pParent;
+            };
+        } // namespace Memory
+    }     // namespace Core
+} // namespace BIGOS
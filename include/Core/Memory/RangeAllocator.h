@@ -0,0 +1,82 @@
+#pragma once
+#include "Core/CoreTypes.h"
+#include "Core/Memory/MemoryTypes.h"
+
+#include "Core/Containers/Array.h"
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            constexpr uint32_t RANGE_ALLOCATOR_SL_COUNT_LOG2 = 5;
+            constexpr uint32_t RANGE_ALLOCATOR_SL_COUNT      = 1U << RANGE_ALLOCATOR_SL_COUNT_LOG2;
+            constexpr uint32_t RANGE_ALLOCATOR_FL_COUNT      = 64 - RANGE_ALLOCATOR_SL_COUNT_LOG2 + 1;
+            constexpr uint32_t RANGE_ALLOCATOR_INVALID_NODE  = MAX_UINT32;
+
+            struct RangeAllocation
+            {
+                uint64_t offset;
+                uint64_t size;
+                uint32_t node;
+
+                RangeAllocation()
+                    : offset( 0 )
+                    , size( 0 )
+                    , node( RANGE_ALLOCATOR_INVALID_NODE )
+                {
+                }
+            };
+
+            struct RangeAllocatorNode
+            {
+                uint64_t offset;
+                uint64_t size;
+                uint32_t prevNeighbour;
+                uint32_t nextNeighbour;
+                uint32_t prevFree;
+                uint32_t nextFree;
+                bool_t   isFree;
+            };
+
+            // Two level segregated fit allocator of offsets inside [0, size) range. Bookkeeping is kept out of the managed memory,
+            // so it can sub-allocate memory CPU can not touch (GPU heaps, descriptor heaps). Allocation and free are O(1).
+            // Not thread safe.
+            class BGS_API RangeAllocator final
+            {
+            public:
+                RangeAllocator();
+                ~RangeAllocator() = default;
+
+                RESULT Create( uint64_t size, IAllocator* pAllocator );
+                void   Destroy();
+
+                RESULT Allocate( uint64_t size, uint64_t alignment, RangeAllocation* pAllocation );
+                void   Free( RangeAllocation* pAllocation );
+
+                uint64_t GetSize() const { return m_size; }
+                uint64_t GetUsedSize() const { return m_usedSize; }
+                uint32_t GetAllocationCount() const { return m_allocationCount; }
+                bool_t   IsEmpty() const { return m_allocationCount == 0 ? BGS_TRUE : BGS_FALSE; }
+
+            private:
+                uint32_t CreateNode( uint64_t offset, uint64_t size );
+                void     ReleaseNode( uint32_t node );
+                void     InsertFreeNode( uint32_t node );
+                void     RemoveFreeNode( uint32_t node );
+                uint32_t FindFreeNode( uint64_t size );
+
+            private:
+                Containers::Array<RangeAllocatorNode> m_nodes;
+                uint32_t                              m_freeNodes;
+                uint64_t                              m_flBitmap;
+                uint32_t                              m_slBitmaps[ RANGE_ALLOCATOR_FL_COUNT ];
+                uint32_t                              m_heads[ RANGE_ALLOCATOR_FL_COUNT ][ RANGE_ALLOCATOR_SL_COUNT ];
+                uint64_t                              m_size;
+                uint64_t                              m_usedSize;
+                uint32_t                              m_allocationCount;
+            };
+        } // namespace Memory
+    }     // namespace Core
+} // namespace BIGOS
@@ -18,9 +18,9 @@ namespace BIGOS
                 SystemHeapAllocator()          = default;
                 virtual ~SystemHeapAllocator() = default;
 
-                BGS_FORCEINLINE RESULT Allocate( size_t size, void** ppMemory, const char* pFile = __FILE__, uint32_t line = __LINE__ ) override;
-                BGS_FORCEINLINE RESULT AllocateAligned( size_t size, size_t alignment, void** ppMemory, const char* pFile = __FILE__,
-                                                        uint32_t line = __LINE__ ) override;
+                BGS_FORCEINLINE RESULT Allocate( size_t size, void** ppMemory, const char* pFile = nullptr, uint32_t line = 0 ) override;
+                BGS_FORCEINLINE RESULT AllocateAligned( size_t size, size_t alignment, void** ppMemory, const char* pFile = nullptr,
+                                                        uint32_t line = 0 ) override;
                 BGS_FORCEINLINE void   Free( void** ppMemory ) override;
                 BGS_FORCEINLINE void   FreeAligned( void** ppMemory ) override;
 
@@ -30,8 +30,8 @@ namespace BIGOS
 
 #if( BGS_MEMORY_DEBUG )
             private:
-                BGS_FORCEINLINE void Register( const MemoryBlockInfo* pDebugInfo );
-                BGS_FORCEINLINE void Deregister( const MemoryBlockInfo* pDebugInfo );
+                BGS_FORCEINLINE void Register( MemoryBlockInfo* pDebugInfo );
+                BGS_FORCEINLINE void Deregister( MemoryBlockInfo* pDebugInfo );
 #endif // ( BGS_MEMORY_DEBUG )
 
             private:
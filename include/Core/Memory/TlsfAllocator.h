@@ -0,0 +1,53 @@
+#pragma once
+#include "Core/CoreTypes.h"
+#include "Core/Memory/MemoryTypes.h"
+
+#include "Core/Memory/IAllocator.h"
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            struct TlsfControl;
+
+            // Two level segregated fit allocator. Allocation and free are O(1) (two bitmap scans and constant number of list
+            // operations) and fragmentation is bounded by the second level granularity. Memory comes from pools of
+            // AllocatorDesc::capacity bytes taken from the system heap, a new pool is added when the current ones are exhausted.
+            class BGS_API TlsfAllocator final : public IAllocator
+            {
+                friend class MemorySystem;
+
+            public:
+                TlsfAllocator();
+                virtual ~TlsfAllocator() = default;
+
+                BGS_FORCEINLINE RESULT Allocate( size_t size, void** ppMemory, const char* pFile = nullptr, uint32_t line = 0 ) override;
+                BGS_FORCEINLINE RESULT AllocateAligned( size_t size, size_t alignment, void** ppMemory, const char* pFile = nullptr,
+                                                        uint32_t line = 0 ) override;
+                BGS_FORCEINLINE void   Free( void** ppMemory ) override;
+                BGS_FORCEINLINE void   FreeAligned( void** ppMemory ) override;
+
+                size_t GetUsedSize() const { return m_usedSize; }
+                size_t GetPoolSize() const { return m_poolSize; }
+                size_t GetPoolCount() const { return m_pools.size(); }
+
+            protected:
+                RESULT Create( const AllocatorDesc& desc ) override;
+                void   Destroy() override;
+
+            private:
+                RESULT AddPool( size_t minSize );
+
+            private:
+                HeapArray<void*> m_pools;
+                Mutex            m_mutex;
+                TlsfControl*     m_pControl;
+                size_t           m_poolSize;
+                size_t           m_usedSize;
+                MemorySystem*    m_pParent;
+            };
+        } // namespace Memory
+    }     // namespace Core
+} // namespace BIGOS
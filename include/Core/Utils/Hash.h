@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Core/CoreTypes.h"
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Utils
+        {
+            // 64 bit FNV-1a. Not cryptographic, meant for cache keys and checking cache files read from disk. Pass previous result as
+            // hash to continue hashing next block.
+            class Hash final
+            {
+            public:
+                static constexpr hash_t SEED = 0xCBF29CE484222325ull;
+
+            public:
+                static hash_t FNV1a( const void* pData, size_t size, hash_t hash = SEED )
+                {
+                    const byte_t* pBytes = static_cast<const byte_t*>( pData );
+                    for( index_t ndx = 0; ndx < size; ++ndx )
+                    {
+                        hash = ( hash ^ static_cast<hash_t>( pBytes[ ndx ] ) ) * PRIME;
+                    }
+
+                    return hash;
+                }
+
+            private:
+                static constexpr hash_t PRIME = 0x00000100000001B3ull;
+            };
+
+        } // namespace Utils
+    } // namespace Core
+} // namespace BIGOS
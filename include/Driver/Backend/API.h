@@ -69,6 +69,8 @@ namespace BIGOS
                 virtual void   DestroyPipelineLayout( PipelineLayoutHandle* pHandle )                                = 0;
                 virtual RESULT CreatePipeline( const PipelineDesc& desc, PipelineHandle* pHandle )                   = 0;
                 virtual void   DestroyPipeline( PipelineHandle* pHandle )                                            = 0;
+                // Serializes cache of all pipelines created so far, with pData set to nullptr only size is returned
+                virtual RESULT GetPipelineCacheData( void* pData, uint64_t* pSize ) = 0;
 
                 virtual RESULT CreateFence( const FenceDesc& desc, FenceHandle* pHandle )       = 0;
                 virtual void   DestroyFence( FenceHandle* pHandle )                             = 0;
@@ -81,6 +83,7 @@ namespace BIGOS
 
                 virtual RESULT AllocateMemory( const AllocateMemoryDesc& desc, MemoryHandle* pHandle ) = 0;
                 virtual void   FreeMemory( MemoryHandle* pHandle )                                     = 0;
+                virtual RESULT QueryMemoryBudget( MemoryBudgetInfo* pInfo )                            = 0;
 
                 virtual RESULT CreateResource( const ResourceDesc& desc, ResourceHandle* pHandle )               = 0;
                 virtual void   DestroyResource( ResourceHandle* pHandle )                                        = 0;
@@ -88,6 +91,8 @@ namespace BIGOS
                 virtual void   GetResourceAllocationInfo( ResourceHandle handle, ResourceAllocationInfo* pInfo ) = 0;
                 virtual RESULT MapResource( const MapResourceDesc& desc, void** ppResource )                     = 0;
                 virtual RESULT UnmapResource( const MapResourceDesc& desc )                                      = 0;
+                virtual RESULT FlushRange( const MapResourceDesc& desc )                                         = 0;
+                virtual RESULT InvalidateRange( const MapResourceDesc& desc )                                    = 0;
 
                 virtual RESULT CreateResourceView( const ResourceViewDesc& desc, ResourceViewHandle* pHandle ) = 0;
                 virtual void   DestroyResourceView( ResourceViewHandle* pHandle )                              = 0;
@@ -102,7 +107,9 @@ namespace BIGOS
                 virtual RESULT CreateBindingHeap( const BindingHeapDesc& desc, BindingHeapHandle* pHandle )                = 0;
                 virtual void   DestroyBindingHeap( BindingHeapHandle* pHandle )                                            = 0;
                 virtual void   GetBindingOffset( const GetBindingOffsetDesc& desc, uint64_t* pOffset )                     = 0;
-                virtual void   WriteBinding( const WriteBindingDesc& desc ) = 0; // TODO: For now, writes only one binding at the time.
+                virtual void   GetBindingSetLayoutSize( BindingSetLayoutHandle handle, uint64_t* pSize )                   = 0;
+                virtual void   WriteBindings( const WriteBindingDesc* pDescs, uint32_t descCount )                         = 0;
+                void           WriteBinding( const WriteBindingDesc& desc ) { WriteBindings( &desc, 1 ); }
 
                 virtual RESULT CreateQueryPool( const QueryPoolDesc& desc, QueryPoolHandle* pHandle ) = 0;
                 virtual void   DestroyQueryPool( QueryPoolHandle* pHandle )                           = 0;
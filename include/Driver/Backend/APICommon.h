@@ -1,6 +1,8 @@
 #pragma once
 #include "APITypes.h"
 
+#include "Core/Utils/Hash.h"
+
 namespace BIGOS::Driver::Backend
 {
     BGS_FORCEINLINE BGS_API uint32_t GetBigosFormatSize( FORMAT format )
@@ -285,4 +287,81 @@ namespace BIGOS::Driver::Backend
         return translateTable[ BGS_ENUM_INDEX( format ) ];
     };
 
+    BGS_FORCEINLINE BGS_API TextureComponentFlags GetFormatComponents( FORMAT format )
+    {
+        TextureComponentFlags components = 0;
+        if( IsDepthFormat( format ) || IsDepthStencilFormat( format ) )
+        {
+            components |= BGS_FLAG( TextureComponentFlagBits::DEPTH );
+        }
+        if( IsStencilFormat( format ) )
+        {
+            components |= BGS_FLAG( TextureComponentFlagBits::STENCIL );
+        }
+        if( components == 0 )
+        {
+            components = BGS_FLAG( TextureComponentFlagBits::COLOR );
+        }
+
+        return components;
+    }
+
+    constexpr uint32_t PIPELINE_CACHE_MAGIC = 0x43504742; // "BGPC"
+
+    // Fills header of the device, data size and hash are set when cache is serialized
+    BGS_FORCEINLINE BGS_API void FillPipelineCacheHeader( API_TYPE apiType, const AdapterInfo& info, const uint8_t* pCacheUUID,
+                                                          PipelineCacheHeader* pHeader )
+    {
+        BGS_ASSERT( pHeader != nullptr, "Pipeline cache header (pHeader) must be a valid pointer." );
+
+        pHeader->magic         = PIPELINE_CACHE_MAGIC;
+        pHeader->version       = Config::Driver::Pipeline::PIPELINE_CACHE_VERSION;
+        pHeader->vendorID      = info.vendorID;
+        pHeader->deviceID      = info.deviceID;
+        pHeader->driverVersion = info.driverVersion;
+        pHeader->dataSize      = 0;
+        pHeader->dataHash      = 0;
+        pHeader->apiType       = static_cast<uint32_t>( apiType );
+        pHeader->reserved      = 0;
+        for( uint32_t ndx = 0; ndx < sizeof( pHeader->cacheUUID ); ++ndx )
+        {
+            pHeader->cacheUUID[ ndx ] = pCacheUUID != nullptr ? pCacheUUID[ ndx ] : 0;
+        }
+    }
+
+    // Checks serialized cache against header of the device, truncated or corrupted data fails the hash check
+    BGS_FORCEINLINE BGS_API bool_t IsPipelineCacheValid( const PipelineCacheHeader& deviceHeader, const void* pData, uint64_t size )
+    {
+        if( ( pData == nullptr ) || ( size < sizeof( PipelineCacheHeader ) ) )
+        {
+            return BGS_FALSE;
+        }
+
+        const PipelineCacheHeader& header = *static_cast<const PipelineCacheHeader*>( pData );
+        if( ( header.magic != deviceHeader.magic ) || ( header.version != deviceHeader.version ) || ( header.apiType != deviceHeader.apiType ) ||
+            ( header.vendorID != deviceHeader.vendorID ) || ( header.deviceID != deviceHeader.deviceID ) ||
+            ( header.driverVersion.major != deviceHeader.driverVersion.major ) ||
+            ( header.driverVersion.minor != deviceHeader.driverVersion.minor ) ||
+            ( header.driverVersion.patch != deviceHeader.driverVersion.patch ) ||
+            ( header.driverVersion.build != deviceHeader.driverVersion.build ) )
+        {
+            return BGS_FALSE;
+        }
+        for( uint32_t ndx = 0; ndx < sizeof( header.cacheUUID ); ++ndx )
+        {
+            if( header.cacheUUID[ ndx ] != deviceHeader.cacheUUID[ ndx ] )
+            {
+                return BGS_FALSE;
+            }
+        }
+
+        if( header.dataSize != size - sizeof( PipelineCacheHeader ) )
+        {
+            return BGS_FALSE;
+        }
+        const uint8_t* pNativeData = static_cast<const uint8_t*>( pData ) + sizeof( PipelineCacheHeader );
+
+        return header.dataHash == Core::Utils::Hash::FNV1a( pNativeData, header.dataSize ) ? BGS_TRUE : BGS_FALSE;
+    }
+
 } // namespace BIGOS::Driver::Backend
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "APIHandles.h"
 
+#include "Core/Containers/Array.h"
 #include "Core/CoreTypes.h"
 #include "Platform/PlatformTypes.h"
 
@@ -25,8 +26,8 @@ namespace BIGOS
 
             struct BackBufferInfo;
 
-            using AdapterArray    = HeapArray<IAdapter*>;
-            using BackBufferArray = HeapArray<BackBufferInfo>;
+            using AdapterArray    = Core::Containers::SmallArray<IAdapter*, 4>;
+            using BackBufferArray = Core::Containers::SmallArray<BackBufferInfo, 4>;
 
             enum class AdapterTypes : uint8_t
             {
@@ -74,7 +75,25 @@ namespace BIGOS
 
             struct DeviceDesc
             {
-                IAdapter* pAdapter;
+                IAdapter*   pAdapter;
+                const void* pPipelineCacheData; // From IDevice::GetPipelineCacheData(), only read during creation, can be nullptr
+                uint64_t    pipelineCacheSize;
+            };
+
+            // Serialized pipeline cache starts with this header followed by native cache data. Data saved by other API, device or driver
+            // is dropped on load and cache starts empty.
+            struct PipelineCacheHeader
+            {
+                uint32_t    magic;
+                uint32_t    version;
+                uint32_t    vendorID;
+                uint32_t    deviceID;
+                VersionDesc driverVersion;
+                uint8_t     cacheUUID[ 16 ]; // Zeroed for D3D12, pipeline library validates driver by itself
+                uint64_t    dataSize;
+                uint64_t    dataHash;
+                uint32_t    apiType;
+                uint32_t    reserved;
             };
 
             struct DeviceLimits
@@ -87,6 +106,7 @@ namespace BIGOS
                 uint64_t constantBufferBindingSize;         // CONSTANT_BUFFER
                 uint64_t readOnlyStorageBufferBindingSize;  // READ_ONLY_STORAGE_BUFFER
                 uint64_t readWriteStorageBufferBindingSize; // READ_WRITE_STORAGE_BUFFER
+                uint64_t bindingSetAlignment;               // Base offset of binding set in binding heap
             };
 
             enum class QueueTypes : uint8_t
@@ -793,6 +813,9 @@ namespace BIGOS
                 AccessFlags        srcAccess;
                 PipelineStageFlags dstStage;
                 AccessFlags        dstAccess;
+                // Ownership transfer between queues of different types, both nullptr if there is none. Recorded like texture one
+                IQueue* pSrcQueue;
+                IQueue* pDstQueue;
             };
 
             struct TextureBarrierDesc
@@ -805,6 +828,10 @@ namespace BIGOS
                 PipelineStageFlags dstStage;
                 AccessFlags        dstAccess;
                 TEXTURE_LAYOUT     dstLayout;
+                // Ownership transfer between queues of different types, both nullptr if there is none. The same barrier is recorded
+                // on source queue (release) and on destination queue (acquire), which has to wait for the release submission
+                IQueue* pSrcQueue;
+                IQueue* pDstQueue;
             };
 
             struct BarierDesc
@@ -887,6 +914,25 @@ namespace BIGOS
                 MEMORY_HEAP_USAGE heapUsage;
             };
 
+            enum class MemorySegmentTypes : uint8_t
+            {
+                LOCAL,     // Video memory, all memory on integrated adapters
+                NON_LOCAL, // System memory visible to the GPU
+                _MAX_ENUM,
+            };
+            using MEMORY_SEGMENT_TYPE = MemorySegmentTypes;
+
+            struct MemorySegmentBudget
+            {
+                uint64_t budget; // Amount the process can use without being paged out by the OS
+                uint64_t usage;
+            };
+
+            struct MemoryBudgetInfo
+            {
+                MemorySegmentBudget segments[ BGS_ENUM_COUNT( MemorySegmentTypes ) ];
+            };
+
             enum class ResourceTypes : uint8_t
             {
                 UNKNOWN,
@@ -926,6 +972,14 @@ namespace BIGOS
             };
             using ResourceUsageFlags = uint32_t;
 
+            enum class ResourceFlagBits : uint32_t
+            {
+                NONE           = 0x00000000,
+                PERSISTENT_MAP = 0x00000001, // Map / Unmap skip sync. UPLOAD and READBACK heaps are coherent, resources in non coherent
+                                             // CUSTOM heap memory need IDevice::FlushRange / InvalidateRange
+            };
+            using ResourceFlags = uint32_t;
+
             enum class ResourceSharingModes : uint8_t
             {
                 EXCLUSIVE_ACCESS,
@@ -945,6 +999,7 @@ namespace BIGOS
                 SAMPLE_COUNT          sampleCount;
                 FORMAT                format;
                 ResourceUsageFlags    resourceUsage;
+                ResourceFlags         flags;
                 uint32_t              mipLevelCount;
                 uint32_t              arrayLayerCount;
                 RESOURCE_TYPE         resourceType;
@@ -1225,6 +1280,7 @@ namespace BIGOS
                 Size3D           size;
                 Offset3D         textureOffset;
                 uint64_t         bufferOffset;
+                uint32_t         bufferRowPitch; // 0 for tightly packed rows, D3D12 requires multiple of TEXTURE_ROW_PITCH_ALIGNMENT
                 FORMAT           textureFormat;
             };
 
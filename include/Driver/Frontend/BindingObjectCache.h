@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Core/Containers/Array.h"
+#include "Driver/Frontend/RenderSystemTypes.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            // Shares resource views and samplers created with identical descriptions. Objects are looked up by hash of the whole
+            // description and reference counted, backend object is destroyed when last user releases it. Handles returned from the
+            // cache must be released with Release...() and never destroyed through the device directly. Thread safe.
+            class BGS_API BindingObjectCache final
+            {
+                friend class RenderSystem;
+
+            public:
+                BindingObjectCache();
+                ~BindingObjectCache() = default;
+
+                RESULT CreateResourceView( const Backend::BufferViewDesc& desc, Backend::ResourceViewHandle* pHandle );
+                RESULT CreateResourceView( const Backend::TexelBufferViewDesc& desc, Backend::ResourceViewHandle* pHandle );
+                RESULT CreateResourceView( const Backend::TextureViewDesc& desc, Backend::ResourceViewHandle* pHandle );
+                void   ReleaseResourceView( Backend::ResourceViewHandle* pHandle );
+
+                RESULT CreateSampler( const Backend::SamplerDesc& desc, Backend::SamplerHandle* pHandle );
+                void   ReleaseSampler( Backend::SamplerHandle* pHandle );
+
+                uint32_t GetObjectCount() const { return m_entryCount; }
+
+            protected:
+                RESULT Create( const BindingObjectCacheDesc& desc, RenderSystem* pSystem );
+                void   Destroy();
+
+            private:
+                enum class EntryTypes : uint8_t
+                {
+                    RESOURCE_VIEW,
+                    SAMPLER,
+                    _MAX_ENUM,
+                };
+                using ENTRY_TYPE = EntryTypes;
+
+                // Keys are zeroed before filling, so padding and unused union members do not change hash
+                struct ViewKey
+                {
+                    Backend::ResourceHandle         hResource;
+                    Backend::BufferRangeDesc        bufferRange;
+                    Backend::TextureRangeDesc       textureRange;
+                    Backend::ResourceViewUsageFlags usage;
+                    Backend::FORMAT                 format;
+                    Backend::TEXTURE_TYPE           textureType;
+                    Backend::TEXTURE_LAYOUT         layout;
+                };
+
+                static constexpr size_t KEY_SIZE =
+                    sizeof( ViewKey ) > sizeof( Backend::SamplerDesc ) ? sizeof( ViewKey ) : sizeof( Backend::SamplerDesc );
+
+                struct Entry
+                {
+                    byte_t     key[ KEY_SIZE ];
+                    hash_t     hash;
+                    handle_t   handle;   // Native value of view or sampler handle
+                    uint32_t   refCount; // 0 for free entries
+                    uint32_t   nextByKey;
+                    uint32_t   nextByHandle;
+                    ENTRY_TYPE type;
+                };
+
+                using EntryArray = Core::Containers::Array<Entry>;
+                using IndexArray = Core::Containers::Array<uint32_t>;
+
+                RESULT CreateResourceView( const Backend::ResourceViewDesc& desc, const ViewKey& key, Backend::ResourceViewHandle* pHandle );
+
+                // Returns entry with reference added or MAX_UINT32, if no object matches key
+                uint32_t Acquire( ENTRY_TYPE type, const byte_t* pKey, hash_t hash );
+                RESULT   Insert( ENTRY_TYPE type, const byte_t* pKey, hash_t hash, handle_t handle );
+                // Returns BGS_TRUE, if last reference was dropped and object has to be destroyed
+                bool_t Release( handle_t handle );
+                RESULT Rehash( uint32_t bucketCount );
+
+            private:
+                BindingObjectCacheDesc m_desc;
+                RenderSystem*          m_pParent;
+                EntryArray             m_entries;
+                IndexArray             m_keyBuckets;
+                IndexArray             m_handleBuckets;
+                IndexArray             m_freeEntries;
+                Mutex                  m_mutex;
+                uint32_t               m_entryCount;
+            };
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Core/Containers/Array.h"
+#include "Driver/Frontend/RenderSystemTypes.h"
+#include "Driver/Frontend/SyncSystem.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            // Keeps views of registered resources in shader visible heap, so shaders index them directly instead of binding sets per
+            // draw. Each binding type gets its own range, index returned by Register...() is stable for resource lifetime. Range uses
+            // binding slot and shader register equal to sum of binding counts of types before it in BindingTypes order. Every frame in
+            // flight reads its own copy of the heap. When defragmenter or streamer swaps resource of a registered texture or buffer, its
+            // entries are rewritten in each copy only once GPU is done with frames reading that copy, so frames in flight keep reading
+            // old views, which live until swapping frame is finished. Residency manager restores evicted resources, whose entries no
+            // frame reads, so they are rewritten in all copies at once.
+            class BGS_API BindlessTable final
+            {
+                friend class RenderSystem;
+                friend class Buffer;
+                friend class Texture;
+
+            public:
+                BindlessTable();
+                ~BindlessTable() = default;
+
+                RESULT RegisterView( Backend::BINDING_TYPE type, Backend::ResourceViewHandle hView, uint32_t* pIndex );
+                // Resource has to be unregistered before it is destroyed
+                RESULT RegisterTexture( Texture* pTexture, Backend::BINDING_TYPE type, uint32_t* pIndex );
+                RESULT RegisterBuffer( Buffer* pBuffer, Backend::BINDING_TYPE type, uint32_t* pIndex );
+                // Index is reused once frames recorded so far are finished
+                void Unregister( Backend::BINDING_TYPE type, uint32_t ndx );
+
+                // Called once per frame after submission, point has to be signaled when GPU finishes work of that frame. Switches to
+                // next heap copy and waits, if GPU still reads it
+                RESULT Update( const SyncPoint& framePoint );
+
+                // Set is bound with base binding offset 0, heap changes with every Update()
+                Backend::BindingSetLayoutHandle GetBindingSetLayout() const { return m_hLayout; }
+                Backend::BindingHeapHandle      GetBindingHeap() const { return m_copies[ m_copyNdx ].hHeap; }
+
+            protected:
+                RESULT Create( const BindlessTableDesc& desc, RenderSystem* pSystem );
+                void   Destroy();
+
+                void RewriteEntry( const Texture* pTexture, const BindlessEntry& entry );
+                void RewriteEntry( const Buffer* pBuffer, const BindlessEntry& entry );
+                void QueueRewrite( const BindlessEntry& entry );
+
+            private:
+                struct PendingIndex
+                {
+                    SyncPoint             point;
+                    uint32_t              ndx;
+                    Backend::BINDING_TYPE type;
+                    bool_t                isPointSet;
+                };
+
+                // Resource which keeps entry of the index, both nullptr for raw views
+                struct Owner
+                {
+                    Texture* pTexture;
+                    Buffer*  pBuffer;
+                };
+
+                struct DirtyEntry
+                {
+                    uint32_t              ndx;
+                    Backend::BINDING_TYPE type;
+                };
+                using DirtyEntryArray = Core::Containers::Array<DirtyEntry>;
+
+                struct HeapCopy
+                {
+                    Backend::BindingHeapHandle hHeap;
+                    DirtyEntryArray            dirtyEntries; // Rewritten before copy is used again
+                    SyncPoint                  point;
+                    bool_t                     isPointSet;
+                };
+
+                using IndexArray        = Core::Containers::Array<uint32_t>;
+                using PendingIndexArray = Core::Containers::Array<PendingIndex>;
+                using OwnerArray        = Core::Containers::Array<Owner>;
+
+                static Backend::ResourceViewHandle GetView( const Texture* pTexture, Backend::BINDING_TYPE type );
+                static Backend::ResourceViewHandle GetView( const Buffer* pBuffer, Backend::BINDING_TYPE type );
+
+                // Current view of resource which owns the index, invalid handle if index has no owner
+                Backend::ResourceViewHandle GetOwnerView( Backend::BINDING_TYPE type, uint32_t ndx ) const;
+
+                RESULT AllocateIndex( Backend::BINDING_TYPE type, uint32_t* pIndex );
+                void   WriteView( Backend::BINDING_TYPE type, uint32_t ndx, Backend::ResourceViewHandle hView );
+                void   WriteView( Backend::BindingHeapHandle hHeap, Backend::BINDING_TYPE type, uint32_t ndx, Backend::ResourceViewHandle hView );
+                void   AddEntry( BindlessEntryArray* pEntries, Backend::BINDING_TYPE type, uint32_t ndx );
+                void   RemoveEntry( BindlessEntryArray* pEntries, Backend::BINDING_TYPE type, uint32_t ndx );
+
+            private:
+                BindlessTableDesc               m_desc;
+                RenderSystem*                   m_pParent;
+                Backend::BindingSetLayoutHandle m_hLayout;
+                HeapCopy                        m_copies[ Config::Driver::Binding::BINDLESS_HEAP_COPY_COUNT ];
+                uint32_t                        m_copyNdx;
+                uint64_t                        m_rangeOffsets[ BGS_ENUM_COUNT( Backend::BindingTypes ) ];
+                uint64_t                        m_bindingSizes[ BGS_ENUM_COUNT( Backend::BindingTypes ) ];
+                uint32_t                        m_nextIndices[ BGS_ENUM_COUNT( Backend::BindingTypes ) ];
+                IndexArray                      m_freeIndices[ BGS_ENUM_COUNT( Backend::BindingTypes ) ];
+                OwnerArray                      m_owners[ BGS_ENUM_COUNT( Backend::BindingTypes ) ];
+                PendingIndexArray               m_pendingIndices;
+            };
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Driver/Frontend/DeviceMemorySystem.h"
 #include "Driver/Frontend/RenderSystemTypes.h"
 
 namespace BIGOS
@@ -12,6 +13,9 @@ namespace BIGOS
             class BGS_API Buffer final
             {
                 friend class RenderSystem;
+                friend class BindlessTable;
+                friend class DeviceMemoryDefragmenter;
+                friend class ResidencyManager;
 
             public:
                 Buffer();
@@ -20,18 +24,27 @@ namespace BIGOS
                 RESULT Map( void** ppHost );
                 void   Unmap();
 
+                Backend::ResourceHandle GetResource() const { return m_hResource; }
+
             protected:
                 RESULT Create( const BufferDesc& desc, RenderSystem* pSystem );
                 void   Destroy();
 
+                // Exchanges GPU objects with buffer created from the same desc, bindless entries of both get new views once frames
+                // reading old ones are finished
+                void SwapResources( Buffer* pOther );
+                void UpdateBindlessEntries();
+                void QueueBindlessRewrites();
+
             private:
                 BufferDesc                  m_desc;
                 RenderSystem*               m_pParent;
-                Backend::MemoryHandle       m_hMemory;
+                DeviceMemoryAllocation      m_memory;
                 Backend::ResourceHandle     m_hResource;
                 Backend::ResourceViewHandle m_hConstantAccess;
                 Backend::ResourceViewHandle m_hReadAccess;
                 Backend::ResourceViewHandle m_hReadWriteAccess;
+                BindlessEntryArray          m_bindlessEntries; // Survive Destroy(), so Create() rewrites them
             };
 
         } // namespace Frontend
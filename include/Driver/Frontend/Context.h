@@ -1,7 +1,10 @@
 #pragma once
+#include "Core/Containers/Array.h"
 #include "Core/CoreTypes.h"
 #include "Driver/Backend/APITypes.h"
+#include "Driver/Frontend/DeviceMemorySystem.h"
 #include "Driver/Frontend/RenderSystemTypes.h"
+#include "Driver/Frontend/SyncSystem.h"
 
 namespace BIGOS
 {
@@ -14,6 +17,7 @@ namespace BIGOS
             {
                 friend class RenderSystem;
                 friend class Swapchain;
+                friend class CopyContext;
 
             public:
                 GraphicsContext();
@@ -51,6 +55,11 @@ namespace BIGOS
                 Backend::IQueue*  m_pQueue;
             };
 
+            // Besides owning copy queue, works as staging belt. Upload data is copied into big persistently mapped staging pages and
+            // copy commands are gathered until FlushUploads(), which records them into a single command buffer and returns sync point
+            // other contexts can wait on. Pages are recycled once that point is reached. Uploads can be issued from any thread.
+            // Copy queue only writes buffers and textures, they are handed over to graphics queue by AcquireUploads(), recorded at the
+            // start of graphics work, which also moves textures to their final layout.
             class BGS_API CopyContext final
             {
                 friend class RenderSystem;
@@ -59,6 +68,24 @@ namespace BIGOS
                 CopyContext();
                 ~CopyContext() = default;
 
+                RESULT UploadBuffer( const BufferUploadDesc& desc );
+                RESULT UploadTexture( const TextureUploadDesc& desc );
+
+                // Submits all uploads issued since previous flush, point is set to the last flush if there was nothing to submit.
+                // Submission waits for release point, graphics queue submission with ReleaseUploadTargets() recorded
+                RESULT FlushUploads( SyncPoint* pPoint, const SyncPoint& releasePoint = SyncPoint() );
+                // Records release of textures whose content is kept by uploads issued so far into graphics queue command buffer
+                RESULT ReleaseUploadTargets( Backend::ICommandBuffer* pCmdBuffer );
+                // Records acquire of resources uploaded by flushes so far into graphics queue command buffer, submission of that
+                // command buffer has to wait for the point. Point is left default if there was nothing to acquire
+                RESULT AcquireUploads( Backend::ICommandBuffer* pCmdBuffer, SyncPoint* pPoint );
+                // Records acquire only of resources whose flush was already finished on the GPU, so submission does not wait
+                RESULT AcquireCompletedUploads( Backend::ICommandBuffer* pCmdBuffer );
+                // Forgets pending acquires of resource, called before destroying resource that was never acquired
+                void DropAcquires( Backend::ResourceHandle hResource );
+
+                uint64_t GetStagingSize() const { return m_stagingSize; }
+
             protected:
                 RESULT Create( Backend::IDevice* pDevice, RenderSystem* pSystem );
                 void   Destroy();
@@ -66,9 +93,67 @@ namespace BIGOS
                 Backend::IQueue* GetQueue() { return m_pQueue; }
 
             private:
-                RenderSystem*     m_pParent;
-                Backend::IDevice* m_pDevice;
-                Backend::IQueue*  m_pQueue;
+                struct StagingPage
+                {
+                    Backend::ResourceHandle hResource;
+                    DeviceMemoryAllocation  memory;
+                    byte_t*                 pHost;
+                    uint64_t                size;
+                    uint64_t                usedSize;
+                    SyncPoint               point;
+                };
+
+                struct UploadBatch
+                {
+                    Backend::CommandPoolHandle hCommandPool;
+                    Backend::ICommandBuffer*   pCommandBuffer;
+                    SyncPoint                  point;
+                    bool_t                     inFlight;
+                };
+
+                using PageArray           = Core::Containers::Array<StagingPage*>;
+                using BufferCopyArray     = Core::Containers::Array<Backend::CopyBufferDesc>;
+                using TextureCopyArray    = Core::Containers::Array<Backend::CopyBufferTextureDesc>;
+                using BufferBarrierArray  = Core::Containers::Array<Backend::BufferBarrierDesc>;
+                using TextureBarrierArray = Core::Containers::Array<Backend::TextureBarrierDesc>;
+                using AcquirePointArray   = Core::Containers::Array<SyncPoint>;
+                using UploadBatchArray    = StackArray<UploadBatch, Config::Driver::Memory::MAX_UPLOAD_BATCH_COUNT>;
+
+                RESULT AllocateStaging( uint64_t size, uint64_t alignment, StagingPage** ppPage, uint64_t* pOffset );
+                void   RecyclePages();
+                void   RecordBarriers( Backend::ICommandBuffer*           pCmdBuffer,
+                                       const Backend::BufferBarrierDesc*  pBufferBarriers,
+                                       index_t                            bufferBarrierCount,
+                                       const Backend::TextureBarrierDesc* pTextureBarriers,
+                                       index_t                            textureBarrierCount );
+
+                RESULT CreatePage( uint64_t size, StagingPage** ppPage );
+                void   DestroyPage( StagingPage** ppPage );
+
+            private:
+                RenderSystem*       m_pParent;
+                Backend::IDevice*   m_pDevice;
+                Backend::IQueue*    m_pQueue;
+                PageArray           m_freePages;
+                PageArray           m_activePages; // Written since last flush
+                PageArray           m_pendingPages;
+                BufferCopyArray     m_bufferCopies;
+                TextureCopyArray    m_textureCopies;
+                TextureBarrierArray m_textureBarriers;
+                TextureBarrierArray m_releaseBarriers; // Graphics queue side of texture barriers keeping content, not recorded yet
+                TextureBarrierArray m_postBarriers;    // Recorded after all copies
+                TextureBarrierArray m_acquireBarriers; // Graphics queue side of post barriers, not flushed yet
+                TextureBarrierArray m_flushedAcquires; // Graphics queue side of post barriers, waiting for AcquireUploads()
+                AcquirePointArray   m_acquirePoints;   // Flush that released texture of every flushed acquire
+                BufferBarrierArray  m_bufferPostBarriers;
+                BufferBarrierArray  m_bufferAcquireBarriers;
+                BufferBarrierArray  m_flushedBufferAcquires;
+                AcquirePointArray   m_bufferAcquirePoints;
+                UploadBatchArray    m_batches;
+                uint32_t            m_nextBatch;
+                SyncPoint           m_lastPoint;
+                uint64_t            m_stagingSize;
+                Mutex               m_uploadMutex;
             };
 
         } // namespace Frontend
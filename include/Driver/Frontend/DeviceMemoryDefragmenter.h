@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Core/Containers/Array.h"
+#include "Driver/Frontend/RenderSystemTypes.h"
+#include "Driver/Frontend/SyncSystem.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            // Empties sparse device memory blocks over several frames. Only registered buffers and textures are moved, they must not
+            // be written by the GPU once their content is uploaded. Each Update() records copies of up to the frame budget out of the
+            // evacuated block into graphics command buffer, so copies follow all earlier work using the resources on the same queue
+            // and no ownership transfer is needed. Once that frame is done frontend objects get new resources and views, old ones
+            // are destroyed when frame that could still use them is finished. Users have to refresh bindings when GetGeneration()
+            // changes.
+            class BGS_API DeviceMemoryDefragmenter
+            {
+                friend class RenderSystem;
+                friend class ResidencyManager;
+
+            public:
+                DeviceMemoryDefragmenter();
+                ~DeviceMemoryDefragmenter() = default;
+
+                // Called once per frame before recording, point has to be signaled when GPU finishes work of that frame. Copies are
+                // recorded into pCmdBuffer, which must be submitted on graphics queue as part of that frame
+                RESULT Update( const SyncPoint& framePoint, Backend::ICommandBuffer* pCmdBuffer );
+
+                // Opts immutable resource in, textures also need their state set. Unregister returns whether object was registered
+                void   RegisterBuffer( Buffer* pBuffer );
+                bool_t UnregisterBuffer( Buffer* pBuffer );
+                void   RegisterTexture( Texture* pTexture );
+                bool_t UnregisterTexture( Texture* pTexture );
+
+                void     SetMaxBytesPerFrame( uint64_t size ) { m_desc.maxBytesPerFrame = size; } // 0 pauses defragmentation
+                uint64_t GetMaxBytesPerFrame() const { return m_desc.maxBytesPerFrame; }
+                uint64_t GetMovedSize() const { return m_movedSize; }
+                // Increased every time objects get new resources
+                uint32_t GetGeneration() const { return m_generation; }
+
+            protected:
+                RESULT Create( const DeviceMemoryDefragmenterDesc& desc, RenderSystem* pSystem );
+                void   Destroy();
+
+            private:
+                enum class MoveStates : uint8_t
+                {
+                    COPYING,
+                    RETIRING, // Objects were swapped, old resources wait for frames still using them
+                };
+                using MOVE_STATE = MoveStates;
+
+                struct Move
+                {
+                    Buffer*    pBuffer;
+                    Buffer*    pShadowBuffer;
+                    Texture*   pTexture;
+                    Texture*   pShadowTexture;
+                    SyncPoint  point;
+                    MOVE_STATE state;
+                };
+
+                using BufferArray  = Core::Containers::Array<Buffer*>;
+                using TextureArray = Core::Containers::Array<Texture*>;
+                using MoveArray    = Core::Containers::Array<Move>;
+
+                RESULT MoveBuffer( Buffer* pBuffer, Backend::ICommandBuffer* pCmdBuffer, const SyncPoint& framePoint );
+                RESULT MoveTexture( Texture* pTexture, Backend::ICommandBuffer* pCmdBuffer, const SyncPoint& framePoint );
+                void   DestroyShadow( Move* pMove );
+                bool_t IsMoving( const void* pObject ) const;
+
+            private:
+                DeviceMemoryDefragmenterDesc m_desc;
+                RenderSystem*                m_pParent;
+                BufferArray                  m_buffers;
+                TextureArray                 m_textures;
+                MoveArray                    m_moves;
+                Mutex                        m_mutex;
+                uint64_t                     m_movedSize;
+                uint32_t                     m_generation;
+            };
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
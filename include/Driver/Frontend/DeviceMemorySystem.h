@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Core/Containers/Array.h"
+#include "Core/Memory/RangeAllocator.h"
+#include "Driver/Frontend/RenderSystemTypes.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            struct DeviceMemoryBlock
+            {
+                Backend::MemoryHandle        hMemory;
+                Core::Memory::RangeAllocator allocator;
+                bool_t                       isEvacuated; // Being emptied by defragmenter, takes no new allocations
+                bool_t                       isPinned;    // Holds allocations defragmenter can not move
+            };
+
+            struct DeviceMemoryAllocation
+            {
+                Backend::MemoryHandle         hMemory;
+                uint64_t                      offset;
+                uint64_t                      size;
+                Backend::MEMORY_HEAP_TYPE     heapType;
+                Backend::MEMORY_HEAP_USAGE    heapUsage;
+                DeviceMemoryBlock*            pBlock; // nullptr for dedicated allocations
+                Core::Memory::RangeAllocation range;
+
+                DeviceMemoryAllocation()
+                    : hMemory()
+                    , offset( 0 )
+                    , size( 0 )
+                    , heapType( Backend::MemoryHeapTypes::_MAX_ENUM )
+                    , heapUsage( Backend::MemoryHeapUsages::_MAX_ENUM )
+                    , pBlock( nullptr )
+                    , range()
+                {
+                }
+            };
+
+            // Places resources in big device memory blocks, one block list per heap type and usage. Keeping usages in separate blocks
+            // satisfies D3D12 heap tier 1 and keeps Vulkan linear and optimal resources apart (buffer image granularity). Resources too
+            // big for a block, or with alignment above block alignment, get their own memory.
+            class BGS_API DeviceMemorySystem
+            {
+                friend class RenderSystem;
+
+            public:
+                DeviceMemorySystem();
+                ~DeviceMemorySystem() = default;
+
+                RESULT Allocate( const Backend::AllocateMemoryDesc& desc, DeviceMemoryAllocation* pAllocation );
+                void   Free( DeviceMemoryAllocation* pAllocation );
+
+                // Queries resource requirements, allocates memory and binds resource at allocation offset
+                RESULT AllocateAndBind( Backend::ResourceHandle hResource, Backend::MEMORY_HEAP_TYPE heapType, Backend::MEMORY_HEAP_USAGE heapUsage,
+                                        DeviceMemoryAllocation* pAllocation );
+
+                // Picks the least used block of default heap pools that have more than one block, nullptr if every block is used above
+                // maxUsage. Only one block is evacuated at a time, it is released by Free() once empty
+                DeviceMemoryBlock* BeginEvacuation( float maxUsage );
+                void               CancelEvacuation(); // Pins evacuated block, so it is not picked again
+                DeviceMemoryBlock* GetEvacuatedBlock() const { return m_pEvacuatedBlock; }
+
+                uint64_t GetAllocatedSize() const { return m_allocatedSize; }
+                uint64_t GetUsedSize() const { return m_usedSize; }
+                uint32_t GetDeviceAllocationCount() const { return m_deviceAllocationCount; }
+
+            protected:
+                RESULT Create( const DeviceMemorySystemDesc& desc, RenderSystem* pSystem );
+                void   Destroy();
+
+            private:
+                using BlockArray = Core::Containers::Array<DeviceMemoryBlock*>;
+
+                RESULT CreateBlock( Backend::MEMORY_HEAP_TYPE heapType, Backend::MEMORY_HEAP_USAGE heapUsage, DeviceMemoryBlock** ppBlock );
+                void   DestroyBlock( DeviceMemoryBlock** ppBlock );
+
+                BlockArray& GetPool( Backend::MEMORY_HEAP_TYPE heapType, Backend::MEMORY_HEAP_USAGE heapUsage )
+                {
+                    return m_pools[ BGS_ENUM_INDEX( heapType ) ][ BGS_ENUM_INDEX( heapUsage ) ];
+                }
+
+            private:
+                DeviceMemorySystemDesc m_desc;
+                RenderSystem*          m_pParent;
+                BlockArray             m_pools[ BGS_ENUM_COUNT( Backend::MemoryHeapTypes ) ][ BGS_ENUM_COUNT( Backend::MemoryHeapUsages ) ];
+                Mutex                  m_mutex;
+                DeviceMemoryBlock*     m_pEvacuatedBlock;
+                uint64_t               m_allocatedSize;
+                uint64_t               m_usedSize;
+                uint32_t               m_deviceAllocationCount;
+            };
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
\ No newline at end of file
@@ -22,18 +22,42 @@ namespace BIGOS
                 RESULT CreateBuffer( const BufferDesc& desc, Buffer** ppBuffer );
                 void   DestroyBuffer( Buffer** ppBuffer );
 
+                RESULT CreateUploadRingBuffer( const UploadRingBufferDesc& desc, UploadRingBuffer** ppRingBuffer );
+                void   DestroyUploadRingBuffer( UploadRingBuffer** ppRingBuffer );
+
                 RESULT CreateTexture( const TextureDesc& desc, Texture** ppTexture );
                 void   DestroyTexture( Texture** ppTexture );
 
                 RESULT CreateRenderTarget( const RenderTargetDesc& desc, RenderTarget** ppRenderTarget );
                 void   DestroyRenderTarget( RenderTarget** ppRenderTarget );
 
+                RESULT CreateTransientResourcePool( const TransientResourcePoolDesc& desc, TransientResourcePool** ppPool );
+                void   DestroyTransientResourcePool( TransientResourcePool** ppPool );
+
+                RESULT CreateResidencyManager( const ResidencyManagerDesc& desc, ResidencyManager** ppManager );
+                void   DestroyResidencyManager( ResidencyManager** ppManager );
+
+                RESULT CreateTextureStreamer( const TextureStreamerDesc& desc, TextureStreamer** ppStreamer );
+                void   DestroyTextureStreamer( TextureStreamer** ppStreamer );
+
+                RESULT CreateBindlessTable( const BindlessTableDesc& desc, BindlessTable** ppTable );
+                void   DestroyBindlessTable( BindlessTable** ppTable );
+
+                RESULT CreateTransientBindingHeap( const TransientBindingHeapDesc& desc, TransientBindingHeap** ppHeap );
+                void   DestroyTransientBindingHeap( TransientBindingHeap** ppHeap );
+
+                // Budget and usage of local and non local memory of this process as reported by the driver
+                RESULT GetMemoryBudget( Backend::MemoryBudgetInfo* pInfo );
+
                 RESULT CreateRenderPass( const RenderPassDesc& desc, RenderPass** ppRenderPass );
                 void   DestroyRenderPass( RenderPass** ppRenderPass );
 
                 RESULT CreateShader( const ShaderDesc& desc, Shader** ppShader );
                 void   DestroyShader( Shader** ppShader );
 
+                RESULT CreateAsyncShaderCompiler( const AsyncShaderCompilerDesc& desc, AsyncShaderCompiler** ppCompiler );
+                void   DestroyAsyncShaderCompiler( AsyncShaderCompiler** ppCompiler );
+
                 RESULT CreatePipeline( const GraphicsPipelineDesc& desc, Pipeline** ppPipeline );
                 RESULT CreatePipeline( const ComputePipelineDesc& desc, Pipeline** ppPipeline );
                 void   DestroyPipeline( Pipeline** ppPipeline );
@@ -41,10 +65,13 @@ namespace BIGOS
                 RESULT CreateSwapchain( const SwapchainDesc& desc, Swapchain** ppSwapchain );
                 void   DestroySwapchain( Swapchain** ppSwapchain );
 
-                GraphicsContext* GetGraphicsContext() { return m_pGraphicsContext; }
-                ComputeContext*  GetComputeContext() { return m_pComputeContext; }
-                CopyContext*     GetCopyContext() { return m_pCopyContext; }
-                SyncSystem*      GetSyncSystem() { return m_pSyncSystem; }
+                GraphicsContext*          GetGraphicsContext() { return m_pGraphicsContext; }
+                ComputeContext*           GetComputeContext() { return m_pComputeContext; }
+                CopyContext*              GetCopyContext() { return m_pCopyContext; }
+                SyncSystem*               GetSyncSystem() { return m_pSyncSystem; }
+                DeviceMemorySystem*       GetDeviceMemorySystem() { return m_pDeviceMemorySystem; }
+                DeviceMemoryDefragmenter* GetDefragmenter() { return m_pDefragmenter; }
+                BindingObjectCache*       GetBindingObjectCache() { return m_pBindingObjectCache; }
 
                 const AdapterArray& GetAdapters() const { return m_adapters; } // Hide
                 Backend::IDevice*   GetDevice() const { return m_pDevice; }    // Hide
@@ -53,10 +80,12 @@ namespace BIGOS
                 RESULT CreateCamera( const CameraDesc& desc, Camera** ppCamera );
                 void   DestroyCamera( Camera** ppCamera );
 
-                BigosEngine*        GetParent() { return m_pParent; }
-                Memory::IAllocator* GetDefaultAllocator() { return m_pDefaultAllocator; }
-                Backend::IFactory*  GetFactory() { return m_pFactory; }
-                IShaderCompiler*    GetDefaultCompiler() { return m_pCompiler; }
+                BigosEngine*           GetParent() { return m_pParent; }
+                Memory::IAllocator*    GetDefaultAllocator() { return m_pDefaultAllocator; }
+                Memory::IAllocator*    GetObjectAllocator() { return m_pObjectAllocator; }
+                Backend::IFactory*     GetFactory() { return m_pFactory; }
+                IShaderCompiler*       GetDefaultCompiler() { return m_pCompiler; }
+                ShaderCompilerFactory* GetShaderCompilerFactory() { return m_pShaderCompilerFactory; }
 
                 const RenderSystemDesc& GetDesc() const { return m_desc; }
                 const DriverDesc&       GetDriverDesc() const { return m_driverDesc; }
@@ -76,23 +105,31 @@ namespace BIGOS
                 RESULT CreateContexts();
                 void   DestroyContexts();
 
+                // Missing or unreadable file leaves data empty, device validates the content itself
+                void LoadPipelineCache( HeapArray<byte_t>* pData );
+                void SavePipelineCache();
+
                 void FreeDriver();
 
             private:
-                RenderSystemDesc       m_desc;
-                DriverDesc             m_driverDesc;
-                Backend::IFactory*     m_pFactory;
-                Backend::IDevice*      m_pDevice;
-                AdapterArray           m_adapters;
-                GraphicsContext*       m_pGraphicsContext;
-                ComputeContext*        m_pComputeContext;
-                CopyContext*           m_pCopyContext;
-                SyncSystem*            m_pSyncSystem;
-                CameraArray            m_cameras; // Shaould be handled by resource manager
-                BigosEngine*           m_pParent;
-                ShaderCompilerFactory* m_pShaderCompilerFactory;
-                Memory::IAllocator*    m_pDefaultAllocator;
-                IShaderCompiler*       m_pCompiler;
+                RenderSystemDesc          m_desc;
+                DriverDesc                m_driverDesc;
+                Backend::IFactory*        m_pFactory;
+                Backend::IDevice*         m_pDevice;
+                AdapterArray              m_adapters;
+                GraphicsContext*          m_pGraphicsContext;
+                ComputeContext*           m_pComputeContext;
+                CopyContext*              m_pCopyContext;
+                SyncSystem*               m_pSyncSystem;
+                DeviceMemorySystem*       m_pDeviceMemorySystem;
+                DeviceMemoryDefragmenter* m_pDefragmenter;
+                BindingObjectCache*       m_pBindingObjectCache;
+                CameraArray               m_cameras; // Shaould be handled by resource manager
+                BigosEngine*              m_pParent;
+                ShaderCompilerFactory*    m_pShaderCompilerFactory;
+                Memory::IAllocator*       m_pDefaultAllocator;
+                Memory::IAllocator*       m_pObjectAllocator;
+                IShaderCompiler*          m_pCompiler;
             };
 
         } // namespace Frontend
@@ -1,5 +1,6 @@
 #pragma once
 #include "Core/CoreTypes.h"
+#include "Core/Containers/StableArray.h"
 #include "Core/Memory/MemoryTypes.h"
 
 #include "Driver/Backend/API.h"
@@ -23,6 +24,16 @@ namespace BIGOS
             class RenderSystem;
             class SyncSystem;
             class SyncPoint;
+            class DeviceMemorySystem;
+            class UploadRingBuffer;
+            class TransientResourcePool;
+            class DeviceMemoryDefragmenter;
+            class ResidencyManager;
+            class TextureStreamer;
+            class AsyncShaderCompiler;
+            class BindlessTable;
+            class TransientBindingHeap;
+            class BindingObjectCache;
             class GraphicsContext;
             class ComputeContext;
             class CopyContext;
@@ -36,8 +47,17 @@ namespace BIGOS
             class IShaderCompiler;
             class ShaderCompilerFactory;
 
-            using AdapterArray = Backend::AdapterArray;
-            using CameraArray  = HeapArray<Camera*>;
+            // Place of buffer or texture view in bindless table, kept by the resource so entry follows its views
+            struct BindlessEntry
+            {
+                BindlessTable*        pTable;
+                Backend::BINDING_TYPE type;
+                uint32_t              ndx;
+            };
+
+            using AdapterArray       = Backend::AdapterArray;
+            using CameraArray        = Core::Containers::StableArray<Camera*>;
+            using BindlessEntryArray = Core::Containers::SmallArray<BindlessEntry, 2>;
 
             using ContextTypes = Backend::QueueTypes;
             using CONTEXT_TYPE = Backend::QUEUE_TYPE;
@@ -68,7 +88,12 @@ namespace BIGOS
 
             struct ShaderCompilerFactoryDesc
             {
-                // For future use
+                const char* pShaderCachePath; // Directory of compiled shaders, nullptr keeps shader cache in memory only
+
+                ShaderCompilerFactoryDesc()
+                    : pShaderCachePath( nullptr )
+                {
+                }
             };
 
             enum class ShaderModels : uint8_t
@@ -181,16 +206,23 @@ namespace BIGOS
 
             struct DriverDesc
             {
-                Backend::API_TYPE apiType;
-                bool              debug;
+                Backend::API_TYPE     apiType;
+                Backend::ADAPTER_TYPE adapterType; // Preferred adapter (SOFTWARE for lavapipe or WARP), first one if there is none
+                bool                  debug;
+                const char*           pPipelineCachePath; // Loaded at initialization and saved at shutdown, nullptr disables it
 
                 DriverDesc()
                     : apiType( Backend::APITypes::_MAX_ENUM )
+                    , adapterType( Backend::AdapterTypes::_MAX_ENUM )
                     , debug( false )
+                    , pPipelineCachePath( nullptr )
                 {
                 }
 
-                bool operator==( const DriverDesc& other ) const { return apiType == other.apiType && debug == other.debug; }
+                bool operator==( const DriverDesc& other ) const
+                {
+                    return apiType == other.apiType && adapterType == other.adapterType && debug == other.debug;
+                }
                 bool operator!=( const DriverDesc& other ) const { return apiType == other.apiType || debug == other.debug; }
             };
 
@@ -294,6 +326,111 @@ namespace BIGOS
                 uint32_t syncPointCount;
             };
 
+            struct DeviceMemorySystemDesc
+            {
+                uint64_t blockSize;
+            };
+
+            struct DeviceMemoryDefragmenterDesc
+            {
+                uint64_t maxBytesPerFrame;
+                float    maxBlockUsage;
+            };
+
+            struct BindingObjectCacheDesc
+            {
+                uint32_t bucketCount; // Power of 2, table grows when it holds more objects
+            };
+
+            // Called from streaming thread, fills one subresource with tightly packed texels
+            using MipLoader = std::function<RESULT( uint32_t mipLevel, uint32_t arrayLayer, void* pData, uint64_t size )>;
+
+            struct StreamingTextureDesc
+            {
+                TextureDesc textureDesc;  // Whole mip chain
+                uint32_t    tailMipCount; // Smallest mips, loaded when texture is added and always resident
+                MipLoader   loader;
+            };
+
+            struct TextureStreamerDesc
+            {
+                uint64_t memoryBudget;    // For all streamed textures
+                uint64_t maxLoadPerFrame; // Bytes of mips requested in one update
+            };
+
+            struct AsyncShaderCompilerDesc
+            {
+                uint32_t workerCount; // 0 uses one worker per hardware thread
+            };
+
+            struct BindlessTableDesc
+            {
+                uint32_t                   bindingCounts[ BGS_ENUM_COUNT( Backend::BindingTypes ) ]; // Samplers are not supported
+                Backend::SHADER_VISIBILITY visibility;
+            };
+
+            struct TransientBindingHeapDesc
+            {
+                uint32_t                   bindingCount;
+                Backend::BINDING_HEAP_TYPE type;
+            };
+
+            struct ResidencyManagerDesc
+            {
+                float    maxBudgetUsage;      // Part of local memory budget that managed resources can use before eviction starts
+                uint64_t maxEvictionPerFrame; // Bytes
+            };
+
+            struct UploadRingBufferDesc
+            {
+                uint64_t                    size;
+                Backend::ResourceUsageFlags usage;
+            };
+
+            // Graphics queue takes uploaded range over in CopyContext::AcquireUploads(), which makes it available to final stage and access
+            struct BufferUploadDesc
+            {
+                const void*                 pData;
+                Backend::ResourceHandle     hBuffer;
+                uint64_t                    offset;
+                uint64_t                    size;
+                Backend::PipelineStageFlags finalStage;
+                Backend::AccessFlags        finalAccess;
+            };
+
+            // Previous content of subresource is discarded only when upload covers all of it or texture state is undefined. Otherwise it is
+            // kept, graphics queue releases texture in CopyContext::ReleaseUploadTargets() first. Graphics queue takes texture over in
+            // CopyContext::AcquireUploads(), which moves it to final layout and makes it available to final stage and access
+            struct TextureUploadDesc
+            {
+                const void*                 pData;    // Tightly packed texels
+                Texture*                    pTexture; // Tracked state is layout of kept content, upload does not change it
+                Backend::TextureRangeDesc   textureRange; // Mip and layer select subresource, counts are totals of the texture
+                Offset3D                    textureOffset;
+                Size3D                      size;
+                Backend::FORMAT             format;
+                Backend::TEXTURE_LAYOUT     finalLayout;
+                Backend::PipelineStageFlags finalStage;
+                Backend::AccessFlags        finalAccess;
+            };
+
+            struct TransientResourcePoolDesc
+            {
+                uint32_t maxTextureCount;
+            };
+
+            struct TransientTextureDesc
+            {
+                Size3D                      size;
+                Backend::FORMAT             format;
+                Backend::SAMPLE_COUNT       sampleCount;
+                uint32_t                    mipLevelCount;
+                uint32_t                    arrayLayerCount;
+                Backend::ResourceUsageFlags usage;
+                uint32_t                    firstPass; // Passes of the frame using the texture, both inclusive
+                uint32_t                    lastPass;
+            };
+
         } // namespace Frontend
     } // namespace Driver
 } // namespace BIGOS
\ No newline at end of file
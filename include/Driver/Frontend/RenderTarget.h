@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Driver/Frontend/DeviceMemorySystem.h"
 #include "Driver/Frontend/RenderSystemTypes.h"
 
 #include "Driver/Frontend/ResourceState.h"
@@ -39,7 +40,7 @@ namespace BIGOS
                 Backend::ResourceDesc       m_targetDesc;
                 ResourceState               m_state;
                 RenderSystem*               m_pParent;
-                Backend::MemoryHandle       m_hMemory;
+                DeviceMemoryAllocation      m_memory;
                 Backend::ResourceHandle     m_hResource;
                 Backend::ResourceViewHandle m_hView;
                 Backend::ResourceViewHandle m_hSampleView;
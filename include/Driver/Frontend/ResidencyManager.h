@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Core/Containers/Array.h"
+#include "Driver/Frontend/RenderSystemTypes.h"
+#include "Driver/Frontend/SyncSystem.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            // Keeps streaming buffers and textures within local memory budget. Resources are ordered by last use, when size of resident
+            // ones goes above the limit taken from budget reported by the driver, least recently used ones whose frames are finished get
+            // their memory released. Own count is used instead of driver usage, which keeps ranges of evicted resources until their
+            // device memory block is emptied. Evicted resources keep their desc, MakeResident() gives them new memory with undefined
+            // content, so data has to be uploaded again. Resources have to be removed from manager before they are destroyed.
+            class BGS_API ResidencyManager final
+            {
+                friend class RenderSystem;
+
+            public:
+                ResidencyManager();
+                ~ResidencyManager() = default;
+
+                RESULT AddBuffer( Buffer* pBuffer, index_t* pIndex );
+                RESULT AddTexture( Texture* pTexture, index_t* pIndex );
+                void   Remove( index_t ndx ); // Resource is left as it is
+
+                // Has to be called for every resource used in frame being recorded
+                void   MarkUsed( index_t ndx );
+                RESULT MakeResident( index_t ndx );
+                bool_t IsResident( index_t ndx ) const { return m_entries[ ndx ].isResident; }
+
+                // Called once per frame after submission, point has to be signaled when GPU finishes work of that frame
+                RESULT Update( const SyncPoint& framePoint );
+
+                const Backend::MemoryBudgetInfo& GetBudget() const { return m_budget; }
+                uint64_t                         GetResidentSize() const { return m_residentSize; }
+                uint64_t                         GetEvictedSize() const { return m_evictedSize; }
+
+            protected:
+                RESULT Create( const ResidencyManagerDesc& desc, RenderSystem* pSystem );
+                void   Destroy();
+
+            private:
+                struct Entry
+                {
+                    Buffer*  pBuffer;
+                    Texture* pTexture;
+                    uint64_t size;
+                    uint64_t lastUsedFrame;
+                    index_t  prev; // Towards more recently used
+                    index_t  next;
+                    bool_t   isResident;
+                    bool_t   isMovable; // Was registered in defragmenter before eviction
+                };
+
+                struct FramePoint
+                {
+                    uint64_t  frame;
+                    SyncPoint point;
+                };
+
+                using EntryArray      = Core::Containers::Array<Entry>;
+                using IndexArray      = Core::Containers::Array<index_t>;
+                using FramePointArray = StackArray<FramePoint, Config::Driver::Memory::MAX_RESIDENCY_FRAME_COUNT>;
+
+                RESULT AddEntry( Buffer* pBuffer, Texture* pTexture, index_t* pIndex );
+                void   Evict( index_t ndx );
+                void   Link( index_t ndx );
+                void   Unlink( index_t ndx );
+
+            private:
+                ResidencyManagerDesc      m_desc;
+                RenderSystem*             m_pParent;
+                EntryArray                m_entries;
+                IndexArray                m_freeEntries;
+                FramePointArray           m_frames;
+                uint32_t                  m_firstFrame;
+                uint32_t                  m_frameCount;
+                index_t                   m_head; // Most recently used
+                index_t                   m_tail;
+                uint64_t                  m_frame; // Frame being recorded
+                uint64_t                  m_completedFrame;
+                Backend::MemoryBudgetInfo m_budget;
+                uint64_t                  m_residentSize;
+                uint64_t                  m_evictedSize;
+            };
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Core/Containers/Array.h"
+#include "Driver/Frontend/RenderSystemTypes.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            // Compiles shaders on a pool of worker threads. DXC compilers are not thread safe, so every worker owns its own compiler
+            // instance. Compilation is the only part done by workers, backend shader is created on thread that takes it with GetShader().
+            // Destroying compiler cancels jobs that workers did not start yet and destroys every shader not taken with GetShader(),
+            // take all needed shaders before.
+            class BGS_API AsyncShaderCompiler final
+            {
+                friend class RenderSystem;
+
+            public:
+                AsyncShaderCompiler();
+                ~AsyncShaderCompiler() = default;
+
+                // Source has to stay valid until shader is taken with GetShader()
+                RESULT CompileShader( const ShaderDesc& desc, index_t* pIndex );
+                bool_t IsReady( index_t ndx );
+                // Waits for compilation. Shader belongs to caller afterwards and is destroyed with RenderSystem::DestroyShader(), index is
+                // released even if compilation failed
+                RESULT GetShader( index_t ndx, Shader** ppShader );
+
+                uint32_t GetWorkerCount() const { return static_cast<uint32_t>( m_workers.size() ); }
+
+            protected:
+                RESULT Create( const AsyncShaderCompilerDesc& desc, RenderSystem* pSystem );
+                void   Destroy();
+
+            private:
+                struct Job
+                {
+                    Shader* pShader;
+                    RESULT  result;
+                    bool_t  isUsed;
+                    bool_t  isDone;
+                };
+
+                using JobArray            = Core::Containers::Array<Job>;
+                using IndexArray          = Core::Containers::Array<index_t>;
+                using PendingJobArray     = HeapArray<index_t>; // Queue shared with workers, consumed from m_pendingHead
+                using WorkerArray         = HeapArray<std::thread>;
+                using WorkerCompilerArray = HeapArray<IShaderCompiler*>;
+
+                void CompileShaders( IShaderCompiler* pCompiler );
+
+            private:
+                AsyncShaderCompilerDesc m_desc;
+                RenderSystem*           m_pParent;
+                JobArray                m_jobs;
+                IndexArray              m_freeJobs;
+                PendingJobArray         m_pendingJobs;
+                index_t                 m_pendingHead;
+                WorkerArray             m_workers;
+                WorkerCompilerArray     m_compilers;
+                Mutex                   m_mutex;
+                std::condition_variable m_pendingCondition;
+                std::condition_variable m_doneCondition;
+                bool_t                  m_isStopping;
+            };
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
@@ -12,6 +12,7 @@ namespace BIGOS
             class BGS_API Shader final
             {
                 friend class RenderSystem;
+                friend class AsyncShaderCompiler;
 
             public:
                 Shader();
@@ -25,7 +26,12 @@ namespace BIGOS
                 void   Destroy();
 
             private:
-                SHADER_LANGUAGE      DetectShaderLanguage( const String& shaderCode );
+                // Creation split in steps, so compilation can run on worker thread with its own compiler
+                void   SetCompileDesc( const ShaderDesc& desc, RenderSystem* pSystem );
+                RESULT Compile( IShaderCompiler* pCompiler );
+                RESULT CreateBackendShader();
+
+                SHADER_LANGUAGE DetectShaderLanguage( const String& shaderCode );
 
             private:
                 CompileShaderDesc     m_compileDesc;
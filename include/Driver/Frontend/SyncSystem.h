@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Core/Containers/StableArray.h"
 #include "Driver/Frontend/RenderSystemTypes.h"
 
 namespace BIGOS
@@ -38,6 +39,8 @@ namespace BIGOS
                 CONTEXT_TYPE m_contextType;
             };
 
+            using SyncPointArray = Core::Containers::StableArray<SyncPoint>;
+
             class BGS_API SyncSystem
             {
                 friend class RenderSystem;
@@ -52,23 +55,33 @@ namespace BIGOS
 
                 RESULT Wait( const SyncPoint& point );
                 RESULT Wait( const HeapArray<SyncPoint>& points );
+                RESULT Wait( const SyncPoint* pPoints, index_t pointCount );
+
+                // Non blocking check, reads fence value and drops tracked points completed by it
+                bool_t IsCompleted( const SyncPoint& point );
+
+                // Fence backing sync points of given context, for signaling them from queue submissions
+                Backend::FenceHandle GetFence( CONTEXT_TYPE ctxType ) { return m_contextData[ BGS_ENUM_INDEX( ctxType ) ].hFence; }
 
             protected:
                 RESULT Create( const SyncSystemDesc& desc, RenderSystem* pSystem );
                 void   Destroy();
 
-            private:
-                void CleanupCompletedPoints( CONTEXT_TYPE ctxType );
-
             private:
                 struct PerContextData
                 {
                     Backend::FenceHandle hFence;
                     Atomic<uint64_t>     counter;
-                    HeapArray<SyncPoint> syncPoints;
+                    SyncPointArray       syncPoints; // Ring of not yet completed points, slots are reused, so points never move
+                    index_t              firstPoint; // Oldest point in the ring
+                    index_t              pointCount;
                     Mutex                mutex;
                 };
 
+                void CleanupCompletedPoints( CONTEXT_TYPE ctxType );
+                // Context mutex has to be locked
+                void CleanupCompletedPoints( PerContextData& contextData, uint64_t fenceVal );
+
             private:
                 SyncSystemDesc                                             m_desc;
                 RenderSystem*                                              m_pParent;
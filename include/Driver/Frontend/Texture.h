@@ -1,6 +1,8 @@
 #pragma once
 
+#include "Driver/Frontend/DeviceMemorySystem.h"
 #include "Driver/Frontend/RenderSystemTypes.h"
+#include "Driver/Frontend/ResourceState.h"
 
 namespace BIGOS
 {
@@ -12,22 +14,41 @@ namespace BIGOS
             class BGS_API Texture final
             {
                 friend class RenderSystem;
+                friend class BindlessTable;
+                friend class DeviceMemoryDefragmenter;
+                friend class ResidencyManager;
+                friend class TextureStreamer;
 
             public:
                 Texture();
                 ~Texture() = default;
 
+                Backend::ResourceHandle GetResource() const { return m_hResource; }
+                const TextureDesc&      GetDesc() const { return m_desc; }
+
+                // Tracked state lets defragmenter move texture, textures in undefined state are never moved
+                void                 SetState( const ResourceState& state ) { m_state = state; }
+                const ResourceState& GetState() const { return m_state; }
+
             protected:
                 RESULT Create( const TextureDesc& desc, RenderSystem* pSystem );
                 void   Destroy();
 
+                // Exchanges GPU objects, desc and state with other texture, bindless entries of both get new views once frames reading
+                // old ones are finished
+                void SwapResources( Texture* pOther );
+                void UpdateBindlessEntries();
+                void QueueBindlessRewrites();
+
             private:
                 TextureDesc                 m_desc;
+                ResourceState               m_state;
                 RenderSystem*               m_pParent;
-                Backend::MemoryHandle       m_hMemory;
+                DeviceMemoryAllocation      m_memory;
                 Backend::ResourceHandle     m_hResource;
                 Backend::ResourceViewHandle m_hSampleAccess;
                 Backend::ResourceViewHandle m_hStorageAccess;
+                BindlessEntryArray          m_bindlessEntries; // Survive Destroy(), so Create() rewrites them
             };
 
         } // namespace Frontend
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Core/Containers/Array.h"
+#include "Driver/Frontend/RenderSystemTypes.h"
+#include "Driver/Frontend/SyncSystem.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            // Streams mips of sampled textures within memory budget. Texture starts with its tail mips only and is replaced with a
+            // bigger one when its screen size asks for more detail, or with a smaller one when budget is needed for more important
+            // textures. Mips are read on streaming thread and uploaded to the new texture on copy context, the old one is never touched
+            // by copies, so frames can sample it until the swap. Resident texture starts at its most detailed mip, so sampling with
+            // normalized coordinates picks the same mips as full chain would and min LOD clamp is implicit. Shaders sampling with
+            // explicit LOD subtract GetResidentMip(). Mips are loaded tightly packed and copy context pads staged rows to the pitch
+            // alignment, which tail mips need too. Only uncompressed formats are supported.
+            class BGS_API TextureStreamer final
+            {
+                friend class RenderSystem;
+
+            public:
+                TextureStreamer();
+                ~TextureStreamer() = default;
+
+                // Texture can be used once IsReady() reports its tail mips were uploaded
+                RESULT AddTexture( const StreamingTextureDesc& desc, index_t* pIndex );
+                void   RemoveTexture( index_t ndx );
+
+                // Largest dimension of texture on screen in pixels, 0 when texture is not visible
+                void SetScreenSize( index_t ndx, float screenSize ) { m_textures[ ndx ].screenSize = screenSize; }
+
+                // Called once per frame before recording, point has to be signaled when GPU finishes work of that frame. Records
+                // graphics queue acquire of swapped textures, so pCmdBuffer must run on graphics queue before work sampling them
+                RESULT Update( const SyncPoint& framePoint, Backend::ICommandBuffer* pCmdBuffer );
+
+                bool_t                      IsReady( index_t ndx ) const { return m_textures[ ndx ].pTexture != nullptr; }
+                Backend::ResourceHandle     GetResource( index_t ndx ) const;
+                Backend::ResourceViewHandle GetSampledView( index_t ndx ) const;
+                uint32_t                    GetResidentMip( index_t ndx ) const { return m_textures[ ndx ].residentMip; }
+                // Object stays the same once texture is ready, so it can be registered in bindless table until RemoveTexture()
+                Texture* GetTexture( index_t ndx ) const { return m_textures[ ndx ].pTexture; }
+                uint64_t                    GetResidentSize() const { return m_residentSize; }
+                // Increased every time textures get new resources and views
+                uint32_t GetGeneration() const { return m_generation; }
+
+            protected:
+                RESULT Create( const TextureStreamerDesc& desc, RenderSystem* pSystem );
+                void   Destroy();
+
+            private:
+                enum class StreamingStates : uint8_t
+                {
+                    IDLE,
+                    LOADING,   // Mips are read on streaming thread
+                    UPLOADING, // New texture is filled on copy context
+                    ACQUIRING, // Graphics queue takes new texture in frame recorded by the last update
+                    RETIRING,  // New texture is in use, old one waits for frames still using it
+                };
+                using STREAMING_STATE = StreamingStates;
+
+                struct StreamingTexture
+                {
+                    StreamingTextureDesc desc;
+                    Texture*             pTexture;    // Its most detailed mip is residentMip of the whole chain
+                    Texture*             pNewTexture; // Being filled or retired
+                    SyncPoint            point;
+                    uint32_t             residentMip;
+                    uint32_t             targetMip;
+                    uint32_t             tailMip;
+                    uint32_t             serial; // Changed on removal, so late loads are dropped
+                    float                screenSize;
+                    STREAMING_STATE      state;
+                    bool_t               isUsed;
+                    bool_t               isFlushed; // Upload was submitted and point is valid
+                };
+
+                struct LoadRequest
+                {
+                    MipLoader   loader;
+                    TextureDesc textureDesc;
+                    index_t     ndx;
+                    uint32_t    serial;
+                    uint32_t    firstMip;
+                };
+
+                struct LoadResult
+                {
+                    HeapArray<byte_t> data; // Subresources one after another, layers of a mip together
+                    index_t           ndx;
+                    uint32_t          serial;
+                    RESULT            result;
+                };
+
+                using TextureArray     = Core::Containers::Array<StreamingTexture>;
+                using IndexArray       = Core::Containers::Array<index_t>;
+                using LoadRequestArray = HeapArray<LoadRequest>; // Shared with streaming thread
+                using LoadResultArray  = HeapArray<LoadResult>;
+
+                void   LoadMips();
+                void   RequestMips( index_t ndx, uint32_t targetMip );
+                RESULT UploadMips( index_t ndx, const LoadResult& result );
+                void   ShrinkUnwanted();
+                void   DestroyTexture( Texture** ppTexture );
+
+                uint32_t GetWantedMip( const StreamingTexture& texture ) const;
+                uint64_t GetUsedSize( const StreamingTexture& texture ) const;
+
+            private:
+                TextureStreamerDesc     m_desc;
+                RenderSystem*           m_pParent;
+                TextureArray            m_textures;
+                IndexArray              m_freeTextures;
+                IndexArray              m_candidates;
+                LoadRequestArray        m_requests;
+                LoadResultArray         m_results;
+                Mutex                   m_loadMutex;
+                std::condition_variable m_loadCondition;
+                std::thread             m_thread;
+                bool_t                  m_isStopping;
+                uint64_t                m_residentSize;
+                uint32_t                m_generation;
+            };
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Driver/Frontend/RenderSystemTypes.h"
+#include "Driver/Frontend/SyncSystem.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            // Shader visible binding heap handing out binding sets that live for one frame, like per-draw constant buffer views.
+            // Sets are allocated linearly and given back per frame, once sync point passed to EndFrame() is reached on the GPU.
+            // Bindings of a set are written at base offset plus binding offset from the layout, and set is bound with base offset.
+            // Not thread safe, use one heap per recording thread.
+            class BGS_API TransientBindingHeap final
+            {
+                friend class RenderSystem;
+
+            public:
+                TransientBindingHeap();
+                ~TransientBindingHeap() = default;
+
+                RESULT Allocate( Backend::BindingSetLayoutHandle hLayout, uint64_t* pBaseOffset );
+
+                // Closes frame, all sets allocated since previous call are recycled after point is signaled
+                RESULT EndFrame( const SyncPoint& point );
+
+                Backend::BindingHeapHandle GetBindingHeap() const { return m_hHeap; }
+                uint64_t                   GetSize() const { return m_size; }
+                uint64_t                   GetUsedSize() const { return m_head - m_tail; }
+
+            protected:
+                RESULT Create( const TransientBindingHeapDesc& desc, RenderSystem* pSystem );
+                void   Destroy();
+
+            private:
+                void   RetireCompletedFrames();
+                RESULT RetireOldestFrame();
+
+            private:
+                struct FrameMarker
+                {
+                    uint64_t  endPos;
+                    SyncPoint point;
+                };
+                using FrameMarkerArray = StackArray<FrameMarker, Config::Driver::Binding::MAX_TRANSIENT_BINDING_FRAME_COUNT>;
+
+            private:
+                TransientBindingHeapDesc   m_desc;
+                RenderSystem*              m_pParent;
+                Backend::BindingHeapHandle m_hHeap;
+                uint64_t                   m_size; // Bytes
+                uint64_t                   m_alignment;
+                uint64_t                   m_head; // Positions grow monotonically, offset is position % size
+                uint64_t                   m_tail;
+                FrameMarkerArray           m_frames;
+                uint32_t                   m_firstFrame;
+                uint32_t                   m_frameCount;
+            };
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Core/Containers/Array.h"
+#include "Core/Memory/LinearAllocator.h"
+#include "Driver/Frontend/DeviceMemorySystem.h"
+#include "Driver/Frontend/RenderSystemTypes.h"
+#include "Driver/Frontend/ResourceState.h"
+#include "Driver/Frontend/SyncSystem.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            // Places textures used only within a frame (post processing chains, intermediate targets) in shared memory. Textures whose
+            // pass ranges do not overlap get the same memory, so heap size is the peak of live textures, not their sum. Textures are
+            // declared with AddTexture() and placed with Compile(), then stay valid until Reset() (e.g. on resize), which waits for
+            // the last frame using them.
+            class BGS_API TransientResourcePool final
+            {
+                friend class RenderSystem;
+
+            public:
+                TransientResourcePool();
+                ~TransientResourcePool() = default;
+
+                RESULT AddTexture( const TransientTextureDesc& desc, index_t* pIndex );
+                RESULT Compile();
+                RESULT Reset( const SyncPoint& lastUsePoint );
+
+                Backend::ResourceHandle     GetResource( index_t ndx ) const { return m_textures[ ndx ].hResource; }
+                const TransientTextureDesc& GetDesc( index_t ndx ) const { return m_textures[ ndx ].desc; }
+                index_t                     GetTextureCount() const { return m_textures.size(); }
+
+                // Range of texture in the heap of its heap usage, valid after Compile()
+                Backend::MEMORY_HEAP_USAGE GetHeapUsage( index_t ndx ) const { return m_textures[ ndx ].heapUsage; }
+                uint64_t                   GetOffset( index_t ndx ) const { return m_textures[ ndx ].offset; }
+                uint64_t                   GetSize( index_t ndx ) const { return m_textures[ ndx ].size; }
+
+                // Memory of a texture holds garbage left by textures aliasing it, so first access in every frame has to go through
+                // this barrier. It waits for aliasing textures and discards old content
+                void GetAliasingBarrier( index_t ndx, const ResourceState& dstState, Backend::TextureBarrierDesc* pBarrier ) const;
+
+                uint64_t GetHeapSize() const { return m_heapSize; }
+                uint64_t GetUnaliasedSize() const { return m_unaliasedSize; } // Memory textures would take placed one after another
+
+            protected:
+                RESULT Create( const TransientResourcePoolDesc& desc, RenderSystem* pSystem );
+                void   Destroy();
+
+            private:
+                struct TransientTexture
+                {
+                    TransientTextureDesc        desc;
+                    Backend::ResourceHandle     hResource;
+                    Backend::MEMORY_HEAP_USAGE  heapUsage;
+                    uint64_t                    size;
+                    uint64_t                    alignment;
+                    uint64_t                    offset;
+                    Backend::PipelineStageFlags aliasedStages; // Stages in which other textures sharing memory are used
+                    Backend::AccessFlags        aliasedWrites; // Writes of those textures
+                };
+
+                using TextureArray      = Core::Containers::Array<TransientTexture>;
+                using ScratchIndexArray = Core::Containers::Array<index_t, Memory::LinearAllocator>;
+
+                RESULT   AllocateHeaps( Memory::LinearAllocator* pScratchAllocator );
+                uint64_t PlaceTexture( index_t ndx, const ScratchIndexArray& placed );
+                void     Release();
+
+            private:
+                TransientResourcePoolDesc m_desc;
+                RenderSystem*             m_pParent;
+                TextureArray              m_textures;
+                DeviceMemoryAllocation    m_memory[ BGS_ENUM_COUNT( Backend::MemoryHeapUsages ) ];
+                uint64_t                  m_heapSize;
+                uint64_t                  m_unaliasedSize;
+                bool_t                    m_compiled;
+            };
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
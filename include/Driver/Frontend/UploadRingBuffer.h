@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Driver/Frontend/DeviceMemorySystem.h"
+#include "Driver/Frontend/RenderSystemTypes.h"
+#include "Driver/Frontend/SyncSystem.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            struct UploadAllocation
+            {
+                Backend::ResourceHandle hResource;
+                void*                   pHost;
+                uint64_t                offset;
+                uint64_t                size;
+            };
+
+            // Persistently mapped upload buffer handing out linear sub-allocations for per-draw constants and dynamic geometry.
+            // Space is given back per frame, once sync point passed to EndFrame() is reached on the GPU. Call Flush() before submitting
+            // work that reads the allocations. Not thread safe, use one ring per recording thread.
+            class BGS_API UploadRingBuffer final
+            {
+                friend class RenderSystem;
+
+            public:
+                UploadRingBuffer();
+                ~UploadRingBuffer() = default;
+
+                RESULT Allocate( uint64_t size, uint64_t alignment, UploadAllocation* pAllocation );
+                RESULT AllocateConstants( uint64_t size, UploadAllocation* pAllocation )
+                {
+                    return Allocate( size, Config::Driver::Memory::CONSTANT_BUFFER_ALIGNMENT, pAllocation );
+                }
+                // Allocates and copies data in with streaming stores, ring memory is write combined
+                RESULT Upload( const void* pData, uint64_t size, uint64_t alignment, UploadAllocation* pAllocation );
+
+                // Makes host writes to allocations made since previous call visible to the GPU. No-op in coherent memory
+                RESULT Flush();
+                // Closes frame, all allocations made since previous call are recycled after point is signaled
+                RESULT EndFrame( const SyncPoint& point );
+
+                Backend::ResourceHandle GetResource() const { return m_hResource; }
+                uint64_t                GetSize() const { return m_desc.size; }
+                uint64_t                GetUsedSize() const { return m_head - m_tail; }
+
+            protected:
+                RESULT Create( const UploadRingBufferDesc& desc, RenderSystem* pSystem );
+                void   Destroy();
+
+            private:
+                void   RetireCompletedFrames();
+                RESULT RetireOldestFrame();
+                RESULT FlushRange( uint64_t offset, uint64_t size );
+
+            private:
+                struct FrameMarker
+                {
+                    uint64_t  endPos;
+                    SyncPoint point;
+                };
+                using FrameMarkerArray = StackArray<FrameMarker, Config::Driver::Memory::MAX_UPLOAD_RING_FRAME_COUNT>;
+
+            private:
+                UploadRingBufferDesc    m_desc;
+                RenderSystem*           m_pParent;
+                DeviceMemoryAllocation  m_memory;
+                Backend::ResourceHandle m_hResource;
+                byte_t*                 m_pHost;
+                uint64_t                m_head; // Positions grow monotonically, offset is position % size
+                uint64_t                m_tail;
+                uint64_t                m_flushedPos;
+                FrameMarkerArray        m_frames;
+                uint32_t                m_firstFrame;
+                uint32_t                m_frameCount;
+            };
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
\ No newline at end of file
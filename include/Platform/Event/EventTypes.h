@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Core/Containers/Array.h"
 #include "Core/CoreTypes.h"
 
 #if defined MOUSE_MOVED
@@ -16,7 +17,7 @@ namespace BIGOS
             class IEventHandlerWraper;
             class EventSystem;
             using EventQueue        = HeapArray<UniquePtr<IEvent>>;
-            using EventHandlerArray = HeapArray<IEventHandlerWraper*>;
+            using EventHandlerArray = Core::Containers::SmallArray<IEventHandlerWraper*, 16>;
 
             template<typename EventType>
             using EventHandler = std::function<void( const EventType& e )>;
@@ -7,6 +7,28 @@
 
 namespace BIGOS
 {
+    // Caches are kept per user and application, working directory can be read only or shared by many applications
+    static String GetUserCacheDirectory( const char* pAppName )
+    {
+#if( BGS_WINDOWS )
+        char*  pLocalAppData = nullptr;
+        size_t size          = 0;
+        if( ( _dupenv_s( &pLocalAppData, &size, "LOCALAPPDATA" ) != 0 ) || ( pLocalAppData == nullptr ) )
+        {
+            return String();
+        }
+        const String directory = String( pLocalAppData ) + "\\BIGOS\\" + pAppName;
+        free( pLocalAppData );
+
+        std::error_code error;
+        std::filesystem::create_directories( directory, error );
+
+        return error ? String() : directory;
+#else
+#    error
+#endif // ( BGS_WINDOWS )
+    }
+
     RESULT IApplication::Create()
     {
         g_pEngine = new BigosEngine();
@@ -36,6 +58,8 @@ namespace BIGOS
         , m_windowResizeHandler( [ this ]( const Platform::Event::WindowResizeEvent& e ) { OnWindowResize( e ); } )
         , m_lastFrameTime( 0.0f )
         , m_renderer()
+        , m_shaderCachePath()
+        , m_pipelineCachePath()
     {
     }
 
@@ -45,15 +69,25 @@ namespace BIGOS
 
     RESULT WindowedApplication::Create()
     {
+        const String cacheDirectory = GetUserCacheDirectory( m_pName );
+        if( !cacheDirectory.empty() )
+        {
+            m_shaderCachePath   = cacheDirectory + "\\ShaderCache";
+            m_pipelineCachePath = cacheDirectory +
+                                  ( m_apiType == BIGOS::Driver::Backend::APITypes::D3D12 ? "\\PipelineCacheD3D12.bin" : "\\PipelineCacheVulkan.bin" );
+        }
+
         BigosEngineDesc frameworkDesc;
+        frameworkDesc.renderSystemDesc.compilerFactoryDesc.pShaderCachePath = m_shaderCachePath.empty() ? nullptr : m_shaderCachePath.c_str();
         if( BGS_FAILED( CreateBigosEngine( frameworkDesc, &g_pEngine ) ) )
         {
             return Results::FAIL;
         }
 
         BIGOS::Driver::Frontend::DriverDesc driverDesc;
-        driverDesc.apiType = m_apiType;
-        driverDesc.debug   = true;
+        driverDesc.apiType            = m_apiType;
+        driverDesc.debug              = true;
+        driverDesc.pPipelineCachePath = m_pipelineCachePath.empty() ? nullptr : m_pipelineCachePath.c_str();
         if( BGS_FAILED( g_pEngine->GetRenderSystem().InitializeDriver( driverDesc ) ) )
         {
             return Results::FAIL;
@@ -109,6 +143,8 @@ namespace BIGOS
             Core::Utils::Timestep ts   = time - m_lastFrameTime;
             m_lastFrameTime            = time;
 
+            g_pEngine->GetMemorySystem().NewFrame();
+
             // Application updates
             m_pWindow->Update();
             OnUpdate( ts );
@@ -1,5 +1,7 @@
 #include "BIGOS/BigosEngine.h"
 
+#include "BIGOS/Config.h"
+
 namespace BIGOS
 {
 
@@ -9,6 +11,7 @@ namespace BIGOS
         , m_windowSystem()
         , m_inputSystem()
         , m_eventSystem()
+        , m_pRenderSystemAllocator( nullptr )
     {
     }
 
@@ -30,7 +33,15 @@ namespace BIGOS
             Destroy();
             return Results::FAIL;
         }
-        if( BGS_FAILED( m_renderSystem.Create( desc.renderSystemDesc, m_memorySystem.GetSystemHeapAllocator(), this ) ) )
+        Core::Memory::AllocatorDesc renderAllocatorDesc;
+        renderAllocatorDesc.type     = Core::Memory::AllocatorTypes::TLSF;
+        renderAllocatorDesc.capacity = Config::Core::Memory::RENDER_SYSTEM_HEAP_SIZE;
+        if( BGS_FAILED( m_memorySystem.CreateAllocator( renderAllocatorDesc, &m_pRenderSystemAllocator ) ) )
+        {
+            Destroy();
+            return Results::FAIL;
+        }
+        if( BGS_FAILED( m_renderSystem.Create( desc.renderSystemDesc, m_pRenderSystemAllocator, this ) ) )
         {
             Destroy();
             return Results::FAIL;
@@ -47,6 +58,10 @@ namespace BIGOS
     void BigosEngine::Destroy()
     {
         m_renderSystem.Destroy();
+        if( m_pRenderSystemAllocator != nullptr )
+        {
+            m_memorySystem.DestroyAllocator( &m_pRenderSystemAllocator );
+        }
         m_windowSystem.Destroy();
         m_inputSystem.Destroy();
         m_eventSystem.Destroy();
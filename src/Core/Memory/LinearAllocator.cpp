@@ -0,0 +1,98 @@
+#include "Core/Memory/LinearAllocator.h"
+
+#include "Core/Memory/IAllocator.h"
+#include "Core/Memory/MemorySystem.h"
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            LinearAllocator::LinearAllocator()
+                : m_pMemory( nullptr )
+                , m_capacity( 0 )
+                , m_offset( 0 )
+                , m_peakOffset( 0 )
+                , m_pParent( nullptr )
+            {
+            }
+
+            RESULT LinearAllocator::Allocate( size_t size, void** ppMemory, const char* pFile, uint32_t line )
+            {
+                pFile;
+                line;
+
+                return AllocateBlock( size, LINEAR_ALLOCATOR_MIN_ALIGNMENT, ppMemory );
+            }
+
+            RESULT LinearAllocator::AllocateAligned( size_t size, size_t alignment, void** ppMemory, const char* pFile, uint32_t line )
+            {
+                pFile;
+                line;
+
+                return AllocateBlock( size, alignment, ppMemory );
+            }
+
+            void LinearAllocator::Free( void** ppMemory ) { FreeBlock( ppMemory ); }
+
+            void LinearAllocator::FreeAligned( void** ppMemory ) { FreeBlock( ppMemory ); }
+
+            void LinearAllocator::FreeToMarker( LinearAllocatorMarker marker )
+            {
+                BGS_ASSERT( marker <= m_offset, "Marker (marker) must be taken before any allocation it should release." );
+
+                if( marker <= m_offset )
+                {
+                    m_telemetry.OnReleaseExclusive( m_offset - marker );
+                    m_offset = marker;
+                }
+            }
+
+            void LinearAllocator::Reset()
+            {
+                m_telemetry.OnReleaseExclusive( m_offset );
+                m_offset = 0;
+            }
+
+            RESULT LinearAllocator::Create( const AllocatorDesc& desc )
+            {
+                BGS_ASSERT( desc.pParent != nullptr, "Invalid parent (pParent)." );
+                BGS_ASSERT( desc.type == AllocatorTypes::LINEAR );
+                BGS_ASSERT( desc.capacity > 0, "Capacity (capacity) must be greater than 0." );
+                if( ( desc.pParent == nullptr ) || ( desc.capacity == 0 ) )
+                {
+                    return Results::FAIL;
+                }
+                m_pParent = desc.pParent;
+
+                void* pMemory = nullptr;
+                if( BGS_FAILED( m_pParent->GetSystemHeapAllocator()->AllocateAligned( desc.capacity, LINEAR_ALLOCATOR_MIN_ALIGNMENT, &pMemory,
+                                                                                      BGS_MEMORY_CALLSITE ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                m_pMemory    = static_cast<byte_t*>( pMemory );
+                m_capacity   = desc.capacity;
+                m_offset     = 0;
+                m_peakOffset = 0;
+
+                return Results::OK;
+            }
+
+            void LinearAllocator::Destroy()
+            {
+                if( m_pMemory != nullptr )
+                {
+                    Core::Memory::FreeAligned( m_pParent->GetSystemHeapAllocator(), &m_pMemory );
+                }
+                m_capacity   = 0;
+                m_offset     = 0;
+                m_peakOffset = 0;
+                m_pParent    = nullptr;
+            }
+
+        } // namespace Memory
+    }     // namespace Core
+} // namespace BIGOS
@@ -0,0 +1,189 @@
+#include "Core/Memory/Memory.h"
+
+#if( BGS_VISUAL_STUDIO )
+#    include <immintrin.h>
+#    include <intrin.h>
+#endif // ( BGS_VISUAL_STUDIO )
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            // Below that size alignment head, tail and store fence cost more than cache pollution they save
+            static constexpr size_t STREAMING_MIN_SIZE = 256;
+
+            using StreamCopyFunc = void ( * )( byte_t* pDst, const byte_t* pSrc, size_t size );
+            using StreamSetFunc  = void ( * )( byte_t* pDst, int32_t val, size_t size );
+
+            struct StreamKernels
+            {
+                StreamCopyFunc pCopy;
+                StreamSetFunc  pSet;
+            };
+
+#if defined( _M_X64 )
+
+            static void StreamCopySSE2( byte_t* pDst, const byte_t* pSrc, size_t size )
+            {
+                // Regular copy of the head, so that streaming stores are aligned
+                const size_t head = ( 16 - ( reinterpret_cast<uintptr_t>( pDst ) & 15 ) ) & 15;
+                memcpy( pDst, pSrc, head );
+                pDst += head;
+                pSrc += head;
+                size -= head;
+
+                for( ; size >= 64; size -= 64, pDst += 64, pSrc += 64 )
+                {
+                    const __m128i val0 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( pSrc ) );
+                    const __m128i val1 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( pSrc + 16 ) );
+                    const __m128i val2 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( pSrc + 32 ) );
+                    const __m128i val3 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( pSrc + 48 ) );
+                    _mm_stream_si128( reinterpret_cast<__m128i*>( pDst ), val0 );
+                    _mm_stream_si128( reinterpret_cast<__m128i*>( pDst + 16 ), val1 );
+                    _mm_stream_si128( reinterpret_cast<__m128i*>( pDst + 32 ), val2 );
+                    _mm_stream_si128( reinterpret_cast<__m128i*>( pDst + 48 ), val3 );
+                }
+                memcpy( pDst, pSrc, size );
+
+                // Streaming stores are weakly ordered, make them visible before anything signals that data is ready
+                _mm_sfence();
+            }
+
+            static void StreamSetSSE2( byte_t* pDst, int32_t val, size_t size )
+            {
+                const size_t head = ( 16 - ( reinterpret_cast<uintptr_t>( pDst ) & 15 ) ) & 15;
+                memset( pDst, val, head );
+                pDst += head;
+                size -= head;
+
+                const __m128i fill = _mm_set1_epi8( static_cast<char>( val ) );
+                for( ; size >= 64; size -= 64, pDst += 64 )
+                {
+                    _mm_stream_si128( reinterpret_cast<__m128i*>( pDst ), fill );
+                    _mm_stream_si128( reinterpret_cast<__m128i*>( pDst + 16 ), fill );
+                    _mm_stream_si128( reinterpret_cast<__m128i*>( pDst + 32 ), fill );
+                    _mm_stream_si128( reinterpret_cast<__m128i*>( pDst + 48 ), fill );
+                }
+                memset( pDst, val, size );
+
+                _mm_sfence();
+            }
+
+            static void StreamCopyAVX( byte_t* pDst, const byte_t* pSrc, size_t size )
+            {
+                const size_t head = ( 32 - ( reinterpret_cast<uintptr_t>( pDst ) & 31 ) ) & 31;
+                memcpy( pDst, pSrc, head );
+                pDst += head;
+                pSrc += head;
+                size -= head;
+
+                for( ; size >= 128; size -= 128, pDst += 128, pSrc += 128 )
+                {
+                    const __m256i val0 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( pSrc ) );
+                    const __m256i val1 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( pSrc + 32 ) );
+                    const __m256i val2 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( pSrc + 64 ) );
+                    const __m256i val3 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( pSrc + 96 ) );
+                    _mm256_stream_si256( reinterpret_cast<__m256i*>( pDst ), val0 );
+                    _mm256_stream_si256( reinterpret_cast<__m256i*>( pDst + 32 ), val1 );
+                    _mm256_stream_si256( reinterpret_cast<__m256i*>( pDst + 64 ), val2 );
+                    _mm256_stream_si256( reinterpret_cast<__m256i*>( pDst + 96 ), val3 );
+                }
+                memcpy( pDst, pSrc, size );
+
+                _mm_sfence();
+            }
+
+            static void StreamSetAVX( byte_t* pDst, int32_t val, size_t size )
+            {
+                const size_t head = ( 32 - ( reinterpret_cast<uintptr_t>( pDst ) & 31 ) ) & 31;
+                memset( pDst, val, head );
+                pDst += head;
+                size -= head;
+
+                const __m256i fill = _mm256_set1_epi8( static_cast<char>( val ) );
+                for( ; size >= 128; size -= 128, pDst += 128 )
+                {
+                    _mm256_stream_si256( reinterpret_cast<__m256i*>( pDst ), fill );
+                    _mm256_stream_si256( reinterpret_cast<__m256i*>( pDst + 32 ), fill );
+                    _mm256_stream_si256( reinterpret_cast<__m256i*>( pDst + 64 ), fill );
+                    _mm256_stream_si256( reinterpret_cast<__m256i*>( pDst + 96 ), fill );
+                }
+                memset( pDst, val, size );
+
+                _mm_sfence();
+            }
+
+            // 256 bit kernels need CPU support and OS that saves YMM registers on context switch
+            static bool_t IsAVXSupported()
+            {
+                int32_t cpuInfo[ 4 ];
+                __cpuid( cpuInfo, 1 );
+                const bool_t hasOSXSave = ( cpuInfo[ 2 ] & ( 1 << 27 ) ) != 0;
+                const bool_t hasAVX     = ( cpuInfo[ 2 ] & ( 1 << 28 ) ) != 0;
+                if( !hasOSXSave || !hasAVX )
+                {
+                    return BGS_FALSE;
+                }
+
+                return ( _xgetbv( 0 ) & 0x6 ) == 0x6 ? BGS_TRUE : BGS_FALSE;
+            }
+
+            static StreamKernels SelectStreamKernels()
+            {
+                if( IsAVXSupported() )
+                {
+                    return { StreamCopyAVX, StreamSetAVX };
+                }
+
+                // SSE2 is part of x64 baseline
+                return { StreamCopySSE2, StreamSetSSE2 };
+            }
+
+#else
+
+            static void StreamCopyGeneric( byte_t* pDst, const byte_t* pSrc, size_t size ) { memcpy( pDst, pSrc, size ); }
+            static void StreamSetGeneric( byte_t* pDst, int32_t val, size_t size ) { memset( pDst, val, size ); }
+
+            static StreamKernels SelectStreamKernels() { return { StreamCopyGeneric, StreamSetGeneric }; }
+
+#endif // defined( _M_X64 )
+
+            static const StreamKernels& GetStreamKernels()
+            {
+                static const StreamKernels kernels = SelectStreamKernels();
+                return kernels;
+            }
+
+            void StreamCopy( const void* pSrc, size_t srcSize, void* pDst, size_t dstSize )
+            {
+                BGS_ASSERT( pSrc != nullptr, "Memory block (pSrc) must be valid pointer." );
+                BGS_ASSERT( pDst != nullptr, "Memory block (pDst) must be valid pointer." );
+                BGS_ASSERT( srcSize <= dstSize, "Destination block (pDst) is too small." );
+
+                const size_t size = srcSize < dstSize ? srcSize : dstSize;
+                if( size < STREAMING_MIN_SIZE )
+                {
+                    memcpy( pDst, pSrc, size );
+                    return;
+                }
+
+                GetStreamKernels().pCopy( static_cast<byte_t*>( pDst ), static_cast<const byte_t*>( pSrc ), size );
+            }
+
+            void StreamSet( void* pDst, int32_t val, size_t size )
+            {
+                BGS_ASSERT( pDst != nullptr, "Memory block (pDst) must be valid pointer." );
+
+                if( size < STREAMING_MIN_SIZE )
+                {
+                    memset( pDst, val, size );
+                    return;
+                }
+
+                GetStreamKernels().pSet( static_cast<byte_t*>( pDst ), val, size );
+            }
+        } // namespace Memory
+    }     // namespace Core
+} // namespace BIGOS
@@ -1,35 +1,340 @@
 #include "Core/Memory/MemorySystem.h"
 
+#include "Core/CoreConfig.h"
+
 namespace BIGOS
 {
     namespace Core
     {
         namespace Memory
         {
+#if( BGS_MEMORY_DEBUG )
+            static constexpr uint32_t MEMORY_TRACKER_BLOCK_STRIPE_COUNT_LOG2 = 6;
+            static constexpr uint32_t MEMORY_TRACKER_BLOCK_STRIPE_COUNT      = 1u << MEMORY_TRACKER_BLOCK_STRIPE_COUNT_LOG2;
+            static constexpr uint32_t MEMORY_TRACKER_CALLSITE_STRIPE_COUNT   = 16;
+            static constexpr uint32_t MEMORY_TRACKER_CALLSITE_STRIPE_SIZE    = 256;
+            static constexpr uint64_t MEMORY_TRACKER_HASH_MULTIPLIER         = 0x9E3779B97F4A7C15ull;
+
+            // Callsites are keyed by pFile pointer and line, counters are updated without taking the stripe lock
+            struct MemoryCallsiteEntry
+            {
+                const char*      pFile;
+                uint32_t         line;
+                bool_t           isUsed;
+                Atomic<uint64_t> liveSize;
+                Atomic<uint64_t> liveCount;
+                Atomic<uint64_t> allocationCount;
+            };
+
+            struct BGS_ALIGN( 64 ) MemoryBlockStripe
+            {
+                Mutex            mutex;
+                MemoryBlockInfo* pHead;
+                uint64_t         blockCount;
+            };
+
+            struct BGS_ALIGN( 64 ) MemoryCallsiteStripe
+            {
+                Mutex               mutex;
+                MemoryCallsiteEntry entries[ MEMORY_TRACKER_CALLSITE_STRIPE_SIZE ];
+            };
+
+            // Live blocks are linked through their MemoryBlockInfo headers into one of the stripes picked by block address,
+            // so register and deregister only lock one stripe and never search.
+            struct MemoryTracker
+            {
+                MemoryBlockStripe    blockStripes[ MEMORY_TRACKER_BLOCK_STRIPE_COUNT ];
+                MemoryCallsiteStripe callsiteStripes[ MEMORY_TRACKER_CALLSITE_STRIPE_COUNT ];
+                MemoryCallsiteEntry  overflowCallsite; // Shared by callsites that do not fit into their stripe
+            };
+
+            static BGS_FORCEINLINE uint32_t GetBlockStripeNdx( const MemoryBlockInfo* pDebugInfo )
+            {
+                const uint64_t hash = static_cast<uint64_t>( reinterpret_cast<uintptr_t>( pDebugInfo ) ) * MEMORY_TRACKER_HASH_MULTIPLIER;
+
+                return static_cast<uint32_t>( hash >> ( 64 - MEMORY_TRACKER_BLOCK_STRIPE_COUNT_LOG2 ) );
+            }
+
+            static MemoryCallsiteEntry* FindCallsite( MemoryTracker* pTracker, const char* pFile, uint32_t line )
+            {
+                const uint64_t hash = ( static_cast<uint64_t>( reinterpret_cast<uintptr_t>( pFile ) ) ^ line ) * MEMORY_TRACKER_HASH_MULTIPLIER;
+
+                MemoryCallsiteStripe&  stripe = pTracker->callsiteStripes[ ( hash >> 32 ) % MEMORY_TRACKER_CALLSITE_STRIPE_COUNT ];
+                std::lock_guard<Mutex> lock( stripe.mutex );
+
+                const uint32_t startNdx = static_cast<uint32_t>( hash >> 40 ) % MEMORY_TRACKER_CALLSITE_STRIPE_SIZE;
+                for( uint32_t ndx = 0; ndx < MEMORY_TRACKER_CALLSITE_STRIPE_SIZE; ++ndx )
+                {
+                    MemoryCallsiteEntry& entry = stripe.entries[ ( startNdx + ndx ) % MEMORY_TRACKER_CALLSITE_STRIPE_SIZE ];
+                    if( !entry.isUsed )
+                    {
+                        entry.pFile  = pFile;
+                        entry.line   = line;
+                        entry.isUsed = BGS_TRUE;
+
+                        return &entry;
+                    }
+                    if( ( entry.pFile == pFile ) && ( entry.line == line ) )
+                    {
+                        return &entry;
+                    }
+                }
+
+                return &pTracker->overflowCallsite;
+            }
+
+            static void InsertSorted( const MemoryCallsiteEntry& entry, MemoryCallsiteInfo* pInfos, uint32_t maxCount, uint32_t* pCount )
+            {
+                MemoryCallsiteInfo info;
+                info.pFile           = entry.pFile;
+                info.line            = entry.line;
+                info.liveSize        = entry.liveSize.load( std::memory_order_relaxed );
+                info.liveCount       = entry.liveCount.load( std::memory_order_relaxed );
+                info.allocationCount = entry.allocationCount.load( std::memory_order_relaxed );
+                if( info.liveCount == 0 )
+                {
+                    return;
+                }
+
+                uint32_t pos = *pCount;
+                if( pos < maxCount )
+                {
+                    ++( *pCount );
+                }
+                else if( info.liveSize > pInfos[ maxCount - 1 ].liveSize )
+                {
+                    pos = maxCount - 1;
+                }
+                else
+                {
+                    return;
+                }
+
+                for( ; ( pos > 0 ) && ( pInfos[ pos - 1 ].liveSize < info.liveSize ); --pos )
+                {
+                    pInfos[ pos ] = pInfos[ pos - 1 ];
+                }
+                pInfos[ pos ] = info;
+            }
+#endif // ( BGS_MEMORY_DEBUG )
+
+            struct ScratchAllocatorSlot
+            {
+                uint64_t         generation;
+                LinearAllocator* pAllocator;
+            };
+
+            // Allocators of threads that exited are kept until memory system is destroyed
+            static thread_local ScratchAllocatorSlot s_scratchAllocatorSlot = { 0, nullptr };
+            static Atomic<uint64_t>                  s_memorySystemGeneration( 0 );
+
             MemorySystem::MemorySystem()
                 : m_desc()
                 , m_allocators()
                 , m_systemHeapAllocator()
+                , m_pFrameAllocator( nullptr )
+                , m_allocatorMutex()
+                , m_generation( 0 )
+                , m_lastMemoryInfo()
+                , m_frameMemoryInfo()
 #if( BGS_MEMORY_DEBUG )
-                , m_memoryBlockInfos()
+                , m_pTracker( nullptr )
 #endif // ( BGS_MEMORY_DEBUG )
                 , m_pParent( nullptr )
             {
             }
+
+            RESULT MemorySystem::CreateAllocator( const AllocatorDesc& desc, IAllocator** ppAllocator )
+            {
+                BGS_ASSERT( ( ppAllocator != nullptr ) && ( *ppAllocator == nullptr ), "Allocator (ppAllocator) must be a valid address." );
+                if( ( ppAllocator == nullptr ) || ( *ppAllocator != nullptr ) )
+                {
+                    return Results::FAIL;
+                }
+
+                AllocatorDesc allocatorDesc = desc;
+                allocatorDesc.pParent       = this;
+
+                IAllocator* pAllocator = nullptr;
+                switch( desc.type )
+                {
+                    case AllocatorTypes::LINEAR:
+                    {
+                        LinearAllocator* pLinearAllocator = nullptr;
+                        if( BGS_FAILED( BGS_ALLOCATE_OBJECT( &m_systemHeapAllocator, &pLinearAllocator ) ) )
+                        {
+                            return Results::NO_MEMORY;
+                        }
+                        pAllocator = pLinearAllocator;
+                        break;
+                    }
+                    case AllocatorTypes::POOL:
+                    {
+                        PoolAllocator* pPoolAllocator = nullptr;
+                        if( BGS_FAILED( BGS_ALLOCATE_OBJECT( &m_systemHeapAllocator, &pPoolAllocator ) ) )
+                        {
+                            return Results::NO_MEMORY;
+                        }
+                        pAllocator = pPoolAllocator;
+                        break;
+                    }
+                    case AllocatorTypes::TLSF:
+                    {
+                        TlsfAllocator* pTlsfAllocator = nullptr;
+                        if( BGS_FAILED( BGS_ALLOCATE_OBJECT( &m_systemHeapAllocator, &pTlsfAllocator ) ) )
+                        {
+                            return Results::NO_MEMORY;
+                        }
+                        pAllocator = pTlsfAllocator;
+                        break;
+                    }
+                    default:
+                    {
+                        BGS_ASSERT( false, "Allocator type (desc.type) can not be created by the memory system." );
+                        return Results::FAIL;
+                    }
+                }
+
+                if( BGS_FAILED( pAllocator->Create( allocatorDesc ) ) )
+                {
+                    Memory::FreeObject( &m_systemHeapAllocator, &pAllocator );
+                    return Results::FAIL;
+                }
+
+                {
+                    std::lock_guard<Mutex> lock( m_allocatorMutex );
+                    m_allocators.push_back( pAllocator );
+                }
+                *ppAllocator = pAllocator;
+
+                return Results::OK;
+            }
+
+            void MemorySystem::DestroyAllocator( IAllocator** ppAllocator )
+            {
+                BGS_ASSERT( ( ppAllocator != nullptr ) && ( *ppAllocator != nullptr ), "Allocator (ppAllocator) must be a valid address." );
+                if( ( ppAllocator != nullptr ) && ( *ppAllocator != nullptr ) )
+                {
+                    {
+                        std::lock_guard<Mutex> lock( m_allocatorMutex );
+                        for( index_t ndx = 0; ndx < m_allocators.size(); ++ndx )
+                        {
+                            if( m_allocators[ ndx ] == *ppAllocator )
+                            {
+                                m_allocators[ ndx ] = m_allocators.back();
+                                m_allocators.pop_back();
+
+                                break;
+                            }
+                        }
+                    }
+
+                    ( *ppAllocator )->Destroy();
+                    Memory::FreeObject( &m_systemHeapAllocator, ppAllocator );
+                }
+            }
+
+            LinearAllocator* MemorySystem::GetThreadScratchAllocator()
+            {
+                ScratchAllocatorSlot& slot = s_scratchAllocatorSlot;
+                if( slot.generation == m_generation )
+                {
+                    return slot.pAllocator;
+                }
+
+                AllocatorDesc scratchAllocatorDesc;
+                scratchAllocatorDesc.type     = AllocatorTypes::LINEAR;
+                scratchAllocatorDesc.capacity = static_cast<size_t>( Config::Core::Memory::SCRATCH_ALLOCATOR_SIZE );
+                scratchAllocatorDesc.pParent  = this;
+
+                IAllocator* pScratchAllocator = nullptr;
+                if( BGS_FAILED( CreateAllocator( scratchAllocatorDesc, &pScratchAllocator ) ) )
+                {
+                    return nullptr;
+                }
+                slot.generation = m_generation;
+                slot.pAllocator = static_cast<LinearAllocator*>( pScratchAllocator );
+
+                return slot.pAllocator;
+            }
+
+            void MemorySystem::NewFrame()
+            {
+                BGS_ASSERT( m_pFrameAllocator != nullptr );
+
+                m_pFrameAllocator->Reset();
+
+                MemoryInfo currInfo;
+                GetMemoryInfo( &currInfo );
+                m_frameMemoryInfo.usage           = currInfo.usage;
+                m_frameMemoryInfo.peakUsage       = currInfo.peakUsage;
+                m_frameMemoryInfo.allocatedSize   = currInfo.allocatedSize - m_lastMemoryInfo.allocatedSize;
+                m_frameMemoryInfo.allocationCount = currInfo.allocationCount - m_lastMemoryInfo.allocationCount;
+                m_frameMemoryInfo.freeCount       = currInfo.freeCount - m_lastMemoryInfo.freeCount;
+                m_lastMemoryInfo                  = currInfo;
+            }
+
+            uint32_t MemorySystem::GetAllocatorMemoryInfo( AllocatorMemoryInfo* pInfos, uint32_t maxCount ) const
+            {
+                BGS_ASSERT( ( pInfos != nullptr ) || ( maxCount == 0 ), "Allocator infos (pInfos) must be a valid address." );
+                if( ( pInfos == nullptr ) || ( maxCount == 0 ) )
+                {
+                    return 0;
+                }
+
+                pInfos[ 0 ].pAllocator = &m_systemHeapAllocator;
+                m_systemHeapAllocator.GetMemoryInfo( &pInfos[ 0 ].info );
+
+                std::lock_guard<Mutex> lock( m_allocatorMutex );
+                uint32_t               count = 1;
+                for( index_t ndx = 0; ( ndx < m_allocators.size() ) && ( count < maxCount ); ++ndx, ++count )
+                {
+                    pInfos[ count ].pAllocator = m_allocators[ ndx ];
+                    m_allocators[ ndx ]->GetMemoryInfo( &pInfos[ count ].info );
+                }
+
+                return count;
+            }
+
             RESULT MemorySystem::Create( const MemorySystemDesc& desc, BigosEngine* pEngine )
             {
-                m_desc    = desc;
-                m_pParent = pEngine;
+                m_desc       = desc;
+                m_pParent    = pEngine;
+                m_generation = s_memorySystemGeneration.fetch_add( 1, std::memory_order_relaxed ) + 1;
+
+#if( BGS_MEMORY_DEBUG )
+                // Tracker memory is not tracked itself, so it comes straight from the CRT heap
+                void* pTrackerMemory = Memory::MallocAligned( sizeof( MemoryTracker ), alignof( MemoryTracker ) );
+                if( pTrackerMemory == nullptr )
+                {
+                    return Results::NO_MEMORY;
+                }
+                m_pTracker = Memory::CreateObject<MemoryTracker>( pTrackerMemory );
+#endif // ( BGS_MEMORY_DEBUG )
 
                 AllocatorDesc heapAllocatorDesc;
-                heapAllocatorDesc.type    = AllocatorTypes::SYSTEM_HEAP;
-                heapAllocatorDesc.pParent = this;
+                heapAllocatorDesc.type     = AllocatorTypes::SYSTEM_HEAP;
+                heapAllocatorDesc.capacity = 0;
+                heapAllocatorDesc.pParent  = this;
 
                 if( BGS_FAILED( m_systemHeapAllocator.Create( heapAllocatorDesc ) ) )
                 {
                     return Results::NO_MEMORY; // TODO: Is that correct error code?
                 }
 
+                AllocatorDesc frameAllocatorDesc;
+                frameAllocatorDesc.type     = AllocatorTypes::LINEAR;
+                frameAllocatorDesc.capacity = static_cast<size_t>( Config::Core::Memory::FRAME_ALLOCATOR_SIZE );
+                frameAllocatorDesc.pParent  = this;
+
+                IAllocator* pFrameAllocator = nullptr;
+                if( BGS_FAILED( CreateAllocator( frameAllocatorDesc, &pFrameAllocator ) ) )
+                {
+                    m_systemHeapAllocator.Destroy();
+                    return Results::NO_MEMORY;
+                }
+                m_pFrameAllocator = static_cast<LinearAllocator*>( pFrameAllocator );
+
                 return Results::OK;
             }
 
@@ -41,43 +346,130 @@ namespace BIGOS
                 for( index_t ndx = 0; ndx < m_allocators.size(); ++ndx )
                 {
                     m_allocators[ ndx ]->Destroy();
+                    Memory::FreeObject( &m_systemHeapAllocator, &m_allocators[ ndx ] );
                 }
                 m_allocators.clear();
+                m_pFrameAllocator = nullptr;
+                m_generation      = 0;
 
                 // Destroy base heap allocator
                 m_systemHeapAllocator.Destroy();
 
 #if( BGS_MEMORY_DEBUG )
-                // TODO: Check if there is no leaks and report (assert for now)
-                BGS_ASSERT( m_memoryBlockInfos.size() == 0 );
+                if( m_pTracker != nullptr )
+                {
+                    // TODO: Check if there is no leaks and report (assert for now)
+                    BGS_ASSERT( GetLiveBlockCount() == 0 );
 
-                m_memoryBlockInfos.clear();
+                    m_pTracker->~MemoryTracker();
+                    Memory::FreeAligned( m_pTracker );
+                    m_pTracker = nullptr;
+                }
 #endif // ( BGS_MEMORY_DEBUG )
                 m_pParent = nullptr;
             }
 
 #if( BGS_MEMORY_DEBUG )
-            void MemorySystem::Register( const MemoryBlockInfo* pDebugInfo )
+            uint32_t MemorySystem::GetMemoryBlockInfo( MemoryCallsiteInfo* pInfos, uint32_t maxCount ) const
+            {
+                BGS_ASSERT( ( pInfos != nullptr ) || ( maxCount == 0 ), "Callsite infos (pInfos) must be a valid address." );
+                if( ( m_pTracker == nullptr ) || ( pInfos == nullptr ) || ( maxCount == 0 ) )
+                {
+                    return 0;
+                }
+
+                uint32_t count = 0;
+                for( index_t ndx = 0; ndx < MEMORY_TRACKER_CALLSITE_STRIPE_COUNT; ++ndx )
+                {
+                    MemoryCallsiteStripe&  stripe = m_pTracker->callsiteStripes[ ndx ];
+                    std::lock_guard<Mutex> lock( stripe.mutex );
+                    for( index_t ndy = 0; ndy < MEMORY_TRACKER_CALLSITE_STRIPE_SIZE; ++ndy )
+                    {
+                        if( stripe.entries[ ndy ].isUsed )
+                        {
+                            InsertSorted( stripe.entries[ ndy ], pInfos, maxCount, &count );
+                        }
+                    }
+                }
+                InsertSorted( m_pTracker->overflowCallsite, pInfos, maxCount, &count );
+
+                return count;
+            }
+
+            uint64_t MemorySystem::GetLiveBlockCount() const
+            {
+                if( m_pTracker == nullptr )
+                {
+                    return 0;
+                }
+
+                uint64_t count = 0;
+                for( index_t ndx = 0; ndx < MEMORY_TRACKER_BLOCK_STRIPE_COUNT; ++ndx )
+                {
+                    MemoryBlockStripe&     stripe = m_pTracker->blockStripes[ ndx ];
+                    std::lock_guard<Mutex> lock( stripe.mutex );
+                    count += stripe.blockCount;
+                }
+
+                return count;
+            }
+
+            void MemorySystem::Register( MemoryBlockInfo* pDebugInfo )
             {
                 BGS_ASSERT( pDebugInfo != nullptr );
+                BGS_ASSERT( m_pTracker != nullptr );
+
+                MemoryCallsiteEntry* pCallsite = FindCallsite( m_pTracker, pDebugInfo->pFile, pDebugInfo->line );
+                pCallsite->liveSize.fetch_add( pDebugInfo->blockSize, std::memory_order_relaxed );
+                pCallsite->liveCount.fetch_add( 1, std::memory_order_relaxed );
+                pCallsite->allocationCount.fetch_add( 1, std::memory_order_relaxed );
+                pDebugInfo->pCallsite = pCallsite;
+
+                MemoryBlockStripe&     stripe = m_pTracker->blockStripes[ GetBlockStripeNdx( pDebugInfo ) ];
+                std::lock_guard<Mutex> lock( stripe.mutex );
 
-                m_memoryBlockInfos.push_back( pDebugInfo );
+                pDebugInfo->pPrev = nullptr;
+                pDebugInfo->pNext = stripe.pHead;
+                if( stripe.pHead != nullptr )
+                {
+                    stripe.pHead->pPrev = pDebugInfo;
+                }
+                stripe.pHead = pDebugInfo;
+                ++stripe.blockCount;
             }
 
-            void MemorySystem::Deregister( const MemoryBlockInfo* pDebugInfo )
+            void MemorySystem::Deregister( MemoryBlockInfo* pDebugInfo )
             {
                 BGS_ASSERT( pDebugInfo != nullptr );
+                BGS_ASSERT( m_pTracker != nullptr );
 
-                for( index_t ndx = 0; ndx < m_memoryBlockInfos.size(); ++ndx )
+                MemoryBlockStripe& stripe = m_pTracker->blockStripes[ GetBlockStripeNdx( pDebugInfo ) ];
                 {
-                    if( m_memoryBlockInfos[ ndx ] == pDebugInfo )
-                    {
-                        m_memoryBlockInfos[ ndx ] = m_memoryBlockInfos.back();
-                        m_memoryBlockInfos.pop_back();
+                    std::lock_guard<Mutex> lock( stripe.mutex );
+                    BGS_ASSERT( ( pDebugInfo->pPrev != nullptr ) || ( stripe.pHead == pDebugInfo ), "Memory block (pDebugInfo) is not registered." );
 
-                        break;
+                    if( pDebugInfo->pPrev != nullptr )
+                    {
+                        pDebugInfo->pPrev->pNext = pDebugInfo->pNext;
+                    }
+                    else
+                    {
+                        stripe.pHead = pDebugInfo->pNext;
                     }
+                    if( pDebugInfo->pNext != nullptr )
+                    {
+                        pDebugInfo->pNext->pPrev = pDebugInfo->pPrev;
+                    }
+                    --stripe.blockCount;
                 }
+
+                MemoryCallsiteEntry* pCallsite = pDebugInfo->pCallsite;
+                pCallsite->liveSize.fetch_sub( pDebugInfo->blockSize, std::memory_order_relaxed );
+                pCallsite->liveCount.fetch_sub( 1, std::memory_order_relaxed );
+
+                pDebugInfo->pPrev     = nullptr;
+                pDebugInfo->pNext     = nullptr;
+                pDebugInfo->pCallsite = nullptr;
             }
 #endif // ( BGS_MEMORY_DEBUG )
         } // namespace Memory
@@ -0,0 +1,149 @@
+#include "Core/Memory/PageAllocator.h"
+
+#if( BGS_WINDOWS )
+#    include <Windows.h>
+#else
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif // ( BGS_WINDOWS )
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            size_t GetPageSize()
+            {
+#if( BGS_WINDOWS )
+                SYSTEM_INFO info;
+                GetSystemInfo( &info );
+                return static_cast<size_t>( info.dwPageSize );
+#else
+                return static_cast<size_t>( sysconf( _SC_PAGESIZE ) );
+#endif // ( BGS_WINDOWS )
+            }
+
+            void* ReservePages( size_t size )
+            {
+                BGS_ASSERT( size > 0, "Range size must be greater than 0." );
+
+#if( BGS_WINDOWS )
+                return VirtualAlloc( nullptr, size, MEM_RESERVE, PAGE_NOACCESS );
+#else
+                void* pMem = mmap( nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+                return pMem != MAP_FAILED ? pMem : nullptr;
+#endif // ( BGS_WINDOWS )
+            }
+
+            bool_t CommitPages( void* pMem, size_t size )
+            {
+                BGS_ASSERT( pMem != nullptr, "Memory range (pMem) must be valid pointer." );
+
+#if( BGS_WINDOWS )
+                return VirtualAlloc( pMem, size, MEM_COMMIT, PAGE_READWRITE ) != nullptr ? BGS_TRUE : BGS_FALSE;
+#else
+                return mprotect( pMem, size, PROT_READ | PROT_WRITE ) == 0 ? BGS_TRUE : BGS_FALSE;
+#endif // ( BGS_WINDOWS )
+            }
+
+            void DecommitPages( void* pMem, size_t size )
+            {
+                BGS_ASSERT( pMem != nullptr, "Memory range (pMem) must be valid pointer." );
+
+#if( BGS_WINDOWS )
+                VirtualFree( pMem, size, MEM_DECOMMIT );
+#else
+                madvise( pMem, size, MADV_DONTNEED );
+                mprotect( pMem, size, PROT_NONE );
+#endif // ( BGS_WINDOWS )
+            }
+
+            void ReleasePages( void* pMem, size_t size )
+            {
+                BGS_ASSERT( pMem != nullptr, "Memory range (pMem) must be valid pointer." );
+
+#if( BGS_WINDOWS )
+                size;
+                VirtualFree( pMem, 0, MEM_RELEASE );
+#else
+                munmap( pMem, size );
+#endif // ( BGS_WINDOWS )
+            }
+
+            PageAllocator::PageAllocator()
+                : m_pBase( nullptr )
+                , m_reservedSize( 0 )
+                , m_committedSize( 0 )
+                , m_pageSize( 0 )
+            {
+            }
+
+            RESULT PageAllocator::Create( size_t reserveSize )
+            {
+                BGS_ASSERT( m_pBase == nullptr, "Page allocator is already created." );
+                BGS_ASSERT( reserveSize > 0, "Reserve size (reserveSize) must be greater than 0." );
+                if( ( m_pBase != nullptr ) || ( reserveSize == 0 ) )
+                {
+                    return Results::FAIL;
+                }
+
+                m_pageSize     = GetPageSize();
+                m_reservedSize = ( reserveSize + m_pageSize - 1 ) & ~( m_pageSize - 1 );
+                m_pBase        = static_cast<byte_t*>( ReservePages( m_reservedSize ) );
+                if( m_pBase == nullptr )
+                {
+                    m_reservedSize = 0;
+                    return Results::NO_MEMORY;
+                }
+                m_committedSize = 0;
+
+                return Results::OK;
+            }
+
+            void PageAllocator::Destroy()
+            {
+                if( m_pBase != nullptr )
+                {
+                    ReleasePages( m_pBase, m_reservedSize );
+                }
+
+                m_pBase         = nullptr;
+                m_reservedSize  = 0;
+                m_committedSize = 0;
+            }
+
+            RESULT PageAllocator::Commit( size_t size )
+            {
+                BGS_ASSERT( m_pBase != nullptr, "Page allocator is not created." );
+                if( size <= m_committedSize )
+                {
+                    return Results::OK;
+                }
+                if( size > m_reservedSize )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                const size_t newSize = ( size + m_pageSize - 1 ) & ~( m_pageSize - 1 );
+                if( CommitPages( m_pBase + m_committedSize, newSize - m_committedSize ) == BGS_FALSE )
+                {
+                    return Results::NO_MEMORY;
+                }
+                m_committedSize = newSize;
+
+                return Results::OK;
+            }
+
+            void PageAllocator::Decommit( size_t size )
+            {
+                const size_t newSize = ( size + m_pageSize - 1 ) & ~( m_pageSize - 1 );
+                if( newSize < m_committedSize )
+                {
+                    DecommitPages( m_pBase + newSize, m_committedSize - newSize );
+                    m_committedSize = newSize;
+                }
+            }
+        } // namespace Memory
+    }     // namespace Core
+} // namespace BIGOS
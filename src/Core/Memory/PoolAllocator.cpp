@@ -0,0 +1,386 @@
+#include "Core/Memory/PoolAllocator.h"
+
+#include "Core/Memory/IAllocator.h"
+#include "Core/Memory/MemorySystem.h"
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            static constexpr uint32_t POOL_SIZE_CLASSES[] = { 16,  32,  48,  64,  80,  96,  112,  128,  160,  192,  224,  256,
+                                                              320, 384, 448, 512, 640, 768, 896, 1024, 1280, 1536, 1792, 2048 };
+
+            static constexpr uint32_t POOL_SIZE_CLASS_COUNT    = sizeof( POOL_SIZE_CLASSES ) / sizeof( POOL_SIZE_CLASSES[ 0 ] );
+            static constexpr uint32_t POOL_MAX_BLOCK_SIZE      = POOL_SIZE_CLASSES[ POOL_SIZE_CLASS_COUNT - 1 ];
+            static constexpr uint32_t POOL_BLOCK_ALIGNMENT     = 16;
+            static constexpr uint32_t POOL_CHUNK_SIZE          = 64 * 1024;
+            static constexpr uint32_t POOL_FALLBACK_CLASS      = MAX_UINT32;
+            static constexpr uint32_t MAX_POOL_ALLOCATOR_COUNT = 32;
+
+            struct PoolBlock
+            {
+                PoolBlock* pNext;
+            };
+
+            // Placed in front of every block handed out. While a block sits in a free list its header is overwritten by PoolBlock.
+            struct alignas( POOL_BLOCK_ALIGNMENT ) PoolBlockHeader
+            {
+                union
+                {
+                    PoolThreadCache* pOwner;
+                    size_t           fallbackSize; // Used when sizeClassNdx is POOL_FALLBACK_CLASS
+                };
+                uint32_t sizeClassNdx;
+                uint32_t baseOffset;
+            };
+            static_assert( sizeof( PoolBlockHeader ) == POOL_BLOCK_ALIGNMENT, "Pool block header must keep blocks aligned." );
+
+            struct PoolThreadCache
+            {
+                PoolBlock*         freeLists[ POOL_SIZE_CLASS_COUNT ];
+                Atomic<PoolBlock*> remoteFreeLists[ POOL_SIZE_CLASS_COUNT ];
+                HeapArray<void*>   chunks;
+            };
+
+            struct PoolThreadCacheSlot
+            {
+                uint64_t         generation;
+                PoolThreadCache* pCache;
+            };
+
+            struct PoolSizeClassLookup
+            {
+                uint8_t sizeClassNdx[ POOL_MAX_BLOCK_SIZE / POOL_BLOCK_ALIGNMENT + 1 ];
+
+                constexpr PoolSizeClassLookup()
+                    : sizeClassNdx()
+                {
+                    uint32_t classNdx = 0;
+                    for( uint32_t ndx = 0; ndx < POOL_MAX_BLOCK_SIZE / POOL_BLOCK_ALIGNMENT + 1; ++ndx )
+                    {
+                        while( POOL_SIZE_CLASSES[ classNdx ] < ndx * POOL_BLOCK_ALIGNMENT )
+                        {
+                            ++classNdx;
+                        }
+                        sizeClassNdx[ ndx ] = static_cast<uint8_t>( classNdx );
+                    }
+                }
+            };
+
+            // Hands caches of exiting thread to their pools, constructed in thread which creates its first cache
+            struct PoolThreadCacheGuard
+            {
+                bool_t isArmed = BGS_FALSE;
+
+                ~PoolThreadCacheGuard();
+            };
+
+            static constexpr PoolSizeClassLookup s_sizeClassLookup;
+
+            static thread_local PoolThreadCacheSlot  s_threadCacheSlots[ MAX_POOL_ALLOCATOR_COUNT ];
+            static thread_local PoolThreadCacheGuard s_threadCacheGuard;
+            static Atomic<uint32_t>                  s_usedSlotMask( 0 );
+            static Atomic<uint64_t>                  s_generationCounter( 0 );
+            static Mutex                             s_poolMutex; // Guards s_pools against pool destruction during thread exit
+            static PoolAllocator*                    s_pools[ MAX_POOL_ALLOCATOR_COUNT ];
+
+            PoolThreadCacheGuard::~PoolThreadCacheGuard()
+            {
+                std::lock_guard<Mutex> poolLock( s_poolMutex );
+                for( uint32_t ndx = 0; ndx < MAX_POOL_ALLOCATOR_COUNT; ++ndx )
+                {
+                    PoolThreadCacheSlot& slot  = s_threadCacheSlots[ ndx ];
+                    PoolAllocator*       pPool = s_pools[ ndx ];
+                    if( ( slot.pCache != nullptr ) && ( pPool != nullptr ) && ( pPool->m_generation == slot.generation ) )
+                    {
+                        std::lock_guard<Mutex> lock( pPool->m_mutex );
+                        pPool->m_orphanedCaches.push_back( slot.pCache );
+                    }
+                    // Blocks freed by later destructors go to remote list of their owner
+                    slot.generation = 0;
+                    slot.pCache     = nullptr;
+                }
+            }
+
+            PoolAllocator::PoolAllocator()
+                : m_threadCaches()
+                , m_orphanedCaches()
+                , m_mutex()
+                , m_generation( 0 )
+                , m_slotNdx( MAX_UINT32 )
+                , m_pParent( nullptr )
+            {
+            }
+
+            RESULT PoolAllocator::Allocate( size_t size, void** ppMemory, const char* pFile, uint32_t line )
+            {
+                return AllocateAligned( size, POOL_BLOCK_ALIGNMENT, ppMemory, pFile, line );
+            }
+
+            RESULT PoolAllocator::AllocateAligned( size_t size, size_t alignment, void** ppMemory, const char* pFile, uint32_t line )
+            {
+                BGS_ASSERT( ( ppMemory != nullptr ) && ( *ppMemory == nullptr ) );
+                BGS_ASSERT( size > 0, "Block size must be greater than 0." );
+                if( ( size > POOL_MAX_BLOCK_SIZE ) || ( ( alignment != DEFAULT_ALIGNMENT ) && ( alignment > POOL_BLOCK_ALIGNMENT ) ) )
+                {
+                    return AllocateFallback( size, alignment, ppMemory, pFile, line );
+                }
+
+                PoolThreadCache* pCache = GetThreadCache( BGS_TRUE );
+                if( pCache == nullptr )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                const uint32_t sizeClassNdx = s_sizeClassLookup.sizeClassNdx[ ( size + POOL_BLOCK_ALIGNMENT - 1 ) / POOL_BLOCK_ALIGNMENT ];
+                if( pCache->freeLists[ sizeClassNdx ] == nullptr )
+                {
+                    if( BGS_FAILED( RefillCache( pCache, sizeClassNdx ) ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+                }
+
+                PoolBlock* pBlock                 = pCache->freeLists[ sizeClassNdx ];
+                pCache->freeLists[ sizeClassNdx ] = pBlock->pNext;
+
+                PoolBlockHeader* pHeader = reinterpret_cast<PoolBlockHeader*>( pBlock );
+                pHeader->pOwner          = pCache;
+                pHeader->sizeClassNdx    = sizeClassNdx;
+                pHeader->baseOffset      = 0;
+                m_telemetry.OnAllocate( POOL_SIZE_CLASSES[ sizeClassNdx ] );
+
+                *ppMemory = pHeader + 1;
+
+                return Results::OK;
+            }
+
+            void PoolAllocator::Free( void** ppMemory )
+            {
+                BGS_ASSERT( ( ppMemory != nullptr ) && ( *ppMemory != nullptr ) );
+
+                PoolBlockHeader* pHeader = static_cast<PoolBlockHeader*>( *ppMemory ) - 1;
+                if( pHeader->sizeClassNdx == POOL_FALLBACK_CLASS )
+                {
+                    m_telemetry.OnFree( pHeader->fallbackSize );
+                    void* pBase = static_cast<byte_t*>( *ppMemory ) - pHeader->baseOffset;
+
+                    std::lock_guard<Mutex> lock( m_mutex );
+                    m_pParent->GetSystemHeapAllocator()->FreeAligned( &pBase );
+                }
+                else
+                {
+                    BGS_ASSERT( pHeader->sizeClassNdx < POOL_SIZE_CLASS_COUNT, "Memory block (*ppMemory) was not allocated by this allocator." );
+
+                    PoolThreadCache* pOwner       = pHeader->pOwner;
+                    const uint32_t   sizeClassNdx = pHeader->sizeClassNdx;
+                    PoolBlock*       pBlock       = reinterpret_cast<PoolBlock*>( pHeader );
+                    m_telemetry.OnFree( POOL_SIZE_CLASSES[ sizeClassNdx ] );
+                    if( pOwner == GetThreadCache( BGS_FALSE ) )
+                    {
+                        pBlock->pNext                     = pOwner->freeLists[ sizeClassNdx ];
+                        pOwner->freeLists[ sizeClassNdx ] = pBlock;
+                    }
+                    else
+                    {
+                        // Block belongs to other thread, hand it back without locking
+                        Atomic<PoolBlock*>& remoteList = pOwner->remoteFreeLists[ sizeClassNdx ];
+                        PoolBlock*          pHead      = remoteList.load( std::memory_order_relaxed );
+                        do
+                        {
+                            pBlock->pNext = pHead;
+                        } while( !remoteList.compare_exchange_weak( pHead, pBlock, std::memory_order_release, std::memory_order_relaxed ) );
+                    }
+                }
+
+                *ppMemory = nullptr;
+            }
+
+            void PoolAllocator::FreeAligned( void** ppMemory ) { Free( ppMemory ); }
+
+            RESULT PoolAllocator::Create( const AllocatorDesc& desc )
+            {
+                BGS_ASSERT( desc.pParent != nullptr, "Invalid parent (pParent)." );
+                BGS_ASSERT( desc.type == AllocatorTypes::POOL );
+                if( desc.pParent == nullptr )
+                {
+                    return Results::FAIL;
+                }
+                m_pParent = desc.pParent;
+
+                // Every pool needs own slot in thread local cache table
+                uint32_t usedMask = s_usedSlotMask.load();
+                uint32_t slotNdx  = 0;
+                do
+                {
+                    if( usedMask == MAX_UINT32 )
+                    {
+                        BGS_ASSERT( false, "Too many pool allocators alive at once." );
+                        return Results::NO_MEMORY;
+                    }
+                    for( slotNdx = 0; ( usedMask & ( 1u << slotNdx ) ) != 0; ++slotNdx )
+                    {
+                    }
+                } while( !s_usedSlotMask.compare_exchange_weak( usedMask, usedMask | ( 1u << slotNdx ) ) );
+
+                m_slotNdx    = slotNdx;
+                m_generation = s_generationCounter.fetch_add( 1 ) + 1;
+
+                std::lock_guard<Mutex> poolLock( s_poolMutex );
+                s_pools[ m_slotNdx ] = this;
+
+                return Results::OK;
+            }
+
+            void PoolAllocator::Destroy()
+            {
+                // Exiting threads must not orphan caches which are freed below
+                if( m_slotNdx != MAX_UINT32 )
+                {
+                    std::lock_guard<Mutex> poolLock( s_poolMutex );
+                    s_pools[ m_slotNdx ] = nullptr;
+                }
+
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                SystemHeapAllocator* pHeapAllocator = m_pParent->GetSystemHeapAllocator();
+                for( index_t ndx = 0; ndx < m_threadCaches.size(); ++ndx )
+                {
+                    PoolThreadCache* pCache = m_threadCaches[ ndx ];
+                    for( index_t chunkNdx = 0; chunkNdx < pCache->chunks.size(); ++chunkNdx )
+                    {
+                        pHeapAllocator->FreeAligned( &pCache->chunks[ chunkNdx ] );
+                    }
+                    Memory::FreeObject( pHeapAllocator, &pCache );
+                }
+                m_threadCaches.clear();
+                m_orphanedCaches.clear();
+
+                if( m_slotNdx != MAX_UINT32 )
+                {
+                    s_usedSlotMask.fetch_and( ~( 1u << m_slotNdx ) );
+                }
+                m_slotNdx    = MAX_UINT32;
+                m_generation = 0;
+                m_pParent    = nullptr;
+            }
+
+            PoolThreadCache* PoolAllocator::GetThreadCache( bool_t create )
+            {
+                PoolThreadCacheSlot& slot = s_threadCacheSlots[ m_slotNdx ];
+                if( slot.generation == m_generation )
+                {
+                    return slot.pCache;
+                }
+                if( create == BGS_FALSE )
+                {
+                    return nullptr;
+                }
+
+                // Cache of exited thread keeps its free lists, blocks still in use keep pointing to it as their owner
+                PoolThreadCache* pCache = nullptr;
+                {
+                    std::lock_guard<Mutex> lock( m_mutex );
+                    if( !m_orphanedCaches.empty() )
+                    {
+                        pCache = m_orphanedCaches.back();
+                        m_orphanedCaches.pop_back();
+                    }
+                    else
+                    {
+                        if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetSystemHeapAllocator(), &pCache ) ) )
+                        {
+                            return nullptr;
+                        }
+                        m_threadCaches.push_back( pCache );
+                        for( index_t ndx = 0; ndx < POOL_SIZE_CLASS_COUNT; ++ndx )
+                        {
+                            pCache->freeLists[ ndx ] = nullptr;
+                            pCache->remoteFreeLists[ ndx ].store( nullptr, std::memory_order_relaxed );
+                        }
+                    }
+                }
+
+                s_threadCacheGuard.isArmed = BGS_TRUE;
+                slot.generation            = m_generation;
+                slot.pCache     = pCache;
+
+                return pCache;
+            }
+
+            RESULT PoolAllocator::RefillCache( PoolThreadCache* pCache, uint32_t sizeClassNdx )
+            {
+                // Reuse blocks freed by other threads before taking new chunk
+                PoolBlock* pRemoteBlocks = pCache->remoteFreeLists[ sizeClassNdx ].exchange( nullptr, std::memory_order_acquire );
+                if( pRemoteBlocks != nullptr )
+                {
+                    pCache->freeLists[ sizeClassNdx ] = pRemoteBlocks;
+                    return Results::OK;
+                }
+
+                void* pChunk = nullptr;
+                {
+                    std::lock_guard<Mutex> lock( m_mutex );
+                    if( BGS_FAILED( m_pParent->GetSystemHeapAllocator()->AllocateAligned( POOL_CHUNK_SIZE, POOL_BLOCK_ALIGNMENT, &pChunk ) ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+                }
+                pCache->chunks.push_back( pChunk );
+
+                // Do not trust heap alignment, debug heap shifts blocks by its header
+                const uintptr_t chunkAddress   = reinterpret_cast<uintptr_t>( pChunk );
+                const uintptr_t alignedAddress = ( chunkAddress + POOL_BLOCK_ALIGNMENT - 1 ) & ~uintptr_t( POOL_BLOCK_ALIGNMENT - 1 );
+                const uint32_t  padding        = static_cast<uint32_t>( alignedAddress - chunkAddress );
+                const uint32_t  stride         = POOL_SIZE_CLASSES[ sizeClassNdx ] + static_cast<uint32_t>( sizeof( PoolBlockHeader ) );
+                const uint32_t  blockCount     = ( POOL_CHUNK_SIZE - padding ) / stride;
+                byte_t*         pBytes         = static_cast<byte_t*>( pChunk ) + padding;
+                PoolBlock*      pFirst         = nullptr;
+                for( uint32_t ndx = blockCount; ndx > 0; --ndx )
+                {
+                    PoolBlock* pBlock = reinterpret_cast<PoolBlock*>( pBytes + ( ndx - 1 ) * stride );
+                    pBlock->pNext     = pFirst;
+                    pFirst            = pBlock;
+                }
+                pCache->freeLists[ sizeClassNdx ] = pFirst;
+
+                return Results::OK;
+            }
+
+            RESULT PoolAllocator::AllocateFallback( size_t size, size_t alignment, void** ppMemory, const char* pFile, uint32_t line )
+            {
+                if( ( alignment == DEFAULT_ALIGNMENT ) || ( alignment < POOL_BLOCK_ALIGNMENT ) )
+                {
+                    alignment = POOL_BLOCK_ALIGNMENT;
+                }
+
+                void* pBase = nullptr;
+                {
+                    std::lock_guard<Mutex> lock( m_mutex );
+                    // Large blocks are tracked by system heap, so they are reported at callsite of pool allocation
+                    if( BGS_FAILED( m_pParent->GetSystemHeapAllocator()->AllocateAligned( size + sizeof( PoolBlockHeader ) + alignment, alignment,
+                                                                                          &pBase, pFile, line ) ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+                }
+
+                const uintptr_t  baseAddress = reinterpret_cast<uintptr_t>( pBase );
+                const uintptr_t  address     = ( baseAddress + sizeof( PoolBlockHeader ) + alignment - 1 ) & ~uintptr_t( alignment - 1 );
+                byte_t*          pMemory     = reinterpret_cast<byte_t*>( address );
+                PoolBlockHeader* pHeader     = reinterpret_cast<PoolBlockHeader*>( pMemory ) - 1;
+                pHeader->fallbackSize        = size;
+                pHeader->sizeClassNdx        = POOL_FALLBACK_CLASS;
+                pHeader->baseOffset          = static_cast<uint32_t>( address - baseAddress );
+                m_telemetry.OnAllocate( size );
+
+                *ppMemory = pMemory;
+
+                return Results::OK;
+            }
+
+        } // namespace Memory
+    }     // namespace Core
+} // namespace BIGOS
@@ -0,0 +1,359 @@
+#include "Core/Memory/RangeAllocator.h"
+
+#if( BGS_VISUAL_STUDIO )
+#    include <intrin.h>
+#endif // ( BGS_VISUAL_STUDIO )
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            static constexpr uint32_t RANGE_ALLOCATOR_INITIAL_NODE_COUNT = 64;
+
+            static BGS_FORCEINLINE uint32_t FindFirstSet32( uint32_t word )
+            {
+#if( BGS_VISUAL_STUDIO )
+                unsigned long ndx = 0;
+                _BitScanForward( &ndx, word );
+                return static_cast<uint32_t>( ndx );
+#else
+                return static_cast<uint32_t>( __builtin_ctz( word ) );
+#endif // ( BGS_VISUAL_STUDIO )
+            }
+
+            static BGS_FORCEINLINE uint32_t FindFirstSet64( uint64_t word )
+            {
+#if( BGS_VISUAL_STUDIO )
+                unsigned long ndx = 0;
+                _BitScanForward64( &ndx, word );
+                return static_cast<uint32_t>( ndx );
+#else
+                return static_cast<uint32_t>( __builtin_ctzll( word ) );
+#endif // ( BGS_VISUAL_STUDIO )
+            }
+
+            static BGS_FORCEINLINE uint32_t FindLastSet64( uint64_t word )
+            {
+#if( BGS_VISUAL_STUDIO )
+                unsigned long ndx = 0;
+                _BitScanReverse64( &ndx, word );
+                return static_cast<uint32_t>( ndx );
+#else
+                return static_cast<uint32_t>( 63 - __builtin_clzll( word ) );
+#endif // ( BGS_VISUAL_STUDIO )
+            }
+
+            // Size classes are rounded down, so every range in the list is at least as big as the class
+            static BGS_FORCEINLINE void MappingInsert( uint64_t size, uint32_t* pFl, uint32_t* pSl )
+            {
+                if( size < RANGE_ALLOCATOR_SL_COUNT )
+                {
+                    *pFl = 0;
+                    *pSl = static_cast<uint32_t>( size );
+                }
+                else
+                {
+                    const uint32_t lastSet = FindLastSet64( size );
+                    *pFl                   = lastSet - RANGE_ALLOCATOR_SL_COUNT_LOG2 + 1;
+                    *pSl = static_cast<uint32_t>( size >> ( lastSet - RANGE_ALLOCATOR_SL_COUNT_LOG2 ) ) ^ RANGE_ALLOCATOR_SL_COUNT;
+                }
+            }
+
+            // Size is rounded up to the next class, so any range found there is big enough without walking the list
+            static BGS_FORCEINLINE void MappingSearch( uint64_t size, uint32_t* pFl, uint32_t* pSl )
+            {
+                if( size >= RANGE_ALLOCATOR_SL_COUNT )
+                {
+                    size += ( 1ULL << ( FindLastSet64( size ) - RANGE_ALLOCATOR_SL_COUNT_LOG2 ) ) - 1;
+                }
+                MappingInsert( size, pFl, pSl );
+            }
+
+            RangeAllocator::RangeAllocator()
+                : m_nodes()
+                , m_freeNodes( RANGE_ALLOCATOR_INVALID_NODE )
+                , m_flBitmap( 0 )
+                , m_slBitmaps()
+                , m_heads()
+                , m_size( 0 )
+                , m_usedSize( 0 )
+                , m_allocationCount( 0 )
+            {
+            }
+
+            RESULT RangeAllocator::Create( uint64_t size, IAllocator* pAllocator )
+            {
+                BGS_ASSERT( size > 0, "Range size (size) must be greater than 0." );
+                BGS_ASSERT( m_nodes.empty(), "Range allocator is already created." );
+                if( ( size == 0 ) || !m_nodes.empty() )
+                {
+                    return Results::FAIL;
+                }
+
+                m_nodes.SetAllocator( pAllocator );
+                m_nodes.reserve( RANGE_ALLOCATOR_INITIAL_NODE_COUNT );
+                m_freeNodes = RANGE_ALLOCATOR_INVALID_NODE;
+                m_flBitmap  = 0;
+                for( uint32_t fl = 0; fl < RANGE_ALLOCATOR_FL_COUNT; ++fl )
+                {
+                    m_slBitmaps[ fl ] = 0;
+                    for( uint32_t sl = 0; sl < RANGE_ALLOCATOR_SL_COUNT; ++sl )
+                    {
+                        m_heads[ fl ][ sl ] = RANGE_ALLOCATOR_INVALID_NODE;
+                    }
+                }
+                m_size            = size;
+                m_usedSize        = 0;
+                m_allocationCount = 0;
+
+                InsertFreeNode( CreateNode( 0, size ) );
+
+                return Results::OK;
+            }
+
+            void RangeAllocator::Destroy()
+            {
+                BGS_ASSERT( m_allocationCount == 0, "Not all ranges were freed." );
+
+                m_nodes.clear();
+                m_nodes.shrink_to_fit();
+                m_freeNodes       = RANGE_ALLOCATOR_INVALID_NODE;
+                m_flBitmap        = 0;
+                m_size            = 0;
+                m_usedSize        = 0;
+                m_allocationCount = 0;
+            }
+
+            RESULT RangeAllocator::Allocate( uint64_t size, uint64_t alignment, RangeAllocation* pAllocation )
+            {
+                BGS_ASSERT( pAllocation != nullptr, "Allocation (pAllocation) must be a valid address." );
+                BGS_ASSERT( size > 0, "Range size (size) must be greater than 0." );
+                BGS_ASSERT( ( alignment & ( alignment - 1 ) ) == 0, "Alignment must be the power of 2." );
+                if( alignment == 0 )
+                {
+                    alignment = 1;
+                }
+
+                // Head of the matching list is usually aligned already, bigger search that fits any padding is the fallback
+                uint32_t node = FindFreeNode( size );
+                if( node != RANGE_ALLOCATOR_INVALID_NODE )
+                {
+                    const RangeAllocatorNode& freeNode = m_nodes[ node ];
+                    const uint64_t            padding  = ( ( freeNode.offset + alignment - 1 ) & ~( alignment - 1 ) ) - freeNode.offset;
+                    if( size + padding > freeNode.size )
+                    {
+                        node = RANGE_ALLOCATOR_INVALID_NODE;
+                    }
+                }
+                if( ( node == RANGE_ALLOCATOR_INVALID_NODE ) && ( alignment > 1 ) )
+                {
+                    node = FindFreeNode( size + alignment - 1 );
+                }
+                if( node == RANGE_ALLOCATOR_INVALID_NODE )
+                {
+                    return Results::NO_MEMORY;
+                }
+                RemoveFreeNode( node );
+
+                const uint64_t padding = ( ( m_nodes[ node ].offset + alignment - 1 ) & ~( alignment - 1 ) ) - m_nodes[ node ].offset;
+                if( padding > 0 )
+                {
+                    const uint32_t head = CreateNode( m_nodes[ node ].offset, padding );
+                    // Nodes array may have grown, no references are kept across CreateNode()
+                    m_nodes[ head ].prevNeighbour = m_nodes[ node ].prevNeighbour;
+                    m_nodes[ head ].nextNeighbour = node;
+                    if( m_nodes[ node ].prevNeighbour != RANGE_ALLOCATOR_INVALID_NODE )
+                    {
+                        m_nodes[ m_nodes[ node ].prevNeighbour ].nextNeighbour = head;
+                    }
+                    m_nodes[ node ].prevNeighbour = head;
+                    m_nodes[ node ].offset += padding;
+                    m_nodes[ node ].size -= padding;
+                    InsertFreeNode( head );
+                }
+
+                if( m_nodes[ node ].size > size )
+                {
+                    const uint32_t tail           = CreateNode( m_nodes[ node ].offset + size, m_nodes[ node ].size - size );
+                    m_nodes[ tail ].prevNeighbour = node;
+                    m_nodes[ tail ].nextNeighbour = m_nodes[ node ].nextNeighbour;
+                    if( m_nodes[ node ].nextNeighbour != RANGE_ALLOCATOR_INVALID_NODE )
+                    {
+                        m_nodes[ m_nodes[ node ].nextNeighbour ].prevNeighbour = tail;
+                    }
+                    m_nodes[ node ].nextNeighbour = tail;
+                    m_nodes[ node ].size          = size;
+                    InsertFreeNode( tail );
+                }
+
+                m_nodes[ node ].isFree = BGS_FALSE;
+                m_usedSize += size;
+                m_allocationCount++;
+
+                pAllocation->offset = m_nodes[ node ].offset;
+                pAllocation->size   = size;
+                pAllocation->node   = node;
+
+                return Results::OK;
+            }
+
+            void RangeAllocator::Free( RangeAllocation* pAllocation )
+            {
+                BGS_ASSERT( pAllocation != nullptr, "Allocation (pAllocation) must be a valid address." );
+                BGS_ASSERT( pAllocation->node < m_nodes.size(), "Allocation (pAllocation) was not made by this allocator." );
+                if( ( pAllocation == nullptr ) || ( pAllocation->node >= m_nodes.size() ) )
+                {
+                    return;
+                }
+
+                const uint32_t node = pAllocation->node;
+                BGS_ASSERT( !m_nodes[ node ].isFree, "Range (pAllocation) is already free." );
+                m_usedSize -= m_nodes[ node ].size;
+                m_allocationCount--;
+
+                // Free neighbours are merged, so two free ranges are never adjacent
+                const uint32_t prev = m_nodes[ node ].prevNeighbour;
+                if( ( prev != RANGE_ALLOCATOR_INVALID_NODE ) && m_nodes[ prev ].isFree )
+                {
+                    RemoveFreeNode( prev );
+                    m_nodes[ node ].offset = m_nodes[ prev ].offset;
+                    m_nodes[ node ].size += m_nodes[ prev ].size;
+                    m_nodes[ node ].prevNeighbour = m_nodes[ prev ].prevNeighbour;
+                    if( m_nodes[ node ].prevNeighbour != RANGE_ALLOCATOR_INVALID_NODE )
+                    {
+                        m_nodes[ m_nodes[ node ].prevNeighbour ].nextNeighbour = node;
+                    }
+                    ReleaseNode( prev );
+                }
+
+                const uint32_t next = m_nodes[ node ].nextNeighbour;
+                if( ( next != RANGE_ALLOCATOR_INVALID_NODE ) && m_nodes[ next ].isFree )
+                {
+                    RemoveFreeNode( next );
+                    m_nodes[ node ].size += m_nodes[ next ].size;
+                    m_nodes[ node ].nextNeighbour = m_nodes[ next ].nextNeighbour;
+                    if( m_nodes[ node ].nextNeighbour != RANGE_ALLOCATOR_INVALID_NODE )
+                    {
+                        m_nodes[ m_nodes[ node ].nextNeighbour ].prevNeighbour = node;
+                    }
+                    ReleaseNode( next );
+                }
+
+                InsertFreeNode( node );
+
+                *pAllocation = RangeAllocation();
+            }
+
+            uint32_t RangeAllocator::CreateNode( uint64_t offset, uint64_t size )
+            {
+                uint32_t node = m_freeNodes;
+                if( node != RANGE_ALLOCATOR_INVALID_NODE )
+                {
+                    m_freeNodes = m_nodes[ node ].nextFree;
+                }
+                else
+                {
+                    node = static_cast<uint32_t>( m_nodes.size() );
+                    m_nodes.emplace_back();
+                }
+
+                RangeAllocatorNode& newNode = m_nodes[ node ];
+                newNode.offset              = offset;
+                newNode.size                = size;
+                newNode.prevNeighbour       = RANGE_ALLOCATOR_INVALID_NODE;
+                newNode.nextNeighbour       = RANGE_ALLOCATOR_INVALID_NODE;
+                newNode.prevFree            = RANGE_ALLOCATOR_INVALID_NODE;
+                newNode.nextFree            = RANGE_ALLOCATOR_INVALID_NODE;
+                newNode.isFree              = BGS_FALSE;
+
+                return node;
+            }
+
+            void RangeAllocator::ReleaseNode( uint32_t node )
+            {
+                m_nodes[ node ].isFree   = BGS_FALSE;
+                m_nodes[ node ].nextFree = m_freeNodes;
+                m_freeNodes              = node;
+            }
+
+            void RangeAllocator::InsertFreeNode( uint32_t node )
+            {
+                uint32_t fl = 0;
+                uint32_t sl = 0;
+                MappingInsert( m_nodes[ node ].size, &fl, &sl );
+
+                const uint32_t head      = m_heads[ fl ][ sl ];
+                m_nodes[ node ].isFree   = BGS_TRUE;
+                m_nodes[ node ].prevFree = RANGE_ALLOCATOR_INVALID_NODE;
+                m_nodes[ node ].nextFree = head;
+                if( head != RANGE_ALLOCATOR_INVALID_NODE )
+                {
+                    m_nodes[ head ].prevFree = node;
+                }
+                m_heads[ fl ][ sl ] = node;
+                m_flBitmap |= 1ULL << fl;
+                m_slBitmaps[ fl ] |= 1U << sl;
+            }
+
+            void RangeAllocator::RemoveFreeNode( uint32_t node )
+            {
+                uint32_t fl = 0;
+                uint32_t sl = 0;
+                MappingInsert( m_nodes[ node ].size, &fl, &sl );
+
+                const uint32_t prev = m_nodes[ node ].prevFree;
+                const uint32_t next = m_nodes[ node ].nextFree;
+                if( next != RANGE_ALLOCATOR_INVALID_NODE )
+                {
+                    m_nodes[ next ].prevFree = prev;
+                }
+                if( prev != RANGE_ALLOCATOR_INVALID_NODE )
+                {
+                    m_nodes[ prev ].nextFree = next;
+                }
+                else
+                {
+                    m_heads[ fl ][ sl ] = next;
+                    if( next == RANGE_ALLOCATOR_INVALID_NODE )
+                    {
+                        m_slBitmaps[ fl ] &= ~( 1U << sl );
+                        if( m_slBitmaps[ fl ] == 0 )
+                        {
+                            m_flBitmap &= ~( 1ULL << fl );
+                        }
+                    }
+                }
+                m_nodes[ node ].isFree   = BGS_FALSE;
+                m_nodes[ node ].prevFree = RANGE_ALLOCATOR_INVALID_NODE;
+                m_nodes[ node ].nextFree = RANGE_ALLOCATOR_INVALID_NODE;
+            }
+
+            uint32_t RangeAllocator::FindFreeNode( uint64_t size )
+            {
+                uint32_t fl = 0;
+                uint32_t sl = 0;
+                MappingSearch( size, &fl, &sl );
+                if( fl >= RANGE_ALLOCATOR_FL_COUNT )
+                {
+                    return RANGE_ALLOCATOR_INVALID_NODE;
+                }
+
+                uint32_t slMap = m_slBitmaps[ fl ] & ( MAX_UINT32 << sl );
+                if( slMap == 0 )
+                {
+                    const uint64_t flMap = fl + 1 < 64 ? m_flBitmap & ( MAX_UINT64 << ( fl + 1 ) ) : 0;
+                    if( flMap == 0 )
+                    {
+                        return RANGE_ALLOCATOR_INVALID_NODE;
+                    }
+                    fl    = FindFirstSet64( flMap );
+                    slMap = m_slBitmaps[ fl ];
+                }
+
+                return m_heads[ fl ][ FindFirstSet32( slMap ) ];
+            }
+        } // namespace Memory
+    }     // namespace Core
+} // namespace BIGOS
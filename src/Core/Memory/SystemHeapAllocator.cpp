@@ -9,6 +9,17 @@ namespace BIGOS
     {
         namespace Memory
         {
+#if( !BGS_MEMORY_DEBUG )
+            // CRT can not report size of an aligned block without knowing its alignment, so release builds keep it in front of
+            // aligned blocks. Offset is multiple of alignment, so payload stays aligned. Normal blocks get no header, telemetry
+            // counts their CRT block size, which can be a few bytes above requested size counted by debug builds.
+            struct SystemHeapAlignedHeader
+            {
+                size_t size;
+                size_t offset;
+            };
+#endif // ( !BGS_MEMORY_DEBUG )
+
             RESULT SystemHeapAllocator::Allocate( size_t size, void** ppMemory, const char* pFile, uint32_t line )
             {
                 BGS_ASSERT( ( ppMemory != nullptr ) && ( *ppMemory == nullptr ) );
@@ -29,8 +40,14 @@ namespace BIGOS
                 pBlockInfo->alignment = DEFAULT_ALIGNMENT;
 
                 Register( pBlockInfo );
+                m_telemetry.OnAllocate( size );
 #else
                 pMemory = Core::Memory::Malloc( size );
+                if( pMemory == nullptr )
+                {
+                    return Results::NO_MEMORY;
+                }
+                m_telemetry.OnAllocate( Core::Memory::Size( pMemory ) );
 #endif // ( BGS_MEMORY_DEBUG )
 
                 *ppMemory = pMemory;
@@ -58,8 +75,20 @@ namespace BIGOS
                 pBlockInfo->alignment = alignment;
 
                 Register( pBlockInfo );
+                m_telemetry.OnAllocate( size );
 #else
-                pMemory = Core::Memory::MallocAligned( size, alignment );
+                const size_t offset = alignment > sizeof( SystemHeapAlignedHeader ) ? alignment : sizeof( SystemHeapAlignedHeader );
+                byte_t*      pBlock = static_cast<byte_t*>( Core::Memory::MallocAligned( size + offset, alignment ) );
+                if( pBlock == nullptr )
+                {
+                    return Results::NO_MEMORY;
+                }
+                pMemory = pBlock + offset;
+
+                SystemHeapAlignedHeader* pHeader = reinterpret_cast<SystemHeapAlignedHeader*>( pMemory ) - 1;
+                pHeader->size                    = size;
+                pHeader->offset                  = offset;
+                m_telemetry.OnAllocate( size );
 #endif // ( BGS_MEMORY_DEBUG )
 
                 *ppMemory = pMemory;
@@ -77,9 +106,11 @@ namespace BIGOS
 
                 BGS_ASSERT( pBlockInfo->allocType == AllocationBlockTypes::NORMAL );
 
+                m_telemetry.OnFree( pBlockInfo->blockSize );
                 Deregister( pBlockInfo );
                 Core::Memory::FreeDebug( *ppMemory );
 #else
+                m_telemetry.OnFree( Core::Memory::Size( *ppMemory ) );
                 Core::Memory::Free( *ppMemory );
 #endif // ( BGS_MEMORY_DEBUG )
 
@@ -96,10 +127,14 @@ namespace BIGOS
 
                 BGS_ASSERT( pBlockInfo->allocType == AllocationBlockTypes::ALIGNED );
 
+                m_telemetry.OnFree( pBlockInfo->blockSize );
                 Deregister( pBlockInfo );
                 Core::Memory::FreeAlignedDebug( *ppMemory );
 #else
-                Core::Memory::FreeAligned( *ppMemory );
+                const SystemHeapAlignedHeader* pHeader = static_cast<const SystemHeapAlignedHeader*>( *ppMemory ) - 1;
+
+                m_telemetry.OnFree( pHeader->size );
+                Core::Memory::FreeAligned( static_cast<byte_t*>( *ppMemory ) - pHeader->offset );
 #endif // ( BGS_MEMORY_DEBUG )
 
                 ppMemory;
@@ -122,14 +157,14 @@ namespace BIGOS
             }
 
 #if( BGS_MEMORY_DEBUG )
-            void SystemHeapAllocator::Register( const MemoryBlockInfo* pDebugInfo )
+            void SystemHeapAllocator::Register( MemoryBlockInfo* pDebugInfo )
             {
                 BGS_ASSERT( pDebugInfo != nullptr );
 
                 m_pParent->Register( pDebugInfo );
             }
 
-            void SystemHeapAllocator::Deregister( const MemoryBlockInfo* pDebugInfo )
+            void SystemHeapAllocator::Deregister( MemoryBlockInfo* pDebugInfo )
             {
                 BGS_ASSERT( pDebugInfo != nullptr );
 
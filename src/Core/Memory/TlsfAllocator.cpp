@@ -0,0 +1,462 @@
+#include "Core/Memory/TlsfAllocator.h"
+
+#include "Core/Memory/IAllocator.h"
+#include "Core/Memory/MemorySystem.h"
+
+#if( BGS_VISUAL_STUDIO )
+#    include <intrin.h>
+#endif // ( BGS_VISUAL_STUDIO )
+
+namespace BIGOS
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            static constexpr uint32_t TLSF_ALIGN_SIZE_LOG2     = 4;
+            static constexpr size_t   TLSF_ALIGN_SIZE          = size_t( 1 ) << TLSF_ALIGN_SIZE_LOG2;
+            static constexpr uint32_t TLSF_SL_INDEX_COUNT_LOG2 = 5;
+            static constexpr uint32_t TLSF_SL_INDEX_COUNT      = 1u << TLSF_SL_INDEX_COUNT_LOG2;
+            static constexpr uint32_t TLSF_FL_INDEX_MAX        = 32;
+            static constexpr uint32_t TLSF_FL_INDEX_SHIFT      = TLSF_SL_INDEX_COUNT_LOG2 + TLSF_ALIGN_SIZE_LOG2;
+            static constexpr uint32_t TLSF_FL_INDEX_COUNT      = TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1;
+            static constexpr size_t   TLSF_SMALL_BLOCK_SIZE    = size_t( 1 ) << TLSF_FL_INDEX_SHIFT;
+
+            static constexpr size_t TLSF_BLOCK_FREE_BIT = 1;
+            static constexpr size_t TLSF_BLOCK_FLAGS    = TLSF_ALIGN_SIZE - 1;
+
+            // Free list pointers live in the payload, so only the first two members are an overhead of used block.
+            struct TlsfBlock
+            {
+                TlsfBlock* pPrevPhysical;
+                size_t     sizeAndFlags;
+                TlsfBlock* pNextFree;
+                TlsfBlock* pPrevFree;
+            };
+
+            static constexpr size_t TLSF_BLOCK_OVERHEAD = offsetof( TlsfBlock, pNextFree );
+            static constexpr size_t TLSF_BLOCK_SIZE_MIN = sizeof( TlsfBlock ) - TLSF_BLOCK_OVERHEAD;
+            static constexpr size_t TLSF_BLOCK_SIZE_MAX = size_t( 1 ) << ( TLSF_FL_INDEX_MAX - 1 );
+
+            static_assert( TLSF_BLOCK_OVERHEAD == TLSF_ALIGN_SIZE, "Block overhead must keep payloads aligned." );
+
+            struct TlsfControl
+            {
+                uint32_t   flBitmap;
+                uint32_t   slBitmaps[ TLSF_FL_INDEX_COUNT ];
+                TlsfBlock* pBlocks[ TLSF_FL_INDEX_COUNT ][ TLSF_SL_INDEX_COUNT ];
+            };
+
+            static BGS_FORCEINLINE uint32_t FindFirstSet( uint32_t word )
+            {
+#if( BGS_VISUAL_STUDIO )
+                unsigned long ndx = 0;
+                _BitScanForward( &ndx, word );
+                return static_cast<uint32_t>( ndx );
+#else
+                return static_cast<uint32_t>( __builtin_ctz( word ) );
+#endif // ( BGS_VISUAL_STUDIO )
+            }
+
+            static BGS_FORCEINLINE uint32_t FindLastSet( size_t size )
+            {
+#if( BGS_VISUAL_STUDIO )
+                unsigned long ndx = 0;
+                _BitScanReverse64( &ndx, static_cast<uint64_t>( size ) );
+                return static_cast<uint32_t>( ndx );
+#else
+                return static_cast<uint32_t>( 63 - __builtin_clzll( static_cast<unsigned long long>( size ) ) );
+#endif // ( BGS_VISUAL_STUDIO )
+            }
+
+            static BGS_FORCEINLINE size_t GetBlockSize( const TlsfBlock* pBlock ) { return pBlock->sizeAndFlags & ~TLSF_BLOCK_FLAGS; }
+
+            static BGS_FORCEINLINE void SetBlockSize( TlsfBlock* pBlock, size_t size )
+            {
+                pBlock->sizeAndFlags = size | ( pBlock->sizeAndFlags & TLSF_BLOCK_FLAGS );
+            }
+
+            static BGS_FORCEINLINE bool_t IsBlockFree( const TlsfBlock* pBlock ) { return ( pBlock->sizeAndFlags & TLSF_BLOCK_FREE_BIT ) != 0; }
+
+            static BGS_FORCEINLINE void SetBlockFree( TlsfBlock* pBlock, bool_t free )
+            {
+                pBlock->sizeAndFlags = free ? ( pBlock->sizeAndFlags | TLSF_BLOCK_FREE_BIT ) : ( pBlock->sizeAndFlags & ~TLSF_BLOCK_FREE_BIT );
+            }
+
+            static BGS_FORCEINLINE byte_t* GetBlockPayload( TlsfBlock* pBlock ) { return reinterpret_cast<byte_t*>( pBlock ) + TLSF_BLOCK_OVERHEAD; }
+
+            static BGS_FORCEINLINE TlsfBlock* GetBlockFromPayload( void* pMemory )
+            {
+                return reinterpret_cast<TlsfBlock*>( static_cast<byte_t*>( pMemory ) - TLSF_BLOCK_OVERHEAD );
+            }
+
+            static BGS_FORCEINLINE TlsfBlock* GetNextPhysical( TlsfBlock* pBlock )
+            {
+                return reinterpret_cast<TlsfBlock*>( GetBlockPayload( pBlock ) + GetBlockSize( pBlock ) );
+            }
+
+            static BGS_FORCEINLINE size_t AlignUp( size_t value, size_t alignment ) { return ( value + alignment - 1 ) & ~( alignment - 1 ); }
+
+            static void MappingInsert( size_t size, uint32_t* pFl, uint32_t* pSl )
+            {
+                if( size < TLSF_SMALL_BLOCK_SIZE )
+                {
+                    *pFl = 0;
+                    *pSl = static_cast<uint32_t>( size / ( TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT ) );
+                }
+                else
+                {
+                    const uint32_t fl = FindLastSet( size );
+                    *pSl              = static_cast<uint32_t>( size >> ( fl - TLSF_SL_INDEX_COUNT_LOG2 ) ) ^ TLSF_SL_INDEX_COUNT;
+                    *pFl              = fl - ( TLSF_FL_INDEX_SHIFT - 1 );
+                }
+            }
+
+            // Rounds size up to the next list boundary, so any block found in that list is big enough
+            static BGS_FORCEINLINE size_t RoundUpToListSize( size_t size )
+            {
+                if( size >= TLSF_SMALL_BLOCK_SIZE )
+                {
+                    size += ( size_t( 1 ) << ( FindLastSet( size ) - TLSF_SL_INDEX_COUNT_LOG2 ) ) - 1;
+                }
+
+                return size;
+            }
+
+            static void MappingSearch( size_t size, uint32_t* pFl, uint32_t* pSl ) { MappingInsert( RoundUpToListSize( size ), pFl, pSl ); }
+
+            static TlsfBlock* FindSuitableBlock( TlsfControl* pControl, uint32_t* pFl, uint32_t* pSl )
+            {
+                uint32_t fl    = *pFl;
+                uint32_t slMap = pControl->slBitmaps[ fl ] & ( MAX_UINT32 << *pSl );
+                if( slMap == 0 )
+                {
+                    const uint32_t flMap = ( fl + 1 < 32 ) ? ( pControl->flBitmap & ( MAX_UINT32 << ( fl + 1 ) ) ) : 0;
+                    if( flMap == 0 )
+                    {
+                        return nullptr;
+                    }
+                    fl    = FindFirstSet( flMap );
+                    slMap = pControl->slBitmaps[ fl ];
+                }
+                const uint32_t sl = FindFirstSet( slMap );
+
+                *pFl = fl;
+                *pSl = sl;
+
+                return pControl->pBlocks[ fl ][ sl ];
+            }
+
+            static void RemoveFreeBlock( TlsfControl* pControl, TlsfBlock* pBlock, uint32_t fl, uint32_t sl )
+            {
+                TlsfBlock* pPrev = pBlock->pPrevFree;
+                TlsfBlock* pNext = pBlock->pNextFree;
+                if( pNext != nullptr )
+                {
+                    pNext->pPrevFree = pPrev;
+                }
+                if( pPrev != nullptr )
+                {
+                    pPrev->pNextFree = pNext;
+                }
+
+                if( pControl->pBlocks[ fl ][ sl ] == pBlock )
+                {
+                    pControl->pBlocks[ fl ][ sl ] = pNext;
+                    if( pNext == nullptr )
+                    {
+                        pControl->slBitmaps[ fl ] &= ~( 1u << sl );
+                        if( pControl->slBitmaps[ fl ] == 0 )
+                        {
+                            pControl->flBitmap &= ~( 1u << fl );
+                        }
+                    }
+                }
+            }
+
+            static void InsertFreeBlock( TlsfControl* pControl, TlsfBlock* pBlock, uint32_t fl, uint32_t sl )
+            {
+                TlsfBlock* pCurrent = pControl->pBlocks[ fl ][ sl ];
+                pBlock->pNextFree   = pCurrent;
+                pBlock->pPrevFree   = nullptr;
+                if( pCurrent != nullptr )
+                {
+                    pCurrent->pPrevFree = pBlock;
+                }
+
+                pControl->pBlocks[ fl ][ sl ] = pBlock;
+                pControl->flBitmap |= 1u << fl;
+                pControl->slBitmaps[ fl ] |= 1u << sl;
+            }
+
+            static void RemoveBlock( TlsfControl* pControl, TlsfBlock* pBlock )
+            {
+                uint32_t fl = 0;
+                uint32_t sl = 0;
+                MappingInsert( GetBlockSize( pBlock ), &fl, &sl );
+                RemoveFreeBlock( pControl, pBlock, fl, sl );
+            }
+
+            static void InsertBlock( TlsfControl* pControl, TlsfBlock* pBlock )
+            {
+                uint32_t fl = 0;
+                uint32_t sl = 0;
+                MappingInsert( GetBlockSize( pBlock ), &fl, &sl );
+                InsertFreeBlock( pControl, pBlock, fl, sl );
+            }
+
+            // Splits pBlock so that it has exactly size bytes of payload, returns the remainder
+            static TlsfBlock* SplitBlock( TlsfBlock* pBlock, size_t size )
+            {
+                TlsfBlock* pRemaining = reinterpret_cast<TlsfBlock*>( GetBlockPayload( pBlock ) + size );
+                pRemaining->sizeAndFlags = 0;
+                SetBlockSize( pRemaining, GetBlockSize( pBlock ) - size - TLSF_BLOCK_OVERHEAD );
+                SetBlockSize( pBlock, size );
+
+                pRemaining->pPrevPhysical                     = pBlock;
+                GetNextPhysical( pRemaining )->pPrevPhysical = pRemaining;
+
+                return pRemaining;
+            }
+
+            // Absorbs pBlock into its previous physical neighbour
+            static TlsfBlock* AbsorbBlock( TlsfBlock* pPrev, TlsfBlock* pBlock )
+            {
+                SetBlockSize( pPrev, GetBlockSize( pPrev ) + GetBlockSize( pBlock ) + TLSF_BLOCK_OVERHEAD );
+                GetNextPhysical( pPrev )->pPrevPhysical = pPrev;
+
+                return pPrev;
+            }
+
+            static TlsfBlock* MergeWithNeighbours( TlsfControl* pControl, TlsfBlock* pBlock )
+            {
+                TlsfBlock* pPrev = pBlock->pPrevPhysical;
+                if( ( pPrev != nullptr ) && IsBlockFree( pPrev ) )
+                {
+                    RemoveBlock( pControl, pPrev );
+                    pBlock = AbsorbBlock( pPrev, pBlock );
+                }
+
+                TlsfBlock* pNext = GetNextPhysical( pBlock );
+                if( IsBlockFree( pNext ) )
+                {
+                    RemoveBlock( pControl, pNext );
+                    pBlock = AbsorbBlock( pBlock, pNext );
+                }
+
+                return pBlock;
+            }
+
+            static void TrimFreeTail( TlsfControl* pControl, TlsfBlock* pBlock, size_t size )
+            {
+                if( GetBlockSize( pBlock ) >= size + sizeof( TlsfBlock ) )
+                {
+                    TlsfBlock* pRemaining = SplitBlock( pBlock, size );
+                    SetBlockFree( pRemaining, BGS_TRUE );
+                    pRemaining = MergeWithNeighbours( pControl, pRemaining );
+                    InsertBlock( pControl, pRemaining );
+                }
+            }
+
+            static TlsfBlock* TrimFreeHead( TlsfControl* pControl, TlsfBlock* pBlock, size_t gap )
+            {
+                // Gap is at least one full block, leading part stays free
+                TlsfBlock* pRemaining = SplitBlock( pBlock, gap - TLSF_BLOCK_OVERHEAD );
+                SetBlockFree( pBlock, BGS_TRUE );
+                InsertBlock( pControl, pBlock );
+
+                return pRemaining;
+            }
+
+            TlsfAllocator::TlsfAllocator()
+                : m_pools()
+                , m_mutex()
+                , m_pControl( nullptr )
+                , m_poolSize( 0 )
+                , m_usedSize( 0 )
+                , m_pParent( nullptr )
+            {
+            }
+
+            RESULT TlsfAllocator::Allocate( size_t size, void** ppMemory, const char* pFile, uint32_t line )
+            {
+                return AllocateAligned( size, TLSF_ALIGN_SIZE, ppMemory, pFile, line );
+            }
+
+            RESULT TlsfAllocator::AllocateAligned( size_t size, size_t alignment, void** ppMemory, const char* pFile, uint32_t line )
+            {
+                BGS_ASSERT( ( ppMemory != nullptr ) && ( *ppMemory == nullptr ) );
+                BGS_ASSERT( size > 0, "Block size must be greater than 0." );
+                pFile;
+                line;
+
+                if( ( alignment == DEFAULT_ALIGNMENT ) || ( alignment < TLSF_ALIGN_SIZE ) )
+                {
+                    alignment = TLSF_ALIGN_SIZE;
+                }
+                BGS_ASSERT( ( alignment & ( alignment - 1 ) ) == 0, "Alignment must be the power of 2." );
+
+                const size_t adjustedSize = size < TLSF_BLOCK_SIZE_MIN ? TLSF_BLOCK_SIZE_MIN : AlignUp( size, TLSF_ALIGN_SIZE );
+                // Over-aligned request needs room to cut off a free block in front of the aligned payload
+                const size_t gapMinimum   = sizeof( TlsfBlock );
+                const size_t searchSize   = alignment > TLSF_ALIGN_SIZE ? adjustedSize + alignment + gapMinimum : adjustedSize;
+                if( searchSize >= TLSF_BLOCK_SIZE_MAX )
+                {
+                    *ppMemory = nullptr;
+                    return Results::NO_MEMORY;
+                }
+
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                uint32_t fl = 0;
+                uint32_t sl = 0;
+                MappingSearch( searchSize, &fl, &sl );
+                TlsfBlock* pBlock = fl < TLSF_FL_INDEX_COUNT ? FindSuitableBlock( m_pControl, &fl, &sl ) : nullptr;
+                if( pBlock == nullptr )
+                {
+                    if( BGS_FAILED( AddPool( RoundUpToListSize( searchSize ) ) ) )
+                    {
+                        *ppMemory = nullptr;
+                        return Results::NO_MEMORY;
+                    }
+                    MappingSearch( searchSize, &fl, &sl );
+                    pBlock = FindSuitableBlock( m_pControl, &fl, &sl );
+                    BGS_ASSERT( pBlock != nullptr );
+                }
+                RemoveFreeBlock( m_pControl, pBlock, fl, sl );
+
+                if( alignment > TLSF_ALIGN_SIZE )
+                {
+                    const uintptr_t payloadAddress = reinterpret_cast<uintptr_t>( GetBlockPayload( pBlock ) );
+                    uintptr_t       alignedAddress = AlignUp( payloadAddress, alignment );
+                    if( ( alignedAddress != payloadAddress ) && ( alignedAddress - payloadAddress < gapMinimum ) )
+                    {
+                        alignedAddress = AlignUp( payloadAddress + gapMinimum, alignment );
+                    }
+
+                    const size_t gap = alignedAddress - payloadAddress;
+                    if( gap != 0 )
+                    {
+                        pBlock = TrimFreeHead( m_pControl, pBlock, gap );
+                    }
+                }
+
+                SetBlockFree( pBlock, BGS_FALSE );
+                TrimFreeTail( m_pControl, pBlock, adjustedSize );
+                m_usedSize += GetBlockSize( pBlock );
+                m_telemetry.OnAllocateExclusive( GetBlockSize( pBlock ) );
+
+                *ppMemory = GetBlockPayload( pBlock );
+
+                return Results::OK;
+            }
+
+            void TlsfAllocator::Free( void** ppMemory )
+            {
+                BGS_ASSERT( ( ppMemory != nullptr ) && ( *ppMemory != nullptr ) );
+
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                TlsfBlock* pBlock = GetBlockFromPayload( *ppMemory );
+                BGS_ASSERT( !IsBlockFree( pBlock ), "Memory block (*ppMemory) is already free." );
+
+                m_usedSize -= GetBlockSize( pBlock );
+                m_telemetry.OnFreeExclusive( GetBlockSize( pBlock ) );
+                SetBlockFree( pBlock, BGS_TRUE );
+                pBlock = MergeWithNeighbours( m_pControl, pBlock );
+                InsertBlock( m_pControl, pBlock );
+
+                *ppMemory = nullptr;
+            }
+
+            void TlsfAllocator::FreeAligned( void** ppMemory ) { Free( ppMemory ); }
+
+            RESULT TlsfAllocator::Create( const AllocatorDesc& desc )
+            {
+                BGS_ASSERT( desc.pParent != nullptr, "Invalid parent (pParent)." );
+                BGS_ASSERT( desc.type == AllocatorTypes::TLSF );
+                BGS_ASSERT( ( desc.capacity > 0 ) && ( desc.capacity < TLSF_BLOCK_SIZE_MAX ), "Capacity (capacity) must be in (0, 2GB) range." );
+                if( ( desc.pParent == nullptr ) || ( desc.capacity == 0 ) || ( desc.capacity >= TLSF_BLOCK_SIZE_MAX ) )
+                {
+                    return Results::FAIL;
+                }
+                m_pParent  = desc.pParent;
+                m_poolSize = AlignUp( desc.capacity, TLSF_ALIGN_SIZE );
+                m_usedSize = 0;
+
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetSystemHeapAllocator(), &m_pControl ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+                Memory::Set( m_pControl, 0, sizeof( TlsfControl ) );
+
+                if( BGS_FAILED( AddPool( 0 ) ) )
+                {
+                    Destroy();
+                    return Results::NO_MEMORY;
+                }
+
+                return Results::OK;
+            }
+
+            void TlsfAllocator::Destroy()
+            {
+                SystemHeapAllocator* pHeapAllocator = m_pParent->GetSystemHeapAllocator();
+                for( index_t ndx = 0; ndx < m_pools.size(); ++ndx )
+                {
+                    pHeapAllocator->FreeAligned( &m_pools[ ndx ] );
+                }
+                m_pools.clear();
+
+                if( m_pControl != nullptr )
+                {
+                    Memory::FreeObject( pHeapAllocator, &m_pControl );
+                }
+                m_poolSize = 0;
+                m_usedSize = 0;
+                m_pParent  = nullptr;
+            }
+
+            RESULT TlsfAllocator::AddPool( size_t minSize )
+            {
+                // Pool layout: [ block header | payload ... ][ sentinel header ], plus slack to align the start
+                const size_t poolOverhead = 2 * TLSF_BLOCK_OVERHEAD + TLSF_ALIGN_SIZE;
+                size_t       poolSize     = m_poolSize;
+                if( minSize + poolOverhead > poolSize )
+                {
+                    poolSize = AlignUp( minSize + poolOverhead, TLSF_ALIGN_SIZE );
+                }
+                if( poolSize - poolOverhead >= TLSF_BLOCK_SIZE_MAX )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                void* pPool = nullptr;
+                if( BGS_FAILED( m_pParent->GetSystemHeapAllocator()->AllocateAligned( poolSize, TLSF_ALIGN_SIZE, &pPool, BGS_MEMORY_CALLSITE ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+                m_pools.push_back( pPool );
+
+                // Do not trust heap alignment, debug heap shifts blocks by its header
+                const uintptr_t poolAddress = reinterpret_cast<uintptr_t>( pPool );
+                const uintptr_t startAddress = AlignUp( poolAddress, TLSF_ALIGN_SIZE );
+                const size_t    blockSize    = ( poolSize - ( startAddress - poolAddress ) - 2 * TLSF_BLOCK_OVERHEAD ) & ~TLSF_BLOCK_FLAGS;
+
+                TlsfBlock* pBlock     = reinterpret_cast<TlsfBlock*>( startAddress );
+                pBlock->pPrevPhysical = nullptr;
+                pBlock->sizeAndFlags  = blockSize | TLSF_BLOCK_FREE_BIT;
+
+                // Zero sized, always used sentinel stops merging at the end of the pool
+                TlsfBlock* pSentinel     = GetNextPhysical( pBlock );
+                pSentinel->pPrevPhysical = pBlock;
+                pSentinel->sizeAndFlags  = 0;
+
+                InsertBlock( m_pControl, pBlock );
+
+                return Results::OK;
+            }
+
+        } // namespace Memory
+    }     // namespace Core
+} // namespace BIGOS
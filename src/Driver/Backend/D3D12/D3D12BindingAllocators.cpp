@@ -1,38 +1,216 @@
 #include "D3D12BindingAllocators.h"
 
+#include <intrin.h>
+
 namespace BIGOS::Driver::Backend
 {
 
+    static constexpr uint32_t WORD_BIT_COUNT = 64;
+
+    static uint32_t FindFirstSetBit( uint64_t mask )
+    {
+        unsigned long ndx = 0;
+        _BitScanForward64( &ndx, mask );
+        return static_cast<uint32_t>( ndx );
+    }
+
+    static uint32_t FindLastSetBit( uint64_t mask )
+    {
+        unsigned long ndx = 0;
+        _BitScanReverse64( &ndx, mask );
+        return static_cast<uint32_t>( ndx );
+    }
+
     RESULT PoolAllocator::Create( uint32_t capacity )
     {
-        m_chunkMap.assign( capacity, BGS_TRUE );
+        BGS_ASSERT( capacity > 0, "Capacity (capacity) must be more than 0." );
+        if( capacity == 0 )
+        {
+            return Results::FAIL;
+        }
+
+        std::lock_guard<Mutex> lock( m_mutex );
+        m_capacity   = capacity;
+        m_levelCount = 0;
+
+        // Everything starts free, bits past the last index stay cleared
+        uint64_t bitCount = capacity;
+        do
+        {
+            const uint64_t       wordCount = ( bitCount + WORD_BIT_COUNT - 1 ) / WORD_BIT_COUNT;
+            HeapArray<uint64_t>& level     = m_levels[ m_levelCount++ ];
+            level.assign( static_cast<size_t>( wordCount ), MAX_UINT64 );
+            if( bitCount % WORD_BIT_COUNT != 0 )
+            {
+                level.back() = ( static_cast<uint64_t>( 1 ) << ( bitCount % WORD_BIT_COUNT ) ) - 1;
+            }
+            bitCount = wordCount;
+        } while( bitCount > 1 );
+
         return Results::OK;
     }
 
-    void PoolAllocator::Destroy() { m_chunkMap.clear(); }
+    void PoolAllocator::Destroy()
+    {
+        std::lock_guard<Mutex> lock( m_mutex );
+        for( uint32_t levelNdx = 0; levelNdx < m_levelCount; ++levelNdx )
+        {
+            m_levels[ levelNdx ].clear();
+        }
+        m_levelCount = 0;
+        m_capacity   = 0;
+    }
 
     RESULT PoolAllocator::Allocate( uint32_t* pNdx )
     {
         BGS_ASSERT( pNdx != nullptr, "Uint (pNdx) must be a valid address." );
-        for( index_t ndy = 0; ndy < m_chunkMap.size(); ++ndy )
+        BGS_ASSERT( m_levelCount > 0, "Allocator has to be created before allocating." );
+
+        std::lock_guard<Mutex> lock( m_mutex );
+        if( m_levels[ m_levelCount - 1 ][ 0 ] == 0 )
+        {
+            *pNdx = MAX_UINT32;
+            return Results::NO_MEMORY;
+        }
+
+        // Set bits always lead to a word with a free index, so descent never fails
+        uint32_t ndx = 0;
+        for( int32_t levelNdx = static_cast<int32_t>( m_levelCount ) - 1; levelNdx >= 0; --levelNdx )
+        {
+            ndx = ndx * WORD_BIT_COUNT + FindFirstSetBit( m_levels[ levelNdx ][ ndx ] );
+        }
+        SetUsed( ndx );
+
+        *pNdx = ndx;
+
+        return Results::OK;
+    }
+
+    RESULT PoolAllocator::AllocateRange( uint32_t count, uint32_t* pFirstNdx )
+    {
+        BGS_ASSERT( pFirstNdx != nullptr, "Uint (pFirstNdx) must be a valid address." );
+        BGS_ASSERT( count > 0, "Index count (count) must be more than 0." );
+        if( count == 1 )
+        {
+            return Allocate( pFirstNdx );
+        }
+
+        std::lock_guard<Mutex> lock( m_mutex );
+        const HeapArray<uint64_t>& bits      = m_levels[ 0 ];
+        uint32_t                   runStart  = 0;
+        uint32_t                   runLength = 0;
+        for( index_t wordNdx = 0; ( wordNdx < bits.size() ) && ( runLength < count ); ++wordNdx )
         {
-            if( m_chunkMap[ ndy ] )
+            const uint64_t word = bits[ wordNdx ];
+            if( word == 0 )
             {
-                *pNdx             = static_cast<uint32_t>( ndy );
-                m_chunkMap[ ndy ] = BGS_FALSE;
-                return Results::OK;
+                runLength = 0;
             }
+            else if( word == MAX_UINT64 )
+            {
+                runStart = runLength == 0 ? static_cast<uint32_t>( wordNdx ) * WORD_BIT_COUNT : runStart;
+                runLength += WORD_BIT_COUNT;
+            }
+            else
+            {
+                // Run carried over from the previous word goes on through the low free bits
+                const uint32_t wordStart = static_cast<uint32_t>( wordNdx ) * WORD_BIT_COUNT;
+                const uint32_t lowRun    = FindFirstSetBit( ~word );
+                if( runLength + lowRun >= count )
+                {
+                    runStart = runLength == 0 ? wordStart : runStart;
+                    runLength += lowRun;
+                    continue;
+                }
+
+                // Bit stays set only when count free bits start at it
+                uint64_t runs = count <= WORD_BIT_COUNT ? word : 0;
+                for( uint32_t length = 1; ( length < count ) && ( runs != 0 ); )
+                {
+                    const uint32_t step = length < count - length ? length : count - length;
+                    runs &= runs >> step;
+                    length += step;
+                }
+
+                if( runs != 0 )
+                {
+                    runStart  = wordStart + FindFirstSetBit( runs );
+                    runLength = count;
+                }
+                else
+                {
+                    // Free bits at the top start a run into the next word
+                    runLength = WORD_BIT_COUNT - 1 - FindLastSetBit( ~word );
+                    runStart  = wordStart + WORD_BIT_COUNT - runLength;
+                }
+            }
+        }
+
+        if( runLength < count )
+        {
+            *pFirstNdx = MAX_UINT32;
+            return Results::NO_MEMORY;
         }
 
-        *pNdx = MAX_UINT32;
+        for( uint32_t ndx = runStart; ndx < runStart + count; ++ndx )
+        {
+            SetUsed( ndx );
+        }
+
+        *pFirstNdx = runStart;
 
-        return Results::NO_MEMORY;
+        return Results::OK;
     }
 
     void PoolAllocator::Free( uint32_t ndx )
     {
-        BGS_ASSERT( ndx < static_cast<uint32_t>( m_chunkMap.size() ), "Allocation index (ndx) out of range." );
-        BGS_ASSERT( m_chunkMap[ ndx ] == BGS_FALSE, "Given index (ndx) is already free." );
-        m_chunkMap[ ndx ] = BGS_TRUE;
+        BGS_ASSERT( ndx < m_capacity, "Allocation index (ndx) out of range." );
+
+        std::lock_guard<Mutex> lock( m_mutex );
+        SetFree( ndx );
+    }
+
+    void PoolAllocator::FreeRange( uint32_t firstNdx, uint32_t count )
+    {
+        BGS_ASSERT( ( firstNdx < m_capacity ) && ( count <= m_capacity - firstNdx ), "Allocation range (firstNdx, count) out of range." );
+
+        std::lock_guard<Mutex> lock( m_mutex );
+        for( uint32_t ndx = firstNdx; ndx < firstNdx + count; ++ndx )
+        {
+            SetFree( ndx );
+        }
+    }
+
+    void PoolAllocator::SetFree( uint32_t ndx )
+    {
+        BGS_ASSERT( ( m_levels[ 0 ][ ndx / WORD_BIT_COUNT ] & ( static_cast<uint64_t>( 1 ) << ( ndx % WORD_BIT_COUNT ) ) ) == 0,
+                    "Given index (ndx) is already free." );
+
+        // Upper levels change only when word goes from full to having a free index
+        for( uint32_t levelNdx = 0; levelNdx < m_levelCount; ++levelNdx )
+        {
+            uint64_t&    word   = m_levels[ levelNdx ][ ndx / WORD_BIT_COUNT ];
+            const bool_t isFull = word == 0;
+            word |= static_cast<uint64_t>( 1 ) << ( ndx % WORD_BIT_COUNT );
+            if( !isFull )
+            {
+                break;
+            }
+            ndx /= WORD_BIT_COUNT;
+        }
+    }
+
+    void PoolAllocator::SetUsed( uint32_t ndx )
+    {
+        for( uint32_t levelNdx = 0; levelNdx < m_levelCount; ++levelNdx )
+        {
+            uint64_t& word = m_levels[ levelNdx ][ ndx / WORD_BIT_COUNT ];
+            word &= ~( static_cast<uint64_t>( 1 ) << ( ndx % WORD_BIT_COUNT ) );
+            if( word != 0 )
+            {
+                break;
+            }
+            ndx /= WORD_BIT_COUNT;
+        }
     }
 } // namespace BIGOS::Driver::Backend
\ No newline at end of file
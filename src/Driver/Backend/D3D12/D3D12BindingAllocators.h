@@ -5,8 +5,12 @@
 namespace BIGOS::Driver::Backend
 {
 
+    // Hierarchical bitmap of free indices. Bit in upper level is set when its word in level below has any free index,
+    // so Allocate() and Free() touch one word per level. All methods are thread safe.
     class PoolAllocator
     {
+        static constexpr uint32_t MAX_LEVEL_COUNT = 6; // Enough for 2^32 indices
+
     public:
         PoolAllocator()  = default;
         ~PoolAllocator() = default;
@@ -15,10 +19,19 @@ namespace BIGOS::Driver::Backend
         void   Destroy();
 
         RESULT Allocate( uint32_t* pNdx );
+        RESULT AllocateRange( uint32_t count, uint32_t* pFirstNdx ); // Contiguous indices for tables, scans whole bitmap
         void   Free( uint32_t ndx );
+        void   FreeRange( uint32_t firstNdx, uint32_t count );
+
+    private:
+        void SetFree( uint32_t ndx );
+        void SetUsed( uint32_t ndx );
 
     private:
-        HeapArray<bool_t> m_chunkMap;
+        HeapArray<uint64_t> m_levels[ MAX_LEVEL_COUNT ]; // Level 0 has one bit per index
+        uint32_t            m_levelCount = 0;
+        uint32_t            m_capacity   = 0;
+        Mutex               m_mutex;
     };
 
 } // namespace BIGOS::Driver::Backend
\ No newline at end of file
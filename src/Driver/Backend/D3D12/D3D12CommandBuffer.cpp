@@ -390,6 +390,9 @@ namespace BIGOS
                 D3D12_BUFFER_BARRIER  bufferBarriers[ Config::Driver::Synchronization::MAX_BUFFER_BARRIER_COUNT ];
                 D3D12_TEXTURE_BARRIER textureBarriers[ Config::Driver::Synchronization::MAX_TEXTURE_BARRIER_COUNT ];
 
+                // Only direct queues can discard render targets and depth stencils
+                const bool_t canDiscard = ( m_desc.pQueue != nullptr ) && ( m_desc.pQueue->GetDesc().type == QueueTypes::GRAPHICS );
+
                 D3D12_BARRIER_GROUP barriers[ 3 ];
                 barriers[ 0 ].Type             = D3D12_BARRIER_TYPE_GLOBAL;
                 barriers[ 0 ].NumBarriers      = desc.globalBarrierCount;
@@ -423,6 +426,21 @@ namespace BIGOS
                     barrier.pResource    = currDesc.hResouce.GetNativeHandle()->pNativeResource;
                     barrier.Offset       = currDesc.bufferRange.offset;
                     barrier.Size         = currDesc.bufferRange.size;
+                    // Buffers have no layouts, only side recorded on the other queue is dropped
+                    if( ( currDesc.pSrcQueue != nullptr ) && ( currDesc.pDstQueue != nullptr ) &&
+                        ( currDesc.pSrcQueue->GetDesc().type != currDesc.pDstQueue->GetDesc().type ) )
+                    {
+                        if( currDesc.pSrcQueue == m_desc.pQueue )
+                        {
+                            barrier.AccessAfter = D3D12_BARRIER_ACCESS_NO_ACCESS;
+                            barrier.SyncAfter   = D3D12_BARRIER_SYNC_NONE;
+                        }
+                        else
+                        {
+                            barrier.AccessBefore = D3D12_BARRIER_ACCESS_NO_ACCESS;
+                            barrier.SyncBefore   = D3D12_BARRIER_SYNC_NONE;
+                        }
+                    }
                 }
                 for( index_t ndx = 0; ndx < static_cast<index_t>( desc.textureBarrierCount ); ++ndx )
                 {
@@ -442,7 +460,33 @@ namespace BIGOS
                     barrier.Subresources.NumMipLevels         = currDesc.textureRange.mipLevelCount;
                     barrier.Subresources.FirstArraySlice      = currDesc.textureRange.arrayLayer;
                     barrier.Subresources.NumArraySlices       = currDesc.textureRange.arrayLayerCount;
-                    barrier.Flags                             = D3D12_TEXTURE_BARRIER_FLAG_NONE; // TODO: Handle! Very important!
+                    // Texture passes between queue types in common layout, copy queues do not support other layouts. Side
+                    // recorded on the other queue keeps its layout
+                    if( ( currDesc.pSrcQueue != nullptr ) && ( currDesc.pDstQueue != nullptr ) &&
+                        ( currDesc.pSrcQueue->GetDesc().type != currDesc.pDstQueue->GetDesc().type ) )
+                    {
+                        if( currDesc.pSrcQueue == m_desc.pQueue )
+                        {
+                            barrier.AccessAfter = D3D12_BARRIER_ACCESS_NO_ACCESS;
+                            barrier.SyncAfter   = D3D12_BARRIER_SYNC_NONE;
+                            barrier.LayoutAfter = D3D12_BARRIER_LAYOUT_COMMON;
+                        }
+                        else
+                        {
+                            barrier.AccessBefore = D3D12_BARRIER_ACCESS_NO_ACCESS;
+                            barrier.SyncBefore   = D3D12_BARRIER_SYNC_NONE;
+                            barrier.LayoutBefore = D3D12_BARRIER_LAYOUT_COMMON;
+                        }
+                    }
+                    // Undefined source layout means previous content is not needed (first use, memory aliasing). Render targets and
+                    // depth stencils placed in aliased memory need discard to initialize their compression metadata
+                    barrier.Flags = D3D12_TEXTURE_BARRIER_FLAG_NONE;
+                    if( canDiscard && ( currDesc.srcLayout == TextureLayouts::UNDEFINED ) &&
+                        ( barrier.pResource->GetDesc().Flags &
+                          ( D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL ) ) )
+                    {
+                        barrier.Flags = D3D12_TEXTURE_BARRIER_FLAG_DISCARD;
+                    }
                 }
 
                 ID3D12GraphicsCommandList7* pNativeCommandList = m_handle.GetNativeHandle();
@@ -502,6 +546,8 @@ namespace BIGOS
                 BGS_ASSERT( desc.hBuffer != ResourceHandle(), "Buffer (desc.hBuffer) must be a valid handle." );
                 BGS_ASSERT( desc.hTexture != ResourceHandle(), "Texture (desc.hTexture) must be a valid handle." );
                 BGS_ASSERT( desc.bufferOffset % 512 == 0, "Buffer offset (desc.bufferOffset) must be 512 aligned." );
+                BGS_ASSERT( desc.bufferRowPitch % Config::Driver::Memory::TEXTURE_ROW_PITCH_ALIGNMENT == 0,
+                            "Row pitch (desc.bufferRowPitch) must be %d aligned.", Config::Driver::Memory::TEXTURE_ROW_PITCH_ALIGNMENT );
 
                 D3D12_TEXTURE_COPY_LOCATION srcBuff;
                 srcBuff.pResource                          = desc.hBuffer.GetNativeHandle()->pNativeResource;
@@ -511,7 +557,8 @@ namespace BIGOS
                 srcBuff.PlacedFootprint.Footprint.Height   = desc.size.height;
                 srcBuff.PlacedFootprint.Footprint.Depth    = desc.size.depth;
                 srcBuff.PlacedFootprint.Footprint.Format   = MapBigosFormatToD3D12Format( desc.textureFormat );
-                srcBuff.PlacedFootprint.Footprint.RowPitch = GetBigosFormatSize( desc.textureFormat ) * desc.size.width;
+                srcBuff.PlacedFootprint.Footprint.RowPitch =
+                    desc.bufferRowPitch != 0 ? desc.bufferRowPitch : GetBigosFormatSize( desc.textureFormat ) * desc.size.width;
 
                 const uint32_t dstNdx = D3D12CalcSubresource( desc.textureRange.mipLevel, desc.textureRange.arrayLayer,
                                                               MapBigosTextureComponentFlagsToD3D12PlaneSlice( desc.textureRange.components ),
@@ -532,6 +579,8 @@ namespace BIGOS
                 BGS_ASSERT( desc.hBuffer != ResourceHandle(), "Buffer (desc.hBuffer) must be a valid handle." );
                 BGS_ASSERT( desc.hTexture != ResourceHandle(), "Texture (desc.hTexture) must be a valid handle." );
                 BGS_ASSERT( desc.bufferOffset % 512 == 0, "Buffer offset (desc.bufferOffset) must be 512 aligned." );
+                BGS_ASSERT( desc.bufferRowPitch % Config::Driver::Memory::TEXTURE_ROW_PITCH_ALIGNMENT == 0,
+                            "Row pitch (desc.bufferRowPitch) must be %d aligned.", Config::Driver::Memory::TEXTURE_ROW_PITCH_ALIGNMENT );
 
                 const uint32_t srcNdx = D3D12CalcSubresource( desc.textureRange.mipLevel, desc.textureRange.arrayLayer,
                                                               MapBigosTextureComponentFlagsToD3D12PlaneSlice( desc.textureRange.components ),
@@ -550,7 +599,8 @@ namespace BIGOS
                 dstBuff.PlacedFootprint.Footprint.Height   = desc.size.height;
                 dstBuff.PlacedFootprint.Footprint.Depth    = desc.size.depth;
                 dstBuff.PlacedFootprint.Footprint.Format   = MapBigosFormatToD3D12Format( desc.textureFormat );
-                dstBuff.PlacedFootprint.Footprint.RowPitch = GetBigosFormatSize( desc.textureFormat ) * desc.size.width;
+                dstBuff.PlacedFootprint.Footprint.RowPitch =
+                    desc.bufferRowPitch != 0 ? desc.bufferRowPitch : GetBigosFormatSize( desc.textureFormat ) * desc.size.width;
 
                 D3D12_BOX region;
                 region.left   = desc.textureOffset.x;
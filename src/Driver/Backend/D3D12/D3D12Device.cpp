@@ -18,6 +18,7 @@
 #include "D3D12Sampler.h"
 #include "D3D12Shader.h"
 #include "D3D12Swapchain.h"
+#include "Driver/Backend/APICommon.h"
 #include "Driver/Frontend/RenderSystem.h"
 
 namespace BIGOS
@@ -74,6 +75,63 @@ namespace BIGOS
                 return result;
             }
 
+            // Pipelines are stored in pipeline library under hash of everything that describes them. Pointers are replaced by data
+            // they point to and descs are zeroed before filling, so padding does not change the name.
+            static uint64_t HashD3D12GraphicsPipeline( const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t signatureHash )
+            {
+                D3D12_GRAPHICS_PIPELINE_STATE_DESC keyDesc;
+                Memory::Copy( &desc, sizeof( desc ), &keyDesc, sizeof( keyDesc ) );
+                keyDesc.pRootSignature                 = nullptr;
+                keyDesc.VS.pShaderBytecode             = nullptr;
+                keyDesc.PS.pShaderBytecode             = nullptr;
+                keyDesc.DS.pShaderBytecode             = nullptr;
+                keyDesc.HS.pShaderBytecode             = nullptr;
+                keyDesc.GS.pShaderBytecode             = nullptr;
+                keyDesc.InputLayout.pInputElementDescs = nullptr;
+
+                uint64_t hash = Core::Utils::Hash::FNV1a( &keyDesc, sizeof( keyDesc ), signatureHash );
+                hash          = Core::Utils::Hash::FNV1a( desc.VS.pShaderBytecode, desc.VS.BytecodeLength, hash );
+                hash          = Core::Utils::Hash::FNV1a( desc.PS.pShaderBytecode, desc.PS.BytecodeLength, hash );
+                hash          = Core::Utils::Hash::FNV1a( desc.DS.pShaderBytecode, desc.DS.BytecodeLength, hash );
+                hash          = Core::Utils::Hash::FNV1a( desc.HS.pShaderBytecode, desc.HS.BytecodeLength, hash );
+                hash          = Core::Utils::Hash::FNV1a( desc.GS.pShaderBytecode, desc.GS.BytecodeLength, hash );
+                for( UINT ndx = 0; ndx < desc.InputLayout.NumElements; ++ndx )
+                {
+                    D3D12_INPUT_ELEMENT_DESC elem;
+                    Memory::Copy( &desc.InputLayout.pInputElementDescs[ ndx ], sizeof( elem ), &elem, sizeof( elem ) );
+                    if( elem.SemanticName != nullptr )
+                    {
+                        hash = Core::Utils::Hash::FNV1a( elem.SemanticName, strlen( elem.SemanticName ), hash );
+                    }
+                    elem.SemanticName = nullptr;
+                    hash              = Core::Utils::Hash::FNV1a( &elem, sizeof( elem ), hash );
+                }
+
+                return hash;
+            }
+
+            static uint64_t HashD3D12ComputePipeline( const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, uint64_t signatureHash )
+            {
+                D3D12_COMPUTE_PIPELINE_STATE_DESC keyDesc;
+                Memory::Copy( &desc, sizeof( desc ), &keyDesc, sizeof( keyDesc ) );
+                keyDesc.pRootSignature     = nullptr;
+                keyDesc.CS.pShaderBytecode = nullptr;
+
+                const uint64_t hash = Core::Utils::Hash::FNV1a( &keyDesc, sizeof( keyDesc ), signatureHash );
+
+                return Core::Utils::Hash::FNV1a( desc.CS.pShaderBytecode, desc.CS.BytecodeLength, hash );
+            }
+
+            static void GetD3D12PipelineName( uint64_t hash, wchar_t ( &name )[ 17 ] )
+            {
+                static const wchar_t hexDigits[] = L"0123456789ABCDEF";
+                for( uint32_t ndx = 0; ndx < 16; ++ndx )
+                {
+                    name[ ndx ] = hexDigits[ ( hash >> ( 60 - 4 * ndx ) ) & 0xF ];
+                }
+                name[ 16 ] = L'\0';
+            }
+
             RESULT D3D12Device::CreateQueue( const QueueDesc& desc, IQueue** ppQueue )
             {
                 BGS_ASSERT( ppQueue != nullptr, "Queue (ppQueue) must be a valid address." );
@@ -84,7 +142,7 @@ namespace BIGOS
                 }
 
                 D3D12Queue* pQueue = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pQueue ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetDefaultAllocator(), &pQueue ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -127,7 +185,7 @@ namespace BIGOS
                 }
 
                 D3D12Swapchain* pSwapchain = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pSwapchain ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetDefaultAllocator(), &pSwapchain ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -220,7 +278,7 @@ namespace BIGOS
                 }
 
                 D3D12CommandBuffer* pCommandBuffer = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pCommandBuffer ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetDefaultAllocator(), &pCommandBuffer ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -260,7 +318,7 @@ namespace BIGOS
                 D3D12ShaderModule* pNativeShader = nullptr;
                 const uint32_t     allocSize     = sizeof( D3D12ShaderModule ) + desc.codeSize;
                 byte_t*            pMem          = nullptr;
-                if( BGS_FAILED( Core::Memory::AllocateBytes( m_pParent->GetParent()->GetDefaultAllocator(), &pMem, allocSize ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetDefaultAllocator(), &pMem, allocSize ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -310,7 +368,7 @@ namespace BIGOS
                 }
 
                 D3D12PipelineLayout* pPipelineLayout = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pPipelineLayout ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetDefaultAllocator(), &pPipelineLayout ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -410,6 +468,7 @@ namespace BIGOS
                     Memory::FreeObject( m_pParent->GetParent()->GetDefaultAllocator(), &pPipelineLayout );
                     return Results::FAIL;
                 }
+                pPipelineLayout->signatureHash = Core::Utils::Hash::FNV1a( pSignature->GetBufferPointer(), pSignature->GetBufferSize() );
                 RELEASE_COM_PTR( pSignature );
                 RELEASE_COM_PTR( pError );
 
@@ -496,6 +555,45 @@ namespace BIGOS
                 }
             }
 
+            RESULT D3D12Device::GetPipelineCacheData( void* pData, uint64_t* pSize )
+            {
+                BGS_ASSERT( pSize != nullptr, "Size (pSize) must be a valid address." );
+                if( ( pSize == nullptr ) || ( m_pPipelineLibrary == nullptr ) )
+                {
+                    return Results::FAIL;
+                }
+
+                std::lock_guard<Mutex> lock( m_pipelineLibraryMutex );
+
+                const uint64_t nativeSize = static_cast<uint64_t>( m_pPipelineLibrary->GetSerializedSize() );
+                if( pData == nullptr )
+                {
+                    *pSize = sizeof( PipelineCacheHeader ) + nativeSize;
+
+                    return Results::OK;
+                }
+
+                BGS_ASSERT( *pSize >= sizeof( PipelineCacheHeader ) + nativeSize, "Size (pSize) must fit whole pipeline library." );
+                if( *pSize < sizeof( PipelineCacheHeader ) + nativeSize )
+                {
+                    return Results::FAIL;
+                }
+
+                byte_t* pNativeData = static_cast<byte_t*>( pData ) + sizeof( PipelineCacheHeader );
+                if( FAILED( m_pPipelineLibrary->Serialize( pNativeData, static_cast<SIZE_T>( nativeSize ) ) ) )
+                {
+                    return Results::FAIL;
+                }
+
+                PipelineCacheHeader header = m_pipelineCacheHeader;
+                header.dataSize            = nativeSize;
+                header.dataHash            = Core::Utils::Hash::FNV1a( pNativeData, nativeSize );
+                Memory::Copy( &header, sizeof( header ), pData, sizeof( header ) );
+                *pSize = sizeof( header ) + nativeSize;
+
+                return Results::OK;
+            }
+
             RESULT D3D12Device::CreateFence( const FenceDesc& desc, FenceHandle* pHandle )
             {
                 BGS_ASSERT( pHandle != nullptr, "Fence (pHandle) must be a valid address." );
@@ -503,7 +601,7 @@ namespace BIGOS
                 ID3D12Device* pNativeDevice = m_handle.GetNativeHandle();
                 D3D12Fence*   pNativeFence  = nullptr;
 
-                if( BGS_FAILED( Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pNativeFence ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetDefaultAllocator(), &pNativeFence ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -680,6 +778,42 @@ namespace BIGOS
                 }
             }
 
+            RESULT D3D12Device::QueryMemoryBudget( MemoryBudgetInfo* pInfo )
+            {
+                BGS_ASSERT( pInfo != nullptr, "Memory budget info (pInfo) must be a valid address." );
+                if( pInfo == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                static const DXGI_MEMORY_SEGMENT_GROUP segmentGroups[ BGS_ENUM_COUNT( MemorySegmentTypes ) ] = {
+                    DXGI_MEMORY_SEGMENT_GROUP_LOCAL,     // LOCAL
+                    DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL, // NON_LOCAL
+                };
+
+                IDXGIAdapter1* pNativeAdapter = m_desc.pAdapter->GetHandle().GetNativeHandle();
+                IDXGIAdapter3* pAdapter3      = nullptr;
+                if( FAILED( pNativeAdapter->QueryInterface( IID_PPV_ARGS( &pAdapter3 ) ) ) )
+                {
+                    return Results::NOT_FOUND;
+                }
+
+                for( index_t ndx = 0; ndx < BGS_ENUM_COUNT( MemorySegmentTypes ); ++ndx )
+                {
+                    DXGI_QUERY_VIDEO_MEMORY_INFO memInfo;
+                    if( FAILED( pAdapter3->QueryVideoMemoryInfo( 0, segmentGroups[ ndx ], &memInfo ) ) )
+                    {
+                        RELEASE_COM_PTR( pAdapter3 );
+                        return Results::FAIL;
+                    }
+                    pInfo->segments[ ndx ].budget = memInfo.Budget;
+                    pInfo->segments[ ndx ].usage  = memInfo.CurrentUsage;
+                }
+                RELEASE_COM_PTR( pAdapter3 );
+
+                return Results::OK;
+            }
+
             RESULT D3D12Device::CreateResource( const ResourceDesc& desc, ResourceHandle* pHandle )
             {
                 BGS_ASSERT( pHandle != nullptr, "Resource (pHandle) must be a valid address." );
@@ -688,7 +822,7 @@ namespace BIGOS
                 // In D3D12 we only fill resource desc in this function. Resource will be created while binding to memory (mimicing vulkan
                 // behaviour)
                 D3D12Resource* pResource = nullptr;
-                if( BGS_FAILED( Core::Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pResource ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetObjectAllocator(), &pResource ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -732,6 +866,8 @@ namespace BIGOS
                 }
 
                 pResource->pNativeResource = nullptr;
+                pResource->flags           = desc.flags;
+                pResource->pHostMemory     = nullptr;
 
                 *pHandle = ResourceHandle( pResource );
 
@@ -746,9 +882,13 @@ namespace BIGOS
                 {
                     D3D12Resource* pNativeResource = pHandle->GetNativeHandle();
 
+                    if( pNativeResource->pHostMemory != nullptr )
+                    {
+                        pNativeResource->pNativeResource->Unmap( 0, nullptr );
+                    }
                     RELEASE_COM_PTR( pNativeResource->pNativeResource );
 
-                    Core::Memory::FreeObject( m_pParent->GetParent()->GetDefaultAllocator(), &pNativeResource );
+                    Core::Memory::FreeObject( m_pParent->GetParent()->GetObjectAllocator(), &pNativeResource );
 
                     *pHandle = ResourceHandle();
                 }
@@ -812,8 +952,23 @@ namespace BIGOS
                     return Results::FAIL;
                 }
 
-                ID3D12Resource*            pNativeResource = desc.hResource.GetNativeHandle()->pNativeResource;
-                const D3D12_RESOURCE_DESC& resDesc         = desc.hResource.GetNativeHandle()->desc;
+                D3D12Resource* pResource = desc.hResource.GetNativeHandle();
+                if( pResource->flags & BGS_FLAG( ResourceFlagBits::PERSISTENT_MAP ) )
+                {
+                    BGS_ASSERT( pResource->desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER, "Only buffers can be persistently mapped." );
+                    // Whole buffer is mapped on first use and stays mapped until resource is destroyed
+                    if( ( pResource->pHostMemory == nullptr ) && FAILED( pResource->pNativeResource->Map( 0, nullptr, &pResource->pHostMemory ) ) )
+                    {
+                        pResource->pHostMemory = nullptr;
+                        return Results::FAIL;
+                    }
+                    *ppResource = pResource->pHostMemory;
+
+                    return Results::OK;
+                }
+
+                ID3D12Resource*            pNativeResource = pResource->pNativeResource;
+                const D3D12_RESOURCE_DESC& resDesc         = pResource->desc;
                 uint32_t                   subResNdx       = 0;
                 D3D12_RANGE*               pResRange       = nullptr;
                 D3D12_RANGE                resRange;
@@ -848,8 +1003,14 @@ namespace BIGOS
                     return Results::FAIL;
                 }
 
-                ID3D12Resource*            pNativeResource = desc.hResource.GetNativeHandle()->pNativeResource;
-                const D3D12_RESOURCE_DESC& resDesc         = desc.hResource.GetNativeHandle()->desc;
+                D3D12Resource* pResource = desc.hResource.GetNativeHandle();
+                if( pResource->flags & BGS_FLAG( ResourceFlagBits::PERSISTENT_MAP ) )
+                {
+                    return Results::OK;
+                }
+
+                ID3D12Resource*            pNativeResource = pResource->pNativeResource;
+                const D3D12_RESOURCE_DESC& resDesc         = pResource->desc;
                 uint32_t                   subResNdx       = 0;
                 D3D12_RANGE*               pResRange       = nullptr;
                 D3D12_RANGE                resRange;
@@ -872,6 +1033,21 @@ namespace BIGOS
                 return Results::OK;
             }
 
+            RESULT D3D12Device::FlushRange( const MapResourceDesc& desc )
+            {
+                // CPU visible D3D12 heaps are always coherent
+                desc;
+
+                return Results::OK;
+            }
+
+            RESULT D3D12Device::InvalidateRange( const MapResourceDesc& desc )
+            {
+                desc;
+
+                return Results::OK;
+            }
+
             RESULT D3D12Device::CreateResourceView( const ResourceViewDesc& desc, ResourceViewHandle* pHandle )
             {
                 BGS_ASSERT( pHandle != nullptr, "Resource view (pHandle) must be a valid address." );
@@ -881,7 +1057,7 @@ namespace BIGOS
                 }
 
                 D3D12ResourceView* pResView = nullptr;
-                if( BGS_FAILED( Core::Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pResView ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetObjectAllocator(), &pResView ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -967,7 +1143,7 @@ namespace BIGOS
                         m_descHeaps[ static_cast<uint32_t>( D3D12_DESCRIPTOR_HEAP_TYPE_DSV ) ].allocator.Free( pNativeView->dsvNdx );
                     }
 
-                    Core::Memory::FreeObject( m_pParent->GetParent()->GetDefaultAllocator(), &pNativeView );
+                    Core::Memory::FreeObject( m_pParent->GetParent()->GetObjectAllocator(), &pNativeView );
 
                     *pHandle = ResourceViewHandle();
                 }
@@ -982,7 +1158,7 @@ namespace BIGOS
                 }
 
                 D3D12Sampler* pSampler = nullptr;
-                if( BGS_FAILED( Core::Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pSampler ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetObjectAllocator(), &pSampler ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -1043,7 +1219,7 @@ namespace BIGOS
                         m_descHeaps[ BGS_ENUM_INDEX( D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ) ].allocator.Free( pNativeSampler->ndx );
                     }
 
-                    Core::Memory::FreeObject( m_pParent->GetParent()->GetDefaultAllocator(), &pNativeSampler );
+                    Core::Memory::FreeObject( m_pParent->GetParent()->GetObjectAllocator(), &pNativeSampler );
 
                     *pHandle = SamplerHandle();
                 }
@@ -1103,7 +1279,7 @@ namespace BIGOS
                 byte_t* pMem = nullptr;
                 // Calculating size of needed memory allocation
                 const uint32_t allocSize = sizeof( D3D12BindingSetLayout ) + desc.bindingRangeCount * sizeof( D3D12_DESCRIPTOR_RANGE1 );
-                if( BGS_FAILED( Core::Memory::AllocateBytes( m_pParent->GetParent()->GetDefaultAllocator(), &pMem, allocSize ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetDefaultAllocator(), &pMem, allocSize ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -1198,22 +1374,78 @@ namespace BIGOS
                                      : desc.bindingNdx * m_limits.constantBufferBindingSize; // each binding has the same size besides samplers
             }
 
-            void D3D12Device::WriteBinding( const WriteBindingDesc& desc )
+            void D3D12Device::GetBindingSetLayoutSize( BindingSetLayoutHandle handle, uint64_t* pSize )
             {
-                BGS_ASSERT( desc.hDstHeap != BindingHeapHandle(), "Binding heap handle (desc.hDstHeap) must be a valid handle." );
-                BGS_ASSERT( ( desc.hResourceView != ResourceViewHandle() || desc.hSampler != SamplerHandle() ),
-                            "Resource view handle (desc.hResourceView) or sampler handle (desc.hSampler) must be a valid handle." );
+                BGS_ASSERT( pSize != nullptr, "Size (pSize) must be a valid address." );
+                BGS_ASSERT( handle != BindingSetLayoutHandle(), "Binding set layout handle (handle) must be a valid handle." );
 
-                ID3D12Device*              pNativeDevice = m_handle.GetNativeHandle();
-                D3D12_DESCRIPTOR_HEAP_TYPE heapType      = MapBigosBindingTypeToD3D12DescriptorHeapType( desc.bindingType );
+                const D3D12BindingSetLayout* pLayout = handle.GetNativeHandle();
+                uint64_t                     size    = 0;
+                for( index_t ndx = 0; static_cast<uint32_t>( ndx ) < pLayout->rangeCount; ++ndx )
+                {
+                    const BindingRangeDesc& range = pLayout->pRanges[ ndx ];
+                    size += range.bindingCount * m_bindingSizes[ BGS_ENUM_INDEX( range.type ) ];
+                }
 
-                const uint32_t              srcNdx = desc.bindingType == BindingTypes::SAMPLER ? desc.hSampler.GetNativeHandle()->ndx
-                                                                                               : desc.hResourceView.GetNativeHandle()->cbvSrvUavNdx;
-                D3D12_CPU_DESCRIPTOR_HANDLE src{ m_descHeaps[ BGS_ENUM_INDEX( heapType ) ].pHeap->GetCPUDescriptorHandleForHeapStart().ptr +
-                                                 m_bindingSizes[ BGS_ENUM_INDEX( desc.bindingType ) ] * srcNdx };
-                D3D12_CPU_DESCRIPTOR_HANDLE dst{ desc.hDstHeap.GetNativeHandle()->GetCPUDescriptorHandleForHeapStart().ptr + desc.dstOffset };
+                *pSize = size;
+            }
 
-                pNativeDevice->CopyDescriptorsSimple( 1, dst, src, heapType );
+            void D3D12Device::WriteBindings( const WriteBindingDesc* pDescs, uint32_t descCount )
+            {
+                BGS_ASSERT( ( pDescs != nullptr ) || ( descCount == 0 ), "Binding writes (pDescs) must be a valid address." );
+
+                static constexpr uint32_t MAX_COPY_COUNT = 64;
+
+                ID3D12Device*                                           pNativeDevice = m_handle.GetNativeHandle();
+                StackArray<D3D12_CPU_DESCRIPTOR_HANDLE, MAX_COPY_COUNT> srcStarts;
+                StackArray<D3D12_CPU_DESCRIPTOR_HANDLE, MAX_COPY_COUNT> dstStarts;
+                StackArray<UINT, MAX_COPY_COUNT>                        dstSizes;
+                uint32_t                                                srcCount      = 0;
+                uint32_t                                                dstCount      = 0;
+                D3D12_DESCRIPTOR_HEAP_TYPE                              batchType     = D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES;
+                for( uint32_t ndx = 0; ndx < descCount; ++ndx )
+                {
+                    const WriteBindingDesc& desc = pDescs[ ndx ];
+                    BGS_ASSERT( desc.hDstHeap != BindingHeapHandle(), "Binding heap handle (desc.hDstHeap) must be a valid handle." );
+                    BGS_ASSERT( ( desc.hResourceView != ResourceViewHandle() || desc.hSampler != SamplerHandle() ),
+                                "Resource view handle (desc.hResourceView) or sampler handle (desc.hSampler) must be a valid handle." );
+
+                    const bool_t                     isSampler   = desc.bindingType == BindingTypes::SAMPLER;
+                    const D3D12_DESCRIPTOR_HEAP_TYPE heapType    = MapBigosBindingTypeToD3D12DescriptorHeapType( desc.bindingType );
+                    const uint64_t                   bindingSize = m_bindingSizes[ BGS_ENUM_INDEX( desc.bindingType ) ];
+                    const uint32_t                   srcNdx =
+                        isSampler ? desc.hSampler.GetNativeHandle()->ndx : desc.hResourceView.GetNativeHandle()->cbvSrvUavNdx;
+                    D3D12_CPU_DESCRIPTOR_HANDLE src{ m_descHeaps[ BGS_ENUM_INDEX( heapType ) ].pHeap->GetCPUDescriptorHandleForHeapStart().ptr +
+                                                     bindingSize * srcNdx };
+                    D3D12_CPU_DESCRIPTOR_HANDLE dst{ desc.hDstHeap.GetNativeHandle()->GetCPUDescriptorHandleForHeapStart().ptr + desc.dstOffset };
+
+                    // One copy call handles a single heap type
+                    if( ( srcCount > 0 ) && ( ( heapType != batchType ) || ( srcCount == MAX_COPY_COUNT ) ) )
+                    {
+                        pNativeDevice->CopyDescriptors( dstCount, dstStarts.data(), dstSizes.data(), srcCount, srcStarts.data(), nullptr, batchType );
+                        srcCount = 0;
+                        dstCount = 0;
+                    }
+                    batchType               = heapType;
+                    srcStarts[ srcCount++ ] = src;
+
+                    // Sources are scattered views, but destinations are usually contiguous and form a single range
+                    if( ( dstCount > 0 ) && ( dstStarts[ dstCount - 1 ].ptr + bindingSize * dstSizes[ dstCount - 1 ] == dst.ptr ) )
+                    {
+                        dstSizes[ dstCount - 1 ]++;
+                    }
+                    else
+                    {
+                        dstStarts[ dstCount ] = dst;
+                        dstSizes[ dstCount ]  = 1;
+                        dstCount++;
+                    }
+                }
+
+                if( srcCount > 0 )
+                {
+                    pNativeDevice->CopyDescriptors( dstCount, dstStarts.data(), dstSizes.data(), srcCount, srcStarts.data(), nullptr, batchType );
+                }
             }
 
             RESULT D3D12Device::CreateQueryPool( const QueryPoolDesc& desc, QueryPoolHandle* pHandle )
@@ -1285,6 +1517,9 @@ namespace BIGOS
 
                 QueryD3D12BindingsSize();
 
+                // Pipelines are created without library, if it fails
+                CreateD3D12PipelineLibrary();
+
                 return Results::OK;
             }
 
@@ -1294,6 +1529,9 @@ namespace BIGOS
 
                 if( m_handle != DeviceHandle() )
                 {
+                    RELEASE_COM_PTR( m_pPipelineLibrary );
+                    m_pipelineLibraryData.clear();
+
                     ID3D12Device* pNativeDevice = m_handle.GetNativeHandle();
                     RELEASE_COM_PTR( pNativeDevice );
 
@@ -1332,6 +1570,7 @@ namespace BIGOS
             RESULT D3D12Device::CreateD3D12GraphicsPipeline( const GraphicsPipelineDesc& gpDesc, D3D12Pipeline** ppPipeline )
             {
                 D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc;
+                Memory::Set( &psoDesc, 0, sizeof( psoDesc ) );
                 // Shader stages
                 if( gpDesc.vertexShader.hShader != ShaderHandle() )
                 {
@@ -1426,6 +1665,7 @@ namespace BIGOS
                 }
 
                 D3D12_INPUT_LAYOUT_DESC inputLayout;
+                Memory::Set( &inputLayout, 0, sizeof( inputLayout ) );
                 inputLayout.NumElements        = gpDesc.inputState.inputElementCount;
                 inputLayout.pInputElementDescs = elemDescs;
 
@@ -1453,6 +1693,7 @@ namespace BIGOS
 
                 // Depth stencil state
                 D3D12_DEPTH_STENCIL_DESC depthStencilState;
+                Memory::Set( &depthStencilState, 0, sizeof( depthStencilState ) );
                 depthStencilState.DepthEnable      = gpDesc.depthStencilState.depthTestEnable;
                 depthStencilState.DepthWriteMask   = MapBigosBoolToD3D12DepthWriteMask( gpDesc.depthStencilState.depthWriteEnable );
                 depthStencilState.DepthFunc        = MapBigosCompareOperationTypeToD3D12ComparsionFunc( gpDesc.depthStencilState.depthCompare );
@@ -1482,6 +1723,7 @@ namespace BIGOS
                 }
 
                 D3D12_BLEND_DESC blendState;
+                Memory::Set( &blendState, 0, sizeof( blendState ) );
                 for( index_t ndx = 0; ndx < static_cast<index_t>( gpDesc.blendState.renderTargetBlendDescCount ); ++ndx )
                 {
                     const RenderTargetBlendDesc&    currDesc   = gpDesc.blendState.pRenderTargetBlendDescs[ ndx ];
@@ -1519,7 +1761,7 @@ namespace BIGOS
                     psoDesc.RTVFormats[ ndx ] = DXGI_FORMAT_UNKNOWN;
                 }
 
-                // Cahed pipeline - TODO: Handle
+                // Cached blobs are not used, pipelines are cached in pipeline library
                 D3D12_CACHED_PIPELINE_STATE cachedPipeline{};
 
                 // Pipeline desc
@@ -1539,13 +1781,28 @@ namespace BIGOS
 
                 ID3D12Device*        pNativeDevice   = m_handle.GetNativeHandle();
                 ID3D12PipelineState* pNativePipeline = nullptr;
-                if( FAILED( pNativeDevice->CreateGraphicsPipelineState( &psoDesc, IID_PPV_ARGS( &pNativePipeline ) ) ) )
+                wchar_t              name[ 17 ];
+                GetD3D12PipelineName( HashD3D12GraphicsPipeline( psoDesc, gpDesc.hPipelineLayout.GetNativeHandle()->signatureHash ), name );
+                if( m_pPipelineLibrary != nullptr )
                 {
-                    return Results::FAIL;
+                    // Loading the same pipeline from many threads at once has to be synchronized
+                    std::lock_guard<Mutex> lock( m_pipelineLibraryMutex );
+                    if( FAILED( m_pPipelineLibrary->LoadGraphicsPipeline( name, &psoDesc, IID_PPV_ARGS( &pNativePipeline ) ) ) )
+                    {
+                        pNativePipeline = nullptr;
+                    }
+                }
+                if( pNativePipeline == nullptr )
+                {
+                    if( FAILED( pNativeDevice->CreateGraphicsPipelineState( &psoDesc, IID_PPV_ARGS( &pNativePipeline ) ) ) )
+                    {
+                        return Results::FAIL;
+                    }
+                    StoreD3D12Pipeline( name, pNativePipeline );
                 }
 
                 D3D12Pipeline* pPipeline = nullptr;
-                if( BGS_FAILED( Core::Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pPipeline ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetDefaultAllocator(), &pPipeline ) ) )
                 {
                     RELEASE_COM_PTR( pNativePipeline );
                     return Results::NO_MEMORY;
@@ -1561,10 +1818,11 @@ namespace BIGOS
 
             RESULT D3D12Device::CreateD3D12ComputePipeline( const ComputePipelineDesc& cpDesc, D3D12Pipeline** ppPipeline )
             {
-                // Cahed pipeline - TODO: Handle
+                // Cached blobs are not used, pipelines are cached in pipeline library
                 D3D12_CACHED_PIPELINE_STATE cachedPipeline{};
 
                 D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc;
+                Memory::Set( &psoDesc, 0, sizeof( psoDesc ) );
                 if( cpDesc.computeShader.hShader != ShaderHandle() )
                 {
                     D3D12ShaderModule* pShader = cpDesc.computeShader.hShader.GetNativeHandle();
@@ -1585,13 +1843,27 @@ namespace BIGOS
 
                 ID3D12Device*        pNativeDevice   = m_handle.GetNativeHandle();
                 ID3D12PipelineState* pNativePipeline = nullptr;
-                if( FAILED( pNativeDevice->CreateComputePipelineState( &psoDesc, IID_PPV_ARGS( &pNativePipeline ) ) ) )
+                wchar_t              name[ 17 ];
+                GetD3D12PipelineName( HashD3D12ComputePipeline( psoDesc, cpDesc.hPipelineLayout.GetNativeHandle()->signatureHash ), name );
+                if( m_pPipelineLibrary != nullptr )
                 {
-                    return Results::FAIL;
+                    std::lock_guard<Mutex> lock( m_pipelineLibraryMutex );
+                    if( FAILED( m_pPipelineLibrary->LoadComputePipeline( name, &psoDesc, IID_PPV_ARGS( &pNativePipeline ) ) ) )
+                    {
+                        pNativePipeline = nullptr;
+                    }
+                }
+                if( pNativePipeline == nullptr )
+                {
+                    if( FAILED( pNativeDevice->CreateComputePipelineState( &psoDesc, IID_PPV_ARGS( &pNativePipeline ) ) ) )
+                    {
+                        return Results::FAIL;
+                    }
+                    StoreD3D12Pipeline( name, pNativePipeline );
                 }
 
                 D3D12Pipeline* pPipeline = nullptr;
-                if( BGS_FAILED( Core::Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pPipeline ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetDefaultAllocator(), &pPipeline ) ) )
                 {
                     RELEASE_COM_PTR( pNativePipeline );
                     return Results::NO_MEMORY;
@@ -1605,6 +1877,55 @@ namespace BIGOS
                 return Results::OK;
             }
 
+            RESULT D3D12Device::CreateD3D12PipelineLibrary()
+            {
+                // D3D12 has no cache UUID, driver itself rejects library serialized by other driver
+                FillPipelineCacheHeader( APITypes::D3D12, m_desc.pAdapter->GetInfo(), nullptr, &m_pipelineCacheHeader );
+
+                ID3D12Device1* pNativeDevice1 = nullptr;
+                if( FAILED( m_handle.GetNativeHandle()->QueryInterface( IID_PPV_ARGS( &pNativeDevice1 ) ) ) )
+                {
+                    return Results::FAIL;
+                }
+
+                if( IsPipelineCacheValid( m_pipelineCacheHeader, m_desc.pPipelineCacheData, m_desc.pipelineCacheSize ) )
+                {
+                    const uint64_t nativeSize = m_desc.pipelineCacheSize - sizeof( PipelineCacheHeader );
+                    m_pipelineLibraryData.resize( static_cast<size_t>( nativeSize ) );
+                    Memory::Copy( static_cast<const byte_t*>( m_desc.pPipelineCacheData ) + sizeof( PipelineCacheHeader ), nativeSize,
+                                  m_pipelineLibraryData.data(), nativeSize );
+                }
+
+                if( FAILED( pNativeDevice1->CreatePipelineLibrary( m_pipelineLibraryData.data(), m_pipelineLibraryData.size(),
+                                                                   IID_PPV_ARGS( &m_pPipelineLibrary ) ) ) )
+                {
+                    // Driver can still reject data (e.g. after update), start with empty library then
+                    m_pipelineLibraryData.clear();
+                    m_pipelineLibraryData.shrink_to_fit();
+                    if( FAILED( pNativeDevice1->CreatePipelineLibrary( nullptr, 0, IID_PPV_ARGS( &m_pPipelineLibrary ) ) ) )
+                    {
+                        m_pPipelineLibrary = nullptr;
+                        RELEASE_COM_PTR( pNativeDevice1 );
+                        return Results::FAIL;
+                    }
+                }
+                RELEASE_COM_PTR( pNativeDevice1 );
+
+                return Results::OK;
+            }
+
+            void D3D12Device::StoreD3D12Pipeline( const wchar_t* pName, ID3D12PipelineState* pPipeline )
+            {
+                if( m_pPipelineLibrary == nullptr )
+                {
+                    return;
+                }
+
+                // Fails when other thread stored the same pipeline first, pipeline itself is still valid then
+                std::lock_guard<Mutex> lock( m_pipelineLibraryMutex );
+                m_pPipelineLibrary->StorePipeline( pName, pPipeline );
+            }
+
             void D3D12Device::CreateD3D12MemoryHeapProperties( const AllocateMemoryDesc& desc, D3D12_HEAP_PROPERTIES* pProps )
             {
                 if( desc.heapType == MemoryHeapTypes::CUSTOM )
@@ -2120,6 +2441,8 @@ namespace BIGOS
                 m_bindingSizes[ BGS_ENUM_INDEX( BindingTypes::READ_ONLY_STORAGE_BUFFER ) ]  = m_limits.readOnlyStorageBufferBindingSize;
                 m_limits.readWriteStorageBufferBindingSize                                  = shaderResBindingSize;
                 m_bindingSizes[ BGS_ENUM_INDEX( BindingTypes::READ_WRITE_STORAGE_BUFFER ) ] = m_limits.readWriteStorageBufferBindingSize;
+                // Tables can start at any binding
+                m_limits.bindingSetAlignment = 1;
             }
 
         } // namespace Backend
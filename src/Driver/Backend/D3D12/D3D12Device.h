@@ -45,6 +45,7 @@ namespace BIGOS
                 virtual void   DestroyPipelineLayout( PipelineLayoutHandle* pHandle ) override;
                 virtual RESULT CreatePipeline( const PipelineDesc& desc, PipelineHandle* pHandle ) override;
                 virtual void   DestroyPipeline( PipelineHandle* pHandle ) override;
+                virtual RESULT GetPipelineCacheData( void* pData, uint64_t* pSize ) override;
 
                 virtual RESULT CreateFence( const FenceDesc& desc, FenceHandle* pHandle ) override;
                 virtual void   DestroyFence( FenceHandle* pHandle ) override;
@@ -57,6 +58,7 @@ namespace BIGOS
 
                 virtual RESULT AllocateMemory( const AllocateMemoryDesc& desc, MemoryHandle* pHandle ) override;
                 virtual void   FreeMemory( MemoryHandle* pHandle ) override;
+                virtual RESULT QueryMemoryBudget( MemoryBudgetInfo* pInfo ) override;
 
                 virtual RESULT CreateResource( const ResourceDesc& desc, ResourceHandle* pHandle ) override;
                 virtual void   DestroyResource( ResourceHandle* pHandle ) override;
@@ -64,6 +66,8 @@ namespace BIGOS
                 virtual void   GetResourceAllocationInfo( ResourceHandle handle, ResourceAllocationInfo* pInfo ) override;
                 virtual RESULT MapResource( const MapResourceDesc& desc, void** ppResource ) override;
                 virtual RESULT UnmapResource( const MapResourceDesc& desc ) override;
+                virtual RESULT FlushRange( const MapResourceDesc& desc ) override;
+                virtual RESULT InvalidateRange( const MapResourceDesc& desc ) override;
 
                 virtual RESULT CreateResourceView( const ResourceViewDesc& desc, ResourceViewHandle* pHandle ) override;
                 virtual void   DestroyResourceView( ResourceViewHandle* pHandle ) override;
@@ -78,7 +82,8 @@ namespace BIGOS
                 virtual RESULT CreateBindingHeap( const BindingHeapDesc& desc, BindingHeapHandle* pHandle ) override;
                 virtual void   DestroyBindingHeap( BindingHeapHandle* pHandle ) override;
                 virtual void   GetBindingOffset( const GetBindingOffsetDesc& desc, uint64_t* pOffset ) override;
-                virtual void   WriteBinding( const WriteBindingDesc& desc ) override;
+                virtual void   GetBindingSetLayoutSize( BindingSetLayoutHandle handle, uint64_t* pSize ) override;
+                virtual void   WriteBindings( const WriteBindingDesc* pDescs, uint32_t descCount ) override;
 
                 virtual RESULT CreateQueryPool( const QueryPoolDesc& desc, QueryPoolHandle* pHandle ) override;
                 virtual void   DestroyQueryPool( QueryPoolHandle* pHandle ) override;
@@ -96,6 +101,8 @@ namespace BIGOS
                 RESULT   CreateD3D12Device();
                 RESULT   CreateD3D12GraphicsPipeline( const GraphicsPipelineDesc& gpDesc, D3D12Pipeline** ppPipeline );
                 RESULT   CreateD3D12ComputePipeline( const ComputePipelineDesc& cpDesc, D3D12Pipeline** ppPipeline );
+                RESULT   CreateD3D12PipelineLibrary();
+                void     StoreD3D12Pipeline( const wchar_t* pName, ID3D12PipelineState* pPipeline );
                 RESULT   CreateD3D12GlobalDescriptorHeaps();
                 uint32_t CreateD3D12RTV( const TextureViewDesc& desc );
                 uint32_t CreateD3D12DSV( const TextureViewDesc& desc );
@@ -113,7 +120,11 @@ namespace BIGOS
                 D3D12HeapProperties        m_heapProperties;
                 D3D12GlobalDescriptorHeaps m_descHeaps;
                 uint64_t                   m_bindingSizes[ BGS_ENUM_COUNT( BindingTypes ) ];
-                D3D12Factory*              m_pParent = nullptr;
+                D3D12Factory*              m_pParent          = nullptr;
+                ID3D12PipelineLibrary*     m_pPipelineLibrary = nullptr;
+                HeapArray<byte_t>          m_pipelineLibraryData; // Library reads pipelines from it, so it lives as long as library
+                PipelineCacheHeader        m_pipelineCacheHeader;
+                Mutex                      m_pipelineLibraryMutex;
             };
 
         } // namespace Backend
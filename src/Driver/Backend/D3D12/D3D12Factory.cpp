@@ -22,7 +22,7 @@ namespace BIGOS
                 BGS_ASSERT( ( ppDevice != nullptr ) && ( *ppDevice == nullptr ) );
 
                 D3D12Device* pDevice = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pParent->GetDefaultAllocator(), &pDevice ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetDefaultAllocator(), &pDevice ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -60,6 +60,7 @@ namespace BIGOS
 
                 m_desc    = desc;
                 m_pParent = pParent;
+                m_adapters.SetAllocator( m_pParent->GetDefaultAllocator() );
 
                 if( BGS_FAILED( CreateD3D12Factory() ) )
                 {
@@ -95,6 +96,7 @@ namespace BIGOS
                     Core::Memory::FreeObject( m_pParent->GetDefaultAllocator(), &m_adapters[ ndx ] );
                 }
                 m_adapters.clear();
+                m_adapters.shrink_to_fit();
 
                 m_pParent = nullptr;
                 m_handle  = FactoryHandle();
@@ -118,7 +120,7 @@ namespace BIGOS
                     if( SUCCEEDED( D3D12CreateDevice( pAdapter, D3D_FEATURE_LEVEL_11_0, __uuidof( ID3D12Device ), nullptr ) ) )
                     {
                         D3D12Adapter* pD3D12Adapter = nullptr;
-                        if( BGS_FAILED( Core::Memory::AllocateObject( m_pParent->GetDefaultAllocator(), &pD3D12Adapter ) ) )
+                        if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetDefaultAllocator(), &pD3D12Adapter ) ) )
                         {
                             return Results::NO_MEMORY;
                         }
@@ -9,6 +9,7 @@ namespace BIGOS::Driver::Backend
     {
         ID3D12RootSignature* pNativeRootSignature;
         uint32_t             pushConstantTable[ 8 ]; // Count of D3D12_SHADER_VISIBILITY
+        uint64_t             signatureHash;          // Hash of serialized root signature, part of pipeline names in pipeline library
     };
 
 } // namespace BIGOS::Driver::Backend
\ No newline at end of file
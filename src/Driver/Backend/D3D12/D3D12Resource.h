@@ -10,6 +10,8 @@ namespace BIGOS::Driver::Backend
         ID3D12Resource*     pNativeResource;
         D3D12_RESOURCE_DESC desc;
         D3D12_CLEAR_VALUE   clrVal;
+        ResourceFlags       flags;
+        void*               pHostMemory; // Cached pointer of persistently mapped buffer
     };
 
 } // namespace BIGOS::Driver::Backend
\ No newline at end of file
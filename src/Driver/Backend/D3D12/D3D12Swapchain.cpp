@@ -187,8 +187,8 @@ namespace BIGOS
                 ID3D12Fence*        pFence       = nullptr;
                 ID3D12CommandQueue* pQueue       = m_desc.pQueue->GetHandle().GetNativeHandle();
 
-                if( BGS_FAILED( Core::Memory::AllocateArray( m_pParent->GetParent()->GetParent()->GetDefaultAllocator(), &pBackBuffers,
-                                                             m_desc.backBufferCount, alignof( D3D12Resource ) ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_ARRAY( m_pParent->GetParent()->GetParent()->GetDefaultAllocator(), &pBackBuffers,
+                                                    m_desc.backBufferCount, alignof( D3D12Resource ) ) ) )
                 {
                     return Results::FAIL;
                 }
@@ -200,6 +200,8 @@ namespace BIGOS
                         Core::Memory::FreeAligned( &pBackBuffers );
                         return Results::FAIL;
                     }
+                    pBackBuffers[ ndx ].flags       = BGS_FLAG( ResourceFlagBits::NONE );
+                    pBackBuffers[ ndx ].pHostMemory = nullptr;
 
                     // Creating semaphores holding current status of back buffer presentation
                     if( BGS_FAILED( m_pParent->CreateSemaphore( sd, &m_backBuffers[ ndx ].hBackBufferAvailableSemaphore ) ) )
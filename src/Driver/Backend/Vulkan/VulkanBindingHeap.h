@@ -7,8 +7,10 @@ namespace BIGOS::Driver::Backend
     {
         void*              pHost;
         VkDeviceMemory     memory;
+        VkDeviceSize       memorySize;
         VkBuffer           buffer;
         VkDeviceAddress    address;
         VkBufferUsageFlags flags;
+        bool_t             isCoherent;
     };
 } // namespace BIGOS::Driver::Backend
\ No newline at end of file
@@ -2,10 +2,12 @@
 
 #include "VulkanCommandBuffer.h"
 
+#include "Driver/Backend/APICommon.h"
 #include "VulkanBindingHeap.h"
 #include "VulkanCommandLayout.h"
 #include "VulkanCommon.h"
 #include "VulkanDevice.h"
+#include "VulkanQueue.h"
 #include "VulkanResource.h"
 #include "VulkanResourceView.h"
 
@@ -458,6 +460,12 @@ namespace BIGOS
                     barrier.buffer              = currDesc.hResouce.GetNativeHandle()->buffer;
                     barrier.offset              = currDesc.bufferRange.offset;
                     barrier.size                = currDesc.bufferRange.size;
+                    if( ( currDesc.pSrcQueue != nullptr ) && ( currDesc.pDstQueue != nullptr ) )
+                    {
+                        // Ignored by implementation when both queues are from the same family
+                        barrier.srcQueueFamilyIndex = static_cast<VulkanQueue*>( currDesc.pSrcQueue )->GetFamilyIndex();
+                        barrier.dstQueueFamilyIndex = static_cast<VulkanQueue*>( currDesc.pDstQueue )->GetFamilyIndex();
+                    }
                 }
                 for( index_t ndx = 0; ndx < static_cast<index_t>( desc.textureBarrierCount ); ++ndx )
                 {
@@ -480,6 +488,12 @@ namespace BIGOS
                     barrier.subresourceRange.levelCount   = currDesc.textureRange.mipLevelCount;
                     barrier.subresourceRange.baseArrayLayer = currDesc.textureRange.arrayLayer;
                     barrier.subresourceRange.layerCount     = currDesc.textureRange.arrayLayerCount;
+                    if( ( currDesc.pSrcQueue != nullptr ) && ( currDesc.pDstQueue != nullptr ) )
+                    {
+                        // Ignored by implementation when both queues are from the same family
+                        barrier.srcQueueFamilyIndex = static_cast<VulkanQueue*>( currDesc.pSrcQueue )->GetFamilyIndex();
+                        barrier.dstQueueFamilyIndex = static_cast<VulkanQueue*>( currDesc.pDstQueue )->GetFamilyIndex();
+                    }
                 }
 
                 VkDependencyInfo info;
@@ -552,9 +566,9 @@ namespace BIGOS
                 BGS_ASSERT( desc.bufferOffset % 512 == 0, "Buffer offset (desc.bufferOffset) must be 512 aligned." );
 
                 VkBufferImageCopy buffTexCpy;
-                // That means tightly packed
+                // Zero means tightly packed, row length is given in texels
                 buffTexCpy.bufferImageHeight               = 0;
-                buffTexCpy.bufferRowLength                 = 0;
+                buffTexCpy.bufferRowLength                 = desc.bufferRowPitch / GetBigosFormatSize( desc.textureFormat );
                 buffTexCpy.bufferOffset                    = desc.bufferOffset;
                 buffTexCpy.imageOffset.x                   = desc.textureOffset.x;
                 buffTexCpy.imageOffset.y                   = desc.textureOffset.y;
@@ -581,9 +595,9 @@ namespace BIGOS
                 BGS_ASSERT( desc.bufferOffset % 512 == 0, "Buffer offset (desc.bufferOffset) must be 512 aligned." );
 
                 VkBufferImageCopy buffTexCpy;
-                // That means tightly packed
+                // Zero means tightly packed, row length is given in texels
                 buffTexCpy.bufferImageHeight               = 0;
-                buffTexCpy.bufferRowLength                 = 0;
+                buffTexCpy.bufferRowLength                 = desc.bufferRowPitch / GetBigosFormatSize( desc.textureFormat );
                 buffTexCpy.bufferOffset                    = desc.bufferOffset;
                 buffTexCpy.imageOffset.x                   = desc.textureOffset.x;
                 buffTexCpy.imageOffset.y                   = desc.textureOffset.y;
@@ -109,6 +109,7 @@ namespace BIGOS
 
                 void*                     GetExtChain() const { return m_pNext; }
                 VkPhysicalDeviceFeatures* GetDeviceFeatures() { return &m_devCoreFeatures; }
+                void                      AddExtension( const char* pName ) { m_extensions.push_back( pName ); }
                 const char* const*        GetExtNames() const { return m_extensions.data(); }
                 uint32_t                  GetExtCount() const { return static_cast<uint32_t>( m_extensions.size() ); }
 
@@ -183,7 +184,7 @@ namespace BIGOS
                 }
 
                 VulkanQueue* pQueue = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pQueue ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetDefaultAllocator(), &pQueue ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -226,7 +227,7 @@ namespace BIGOS
                 }
 
                 VulkanSwapchain* pSwapchain = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pSwapchain ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetDefaultAllocator(), &pSwapchain ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -326,7 +327,7 @@ namespace BIGOS
                 }
 
                 VulkanCommandBuffer* pCommandBuffer = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pCommandBuffer ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetDefaultAllocator(), &pCommandBuffer ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -535,6 +536,50 @@ namespace BIGOS
                 }
             }
 
+            RESULT VulkanDevice::GetPipelineCacheData( void* pData, uint64_t* pSize )
+            {
+                BGS_ASSERT( pSize != nullptr, "Size (pSize) must be a valid address." );
+                if( ( pSize == nullptr ) || ( m_pipelineCache == VK_NULL_HANDLE ) )
+                {
+                    return Results::FAIL;
+                }
+
+                VkDevice nativeDevice = m_handle.GetNativeHandle();
+                size_t   nativeSize   = 0;
+                if( pData == nullptr )
+                {
+                    if( m_pDeviceAPI->vkGetPipelineCacheData( nativeDevice, m_pipelineCache, &nativeSize, nullptr ) != VK_SUCCESS )
+                    {
+                        return Results::FAIL;
+                    }
+                    *pSize = sizeof( PipelineCacheHeader ) + nativeSize;
+
+                    return Results::OK;
+                }
+
+                BGS_ASSERT( *pSize >= sizeof( PipelineCacheHeader ), "Size (pSize) must be at least size of the pipeline cache header." );
+                if( *pSize < sizeof( PipelineCacheHeader ) )
+                {
+                    return Results::FAIL;
+                }
+
+                // VK_INCOMPLETE is returned when pipelines were created after size query
+                byte_t* pNativeData = static_cast<byte_t*>( pData ) + sizeof( PipelineCacheHeader );
+                nativeSize          = static_cast<size_t>( *pSize - sizeof( PipelineCacheHeader ) );
+                if( m_pDeviceAPI->vkGetPipelineCacheData( nativeDevice, m_pipelineCache, &nativeSize, pNativeData ) != VK_SUCCESS )
+                {
+                    return Results::FAIL;
+                }
+
+                PipelineCacheHeader header = m_pipelineCacheHeader;
+                header.dataSize            = nativeSize;
+                header.dataHash            = Core::Utils::Hash::FNV1a( pNativeData, nativeSize );
+                Memory::Copy( &header, sizeof( header ), pData, sizeof( header ) );
+                *pSize = sizeof( header ) + nativeSize;
+
+                return Results::OK;
+            }
+
             RESULT VulkanDevice::CreateFence( const FenceDesc& desc, FenceHandle* pHandle )
             {
                 BGS_ASSERT( pHandle != nullptr, "Fence (pHandle) must be a valid address." );
@@ -718,6 +763,12 @@ namespace BIGOS
                 }
 
                 VkMemoryPropertyFlags nativePropsFlags = MapBigosMemoryAccessFlagsToVulkanMemoryPropertFlags( access );
+                if( ( desc.heapType != MemoryHeapTypes::CUSTOM ) && ( nativePropsFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) )
+                {
+                    // Upload and readback heaps behave like D3D12 ones, persistently mapped resources in them are never flushed.
+                    // Spec guarantees at least one host visible and coherent memory type.
+                    nativePropsFlags |= VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+                }
 
                 const VkPhysicalDeviceMemoryProperties& nativeProps = m_heapProperties.memoryProperties;
                 const int32_t                           ndx         = FindVulkanMemTypeNdx( &nativeProps, MAX_UINT32, nativePropsFlags );
@@ -727,7 +778,7 @@ namespace BIGOS
                 }
                 // TODO: Handle heap capacity
 
-                if( BGS_FAILED( Core::Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pNativeMem ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetObjectAllocator(), &pNativeMem ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -746,10 +797,16 @@ namespace BIGOS
 
                 if( m_pDeviceAPI->vkAllocateMemory( nativeDevice, &allocInfo, nullptr, &pNativeMem->nativeMemory ) != VK_SUCCESS )
                 {
-                    Core::Memory::FreeObject( m_pParent->GetParent()->GetDefaultAllocator(), &pNativeMem );
+                    Core::Memory::FreeObject( m_pParent->GetParent()->GetObjectAllocator(), &pNativeMem );
                     return Results::FAIL;
                 }
 
+                const VkMemoryPropertyFlags typeFlags = nativeProps.memoryTypes[ ndx ].propertyFlags;
+                pNativeMem->size                      = desc.size;
+                pNativeMem->pHostMemory               = nullptr;
+                pNativeMem->heapIndex                 = nativeProps.memoryTypes[ ndx ].heapIndex;
+                pNativeMem->isCoherent                = ( typeFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT ) ? BGS_TRUE : BGS_FALSE;
+
                 // Maping memory for futer use i9n D3D12 behaviour emulation
                 if( nativePropsFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT )
                 {
@@ -757,11 +814,13 @@ namespace BIGOS
                         VK_SUCCESS )
                     {
                         m_pDeviceAPI->vkFreeMemory( nativeDevice, pNativeMem->nativeMemory, nullptr );
-                        Core::Memory::FreeObject( m_pParent->GetParent()->GetDefaultAllocator(), &pNativeMem );
+                        Core::Memory::FreeObject( m_pParent->GetParent()->GetObjectAllocator(), &pNativeMem );
                         return Results::FAIL;
                     }
                 }
 
+                // Memory can be allocated and freed from many threads
+                m_heapUsages[ pNativeMem->heapIndex ].fetch_add( pNativeMem->size, std::memory_order_relaxed );
                 *pHandle = MemoryHandle( pNativeMem );
 
                 return Results::OK;
@@ -777,20 +836,63 @@ namespace BIGOS
                     VulkanMemory* pNativeMem   = pHandle->GetNativeHandle();
 
                     m_pDeviceAPI->vkFreeMemory( nativeDevice, pNativeMem->nativeMemory, nullptr );
+                    m_heapUsages[ pNativeMem->heapIndex ].fetch_sub( pNativeMem->size, std::memory_order_relaxed );
 
-                    Core::Memory::FreeObject( m_pParent->GetParent()->GetDefaultAllocator(), &pNativeMem );
+                    Core::Memory::FreeObject( m_pParent->GetParent()->GetObjectAllocator(), &pNativeMem );
 
                     *pHandle = MemoryHandle();
                 }
             }
 
+            RESULT VulkanDevice::QueryMemoryBudget( MemoryBudgetInfo* pInfo )
+            {
+                BGS_ASSERT( pInfo != nullptr, "Memory budget info (pInfo) must be a valid address." );
+                if( pInfo == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                VkPhysicalDevice nativeAdapter = m_desc.pAdapter->GetHandle().GetNativeHandle();
+
+                VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProps;
+                budgetProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+                budgetProps.pNext = nullptr;
+
+                VkPhysicalDeviceMemoryProperties2 memProps;
+                memProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+                memProps.pNext = m_memoryBudgetSupported ? &budgetProps : nullptr;
+                vkGetPhysicalDeviceMemoryProperties2( nativeAdapter, &memProps );
+
+                Memory::Set( pInfo, 0, sizeof( MemoryBudgetInfo ) );
+                for( index_t ndx = 0; ndx < static_cast<index_t>( memProps.memoryProperties.memoryHeapCount ); ++ndx )
+                {
+                    const VkMemoryHeap&       heap    = memProps.memoryProperties.memoryHeaps[ ndx ];
+                    const MEMORY_SEGMENT_TYPE segType = ( heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT ) ? MemorySegmentTypes::LOCAL
+                                                                                                         : MemorySegmentTypes::NON_LOCAL;
+                    MemorySegmentBudget&      segment = pInfo->segments[ BGS_ENUM_INDEX( segType ) ];
+                    if( m_memoryBudgetSupported )
+                    {
+                        segment.budget += budgetProps.heapBudget[ ndx ];
+                        segment.usage += budgetProps.heapUsage[ ndx ];
+                    }
+                    else
+                    {
+                        // Only own allocations are known, 80% of the heap is what OS usually leaves to one process
+                        segment.budget += heap.size / 10 * 8;
+                        segment.usage += m_heapUsages[ ndx ].load( std::memory_order_relaxed );
+                    }
+                }
+
+                return Results::OK;
+            }
+
             RESULT VulkanDevice::CreateResource( const ResourceDesc& desc, ResourceHandle* pHandle )
             {
                 BGS_ASSERT( pHandle != nullptr, "Memory (pHandle) must be a valid address." );
                 // TODO: Think about validation, because things ale getting complex
 
                 VulkanResource* pRes = nullptr;
-                if( BGS_FAILED( Core::Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pRes ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetObjectAllocator(), &pRes ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -821,6 +923,7 @@ namespace BIGOS
                 pRes->pMemory       = nullptr;
                 pRes->memoryOffset  = INVALID_OFFSET;
                 pRes->usage         = desc.resourceUsage;
+                pRes->flags         = desc.flags;
                 *pHandle            = ResourceHandle( pRes );
 
                 return Results::OK;
@@ -844,7 +947,7 @@ namespace BIGOS
                         m_pDeviceAPI->vkDestroyImage( nativeDevice, pNativeRes->image, nullptr );
                     }
 
-                    Core::Memory::FreeObject( m_pParent->GetParent()->GetDefaultAllocator(), &pNativeRes );
+                    Core::Memory::FreeObject( m_pParent->GetParent()->GetObjectAllocator(), &pNativeRes );
 
                     *pHandle = ResourceHandle();
                 }
@@ -924,39 +1027,19 @@ namespace BIGOS
 
                 VkDevice        nativeDevice = m_handle.GetNativeHandle();
                 VulkanResource* pRes         = desc.hResource.GetNativeHandle();
-                VkDeviceSize    offset       = pRes->memoryOffset;
+                VkDeviceSize    offset;
                 VkDeviceSize    size;
-                if( pRes->type == VulkanResourceTypes::IMAGE )
-                {
-                    VkImage             nativeImage = pRes->image;
-                    VkSubresourceLayout subresourceLayout;
-                    VkImageSubresource  subresource;
-                    subresource.aspectMask = MapBigosTextureComponentFlagsToVulkanImageAspectFlags( desc.textureRange.components );
-                    subresource.arrayLayer = desc.textureRange.arrayLayer;
-                    subresource.mipLevel   = desc.textureRange.mipLevel;
-
-                    m_pDeviceAPI->vkGetImageSubresourceLayout( nativeDevice, nativeImage, &subresource, &subresourceLayout );
-
-                    // Note that subresourceLayout.offset is offset from begining of resource
-                    offset += subresourceLayout.offset;
-                    size = subresourceLayout.size;
-                }
-                else
-                {
-                    offset += desc.bufferRange.offset;
-                    size = desc.bufferRange.size;
-                }
+                GetMappedRange( desc, &offset, &size );
 
-                VkMappedMemoryRange nativeMemRange;
-                nativeMemRange.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-                nativeMemRange.pNext  = nullptr;
-                nativeMemRange.memory = pRes->pMemory->nativeMemory;
-                nativeMemRange.size   = size;
-                nativeMemRange.offset = offset;
-
-                if( m_pDeviceAPI->vkInvalidateMappedMemoryRanges( nativeDevice, 1, &nativeMemRange ) != VK_SUCCESS )
+                // Coherent memory is always up to date and persistently mapped resources are synchronized by explicit calls
+                if( !pRes->pMemory->isCoherent && !( pRes->flags & BGS_FLAG( ResourceFlagBits::PERSISTENT_MAP ) ) )
                 {
-                    return Results::FAIL;
+                    VkMappedMemoryRange nativeMemRange;
+                    CreateVkMappedMemoryRange( pRes->pMemory, offset, size, &nativeMemRange );
+                    if( m_pDeviceAPI->vkInvalidateMappedMemoryRanges( nativeDevice, 1, &nativeMemRange ) != VK_SUCCESS )
+                    {
+                        return Results::FAIL;
+                    }
                 }
 
                 byte_t* pMem = static_cast<byte_t*>( pRes->pMemory->pHostMemory );
@@ -975,39 +1058,66 @@ namespace BIGOS
                     return Results::FAIL;
                 }
 
-                VkDevice        nativeDevice = m_handle.GetNativeHandle();
-                VulkanResource* pRes         = desc.hResource.GetNativeHandle();
-                VkDeviceSize    offset       = pRes->memoryOffset;
-                VkDeviceSize    size;
-                if( pRes->type == VulkanResourceTypes::IMAGE )
+                VulkanResource* pRes = desc.hResource.GetNativeHandle();
+                if( pRes->pMemory->isCoherent || ( pRes->flags & BGS_FLAG( ResourceFlagBits::PERSISTENT_MAP ) ) )
                 {
-                    VkImage             nativeImage = pRes->image;
-                    VkSubresourceLayout subresourceLayout;
-                    VkImageSubresource  subresource;
-                    subresource.aspectMask = MapBigosTextureComponentFlagsToVulkanImageAspectFlags( desc.textureRange.components );
-                    subresource.arrayLayer = desc.textureRange.arrayLayer;
-                    subresource.mipLevel   = desc.textureRange.mipLevel;
+                    return Results::OK;
+                }
 
-                    m_pDeviceAPI->vkGetImageSubresourceLayout( nativeDevice, nativeImage, &subresource, &subresourceLayout );
+                return FlushRange( desc );
+            }
 
-                    // Note that subresourceLayout.offset is offset from begining of resource
-                    offset += subresourceLayout.offset;
-                    size = subresourceLayout.size;
+            RESULT VulkanDevice::FlushRange( const MapResourceDesc& desc )
+            {
+                BGS_ASSERT( desc.hResource != ResourceHandle(), "Resource (hResource) must be a valid handle." );
+                BGS_ASSERT( desc.hResource.GetNativeHandle() != nullptr, "Resource (hResource) must hold valid internal resource." );
+                if( desc.hResource == ResourceHandle() )
+                {
+                    return Results::FAIL;
                 }
-                else
+
+                VulkanResource* pRes = desc.hResource.GetNativeHandle();
+                if( pRes->pMemory->isCoherent )
                 {
-                    offset += desc.bufferRange.offset;
-                    size = desc.bufferRange.size;
+                    return Results::OK;
                 }
 
+                VkDeviceSize offset;
+                VkDeviceSize size;
+                GetMappedRange( desc, &offset, &size );
+
                 VkMappedMemoryRange nativeMemRange;
-                nativeMemRange.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-                nativeMemRange.pNext  = nullptr;
-                nativeMemRange.memory = pRes->pMemory->nativeMemory;
-                nativeMemRange.size   = size;
-                nativeMemRange.offset = offset;
+                CreateVkMappedMemoryRange( pRes->pMemory, offset, size, &nativeMemRange );
+                if( m_pDeviceAPI->vkFlushMappedMemoryRanges( m_handle.GetNativeHandle(), 1, &nativeMemRange ) != VK_SUCCESS )
+                {
+                    return Results::FAIL;
+                }
+
+                return Results::OK;
+            }
+
+            RESULT VulkanDevice::InvalidateRange( const MapResourceDesc& desc )
+            {
+                BGS_ASSERT( desc.hResource != ResourceHandle(), "Resource (hResource) must be a valid handle." );
+                BGS_ASSERT( desc.hResource.GetNativeHandle() != nullptr, "Resource (hResource) must hold valid internal resource." );
+                if( desc.hResource == ResourceHandle() )
+                {
+                    return Results::FAIL;
+                }
+
+                VulkanResource* pRes = desc.hResource.GetNativeHandle();
+                if( pRes->pMemory->isCoherent )
+                {
+                    return Results::OK;
+                }
+
+                VkDeviceSize offset;
+                VkDeviceSize size;
+                GetMappedRange( desc, &offset, &size );
 
-                if( m_pDeviceAPI->vkFlushMappedMemoryRanges( nativeDevice, 1, &nativeMemRange ) != VK_SUCCESS )
+                VkMappedMemoryRange nativeMemRange;
+                CreateVkMappedMemoryRange( pRes->pMemory, offset, size, &nativeMemRange );
+                if( m_pDeviceAPI->vkInvalidateMappedMemoryRanges( m_handle.GetNativeHandle(), 1, &nativeMemRange ) != VK_SUCCESS )
                 {
                     return Results::FAIL;
                 }
@@ -1058,7 +1168,7 @@ namespace BIGOS
                     if( desc.usage & BGS_FLAG( ResourceViewUsageFlagBits::SAMPLED_TEXTURE ) )
                     {
                         const uint32_t blockSize = static_cast<uint32_t>( sizeof( VulkanResourceView ) + m_limits.sampledTextureBindingSize );
-                        if( BGS_FAILED( Core::Memory::AllocateBytes( m_pParent->GetParent()->GetDefaultAllocator(), &pBlock, blockSize ) ) )
+                        if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetObjectAllocator(), &pBlock, blockSize ) ) )
                         {
                             m_pDeviceAPI->vkDestroyImageView( nativeDevice, nativeView, nullptr );
                             return Results::NO_MEMORY;
@@ -1084,7 +1194,7 @@ namespace BIGOS
                     else if( desc.usage & BGS_FLAG( ResourceViewUsageFlagBits::STORAGE_TEXTURE ) )
                     {
                         const uint32_t blockSize = static_cast<uint32_t>( sizeof( VulkanResourceView ) + m_limits.storageTextureBindingSize );
-                        if( BGS_FAILED( Core::Memory::AllocateBytes( m_pParent->GetParent()->GetDefaultAllocator(), &pBlock, blockSize ) ) )
+                        if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetObjectAllocator(), &pBlock, blockSize ) ) )
                         {
                             m_pDeviceAPI->vkDestroyImageView( nativeDevice, nativeView, nullptr );
                             return Results::NO_MEMORY;
@@ -1109,8 +1219,7 @@ namespace BIGOS
                     }
                     else // Handling render target and depth stencil view
                     {
-                        if( BGS_FAILED( Core::Memory::AllocateBytes( m_pParent->GetParent()->GetDefaultAllocator(), &pBlock,
-                                                                     sizeof( VulkanResourceView ) ) ) )
+                        if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetObjectAllocator(), &pBlock, sizeof( VulkanResourceView ) ) ) )
                         {
                             m_pDeviceAPI->vkDestroyImageView( nativeDevice, nativeView, nullptr );
                             return Results::NO_MEMORY;
@@ -1129,7 +1238,7 @@ namespace BIGOS
                     {
                         const TexelBufferViewDesc& buffDesc = static_cast<const TexelBufferViewDesc&>( desc );
                         const uint32_t blockSize = static_cast<uint32_t>( sizeof( VulkanResourceView ) + m_limits.constantTexelBufferBindingSize );
-                        if( BGS_FAILED( Core::Memory::AllocateBytes( m_pParent->GetParent()->GetDefaultAllocator(), &pBlock, blockSize ) ) )
+                        if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetObjectAllocator(), &pBlock, blockSize ) ) )
                         {
                             return Results::NO_MEMORY;
                         }
@@ -1162,7 +1271,7 @@ namespace BIGOS
                     {
                         const TexelBufferViewDesc& buffDesc = static_cast<const TexelBufferViewDesc&>( desc );
                         const uint32_t blockSize = static_cast<uint32_t>( sizeof( VulkanResourceView ) + m_limits.storageTexelBufferBindingSize );
-                        if( BGS_FAILED( Core::Memory::AllocateBytes( m_pParent->GetParent()->GetDefaultAllocator(), &pBlock, blockSize ) ) )
+                        if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetObjectAllocator(), &pBlock, blockSize ) ) )
                         {
                             return Results::NO_MEMORY;
                         }
@@ -1194,7 +1303,7 @@ namespace BIGOS
                     {
                         const BufferViewDesc& buffDesc  = static_cast<const BufferViewDesc&>( desc );
                         const uint32_t        blockSize = static_cast<uint32_t>( sizeof( VulkanResourceView ) + m_limits.constantBufferBindingSize );
-                        if( BGS_FAILED( Core::Memory::AllocateBytes( m_pParent->GetParent()->GetDefaultAllocator(), &pBlock, blockSize ) ) )
+                        if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetObjectAllocator(), &pBlock, blockSize ) ) )
                         {
                             return Results::NO_MEMORY;
                         }
@@ -1226,7 +1335,7 @@ namespace BIGOS
                     {
                         const BufferViewDesc& buffDesc = static_cast<const BufferViewDesc&>( desc );
                         const uint32_t blockSize = static_cast<uint32_t>( sizeof( VulkanResourceView ) + m_limits.readOnlyStorageBufferBindingSize );
-                        if( BGS_FAILED( Core::Memory::AllocateBytes( m_pParent->GetParent()->GetDefaultAllocator(), &pBlock, blockSize ) ) )
+                        if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetObjectAllocator(), &pBlock, blockSize ) ) )
                         {
                             return Results::NO_MEMORY;
                         }
@@ -1259,7 +1368,7 @@ namespace BIGOS
                     {
                         const BufferViewDesc& buffDesc = static_cast<const BufferViewDesc&>( desc );
                         const uint32_t blockSize = static_cast<uint32_t>( sizeof( VulkanResourceView ) + m_limits.readWriteStorageBufferBindingSize );
-                        if( BGS_FAILED( Core::Memory::AllocateBytes( m_pParent->GetParent()->GetDefaultAllocator(), &pBlock, blockSize ) ) )
+                        if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetObjectAllocator(), &pBlock, blockSize ) ) )
                         {
                             return Results::NO_MEMORY;
                         }
@@ -1310,7 +1419,7 @@ namespace BIGOS
                         m_pDeviceAPI->vkDestroyImageView( nativeDevice, nativeView, nullptr );
                     }
 
-                    Core::Memory::Free( m_pParent->GetParent()->GetDefaultAllocator(), &pNativeView );
+                    Core::Memory::Free( m_pParent->GetParent()->GetObjectAllocator(), &pNativeView );
 
                     *pHandle = ResourceViewHandle();
                 }
@@ -1329,7 +1438,7 @@ namespace BIGOS
                 if( desc.type == SamplerTypes::NORMAL )
                 {
                     const uint32_t blockSize = static_cast<uint32_t>( sizeof( VulkanSampler ) + m_limits.samplerBindingSize );
-                    if( BGS_FAILED( Core::Memory::AllocateBytes( m_pParent->GetParent()->GetDefaultAllocator(), &pBlock, blockSize ) ) )
+                    if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetObjectAllocator(), &pBlock, blockSize ) ) )
                     {
                         return Results::NO_MEMORY;
                     }
@@ -1344,7 +1453,7 @@ namespace BIGOS
                 }
                 else // desc.type == SamplerTypes::IMMUTABLE
                 {
-                    if( BGS_FAILED( Core::Memory::AllocateBytes( m_pParent->GetParent()->GetDefaultAllocator(), &pBlock, sizeof( VulkanSampler ) ) ) )
+                    if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetObjectAllocator(), &pBlock, sizeof( VulkanSampler ) ) ) )
                     {
                         return Results::NO_MEMORY;
                     }
@@ -1381,7 +1490,7 @@ namespace BIGOS
 
                 if( m_pDeviceAPI->vkCreateSampler( nativeDevice, &samplerInfo, nullptr, &nativeSampler ) != VK_SUCCESS )
                 {
-                    Memory::Free( m_pParent->GetParent()->GetDefaultAllocator(), &pBlock );
+                    Memory::Free( m_pParent->GetParent()->GetObjectAllocator(), &pBlock );
                     return Results::FAIL;
                 }
 
@@ -1420,7 +1529,7 @@ namespace BIGOS
                     VulkanSampler* pSampler     = pHandle->GetNativeHandle();
 
                     m_pDeviceAPI->vkDestroySampler( nativeDevice, pSampler->sampler, nullptr );
-                    Memory::Free( m_pParent->GetParent()->GetDefaultAllocator(), &pSampler );
+                    Memory::Free( m_pParent->GetParent()->GetObjectAllocator(), &pSampler );
 
                     *pHandle = SamplerHandle();
                 }
@@ -1430,7 +1539,7 @@ namespace BIGOS
             {
                 BGS_ASSERT( pHandle != nullptr, "Command layout (pHandle) must be a valid address." );
                 VulkanCommandLayout* pNativeLayout = nullptr;
-                if( BGS_FAILED( Core::Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pNativeLayout ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetObjectAllocator(), &pNativeLayout ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -1451,7 +1560,7 @@ namespace BIGOS
                 {
                     VulkanCommandLayout* pLayout = pHandle->GetNativeHandle();
 
-                    Memory::FreeObject( m_pParent->GetParent()->GetDefaultAllocator(), &pLayout );
+                    Memory::FreeObject( m_pParent->GetParent()->GetObjectAllocator(), &pLayout );
 
                     *pHandle = CommandLayoutHandle();
                 }
@@ -1545,7 +1654,7 @@ namespace BIGOS
                     return Results::FAIL;
                 }
                 VulkanBindingHeap* pHeap = nullptr;
-                if( BGS_FAILED( Core::Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &pHeap ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetDefaultAllocator(), &pHeap ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -1574,7 +1683,14 @@ namespace BIGOS
                     return Results::FAIL;
                 }
 
-                uint32_t memNdx = FindVulkanMemTypeNdx( &m_heapProperties.memoryProperties, MAX_UINT32, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT );
+                // Coherent memory is preferred, so written bindings do not need flushing
+                const VkPhysicalDeviceMemoryProperties& memProps = m_heapProperties.memoryProperties;
+                const VkMemoryPropertyFlags             coherent = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+                uint32_t                                memNdx   = FindVulkanMemTypeNdx( &memProps, MAX_UINT32, coherent );
+                if( memNdx == MAX_UINT32 )
+                {
+                    memNdx = FindVulkanMemTypeNdx( &memProps, MAX_UINT32, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT );
+                }
                 BGS_ASSERT( memNdx != MAX_UINT32 );
                 if( memNdx == MAX_UINT32 )
                 {
@@ -1626,10 +1742,12 @@ namespace BIGOS
                 addressInfo.pNext  = nullptr;
                 addressInfo.buffer = nativeHeap;
 
-                pHeap->buffer  = nativeHeap;
-                pHeap->memory  = nativeMemory;
-                pHeap->address = m_pDeviceAPI->vkGetBufferDeviceAddress( nativeDevice, &addressInfo );
-                pHeap->flags   = buffInfo.usage;
+                pHeap->buffer     = nativeHeap;
+                pHeap->memory     = nativeMemory;
+                pHeap->memorySize = allocInfo.allocationSize;
+                pHeap->address    = m_pDeviceAPI->vkGetBufferDeviceAddress( nativeDevice, &addressInfo );
+                pHeap->flags      = buffInfo.usage;
+                pHeap->isCoherent = ( memProps.memoryTypes[ memNdx ].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT ) ? BGS_TRUE : BGS_FALSE;
 
                 *pHandle = BindingHeapHandle( pHeap );
 
@@ -1667,28 +1785,78 @@ namespace BIGOS
                 m_pDeviceAPI->vkGetDescriptorSetLayoutBindingOffsetEXT( nativeDevice, nativeLayout, desc.bindingNdx, pOffset );
             }
 
-            void VulkanDevice::WriteBinding( const WriteBindingDesc& desc )
+            void VulkanDevice::GetBindingSetLayoutSize( BindingSetLayoutHandle handle, uint64_t* pSize )
             {
-                BGS_ASSERT( desc.hDstHeap != BindingHeapHandle(), "Binding heap handle (desc.hDstHeap) must be a valid handle." );
-                BGS_ASSERT( ( desc.hResourceView != ResourceViewHandle() || desc.hSampler != SamplerHandle() ),
-                            "Resource view handle (desc.hResourceView) or sampler handle (desc.hSampler) must be a valid handle." );
+                BGS_ASSERT( pSize != nullptr, "Size (pSize) must be a valid address." );
+                BGS_ASSERT( handle != BindingSetLayoutHandle(), "Binding set layout handle (handle) must be a valid handle." );
 
-                VkDevice           nativeDevice = m_handle.GetNativeHandle();
-                VulkanBindingHeap* pHeap        = desc.hDstHeap.GetNativeHandle();
-                const void*        pData        = desc.bindingType == BindingTypes::SAMPLER ? desc.hSampler.GetNativeHandle()->pDescriptorData
-                                                                                            : desc.hResourceView.GetNativeHandle()->pDescriptorData;
-                byte_t*            pDst         = reinterpret_cast<byte_t*>( pHeap->pHost ) + desc.dstOffset;
-                const size_t       bindingSize  = static_cast<size_t>( m_bindingSizes[ BGS_ENUM_INDEX( desc.bindingType ) ] );
-                Memory::Copy( pData, bindingSize, pDst, bindingSize );
+                VkDevice              nativeDevice = m_handle.GetNativeHandle();
+                VkDescriptorSetLayout nativeLayout = handle.GetNativeHandle();
+
+                m_pDeviceAPI->vkGetDescriptorSetLayoutSizeEXT( nativeDevice, nativeLayout, pSize );
+            }
+
+            void VulkanDevice::WriteBindings( const WriteBindingDesc* pDescs, uint32_t descCount )
+            {
+                BGS_ASSERT( ( pDescs != nullptr ) || ( descCount == 0 ), "Binding writes (pDescs) must be a valid address." );
+
+                static constexpr uint32_t MAX_FLUSH_RANGE_COUNT = 32;
+
+                VkDevice                                               nativeDevice = m_handle.GetNativeHandle();
+                StackArray<VkMappedMemoryRange, MAX_FLUSH_RANGE_COUNT> ranges;
+                uint32_t                                               rangeCount   = 0;
+                for( uint32_t ndx = 0; ndx < descCount; ++ndx )
+                {
+                    const WriteBindingDesc& desc = pDescs[ ndx ];
+                    BGS_ASSERT( desc.hDstHeap != BindingHeapHandle(), "Binding heap handle (desc.hDstHeap) must be a valid handle." );
+                    BGS_ASSERT( ( desc.hResourceView != ResourceViewHandle() || desc.hSampler != SamplerHandle() ),
+                                "Resource view handle (desc.hResourceView) or sampler handle (desc.hSampler) must be a valid handle." );
+
+                    const bool_t       isSampler   = desc.bindingType == BindingTypes::SAMPLER;
+                    VulkanBindingHeap* pHeap       = desc.hDstHeap.GetNativeHandle();
+                    const void*        pData       = isSampler ? desc.hSampler.GetNativeHandle()->pDescriptorData
+                                                               : desc.hResourceView.GetNativeHandle()->pDescriptorData;
+                    byte_t*            pDst        = reinterpret_cast<byte_t*>( pHeap->pHost ) + desc.dstOffset;
+                    const size_t       bindingSize = static_cast<size_t>( m_bindingSizes[ BGS_ENUM_INDEX( desc.bindingType ) ] );
+                    Memory::Copy( pData, bindingSize, pDst, bindingSize );
+                    if( pHeap->isCoherent )
+                    {
+                        continue;
+                    }
+
+                    // Range has to be aligned to nonCoherentAtomSize or reach the end of the allocation
+                    const VkDeviceSize alignedEnd = ( desc.dstOffset + bindingSize + m_nonCoherentAtomSize - 1 ) & ~( m_nonCoherentAtomSize - 1 );
+                    const VkDeviceSize begin      = desc.dstOffset & ~( m_nonCoherentAtomSize - 1 );
+                    const VkDeviceSize end        = alignedEnd < pHeap->memorySize ? alignedEnd : pHeap->memorySize;
+
+                    // Neighbouring bindings are usually written one after another, so they are merged into the last range
+                    VkMappedMemoryRange* pLast = rangeCount > 0 ? &ranges[ rangeCount - 1 ] : nullptr;
+                    if( ( pLast != nullptr ) && ( pLast->memory == pHeap->memory ) && ( begin <= pLast->offset + pLast->size ) &&
+                        ( end >= pLast->offset ) )
+                    {
+                        const VkDeviceSize lastEnd = pLast->offset + pLast->size;
+                        pLast->offset              = begin < pLast->offset ? begin : pLast->offset;
+                        pLast->size                = ( end > lastEnd ? end : lastEnd ) - pLast->offset;
+                        continue;
+                    }
 
-                VkMappedMemoryRange range;
-                range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-                range.pNext  = nullptr;
-                range.offset = 0;
-                range.size   = VK_WHOLE_SIZE;
-                range.memory = pHeap->memory;
+                    if( rangeCount == MAX_FLUSH_RANGE_COUNT )
+                    {
+                        m_pDeviceAPI->vkFlushMappedMemoryRanges( nativeDevice, rangeCount, ranges.data() );
+                        rangeCount = 0;
+                    }
+                    VkMappedMemoryRange& range = ranges[ rangeCount++ ];
+                    range.sType                = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+                    range.pNext                = nullptr;
+                    range.memory               = pHeap->memory;
+                    range.offset               = begin;
+                    range.size                 = end - begin;
+                }
 
-                m_pDeviceAPI->vkFlushMappedMemoryRanges( nativeDevice, 1, &range );
+                if( rangeCount > 0 )
+                {
+                    m_pDeviceAPI->vkFlushMappedMemoryRanges( nativeDevice, rangeCount, ranges.data() );
+                }
             }
 
             RESULT VulkanDevice::CreateQueryPool( const QueryPoolDesc& desc, QueryPoolHandle* pHandle )
@@ -1771,6 +1939,11 @@ namespace BIGOS
                 if( m_handle != DeviceHandle() )
                 {
                     VkDevice nativeDevice = m_handle.GetNativeHandle();
+                    if( m_pipelineCache != VK_NULL_HANDLE )
+                    {
+                        m_pDeviceAPI->vkDestroyPipelineCache( nativeDevice, m_pipelineCache, nullptr );
+                        m_pipelineCache = VK_NULL_HANDLE;
+                    }
                     m_pDeviceAPI->vkDestroyDevice( nativeDevice, nullptr );
                 }
 
@@ -1814,15 +1987,23 @@ namespace BIGOS
                     queueCreateInfos[ ndx ].pQueuePriorities = queuePrios[ ndx ];
                 }
 
-                const char* const* ppQueriedExt    = deviceFeaturesHelper.GetExtNames();
-                const uint32_t     queriedExtCount = deviceFeaturesHelper.GetExtCount();
-
-                if( BGS_FAILED( CheckVkExtensionSupport( queriedExtCount, ppQueriedExt ) ) )
+                if( BGS_FAILED( CheckVkExtensionSupport( deviceFeaturesHelper.GetExtCount(), deviceFeaturesHelper.GetExtNames() ) ) )
                 {
                     return Results::NOT_FOUND;
                 }
 
-                if( BGS_FAILED( Core::Memory::AllocateObject( m_pParent->GetParent()->GetDefaultAllocator(), &m_pDeviceAPI ) ) )
+                // Memory budget is optional, without it budget is estimated from heap sizes
+                const char* pBudgetExt  = VK_EXT_MEMORY_BUDGET_EXTENSION_NAME;
+                m_memoryBudgetSupported = BGS_SUCCESS( CheckVkExtensionSupport( 1, &pBudgetExt ) );
+                if( m_memoryBudgetSupported )
+                {
+                    deviceFeaturesHelper.AddExtension( pBudgetExt );
+                }
+
+                const char* const* ppQueriedExt    = deviceFeaturesHelper.GetExtNames();
+                const uint32_t     queriedExtCount = deviceFeaturesHelper.GetExtCount();
+
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetParent()->GetDefaultAllocator(), &m_pDeviceAPI ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -1852,12 +2033,49 @@ namespace BIGOS
                 m_heapProperties.pNext = nullptr;
                 vkGetPhysicalDeviceMemoryProperties2( nativeAdapter, &m_heapProperties );
 
+                VkPhysicalDeviceProperties nativeProps;
+                vkGetPhysicalDeviceProperties( nativeAdapter, &nativeProps );
+                m_nonCoherentAtomSize = nativeProps.limits.nonCoherentAtomSize;
+
                 Memory::Set( m_bindingSizes, 0, sizeof( m_bindingSizes ) );
+                for( index_t ndx = 0; ndx < VK_MAX_MEMORY_HEAPS; ++ndx )
+                {
+                    m_heapUsages[ ndx ].store( 0, std::memory_order_relaxed );
+                }
 
                 QueryVkBindingsSize();
 
                 m_handle = DeviceHandle( nativeDevice );
 
+                // Pipelines are created without cache, if it fails
+                CreateVkPipelineCache( nativeProps );
+
+                return Results::OK;
+            }
+
+            RESULT VulkanDevice::CreateVkPipelineCache( const VkPhysicalDeviceProperties& props )
+            {
+                FillPipelineCacheHeader( APITypes::VULKAN, m_desc.pAdapter->GetInfo(), props.pipelineCacheUUID, &m_pipelineCacheHeader );
+
+                VkPipelineCacheCreateInfo cacheInfo;
+                cacheInfo.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+                cacheInfo.pNext           = nullptr;
+                cacheInfo.flags           = 0;
+                cacheInfo.initialDataSize = 0;
+                cacheInfo.pInitialData    = nullptr;
+                if( IsPipelineCacheValid( m_pipelineCacheHeader, m_desc.pPipelineCacheData, m_desc.pipelineCacheSize ) )
+                {
+                    cacheInfo.initialDataSize = static_cast<size_t>( m_desc.pipelineCacheSize - sizeof( PipelineCacheHeader ) );
+                    cacheInfo.pInitialData    = static_cast<const byte_t*>( m_desc.pPipelineCacheData ) + sizeof( PipelineCacheHeader );
+                }
+
+                VkDevice nativeDevice = m_handle.GetNativeHandle();
+                if( m_pDeviceAPI->vkCreatePipelineCache( nativeDevice, &cacheInfo, nullptr, &m_pipelineCache ) != VK_SUCCESS )
+                {
+                    m_pipelineCache = VK_NULL_HANDLE;
+                    return Results::FAIL;
+                }
+
                 return Results::OK;
             }
 
@@ -2108,8 +2326,7 @@ namespace BIGOS
                 VkDevice   nativeDevice   = m_handle.GetNativeHandle();
                 VkPipeline nativePipeline = VK_NULL_HANDLE;
 
-                // TODO: Handle cached pso
-                if( m_pDeviceAPI->vkCreateGraphicsPipelines( nativeDevice, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &nativePipeline ) !=
+                if( m_pDeviceAPI->vkCreateGraphicsPipelines( nativeDevice, m_pipelineCache, 1, &pipelineInfo, nullptr, &nativePipeline ) !=
                     VK_SUCCESS )
                 {
                     return Results::FAIL;
@@ -2134,8 +2351,8 @@ namespace BIGOS
                 VkDevice   nativeDevice   = m_handle.GetNativeHandle();
                 VkPipeline nativePipeline = VK_NULL_HANDLE;
 
-                // TODO: Handle cached pso
-                if( m_pDeviceAPI->vkCreateComputePipelines( nativeDevice, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &nativePipeline ) != VK_SUCCESS )
+                if( m_pDeviceAPI->vkCreateComputePipelines( nativeDevice, m_pipelineCache, 1, &pipelineInfo, nullptr, &nativePipeline ) !=
+                    VK_SUCCESS )
                 {
                     return Results::FAIL;
                 }
@@ -2204,6 +2421,50 @@ namespace BIGOS
                 return Results::OK;
             }
 
+            void VulkanDevice::GetMappedRange( const MapResourceDesc& desc, VkDeviceSize* pOffset, VkDeviceSize* pSize )
+            {
+                VulkanResource* pRes   = desc.hResource.GetNativeHandle();
+                VkDeviceSize    offset = pRes->memoryOffset;
+                VkDeviceSize    size;
+                if( pRes->type == VulkanResourceTypes::IMAGE )
+                {
+                    VkImage             nativeImage = pRes->image;
+                    VkSubresourceLayout subresourceLayout;
+                    VkImageSubresource  subresource;
+                    subresource.aspectMask = MapBigosTextureComponentFlagsToVulkanImageAspectFlags( desc.textureRange.components );
+                    subresource.arrayLayer = desc.textureRange.arrayLayer;
+                    subresource.mipLevel   = desc.textureRange.mipLevel;
+
+                    m_pDeviceAPI->vkGetImageSubresourceLayout( m_handle.GetNativeHandle(), nativeImage, &subresource, &subresourceLayout );
+
+                    // Note that subresourceLayout.offset is offset from begining of resource
+                    offset += subresourceLayout.offset;
+                    size = subresourceLayout.size;
+                }
+                else
+                {
+                    offset += desc.bufferRange.offset;
+                    size = desc.bufferRange.size;
+                }
+
+                *pOffset = offset;
+                *pSize   = size;
+            }
+
+            void VulkanDevice::CreateVkMappedMemoryRange( const VulkanMemory* pMemory, VkDeviceSize offset, VkDeviceSize size,
+                                                          VkMappedMemoryRange* pRange )
+            {
+                // Range has to be aligned to nonCoherentAtomSize or reach the end of the allocation
+                const VkDeviceSize begin = offset & ~( m_nonCoherentAtomSize - 1 );
+                const VkDeviceSize end   = ( offset + size + m_nonCoherentAtomSize - 1 ) & ~( m_nonCoherentAtomSize - 1 );
+
+                pRange->sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+                pRange->pNext  = nullptr;
+                pRange->memory = pMemory->nativeMemory;
+                pRange->offset = begin;
+                pRange->size   = end < pMemory->size ? end - begin : VK_WHOLE_SIZE;
+            }
+
             void VulkanDevice::EnumerateNativeQueues()
             {
                 VkPhysicalDevice nativeAdapter = m_desc.pAdapter->GetHandle().GetNativeHandle();
@@ -2316,6 +2577,7 @@ namespace BIGOS
                 m_bindingSizes[ BGS_ENUM_INDEX( BindingTypes::READ_ONLY_STORAGE_BUFFER ) ]  = m_limits.readOnlyStorageBufferBindingSize;
                 m_limits.readWriteStorageBufferBindingSize                                  = descBufferProps.storageBufferDescriptorSize;
                 m_bindingSizes[ BGS_ENUM_INDEX( BindingTypes::READ_WRITE_STORAGE_BUFFER ) ] = m_limits.readWriteStorageBufferBindingSize;
+                m_limits.bindingSetAlignment                                                = descBufferProps.descriptorBufferOffsetAlignment;
 
                 if( m_limits.samplerBindingSize > m_bindingSize )
                 {
@@ -52,6 +52,7 @@ namespace BIGOS
                 virtual void   DestroyPipelineLayout( PipelineLayoutHandle* pHandle ) override;
                 virtual RESULT CreatePipeline( const PipelineDesc& desc, PipelineHandle* pHandle ) override;
                 virtual void   DestroyPipeline( PipelineHandle* pHandle ) override;
+                virtual RESULT GetPipelineCacheData( void* pData, uint64_t* pSize ) override;
 
                 virtual RESULT CreateFence( const FenceDesc& desc, FenceHandle* pHandle ) override;
                 virtual void   DestroyFence( FenceHandle* pHandle ) override;
@@ -64,6 +65,7 @@ namespace BIGOS
 
                 virtual RESULT AllocateMemory( const AllocateMemoryDesc& desc, MemoryHandle* pHandle ) override;
                 virtual void   FreeMemory( MemoryHandle* pHandle ) override;
+                virtual RESULT QueryMemoryBudget( MemoryBudgetInfo* pInfo ) override;
 
                 virtual RESULT CreateResource( const ResourceDesc& desc, ResourceHandle* pHandle ) override;
                 virtual void   DestroyResource( ResourceHandle* pHandle ) override;
@@ -71,6 +73,8 @@ namespace BIGOS
                 virtual void   GetResourceAllocationInfo( ResourceHandle handle, ResourceAllocationInfo* pInfo ) override;
                 virtual RESULT MapResource( const MapResourceDesc& desc, void** ppResource ) override;
                 virtual RESULT UnmapResource( const MapResourceDesc& desc ) override;
+                virtual RESULT FlushRange( const MapResourceDesc& desc ) override;
+                virtual RESULT InvalidateRange( const MapResourceDesc& desc ) override;
 
                 virtual RESULT CreateResourceView( const ResourceViewDesc& desc, ResourceViewHandle* pHandle ) override;
                 virtual void   DestroyResourceView( ResourceViewHandle* pHandle ) override;
@@ -85,7 +89,8 @@ namespace BIGOS
                 virtual RESULT CreateBindingHeap( const BindingHeapDesc& desc, BindingHeapHandle* pHandle ) override;
                 virtual void   DestroyBindingHeap( BindingHeapHandle* pHandle ) override;
                 virtual void   GetBindingOffset( const GetBindingOffsetDesc& desc, uint64_t* pOffset ) override;
-                virtual void   WriteBinding( const WriteBindingDesc& desc ) override;
+                virtual void   GetBindingSetLayoutSize( BindingSetLayoutHandle handle, uint64_t* pSize ) override;
+                virtual void   WriteBindings( const WriteBindingDesc* pDescs, uint32_t descCount ) override;
 
                 virtual RESULT CreateQueryPool( const QueryPoolDesc& desc, QueryPoolHandle* pHandle ) override;
                 virtual void   DestroyQueryPool( QueryPoolHandle* pHandle ) override;
@@ -104,11 +109,15 @@ namespace BIGOS
 
             private:
                 RESULT CreateVkDevice();
+                RESULT CreateVkPipelineCache( const VkPhysicalDeviceProperties& props );
                 RESULT CreateVkGraphicsPipeline( const GraphicsPipelineDesc& gpDesc, VkPipeline* pNativePipeline );
                 RESULT CreateVkComputePipeline( const ComputePipelineDesc& cpDesc, VkPipeline* pNativePipeline );
                 RESULT CreateVkBuffer( const ResourceDesc desc, VkBuffer* pBuff );
                 RESULT CreateVkImage( const ResourceDesc desc, VkImage* pImg );
 
+                void GetMappedRange( const MapResourceDesc& desc, VkDeviceSize* pOffset, VkDeviceSize* pSize );
+                void CreateVkMappedMemoryRange( const VulkanMemory* pMemory, VkDeviceSize offset, VkDeviceSize size, VkMappedMemoryRange* pRange );
+
                 void EnumerateNativeQueues();
                 void QueryVkBindingsSize();
 
@@ -118,9 +127,14 @@ namespace BIGOS
                 uint64_t              m_bindingSizes[ BGS_ENUM_COUNT( BindingTypes ) ];
                 VulkanQueueProperties m_queueProperties;
                 VulkanHeapProperties  m_heapProperties;
-                VulkanFactory*        m_pParent     = nullptr;
-                uint64_t              m_bindingSize = 0;
+                VulkanFactory*        m_pParent             = nullptr;
+                uint64_t              m_bindingSize         = 0;
+                VkDeviceSize          m_nonCoherentAtomSize = 1;
                 VolkDeviceTable*      m_pDeviceAPI;
+                Atomic<uint64_t>      m_heapUsages[ VK_MAX_MEMORY_HEAPS ]; // Own allocations, used when budget extension is missing
+                bool_t                m_memoryBudgetSupported = BGS_FALSE;
+                VkPipelineCache       m_pipelineCache         = VK_NULL_HANDLE;
+                PipelineCacheHeader   m_pipelineCacheHeader;
             };
         } // namespace Backend
     }     // namespace Driver
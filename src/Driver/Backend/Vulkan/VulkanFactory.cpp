@@ -28,7 +28,7 @@ namespace BIGOS
                 BGS_ASSERT( ( ppDevice != nullptr ) && ( *ppDevice == nullptr ) );
 
                 VulkanDevice* pDevice = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pParent->GetDefaultAllocator(), &pDevice ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetDefaultAllocator(), &pDevice ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -62,6 +62,7 @@ namespace BIGOS
 
                 m_desc    = desc;
                 m_pParent = pParent;
+                m_adapters.SetAllocator( m_pParent->GetDefaultAllocator() );
 
                 if( volkInitialize() != VK_SUCCESS )
                 {
@@ -105,6 +106,7 @@ namespace BIGOS
                     Core::Memory::FreeObject( m_pParent->GetDefaultAllocator(), &m_adapters[ ndx ] );
                 }
                 m_adapters.clear();
+                m_adapters.shrink_to_fit();
 
                 m_pParent = nullptr;
                 m_handle  = FactoryHandle();
@@ -318,7 +320,7 @@ namespace BIGOS
                 for( index_t ndx = 0; ndx < nativeAdapters.size(); ++ndx )
                 {
                     VulkanAdapter* pVulkanAdapter = nullptr;
-                    if( BGS_FAILED( Core::Memory::AllocateObject( m_pParent->GetDefaultAllocator(), &pVulkanAdapter ) ) )
+                    if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetDefaultAllocator(), &pVulkanAdapter ) ) )
                     {
                         return Results::NO_MEMORY;
                     }
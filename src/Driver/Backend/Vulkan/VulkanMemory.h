@@ -7,6 +7,9 @@ namespace BIGOS::Driver::Backend
     struct VulkanMemory
     {
         VkDeviceMemory nativeMemory;
+        VkDeviceSize   size;
         void*          pHostMemory;
+        uint32_t       heapIndex;
+        bool_t         isCoherent;
     };
 } // namespace BIGOS::Driver::Backend
\ No newline at end of file
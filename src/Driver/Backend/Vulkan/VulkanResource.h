@@ -15,6 +15,7 @@ namespace BIGOS::Driver::Backend
         VulkanMemory*        pMemory;
         VkDeviceSize         memoryOffset;
         ResourceUsageFlags   usage;
+        ResourceFlags        flags;
         VULKAN_RESOURCE_TYPE type;
     };
 } // namespace BIGOS::Driver::Backend
\ No newline at end of file
@@ -328,8 +328,8 @@ namespace BIGOS
 
                 SemaphoreDesc   desc;
                 VulkanResource* pResArr = nullptr;
-                if( BGS_FAILED( Core::Memory::AllocateArray( m_pParent->GetParent()->GetParent()->GetDefaultAllocator(), &pResArr,
-                                                             m_desc.backBufferCount, alignof( VulkanResource ) ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_ARRAY( m_pParent->GetParent()->GetParent()->GetDefaultAllocator(), &pResArr,
+                                                    m_desc.backBufferCount, alignof( VulkanResource ) ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -342,6 +342,7 @@ namespace BIGOS
                     currRes.image                    = images[ ndx ];
                     currRes.pMemory                  = nullptr;
                     currRes.usage                    = static_cast<ResourceUsageFlags>( ResourceUsageFlagBits::COLOR_RENDER_TARGET );
+                    currRes.flags                    = static_cast<ResourceFlags>( ResourceFlagBits::NONE );
                     currRes.memoryOffset             = INVALID_OFFSET;
                     m_backBuffers[ ndx ].hBackBuffer = ResourceHandle( &currRes );
                     if( BGS_FAILED( m_pParent->CreateSemaphore( desc, &m_backBuffers[ ndx ].hBackBufferAvailableSemaphore ) ) )
@@ -0,0 +1,388 @@
+#include "Driver/Frontend/BindingObjectCache.h"
+
+#include "Core/Memory/Memory.h"
+#include "Core/Utils/Hash.h"
+#include "Driver/Frontend/RenderSystem.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+
+            static uint32_t GetHandleBucket( handle_t handle, uint32_t bucketCount )
+            {
+                // Handles are pointers, low bits are mostly zero
+                return static_cast<uint32_t>( ( handle * 0x9E3779B97F4A7C15ull ) >> 32 ) & ( bucketCount - 1 );
+            }
+
+            BindingObjectCache::BindingObjectCache()
+                : m_desc()
+                , m_pParent( nullptr )
+                , m_entries()
+                , m_keyBuckets()
+                , m_handleBuckets()
+                , m_freeEntries()
+                , m_mutex()
+                , m_entryCount( 0 )
+            {
+            }
+
+            RESULT BindingObjectCache::CreateResourceView( const Backend::BufferViewDesc& desc, Backend::ResourceViewHandle* pHandle )
+            {
+                ViewKey key;
+                Memory::Set( &key, 0, sizeof( key ) );
+                key.hResource   = desc.hResource;
+                key.usage       = desc.usage;
+                key.bufferRange = desc.range;
+
+                return CreateResourceView( desc, key, pHandle );
+            }
+
+            RESULT BindingObjectCache::CreateResourceView( const Backend::TexelBufferViewDesc& desc, Backend::ResourceViewHandle* pHandle )
+            {
+                ViewKey key;
+                Memory::Set( &key, 0, sizeof( key ) );
+                key.hResource   = desc.hResource;
+                key.usage       = desc.usage;
+                key.bufferRange = desc.range;
+                key.format      = desc.format;
+
+                return CreateResourceView( desc, key, pHandle );
+            }
+
+            RESULT BindingObjectCache::CreateResourceView( const Backend::TextureViewDesc& desc, Backend::ResourceViewHandle* pHandle )
+            {
+                ViewKey key;
+                Memory::Set( &key, 0, sizeof( key ) );
+                key.hResource                    = desc.hResource;
+                key.usage                        = desc.usage;
+                key.textureRange.components      = desc.range.components;
+                key.textureRange.mipLevel        = desc.range.mipLevel;
+                key.textureRange.mipLevelCount   = desc.range.mipLevelCount;
+                key.textureRange.arrayLayer      = desc.range.arrayLayer;
+                key.textureRange.arrayLayerCount = desc.range.arrayLayerCount;
+                key.format                       = desc.format;
+                key.textureType                  = desc.textureType;
+                key.layout                       = desc.layout;
+
+                return CreateResourceView( desc, key, pHandle );
+            }
+
+            void BindingObjectCache::ReleaseResourceView( Backend::ResourceViewHandle* pHandle )
+            {
+                BGS_ASSERT( pHandle != nullptr, "Resource view handle (pHandle) must be a valid address." );
+                if( ( pHandle == nullptr ) || ( *pHandle == Backend::ResourceViewHandle() ) )
+                {
+                    return;
+                }
+
+                if( Release( pHandle->GetNativeHandle() ) )
+                {
+                    m_pParent->GetDevice()->DestroyResourceView( pHandle );
+                }
+                *pHandle = Backend::ResourceViewHandle();
+            }
+
+            RESULT BindingObjectCache::CreateSampler( const Backend::SamplerDesc& desc, Backend::SamplerHandle* pHandle )
+            {
+                BGS_ASSERT( pHandle != nullptr, "Sampler handle (pHandle) must be a valid address." );
+                if( pHandle == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                // Only border color member used by the backend for sampler type goes to the key
+                Backend::SamplerDesc key;
+                Memory::Set( &key, 0, sizeof( key ) );
+                if( desc.type == Backend::SamplerTypes::NORMAL )
+                {
+                    key.customBorderColor = desc.customBorderColor;
+                }
+                else
+                {
+                    key.enumBorderColor = desc.enumBorderColor;
+                }
+                key.mipLodBias       = desc.mipLodBias;
+                key.maxAnisotropy    = desc.maxAnisotropy;
+                key.minLod           = desc.minLod;
+                key.maxLod           = desc.maxLod;
+                key.anisotropyEnable = desc.anisotropyEnable;
+                key.compareEnable    = desc.compareEnable;
+                key.minFilter        = desc.minFilter;
+                key.magFilter        = desc.magFilter;
+                key.mipMapFilter     = desc.mipMapFilter;
+                key.addressU         = desc.addressU;
+                key.addressV         = desc.addressV;
+                key.addressW         = desc.addressW;
+                key.compareOperation = desc.compareOperation;
+                key.reductionMode    = desc.reductionMode;
+                key.type             = desc.type;
+
+                byte_t keyData[ KEY_SIZE ] = {};
+                Memory::Copy( &key, sizeof( key ), keyData, KEY_SIZE );
+                const hash_t hash = Core::Utils::Hash::FNV1a( keyData, KEY_SIZE );
+
+                // Lock is held while object is created, so threads asking for the same description do not create it twice
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                const uint32_t entryNdx = Acquire( EntryTypes::SAMPLER, keyData, hash );
+                if( entryNdx != MAX_UINT32 )
+                {
+                    *pHandle = Backend::SamplerHandle( m_entries[ entryNdx ].handle );
+                    return Results::OK;
+                }
+
+                Backend::SamplerHandle hSampler;
+                if( BGS_FAILED( m_pParent->GetDevice()->CreateSampler( desc, &hSampler ) ) )
+                {
+                    return Results::FAIL;
+                }
+                if( BGS_FAILED( Insert( EntryTypes::SAMPLER, keyData, hash, hSampler.GetNativeHandle() ) ) )
+                {
+                    m_pParent->GetDevice()->DestroySampler( &hSampler );
+                    return Results::NO_MEMORY;
+                }
+
+                *pHandle = hSampler;
+
+                return Results::OK;
+            }
+
+            void BindingObjectCache::ReleaseSampler( Backend::SamplerHandle* pHandle )
+            {
+                BGS_ASSERT( pHandle != nullptr, "Sampler handle (pHandle) must be a valid address." );
+                if( ( pHandle == nullptr ) || ( *pHandle == Backend::SamplerHandle() ) )
+                {
+                    return;
+                }
+
+                if( Release( pHandle->GetNativeHandle() ) )
+                {
+                    m_pParent->GetDevice()->DestroySampler( pHandle );
+                }
+                *pHandle = Backend::SamplerHandle();
+            }
+
+            RESULT BindingObjectCache::Create( const BindingObjectCacheDesc& desc, RenderSystem* pSystem )
+            {
+                BGS_ASSERT( pSystem != nullptr, "Render system (pSystem) must be a valid pointer." );
+                BGS_ASSERT( ( desc.bucketCount > 0 ) && ( ( desc.bucketCount & ( desc.bucketCount - 1 ) ) == 0 ),
+                            "Bucket count (desc.bucketCount) must be the power of 2." );
+                if( ( desc.bucketCount == 0 ) || ( ( desc.bucketCount & ( desc.bucketCount - 1 ) ) != 0 ) )
+                {
+                    return Results::FAIL;
+                }
+                m_pParent    = pSystem;
+                m_desc       = desc;
+                m_entryCount = 0;
+
+                m_entries.SetAllocator( m_pParent->GetDefaultAllocator() );
+                m_keyBuckets.SetAllocator( m_pParent->GetDefaultAllocator() );
+                m_handleBuckets.SetAllocator( m_pParent->GetDefaultAllocator() );
+                m_freeEntries.SetAllocator( m_pParent->GetDefaultAllocator() );
+
+                return Rehash( desc.bucketCount );
+            }
+
+            void BindingObjectCache::Destroy()
+            {
+                // Objects still referenced here were leaked by their users
+                BGS_ASSERT( m_entryCount == 0, "Not all cached views and samplers were released." );
+                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
+                for( index_t ndx = 0; ndx < m_entries.size(); ++ndx )
+                {
+                    Entry& entry = m_entries[ ndx ];
+                    if( entry.refCount == 0 )
+                    {
+                        continue;
+                    }
+                    if( entry.type == EntryTypes::RESOURCE_VIEW )
+                    {
+                        Backend::ResourceViewHandle hView( entry.handle );
+                        pAPIDevice->DestroyResourceView( &hView );
+                    }
+                    else
+                    {
+                        Backend::SamplerHandle hSampler( entry.handle );
+                        pAPIDevice->DestroySampler( &hSampler );
+                    }
+                }
+
+                m_entries.clear();
+                m_entries.shrink_to_fit();
+                m_keyBuckets.clear();
+                m_keyBuckets.shrink_to_fit();
+                m_handleBuckets.clear();
+                m_handleBuckets.shrink_to_fit();
+                m_freeEntries.clear();
+                m_freeEntries.shrink_to_fit();
+                m_entryCount = 0;
+            }
+
+            RESULT BindingObjectCache::CreateResourceView( const Backend::ResourceViewDesc& desc, const ViewKey& key,
+                                                           Backend::ResourceViewHandle* pHandle )
+            {
+                BGS_ASSERT( pHandle != nullptr, "Resource view handle (pHandle) must be a valid address." );
+                if( pHandle == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                byte_t keyData[ KEY_SIZE ] = {};
+                Memory::Copy( &key, sizeof( key ), keyData, KEY_SIZE );
+                const hash_t hash = Core::Utils::Hash::FNV1a( keyData, KEY_SIZE );
+
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                const uint32_t entryNdx = Acquire( EntryTypes::RESOURCE_VIEW, keyData, hash );
+                if( entryNdx != MAX_UINT32 )
+                {
+                    *pHandle = Backend::ResourceViewHandle( m_entries[ entryNdx ].handle );
+                    return Results::OK;
+                }
+
+                Backend::ResourceViewHandle hView;
+                if( BGS_FAILED( m_pParent->GetDevice()->CreateResourceView( desc, &hView ) ) )
+                {
+                    return Results::FAIL;
+                }
+                if( BGS_FAILED( Insert( EntryTypes::RESOURCE_VIEW, keyData, hash, hView.GetNativeHandle() ) ) )
+                {
+                    m_pParent->GetDevice()->DestroyResourceView( &hView );
+                    return Results::NO_MEMORY;
+                }
+
+                *pHandle = hView;
+
+                return Results::OK;
+            }
+
+            uint32_t BindingObjectCache::Acquire( ENTRY_TYPE type, const byte_t* pKey, hash_t hash )
+            {
+                uint32_t entryNdx = m_keyBuckets[ static_cast<uint32_t>( hash ) & ( m_keyBuckets.size() - 1 ) ];
+                while( entryNdx != MAX_UINT32 )
+                {
+                    Entry& entry = m_entries[ entryNdx ];
+                    if( ( entry.hash == hash ) && ( entry.type == type ) && ( Memory::Compare( entry.key, pKey, KEY_SIZE ) == 0 ) )
+                    {
+                        entry.refCount++;
+                        return entryNdx;
+                    }
+                    entryNdx = entry.nextByKey;
+                }
+
+                return MAX_UINT32;
+            }
+
+            RESULT BindingObjectCache::Insert( ENTRY_TYPE type, const byte_t* pKey, hash_t hash, handle_t handle )
+            {
+                if( m_entryCount >= m_keyBuckets.size() )
+                {
+                    if( BGS_FAILED( Rehash( static_cast<uint32_t>( m_keyBuckets.size() * 2 ) ) ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+                }
+
+                uint32_t entryNdx = 0;
+                if( !m_freeEntries.empty() )
+                {
+                    entryNdx = m_freeEntries.back();
+                    m_freeEntries.pop_back();
+                }
+                else
+                {
+                    entryNdx = static_cast<uint32_t>( m_entries.size() );
+                    m_entries.push_back( Entry() );
+                }
+
+                const uint32_t keyBucket    = static_cast<uint32_t>( hash ) & ( m_keyBuckets.size() - 1 );
+                const uint32_t handleBucket = GetHandleBucket( handle, static_cast<uint32_t>( m_handleBuckets.size() ) );
+
+                Entry& entry = m_entries[ entryNdx ];
+                Memory::Copy( pKey, KEY_SIZE, entry.key, KEY_SIZE );
+                entry.hash                      = hash;
+                entry.handle                    = handle;
+                entry.refCount                  = 1;
+                entry.type                      = type;
+                entry.nextByKey                 = m_keyBuckets[ keyBucket ];
+                entry.nextByHandle              = m_handleBuckets[ handleBucket ];
+                m_keyBuckets[ keyBucket ]       = entryNdx;
+                m_handleBuckets[ handleBucket ] = entryNdx;
+                m_entryCount++;
+
+                return Results::OK;
+            }
+
+            bool_t BindingObjectCache::Release( handle_t handle )
+            {
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                uint32_t* pHandleLink = &m_handleBuckets[ GetHandleBucket( handle, static_cast<uint32_t>( m_handleBuckets.size() ) ) ];
+                while( ( *pHandleLink != MAX_UINT32 ) && ( m_entries[ *pHandleLink ].handle != handle ) )
+                {
+                    pHandleLink = &m_entries[ *pHandleLink ].nextByHandle;
+                }
+                BGS_ASSERT( *pHandleLink != MAX_UINT32, "Handle (handle) was not created by binding object cache." );
+                if( *pHandleLink == MAX_UINT32 )
+                {
+                    return BGS_FALSE;
+                }
+
+                const uint32_t entryNdx = *pHandleLink;
+                Entry&         entry    = m_entries[ entryNdx ];
+                if( --entry.refCount > 0 )
+                {
+                    return BGS_FALSE;
+                }
+
+                uint32_t* pKeyLink = &m_keyBuckets[ static_cast<uint32_t>( entry.hash ) & ( m_keyBuckets.size() - 1 ) ];
+                while( *pKeyLink != entryNdx )
+                {
+                    pKeyLink = &m_entries[ *pKeyLink ].nextByKey;
+                }
+                *pKeyLink    = entry.nextByKey;
+                *pHandleLink = entry.nextByHandle;
+                m_freeEntries.push_back( entryNdx );
+                m_entryCount--;
+
+                return BGS_TRUE;
+            }
+
+            RESULT BindingObjectCache::Rehash( uint32_t bucketCount )
+            {
+                m_keyBuckets.resize( bucketCount );
+                m_handleBuckets.resize( bucketCount );
+                if( ( m_keyBuckets.size() != bucketCount ) || ( m_handleBuckets.size() != bucketCount ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+                for( index_t ndx = 0; ndx < bucketCount; ++ndx )
+                {
+                    m_keyBuckets[ ndx ]    = MAX_UINT32;
+                    m_handleBuckets[ ndx ] = MAX_UINT32;
+                }
+
+                for( uint32_t ndx = 0; ndx < m_entries.size(); ++ndx )
+                {
+                    Entry& entry = m_entries[ ndx ];
+                    if( entry.refCount == 0 )
+                    {
+                        continue;
+                    }
+                    const uint32_t keyBucket        = static_cast<uint32_t>( entry.hash ) & ( bucketCount - 1 );
+                    const uint32_t handleBucket     = GetHandleBucket( entry.handle, bucketCount );
+                    entry.nextByKey                 = m_keyBuckets[ keyBucket ];
+                    entry.nextByHandle              = m_handleBuckets[ handleBucket ];
+                    m_keyBuckets[ keyBucket ]       = ndx;
+                    m_handleBuckets[ handleBucket ] = ndx;
+                }
+
+                return Results::OK;
+            }
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
@@ -0,0 +1,424 @@
+#include "Driver/Frontend/BindlessTable.h"
+
+#include "Driver/Frontend/Buffer.h"
+#include "Driver/Frontend/RenderSystem.h"
+#include "Driver/Frontend/Texture.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+
+            BindlessTable::BindlessTable()
+                : m_desc()
+                , m_pParent( nullptr )
+                , m_hLayout()
+                , m_copies()
+                , m_copyNdx( 0 )
+                , m_rangeOffsets()
+                , m_bindingSizes()
+                , m_nextIndices()
+                , m_freeIndices()
+                , m_owners()
+                , m_pendingIndices()
+            {
+            }
+
+            RESULT BindlessTable::RegisterView( Backend::BINDING_TYPE type, Backend::ResourceViewHandle hView, uint32_t* pIndex )
+            {
+                BGS_ASSERT( hView != Backend::ResourceViewHandle(), "Resource view (hView) must be a valid handle." );
+                if( hView == Backend::ResourceViewHandle() )
+                {
+                    return Results::FAIL;
+                }
+
+                uint32_t     ndx    = 0;
+                const RESULT result = AllocateIndex( type, &ndx );
+                if( BGS_FAILED( result ) )
+                {
+                    return result;
+                }
+                WriteView( type, ndx, hView );
+
+                *pIndex = ndx;
+
+                return Results::OK;
+            }
+
+            RESULT BindlessTable::RegisterTexture( Texture* pTexture, Backend::BINDING_TYPE type, uint32_t* pIndex )
+            {
+                BGS_ASSERT( pTexture != nullptr, "Texture (pTexture) must be a valid pointer." );
+                BGS_ASSERT( ( type == Backend::BindingTypes::SAMPLED_TEXTURE ) || ( type == Backend::BindingTypes::STORAGE_TEXTURE ),
+                            "Texture can be registered only as sampled or storage texture." );
+                if( pTexture == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                const RESULT result = RegisterView( type, GetView( pTexture, type ), pIndex );
+                if( BGS_FAILED( result ) )
+                {
+                    return result;
+                }
+                m_owners[ BGS_ENUM_INDEX( type ) ][ *pIndex ].pTexture = pTexture;
+                AddEntry( &pTexture->m_bindlessEntries, type, *pIndex );
+
+                return Results::OK;
+            }
+
+            RESULT BindlessTable::RegisterBuffer( Buffer* pBuffer, Backend::BINDING_TYPE type, uint32_t* pIndex )
+            {
+                BGS_ASSERT( pBuffer != nullptr, "Buffer (pBuffer) must be a valid pointer." );
+                BGS_ASSERT( ( type == Backend::BindingTypes::CONSTANT_BUFFER ) || ( type == Backend::BindingTypes::READ_ONLY_STORAGE_BUFFER ) ||
+                                ( type == Backend::BindingTypes::READ_WRITE_STORAGE_BUFFER ),
+                            "Buffer can be registered only as constant or storage buffer." );
+                if( pBuffer == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                const RESULT result = RegisterView( type, GetView( pBuffer, type ), pIndex );
+                if( BGS_FAILED( result ) )
+                {
+                    return result;
+                }
+                m_owners[ BGS_ENUM_INDEX( type ) ][ *pIndex ].pBuffer = pBuffer;
+                AddEntry( &pBuffer->m_bindlessEntries, type, *pIndex );
+
+                return Results::OK;
+            }
+
+            void BindlessTable::Unregister( Backend::BINDING_TYPE type, uint32_t ndx )
+            {
+                BGS_ASSERT( ndx < m_nextIndices[ BGS_ENUM_INDEX( type ) ], "Index (ndx) was not registered." );
+
+                // Binding keeps the last view until the index is reused
+                Owner& owner = m_owners[ BGS_ENUM_INDEX( type ) ][ ndx ];
+                if( owner.pTexture != nullptr )
+                {
+                    RemoveEntry( &owner.pTexture->m_bindlessEntries, type, ndx );
+                }
+                if( owner.pBuffer != nullptr )
+                {
+                    RemoveEntry( &owner.pBuffer->m_bindlessEntries, type, ndx );
+                }
+                owner.pTexture = nullptr;
+                owner.pBuffer  = nullptr;
+
+                PendingIndex pending;
+                pending.ndx        = ndx;
+                pending.type       = type;
+                pending.isPointSet = BGS_FALSE;
+                m_pendingIndices.push_back( pending );
+            }
+
+            RESULT BindlessTable::Update( const SyncPoint& framePoint )
+            {
+                SyncSystem* pSyncSystem = m_pParent->GetSyncSystem();
+
+                index_t keptCount = 0;
+                for( index_t ndx = 0; ndx < m_pendingIndices.size(); ++ndx )
+                {
+                    PendingIndex& pending = m_pendingIndices[ ndx ];
+                    if( pending.isPointSet && pSyncSystem->IsCompleted( pending.point ) )
+                    {
+                        m_freeIndices[ BGS_ENUM_INDEX( pending.type ) ].push_back( pending.ndx );
+                        continue;
+                    }
+                    // Frames recorded before unregistering may still read the binding
+                    if( !pending.isPointSet )
+                    {
+                        pending.point      = framePoint;
+                        pending.isPointSet = BGS_TRUE;
+                    }
+                    m_pendingIndices[ keptCount++ ] = pending;
+                }
+                m_pendingIndices.resize( keptCount );
+
+                // Frame just submitted reads current copy until its point is signaled
+                HeapCopy& usedCopy  = m_copies[ m_copyNdx ];
+                usedCopy.point      = framePoint;
+                usedCopy.isPointSet = BGS_TRUE;
+
+                const uint32_t nextNdx = ( m_copyNdx + 1 ) % Config::Driver::Binding::BINDLESS_HEAP_COPY_COUNT;
+                HeapCopy&      copy    = m_copies[ nextNdx ];
+                if( copy.isPointSet && BGS_FAILED( pSyncSystem->Wait( copy.point ) ) )
+                {
+                    return Results::FAIL;
+                }
+                for( index_t ndx = 0; ndx < copy.dirtyEntries.size(); ++ndx )
+                {
+                    const DirtyEntry&                 entry = copy.dirtyEntries[ ndx ];
+                    const Backend::ResourceViewHandle hView = GetOwnerView( entry.type, entry.ndx );
+                    if( hView != Backend::ResourceViewHandle() )
+                    {
+                        WriteView( copy.hHeap, entry.type, entry.ndx, hView );
+                    }
+                }
+                copy.dirtyEntries.clear();
+                copy.isPointSet = BGS_FALSE;
+                m_copyNdx       = nextNdx;
+
+                return Results::OK;
+            }
+
+            void BindlessTable::RewriteEntry( const Texture* pTexture, const BindlessEntry& entry )
+            {
+                const Backend::ResourceViewHandle hView = GetView( pTexture, entry.type );
+                if( hView != Backend::ResourceViewHandle() )
+                {
+                    WriteView( entry.type, entry.ndx, hView );
+                }
+            }
+
+            void BindlessTable::RewriteEntry( const Buffer* pBuffer, const BindlessEntry& entry )
+            {
+                const Backend::ResourceViewHandle hView = GetView( pBuffer, entry.type );
+                if( hView != Backend::ResourceViewHandle() )
+                {
+                    WriteView( entry.type, entry.ndx, hView );
+                }
+            }
+
+            void BindlessTable::QueueRewrite( const BindlessEntry& entry )
+            {
+                // Current copy is rewritten too, but only after frame being recorded is finished
+                DirtyEntry dirtyEntry;
+                dirtyEntry.ndx  = entry.ndx;
+                dirtyEntry.type = entry.type;
+                for( uint32_t ndx = 0; ndx < Config::Driver::Binding::BINDLESS_HEAP_COPY_COUNT; ++ndx )
+                {
+                    m_copies[ ndx ].dirtyEntries.push_back( dirtyEntry );
+                }
+            }
+
+            Backend::ResourceViewHandle BindlessTable::GetView( const Texture* pTexture, Backend::BINDING_TYPE type )
+            {
+                return type == Backend::BindingTypes::SAMPLED_TEXTURE ? pTexture->m_hSampleAccess : pTexture->m_hStorageAccess;
+            }
+
+            Backend::ResourceViewHandle BindlessTable::GetView( const Buffer* pBuffer, Backend::BINDING_TYPE type )
+            {
+                switch( type )
+                {
+                    case Backend::BindingTypes::CONSTANT_BUFFER:
+                        return pBuffer->m_hConstantAccess;
+                    case Backend::BindingTypes::READ_ONLY_STORAGE_BUFFER:
+                        return pBuffer->m_hReadAccess;
+                    case Backend::BindingTypes::READ_WRITE_STORAGE_BUFFER:
+                        return pBuffer->m_hReadWriteAccess;
+                    default:
+                        return Backend::ResourceViewHandle();
+                }
+            }
+
+            Backend::ResourceViewHandle BindlessTable::GetOwnerView( Backend::BINDING_TYPE type, uint32_t ndx ) const
+            {
+                const Owner& owner = m_owners[ BGS_ENUM_INDEX( type ) ][ ndx ];
+                if( owner.pTexture != nullptr )
+                {
+                    return GetView( owner.pTexture, type );
+                }
+                if( owner.pBuffer != nullptr )
+                {
+                    return GetView( owner.pBuffer, type );
+                }
+
+                return Backend::ResourceViewHandle();
+            }
+
+            RESULT BindlessTable::AllocateIndex( Backend::BINDING_TYPE type, uint32_t* pIndex )
+            {
+                const uint32_t typeNdx = BGS_ENUM_INDEX( type );
+                BGS_ASSERT( pIndex != nullptr, "Index (pIndex) must be a valid address." );
+                BGS_ASSERT( m_desc.bindingCounts[ typeNdx ] > 0, "Table has no range for binding type (type)." );
+                if( ( pIndex == nullptr ) || ( m_desc.bindingCounts[ typeNdx ] == 0 ) )
+                {
+                    return Results::FAIL;
+                }
+
+                IndexArray& freeIndices = m_freeIndices[ typeNdx ];
+                if( !freeIndices.empty() )
+                {
+                    *pIndex = freeIndices.back();
+                    freeIndices.pop_back();
+                }
+                else if( m_nextIndices[ typeNdx ] < m_desc.bindingCounts[ typeNdx ] )
+                {
+                    *pIndex = m_nextIndices[ typeNdx ]++;
+                }
+                else
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                return Results::OK;
+            }
+
+            void BindlessTable::WriteView( Backend::BINDING_TYPE type, uint32_t ndx, Backend::ResourceViewHandle hView )
+            {
+                for( uint32_t copyNdx = 0; copyNdx < Config::Driver::Binding::BINDLESS_HEAP_COPY_COUNT; ++copyNdx )
+                {
+                    WriteView( m_copies[ copyNdx ].hHeap, type, ndx, hView );
+                }
+            }
+
+            void BindlessTable::WriteView( Backend::BindingHeapHandle hHeap, Backend::BINDING_TYPE type, uint32_t ndx,
+                                           Backend::ResourceViewHandle hView )
+            {
+                const uint32_t typeNdx = BGS_ENUM_INDEX( type );
+
+                Backend::WriteBindingDesc writeDesc;
+                writeDesc.hResourceView = hView;
+                writeDesc.hSampler      = Backend::SamplerHandle();
+                writeDesc.hDstHeap      = hHeap;
+                writeDesc.dstOffset     = m_rangeOffsets[ typeNdx ] + ndx * m_bindingSizes[ typeNdx ];
+                writeDesc.bindingType   = type;
+                m_pParent->GetDevice()->WriteBinding( writeDesc );
+            }
+
+            void BindlessTable::AddEntry( BindlessEntryArray* pEntries, Backend::BINDING_TYPE type, uint32_t ndx )
+            {
+                BindlessEntry entry;
+                entry.pTable = this;
+                entry.type   = type;
+                entry.ndx    = ndx;
+                pEntries->push_back( entry );
+            }
+
+            void BindlessTable::RemoveEntry( BindlessEntryArray* pEntries, Backend::BINDING_TYPE type, uint32_t ndx )
+            {
+                for( index_t entryNdx = 0; entryNdx < pEntries->size(); ++entryNdx )
+                {
+                    const BindlessEntry& entry = ( *pEntries )[ entryNdx ];
+                    if( ( entry.pTable == this ) && ( entry.type == type ) && ( entry.ndx == ndx ) )
+                    {
+                        ( *pEntries )[ entryNdx ] = pEntries->back();
+                        pEntries->pop_back();
+                        return;
+                    }
+                }
+            }
+
+            RESULT BindlessTable::Create( const BindlessTableDesc& desc, RenderSystem* pSystem )
+            {
+                BGS_ASSERT( pSystem != nullptr, "Render system (pSystem) must be a valid pointer." );
+                BGS_ASSERT( desc.bindingCounts[ BGS_ENUM_INDEX( Backend::BindingTypes::SAMPLER ) ] == 0,
+                            "Samplers can not be placed in shader resource heap." );
+                m_pParent = pSystem;
+                m_desc    = desc;
+
+                Backend::IDevice*            pAPIDevice = m_pParent->GetDevice();
+                const Backend::DeviceLimits& limits     = pAPIDevice->GetLimits();
+
+                m_bindingSizes[ BGS_ENUM_INDEX( Backend::BindingTypes::SAMPLER ) ]                   = limits.samplerBindingSize;
+                m_bindingSizes[ BGS_ENUM_INDEX( Backend::BindingTypes::SAMPLED_TEXTURE ) ]           = limits.sampledTextureBindingSize;
+                m_bindingSizes[ BGS_ENUM_INDEX( Backend::BindingTypes::STORAGE_TEXTURE ) ]           = limits.storageTextureBindingSize;
+                m_bindingSizes[ BGS_ENUM_INDEX( Backend::BindingTypes::CONSTANT_TEXEL_BUFFER ) ]     = limits.constantTexelBufferBindingSize;
+                m_bindingSizes[ BGS_ENUM_INDEX( Backend::BindingTypes::STORAGE_TEXEL_BUFFER ) ]      = limits.storageTexelBufferBindingSize;
+                m_bindingSizes[ BGS_ENUM_INDEX( Backend::BindingTypes::CONSTANT_BUFFER ) ]           = limits.constantBufferBindingSize;
+                m_bindingSizes[ BGS_ENUM_INDEX( Backend::BindingTypes::READ_ONLY_STORAGE_BUFFER ) ]  = limits.readOnlyStorageBufferBindingSize;
+                m_bindingSizes[ BGS_ENUM_INDEX( Backend::BindingTypes::READ_WRITE_STORAGE_BUFFER ) ] = limits.readWriteStorageBufferBindingSize;
+
+                // Binding slot of a range is also its first binding in the heap, so one offset query works on both backends
+                Backend::BindingRangeDesc ranges[ BGS_ENUM_COUNT( Backend::BindingTypes ) ];
+                uint32_t                  rangeCount   = 0;
+                uint32_t                  bindingCount = 0;
+                for( uint32_t ndx = 0; ndx < BGS_ENUM_COUNT( Backend::BindingTypes ); ++ndx )
+                {
+                    m_freeIndices[ ndx ].SetAllocator( m_pParent->GetDefaultAllocator() );
+                    m_owners[ ndx ].SetAllocator( m_pParent->GetDefaultAllocator() );
+                    m_nextIndices[ ndx ] = 0;
+                    if( desc.bindingCounts[ ndx ] == 0 )
+                    {
+                        continue;
+                    }
+                    Owner noOwner;
+                    noOwner.pTexture = nullptr;
+                    noOwner.pBuffer  = nullptr;
+                    m_owners[ ndx ].resize( desc.bindingCounts[ ndx ], noOwner );
+                    Backend::BindingRangeDesc& range = ranges[ rangeCount++ ];
+                    range.bindingCount               = desc.bindingCounts[ ndx ];
+                    range.baseBindingSlot            = bindingCount;
+                    range.baseShaderRegister         = bindingCount;
+                    range.type                       = static_cast<Backend::BINDING_TYPE>( ndx );
+                    bindingCount += desc.bindingCounts[ ndx ];
+                }
+                BGS_ASSERT( bindingCount > 0, "Binding counts (desc.bindingCounts) must not be all 0." );
+                if( bindingCount == 0 )
+                {
+                    return Results::FAIL;
+                }
+                m_pendingIndices.SetAllocator( m_pParent->GetDefaultAllocator() );
+                m_copyNdx = 0;
+
+                Backend::BindingSetLayoutDesc layoutDesc;
+                layoutDesc.pBindingRanges    = ranges;
+                layoutDesc.bindingRangeCount = rangeCount;
+                layoutDesc.visibility        = desc.visibility;
+                if( BGS_FAILED( pAPIDevice->CreateBindingSetLayout( layoutDesc, &m_hLayout ) ) )
+                {
+                    return Results::FAIL;
+                }
+
+                Backend::BindingHeapDesc heapDesc;
+                heapDesc.bindingCount = bindingCount;
+                heapDesc.type         = Backend::BindingHeapTypes::SHADER_RESOURCE;
+                for( uint32_t ndx = 0; ndx < Config::Driver::Binding::BINDLESS_HEAP_COPY_COUNT; ++ndx )
+                {
+                    HeapCopy& copy = m_copies[ ndx ];
+                    copy.dirtyEntries.SetAllocator( m_pParent->GetDefaultAllocator() );
+                    copy.isPointSet = BGS_FALSE;
+                    if( BGS_FAILED( pAPIDevice->CreateBindingHeap( heapDesc, &copy.hHeap ) ) )
+                    {
+                        Destroy();
+                        return Results::FAIL;
+                    }
+                }
+
+                Backend::GetBindingOffsetDesc offsetDesc;
+                offsetDesc.hBindingSetLayout = m_hLayout;
+                for( uint32_t ndx = 0; ndx < rangeCount; ++ndx )
+                {
+                    offsetDesc.bindingNdx = ranges[ ndx ].baseBindingSlot;
+                    pAPIDevice->GetBindingOffset( offsetDesc, &m_rangeOffsets[ BGS_ENUM_INDEX( ranges[ ndx ].type ) ] );
+                }
+
+                return Results::OK;
+            }
+
+            void BindlessTable::Destroy()
+            {
+                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
+                for( uint32_t ndx = 0; ndx < Config::Driver::Binding::BINDLESS_HEAP_COPY_COUNT; ++ndx )
+                {
+                    HeapCopy& copy = m_copies[ ndx ];
+                    if( copy.hHeap != Backend::BindingHeapHandle() )
+                    {
+                        pAPIDevice->DestroyBindingHeap( &copy.hHeap );
+                    }
+                    copy.dirtyEntries.clear();
+                    copy.dirtyEntries.shrink_to_fit();
+                }
+                if( m_hLayout != Backend::BindingSetLayoutHandle() )
+                {
+                    pAPIDevice->DestroyBindingSetLayout( &m_hLayout );
+                }
+
+                for( uint32_t ndx = 0; ndx < BGS_ENUM_COUNT( Backend::BindingTypes ); ++ndx )
+                {
+                    m_freeIndices[ ndx ].clear();
+                    m_freeIndices[ ndx ].shrink_to_fit();
+                    m_owners[ ndx ].clear();
+                    m_owners[ ndx ].shrink_to_fit();
+                    m_nextIndices[ ndx ] = 0;
+                }
+                m_pendingIndices.clear();
+                m_pendingIndices.shrink_to_fit();
+            }
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
@@ -1,5 +1,7 @@
 #include "Driver/Frontend/Buffer.h"
 
+#include "Driver/Frontend/BindingObjectCache.h"
+#include "Driver/Frontend/BindlessTable.h"
 #include "Driver/Frontend/RenderSystem.h"
 
 namespace BIGOS
@@ -12,11 +14,12 @@ namespace BIGOS
             Buffer::Buffer()
                 : m_desc()
                 , m_pParent( nullptr )
-                , m_hMemory()
+                , m_memory()
                 , m_hResource()
                 , m_hConstantAccess()
                 , m_hReadAccess()
                 , m_hReadWriteAccess()
+                , m_bindlessEntries()
             {
             }
 
@@ -58,14 +61,16 @@ namespace BIGOS
             RESULT Buffer::Create( const BufferDesc& desc, RenderSystem* pSystem )
             {
                 BGS_ASSERT( pSystem != nullptr, "Render system (pSystem) must be a valid pointer." );
-                m_pParent                    = pSystem;
-                m_desc                       = desc;
-                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
+                m_pParent                      = pSystem;
+                m_desc                         = desc;
+                Backend::IDevice*   pAPIDevice = m_pParent->GetDevice();
+                BindingObjectCache* pViewCache = m_pParent->GetBindingObjectCache();
 
+                // Transfer source allows defragmenter to move buffer
                 Backend::ResourceUsageFlags usage = m_desc.usage;
                 if( !( m_desc.usage & BGS_FLAG( Backend::ResourceUsageFlagBits::CONSTANT_BUFFER ) ) )
                 {
-                    usage |= BGS_FLAG( Backend::ResourceUsageFlagBits::TRANSFER_DST );
+                    usage |= BGS_FLAG( Backend::ResourceUsageFlagBits::TRANSFER_DST ) | BGS_FLAG( Backend::ResourceUsageFlagBits::TRANSFER_SRC );
                 }
 
                 BIGOS::Driver::Backend::ResourceDesc buffDesc;
@@ -75,39 +80,30 @@ namespace BIGOS
                 buffDesc.size.depth      = 1;
                 buffDesc.arrayLayerCount = 1;
                 buffDesc.mipLevelCount   = 1;
-                buffDesc.resourceUsage   = m_desc.usage;
+                buffDesc.resourceUsage   = usage;
                 buffDesc.resourceLayout  = BIGOS::Driver::Backend::ResourceLayouts::LINEAR;
                 buffDesc.resourceType    = BIGOS::Driver::Backend::ResourceTypes::BUFFER;
                 buffDesc.sampleCount     = BIGOS::Driver::Backend::SampleCount::COUNT_1;
                 buffDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
-                if( BGS_FAILED( pAPIDevice->CreateResource( buffDesc, &m_hResource ) ) )
+                buffDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
+                if( m_desc.usage & BGS_FLAG( Backend::ResourceUsageFlagBits::CONSTANT_BUFFER ) )
                 {
-                    return Results::FAIL;
+                    // Constant buffers are updated every frame, keeping them mapped makes Map / Unmap free
+                    buffDesc.flags = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::PERSISTENT_MAP );
                 }
-
-                BIGOS::Driver::Backend::ResourceAllocationInfo allocInfo;
-                pAPIDevice->GetResourceAllocationInfo( m_hResource, &allocInfo );
-
-                BIGOS::Driver::Backend::AllocateMemoryDesc allocDesc;
-                allocDesc.size      = allocInfo.size;
-                allocDesc.alignment = allocInfo.alignment;
-                allocDesc.heapType  = m_desc.usage & BGS_FLAG( Backend::ResourceUsageFlagBits::CONSTANT_BUFFER ) ? Backend::MemoryHeapTypes::UPLOAD
-                                                                                                                 : Backend::MemoryHeapTypes::DEFAULT;
-                allocDesc.heapUsage = Backend::MemoryHeapUsages::BUFFERS;
-                if( BGS_FAILED( pAPIDevice->AllocateMemory( allocDesc, &m_hMemory ) ) )
+                if( BGS_FAILED( pAPIDevice->CreateResource( buffDesc, &m_hResource ) ) )
                 {
-                    Destroy();
                     return Results::FAIL;
                 }
 
-                BIGOS::Driver::Backend::BindResourceMemoryDesc bindDesc;
-                bindDesc.hMemory      = m_hMemory;
-                bindDesc.hResource    = m_hResource;
-                bindDesc.memoryOffset = 0;
-                if( BGS_FAILED( pAPIDevice->BindResourceMemory( bindDesc ) ) )
+                const Backend::MEMORY_HEAP_TYPE heapType = m_desc.usage & BGS_FLAG( Backend::ResourceUsageFlagBits::CONSTANT_BUFFER )
+                                                               ? Backend::MemoryHeapTypes::UPLOAD
+                                                               : Backend::MemoryHeapTypes::DEFAULT;
+                if( BGS_FAILED( m_pParent->GetDeviceMemorySystem()->AllocateAndBind( m_hResource, heapType, Backend::MemoryHeapUsages::BUFFERS,
+                                                                                     &m_memory ) ) )
                 {
                     Destroy();
-                    return BIGOS::Results::FAIL;
+                    return Results::FAIL;
                 }
 
                 BIGOS::Driver::Backend::BufferViewDesc viewDesc;
@@ -117,7 +113,7 @@ namespace BIGOS
                 if( m_desc.usage & BGS_FLAG( Backend::ResourceUsageFlagBits::CONSTANT_BUFFER ) )
                 {
                     viewDesc.usage = BGS_FLAG( BIGOS::Driver::Backend::ResourceViewUsageFlagBits::CONSTANT_BUFFER );
-                    if( BGS_FAILED( pAPIDevice->CreateResourceView( viewDesc, &m_hConstantAccess ) ) )
+                    if( BGS_FAILED( pViewCache->CreateResourceView( viewDesc, &m_hConstantAccess ) ) )
                     {
                         Destroy();
                         return Results::FAIL;
@@ -126,7 +122,7 @@ namespace BIGOS
                 if( m_desc.usage & BGS_FLAG( Backend::ResourceUsageFlagBits::READ_ONLY_STORAGE_BUFFER ) )
                 {
                     viewDesc.usage = BGS_FLAG( BIGOS::Driver::Backend::ResourceViewUsageFlagBits::READ_ONLY_STORAGE_BUFFER );
-                    if( BGS_FAILED( pAPIDevice->CreateResourceView( viewDesc, &m_hReadAccess ) ) )
+                    if( BGS_FAILED( pViewCache->CreateResourceView( viewDesc, &m_hReadAccess ) ) )
                     {
                         Destroy();
                         return Results::FAIL;
@@ -135,39 +131,70 @@ namespace BIGOS
                 if( m_desc.usage & BGS_FLAG( Backend::ResourceUsageFlagBits::READ_WRITE_STORAGE_BUFFER ) )
                 {
                     viewDesc.usage = BGS_FLAG( BIGOS::Driver::Backend::ResourceViewUsageFlagBits::READ_WRITE_STORAGE_BUFFER );
-                    if( BGS_FAILED( pAPIDevice->CreateResourceView( viewDesc, &m_hReadWriteAccess ) ) )
+                    if( BGS_FAILED( pViewCache->CreateResourceView( viewDesc, &m_hReadWriteAccess ) ) )
                     {
                         Destroy();
                         return Results::FAIL;
                     }
                 }
+                UpdateBindlessEntries();
 
                 return Results::OK;
             }
 
             void Buffer::Destroy()
             {
-                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
+                Backend::IDevice*   pAPIDevice = m_pParent->GetDevice();
+                BindingObjectCache* pViewCache = m_pParent->GetBindingObjectCache();
 
-                if( m_hMemory != Backend::MemoryHandle() )
-                {
-                    pAPIDevice->FreeMemory( &m_hMemory );
-                }
                 if( m_hResource != Backend::ResourceHandle() )
                 {
                     pAPIDevice->DestroyResource( &m_hResource );
                 }
+                if( m_memory.hMemory != Backend::MemoryHandle() )
+                {
+                    m_pParent->GetDeviceMemorySystem()->Free( &m_memory );
+                }
                 if( m_hConstantAccess != Backend::ResourceViewHandle() )
                 {
-                    pAPIDevice->DestroyResourceView( &m_hConstantAccess );
+                    pViewCache->ReleaseResourceView( &m_hConstantAccess );
                 }
                 if( m_hReadAccess != Backend::ResourceViewHandle() )
                 {
-                    pAPIDevice->DestroyResourceView( &m_hReadAccess );
+                    pViewCache->ReleaseResourceView( &m_hReadAccess );
                 }
                 if( m_hReadWriteAccess != Backend::ResourceViewHandle() )
                 {
-                    pAPIDevice->DestroyResourceView( &m_hReadWriteAccess );
+                    pViewCache->ReleaseResourceView( &m_hReadWriteAccess );
+                }
+            }
+
+            void Buffer::SwapResources( Buffer* pOther )
+            {
+                BGS_ASSERT( pOther != nullptr, "Buffer (pOther) must be a valid pointer." );
+
+                std::swap( m_memory, pOther->m_memory );
+                std::swap( m_hResource, pOther->m_hResource );
+                std::swap( m_hConstantAccess, pOther->m_hConstantAccess );
+                std::swap( m_hReadAccess, pOther->m_hReadAccess );
+                std::swap( m_hReadWriteAccess, pOther->m_hReadWriteAccess );
+                QueueBindlessRewrites();
+                pOther->QueueBindlessRewrites();
+            }
+
+            void Buffer::UpdateBindlessEntries()
+            {
+                for( index_t ndx = 0; ndx < m_bindlessEntries.size(); ++ndx )
+                {
+                    m_bindlessEntries[ ndx ].pTable->RewriteEntry( this, m_bindlessEntries[ ndx ] );
+                }
+            }
+
+            void Buffer::QueueBindlessRewrites()
+            {
+                for( index_t ndx = 0; ndx < m_bindlessEntries.size(); ++ndx )
+                {
+                    m_bindlessEntries[ ndx ].pTable->QueueRewrite( m_bindlessEntries[ ndx ] );
                 }
             }
 
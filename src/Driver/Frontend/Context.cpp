@@ -1,7 +1,10 @@
 #include "Driver/Frontend/Context.h"
 
+#include "Core/Memory/Memory.h"
 #include "Driver/Backend/API.h"
+#include "Driver/Backend/APICommon.h"
 #include "Driver/Frontend/RenderSystem.h"
+#include "Driver/Frontend/Texture.h"
 
 namespace BIGOS
 {
@@ -10,6 +13,18 @@ namespace BIGOS
         namespace Frontend
         {
 
+            // Drops first count elements, order of the rest is kept
+            template<typename T>
+            static void EraseFront( Core::Containers::Array<T>* pArray, index_t count )
+            {
+                const index_t leftCount = pArray->size() - count;
+                for( index_t ndx = 0; ndx < leftCount; ++ndx )
+                {
+                    ( *pArray )[ ndx ] = ( *pArray )[ count + ndx ];
+                }
+                pArray->resize( leftCount );
+            }
+
             GraphicsContext::GraphicsContext()
                 : m_pQueue( nullptr )
                 , m_pDevice( nullptr )
@@ -80,7 +95,461 @@ namespace BIGOS
                 : m_pQueue( nullptr )
                 , m_pDevice( nullptr )
                 , m_pParent( nullptr )
+                , m_freePages()
+                , m_activePages()
+                , m_pendingPages()
+                , m_bufferCopies()
+                , m_textureCopies()
+                , m_textureBarriers()
+                , m_releaseBarriers()
+                , m_postBarriers()
+                , m_acquireBarriers()
+                , m_flushedAcquires()
+                , m_acquirePoints()
+                , m_bufferPostBarriers()
+                , m_bufferAcquireBarriers()
+                , m_flushedBufferAcquires()
+                , m_bufferAcquirePoints()
+                , m_batches()
+                , m_nextBatch( 0 )
+                , m_lastPoint()
+                , m_stagingSize( 0 )
+                , m_uploadMutex()
+            {
+            }
+
+            RESULT CopyContext::UploadBuffer( const BufferUploadDesc& desc )
+            {
+                BGS_ASSERT( desc.pData != nullptr, "Upload data (desc.pData) must be a valid pointer." );
+                BGS_ASSERT( desc.hBuffer != Backend::ResourceHandle(), "Buffer (desc.hBuffer) must be a valid handle." );
+                BGS_ASSERT( desc.size > 0, "Upload size (desc.size) must be greater than 0." );
+                if( ( desc.pData == nullptr ) || ( desc.size == 0 ) )
+                {
+                    return Results::FAIL;
+                }
+
+                std::lock_guard<Mutex> lock( m_uploadMutex );
+
+                StagingPage* pPage  = nullptr;
+                uint64_t     offset = 0;
+                if( BGS_FAILED( AllocateStaging( desc.size, 16, &pPage, &offset ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+                // Staging pages are write combined upload memory, CPU never reads them back
+                Memory::StreamCopy( desc.pData, static_cast<size_t>( desc.size ), pPage->pHost + offset, static_cast<size_t>( desc.size ) );
+
+                Backend::CopyBufferDesc cpyDesc;
+                cpyDesc.hSrcBuffer = pPage->hResource;
+                cpyDesc.hDstBuffer = desc.hBuffer;
+                cpyDesc.srcOffset  = offset;
+                cpyDesc.dstOffset  = desc.offset;
+                cpyDesc.size       = desc.size;
+                m_bufferCopies.push_back( cpyDesc );
+
+                // Buffers are created with exclusive access, so copy queue releases written range and graphics queue acquires it with
+                // the same barrier once it waits for the flush
+                Backend::BufferBarrierDesc barrier;
+                barrier.bufferRange.offset = desc.offset;
+                barrier.bufferRange.size   = desc.size;
+                barrier.hResouce           = desc.hBuffer;
+                barrier.srcStage           = BGS_FLAG( Backend::PipelineStageFlagBits::TRANSFER );
+                barrier.srcAccess          = BGS_FLAG( Backend::AccessFlagBits::TRANSFER_DST );
+                barrier.dstStage           = desc.finalStage;
+                barrier.dstAccess          = desc.finalAccess;
+                barrier.pSrcQueue          = m_pQueue;
+                barrier.pDstQueue          = m_pParent->GetGraphicsContext()->GetQueue();
+                m_bufferPostBarriers.push_back( barrier );
+                m_bufferAcquireBarriers.push_back( barrier );
+
+                return Results::OK;
+            }
+
+            RESULT CopyContext::UploadTexture( const TextureUploadDesc& desc )
+            {
+                BGS_ASSERT( desc.pData != nullptr, "Upload data (desc.pData) must be a valid pointer." );
+                BGS_ASSERT( desc.pTexture != nullptr, "Texture (desc.pTexture) must be a valid pointer." );
+                BGS_ASSERT( desc.format != Backend::Formats::UNKNOWN, "Texture format (desc.format) must be a valid format." );
+                const uint64_t texelSize = Backend::GetBigosFormatSize( desc.format );
+                const uint64_t rowSize   = texelSize * desc.size.width;
+                const uint64_t rowCount  = static_cast<uint64_t>( desc.size.height ) * desc.size.depth;
+                if( ( desc.pData == nullptr ) || ( desc.pTexture == nullptr ) || ( rowSize == 0 ) || ( rowCount == 0 ) )
+                {
+                    return Results::FAIL;
+                }
+                // Staged rows are padded to pitch alignment of D3D12 and must hold whole texels, Vulkan takes row length in texels
+                const uint64_t pitchAlignment = Config::Driver::Memory::TEXTURE_ROW_PITCH_ALIGNMENT;
+                uint64_t       rowPitch       = ( rowSize + pitchAlignment - 1 ) & ~( pitchAlignment - 1 );
+                while( rowPitch % texelSize != 0 )
+                {
+                    rowPitch += pitchAlignment;
+                }
+
+                std::lock_guard<Mutex> lock( m_uploadMutex );
+
+                StagingPage* pPage  = nullptr;
+                uint64_t     offset = 0;
+                if( BGS_FAILED( AllocateStaging( rowPitch * rowCount, Config::Driver::Memory::TEXTURE_UPLOAD_ALIGNMENT, &pPage, &offset ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+                const byte_t* pSrc = static_cast<const byte_t*>( desc.pData );
+                byte_t*       pDst = pPage->pHost + offset;
+                if( rowPitch == rowSize )
+                {
+                    Memory::StreamCopy( pSrc, static_cast<size_t>( rowSize * rowCount ), pDst, static_cast<size_t>( rowSize * rowCount ) );
+                }
+                else
+                {
+                    for( uint64_t rowNdx = 0; rowNdx < rowCount; ++rowNdx )
+                    {
+                        Memory::StreamCopy( pSrc + rowNdx * rowSize, static_cast<size_t>( rowSize ), pDst + rowNdx * rowPitch,
+                                            static_cast<size_t>( rowSize ) );
+                    }
+                }
+
+                const Backend::ResourceHandle hTexture = desc.pTexture->GetResource();
+                const uint32_t                mipLevel = desc.textureRange.mipLevel;
+                const uint32_t                layer    = desc.textureRange.arrayLayer;
+
+                // Subresource written earlier in this batch is already in copy layout and owned by copy queue
+                bool_t isStaged = BGS_FALSE;
+                for( index_t ndx = 0; ( ndx < m_textureBarriers.size() ) && !isStaged; ++ndx )
+                {
+                    const Backend::TextureBarrierDesc& staged = m_textureBarriers[ ndx ];
+                    isStaged = ( staged.hResouce == hTexture ) && ( staged.textureRange.mipLevel == mipLevel ) &&
+                               ( staged.textureRange.arrayLayer == layer );
+                }
+
+                if( !isStaged )
+                {
+                    // Content is dropped only if upload overwrites whole subresource or there is none
+                    const TextureDesc&   texDesc = desc.pTexture->GetDesc();
+                    const ResourceState& state   = desc.pTexture->GetState();
+                    const uint32_t       width   = ( texDesc.size.width >> mipLevel ) > 0 ? texDesc.size.width >> mipLevel : 1;
+                    const uint32_t       height  = ( texDesc.size.height >> mipLevel ) > 0 ? texDesc.size.height >> mipLevel : 1;
+                    const uint32_t       depth   = ( texDesc.size.depth >> mipLevel ) > 0 ? texDesc.size.depth >> mipLevel : 1;
+
+                    const bool_t isOrigin    = ( desc.textureOffset.x == 0 ) && ( desc.textureOffset.y == 0 ) && ( desc.textureOffset.z == 0 );
+                    const bool_t isFullSize  = ( desc.size.width == width ) && ( desc.size.height == height ) && ( desc.size.depth == depth );
+                    const bool_t keepContent = !( isOrigin && isFullSize ) && ( state.GetLayout() != Backend::TextureLayouts::UNDEFINED );
+
+                    // Copy range carries texture totals, barriers cover only uploaded subresource. Kept content belongs to graphics
+                    // queue, copy queue acquires it with the same barrier graphics queue records in ReleaseUploadTargets()
+                    Backend::TextureBarrierDesc barrier;
+                    barrier.hResouce                     = hTexture;
+                    barrier.textureRange                 = desc.textureRange;
+                    barrier.textureRange.mipLevelCount   = 1;
+                    barrier.textureRange.arrayLayerCount = 1;
+                    barrier.srcStage                     = keepContent ? state.GetStage() : BGS_FLAG( Backend::PipelineStageFlagBits::NONE );
+                    barrier.srcAccess                    = keepContent ? state.GetAccess() : BGS_FLAG( Backend::AccessFlagBits::NONE );
+                    barrier.srcLayout                    = keepContent ? state.GetLayout() : Backend::TextureLayouts::UNDEFINED;
+                    barrier.dstStage                     = BGS_FLAG( Backend::PipelineStageFlagBits::TRANSFER );
+                    barrier.dstAccess                    = BGS_FLAG( Backend::AccessFlagBits::TRANSFER_DST );
+                    barrier.dstLayout                    = Backend::TextureLayouts::TRANSFER_DST;
+                    barrier.pSrcQueue                    = keepContent ? m_pParent->GetGraphicsContext()->GetQueue() : nullptr;
+                    barrier.pDstQueue                    = keepContent ? m_pQueue : nullptr;
+                    m_textureBarriers.push_back( barrier );
+                    if( keepContent )
+                    {
+                        m_releaseBarriers.push_back( barrier );
+                    }
+
+                    // Copy queue releases texture, graphics queue acquires it with the same barrier once it waits for the flush.
+                    // Layout is changed there, copy queues support only copy layouts on D3D12
+                    barrier.srcStage  = BGS_FLAG( Backend::PipelineStageFlagBits::TRANSFER );
+                    barrier.srcAccess = BGS_FLAG( Backend::AccessFlagBits::TRANSFER_DST );
+                    barrier.srcLayout = Backend::TextureLayouts::TRANSFER_DST;
+                    barrier.dstStage  = desc.finalStage;
+                    barrier.dstAccess = desc.finalAccess;
+                    barrier.dstLayout = desc.finalLayout;
+                    barrier.pSrcQueue = m_pQueue;
+                    barrier.pDstQueue = m_pParent->GetGraphicsContext()->GetQueue();
+                    m_postBarriers.push_back( barrier );
+                    m_acquireBarriers.push_back( barrier );
+                }
+
+                Backend::CopyBufferTextureDesc cpyDesc;
+                cpyDesc.hBuffer        = pPage->hResource;
+                cpyDesc.hTexture       = hTexture;
+                cpyDesc.bufferOffset   = offset;
+                cpyDesc.bufferRowPitch = static_cast<uint32_t>( rowPitch );
+                cpyDesc.textureOffset  = desc.textureOffset;
+                cpyDesc.size           = desc.size;
+                cpyDesc.textureFormat  = desc.format;
+                cpyDesc.textureRange   = desc.textureRange;
+                m_textureCopies.push_back( cpyDesc );
+
+                return Results::OK;
+            }
+
+            RESULT CopyContext::FlushUploads( SyncPoint* pPoint, const SyncPoint& releasePoint )
+            {
+                BGS_ASSERT( pPoint != nullptr, "Sync point (pPoint) must be a valid address." );
+                if( pPoint == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                std::lock_guard<Mutex> lock( m_uploadMutex );
+                BGS_ASSERT( m_releaseBarriers.empty(), "Textures with kept content must be released with ReleaseUploadTargets() first." );
+                if( !m_releaseBarriers.empty() )
+                {
+                    return Results::FAIL;
+                }
+
+                // Empty batch is still submitted when there is no earlier point to return
+                if( m_bufferCopies.empty() && m_textureCopies.empty() &&
+                    ( m_lastPoint.GetContextType() == ContextTypes::COPY ) )
+                {
+                    *pPoint = m_lastPoint;
+                    return Results::OK;
+                }
+
+                SyncSystem*  pSyncSystem = m_pParent->GetSyncSystem();
+                UploadBatch& batch       = m_batches[ m_nextBatch ];
+                if( batch.inFlight )
+                {
+                    if( BGS_FAILED( pSyncSystem->Wait( batch.point ) ) )
+                    {
+                        return Results::FAIL;
+                    }
+                    batch.inFlight = BGS_FALSE;
+                }
+                if( BGS_FAILED( m_pDevice->ResetCommandPool( batch.hCommandPool ) ) )
+                {
+                    return Results::FAIL;
+                }
+
+                Backend::ICommandBuffer*        pCmdBuffer = batch.pCommandBuffer;
+                Backend::BeginCommandBufferDesc beginDesc;
+                pCmdBuffer->Begin( beginDesc );
+
+                // All layout transitions go first, so copies are not interleaved with barriers
+                RecordBarriers( pCmdBuffer, nullptr, 0, m_textureBarriers.data(), m_textureBarriers.size() );
+                for( index_t ndx = 0; ndx < m_bufferCopies.size(); ++ndx )
+                {
+                    pCmdBuffer->CopyBuffer( m_bufferCopies[ ndx ] );
+                }
+                for( index_t ndx = 0; ndx < m_textureCopies.size(); ++ndx )
+                {
+                    pCmdBuffer->CopyBuferToTexture( m_textureCopies[ ndx ] );
+                }
+                RecordBarriers( pCmdBuffer, m_bufferPostBarriers.data(), m_bufferPostBarriers.size(), m_postBarriers.data(),
+                                m_postBarriers.size() );
+
+                pCmdBuffer->End();
+
+                m_bufferCopies.clear();
+                m_textureCopies.clear();
+                m_textureBarriers.clear();
+                m_postBarriers.clear();
+                m_bufferPostBarriers.clear();
+
+                const SyncPoint      point       = pSyncSystem->CreateSyncPoint( ContextTypes::COPY, "Upload" );
+                Backend::FenceHandle hFence      = pSyncSystem->GetFence( ContextTypes::COPY );
+                uint64_t             signalValue = point.GetValue();
+
+                // Copies of kept content start after graphics queue released it
+                const bool_t         hasRelease   = releasePoint.GetContextType() != ContextTypes::_MAX_ENUM;
+                Backend::FenceHandle hWaitFence   = hasRelease ? pSyncSystem->GetFence( releasePoint.GetContextType() ) : Backend::FenceHandle();
+                uint64_t             releaseValue = releasePoint.GetValue();
+
+                Backend::QueueSubmitDesc submitDesc;
+                submitDesc.waitSemaphoreCount   = 0;
+                submitDesc.phWaitSemaphores     = nullptr;
+                submitDesc.waitFenceCount       = hasRelease ? 1 : 0;
+                submitDesc.phWaitFences         = hasRelease ? &hWaitFence : nullptr;
+                submitDesc.pWaitValues          = hasRelease ? &releaseValue : nullptr;
+                submitDesc.commandBufferCount   = 1;
+                submitDesc.ppCommandBuffers     = &pCmdBuffer;
+                submitDesc.signalSemaphoreCount = 0;
+                submitDesc.phSignalSemaphores   = nullptr;
+                submitDesc.signalFenceCount     = 1;
+                submitDesc.phSignalFences       = &hFence;
+                submitDesc.pSignalValues        = &signalValue;
+                if( BGS_FAILED( m_pQueue->Submit( submitDesc ) ) )
+                {
+                    // Nothing reached the GPU, staging written since last flush can be reused right away
+                    for( index_t ndx = 0; ndx < m_activePages.size(); ++ndx )
+                    {
+                        m_activePages[ ndx ]->usedSize = 0;
+                        m_freePages.push_back( m_activePages[ ndx ] );
+                    }
+                    m_activePages.clear();
+                    m_acquireBarriers.clear();
+                    m_bufferAcquireBarriers.clear();
+                    return Results::FAIL;
+                }
+
+                batch.point    = point;
+                batch.inFlight = BGS_TRUE;
+                m_nextBatch    = ( m_nextBatch + 1 ) % Config::Driver::Memory::MAX_UPLOAD_BATCH_COUNT;
+
+                for( index_t ndx = 0; ndx < m_activePages.size(); ++ndx )
+                {
+                    m_activePages[ ndx ]->point = point;
+                    m_pendingPages.push_back( m_activePages[ ndx ] );
+                }
+                m_activePages.clear();
+
+                for( index_t ndx = 0; ndx < m_acquireBarriers.size(); ++ndx )
+                {
+                    m_flushedAcquires.push_back( m_acquireBarriers[ ndx ] );
+                    m_acquirePoints.push_back( point );
+                }
+                m_acquireBarriers.clear();
+                for( index_t ndx = 0; ndx < m_bufferAcquireBarriers.size(); ++ndx )
+                {
+                    m_flushedBufferAcquires.push_back( m_bufferAcquireBarriers[ ndx ] );
+                    m_bufferAcquirePoints.push_back( point );
+                }
+                m_bufferAcquireBarriers.clear();
+
+                m_lastPoint = point;
+                *pPoint     = point;
+
+                return Results::OK;
+            }
+
+            RESULT CopyContext::AcquireUploads( Backend::ICommandBuffer* pCmdBuffer, SyncPoint* pPoint )
             {
+                BGS_ASSERT( pCmdBuffer != nullptr, "Command buffer (pCmdBuffer) must be a valid pointer." );
+                BGS_ASSERT( pPoint != nullptr, "Sync point (pPoint) must be a valid address." );
+                if( ( pCmdBuffer == nullptr ) || ( pPoint == nullptr ) )
+                {
+                    return Results::FAIL;
+                }
+
+                std::lock_guard<Mutex> lock( m_uploadMutex );
+                if( m_flushedAcquires.empty() && m_flushedBufferAcquires.empty() )
+                {
+                    *pPoint = SyncPoint();
+                    return Results::OK;
+                }
+
+                // Flushes are submitted in order, so the last one covers all acquired resources
+                RecordBarriers( pCmdBuffer, m_flushedBufferAcquires.data(), m_flushedBufferAcquires.size(), m_flushedAcquires.data(),
+                                m_flushedAcquires.size() );
+                m_flushedAcquires.clear();
+                m_acquirePoints.clear();
+                m_flushedBufferAcquires.clear();
+                m_bufferAcquirePoints.clear();
+                *pPoint = m_lastPoint;
+
+                return Results::OK;
+            }
+
+            RESULT CopyContext::ReleaseUploadTargets( Backend::ICommandBuffer* pCmdBuffer )
+            {
+                BGS_ASSERT( pCmdBuffer != nullptr, "Command buffer (pCmdBuffer) must be a valid pointer." );
+                if( pCmdBuffer == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                std::lock_guard<Mutex> lock( m_uploadMutex );
+                RecordBarriers( pCmdBuffer, nullptr, 0, m_releaseBarriers.data(), m_releaseBarriers.size() );
+                m_releaseBarriers.clear();
+
+                return Results::OK;
+            }
+
+            RESULT CopyContext::AcquireCompletedUploads( Backend::ICommandBuffer* pCmdBuffer )
+            {
+                BGS_ASSERT( pCmdBuffer != nullptr, "Command buffer (pCmdBuffer) must be a valid pointer." );
+                if( pCmdBuffer == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                std::lock_guard<Mutex> lock( m_uploadMutex );
+
+                // Acquires are kept in flush order, completed ones form a prefix
+                SyncSystem* pSyncSystem = m_pParent->GetSyncSystem();
+                index_t     count       = 0;
+                while( ( count < m_acquirePoints.size() ) && pSyncSystem->IsCompleted( m_acquirePoints[ count ] ) )
+                {
+                    count++;
+                }
+                index_t bufferCount = 0;
+                while( ( bufferCount < m_bufferAcquirePoints.size() ) && pSyncSystem->IsCompleted( m_bufferAcquirePoints[ bufferCount ] ) )
+                {
+                    bufferCount++;
+                }
+                if( ( count == 0 ) && ( bufferCount == 0 ) )
+                {
+                    return Results::OK;
+                }
+
+                RecordBarriers( pCmdBuffer, m_flushedBufferAcquires.data(), bufferCount, m_flushedAcquires.data(), count );
+                EraseFront( &m_flushedAcquires, count );
+                EraseFront( &m_acquirePoints, count );
+                EraseFront( &m_flushedBufferAcquires, bufferCount );
+                EraseFront( &m_bufferAcquirePoints, bufferCount );
+
+                return Results::OK;
+            }
+
+            void CopyContext::DropAcquires( Backend::ResourceHandle hResource )
+            {
+                std::lock_guard<Mutex> lock( m_uploadMutex );
+
+                index_t releaseCount = 0;
+                for( index_t ndx = 0; ndx < m_releaseBarriers.size(); ++ndx )
+                {
+                    if( m_releaseBarriers[ ndx ].hResouce != hResource )
+                    {
+                        m_releaseBarriers[ releaseCount++ ] = m_releaseBarriers[ ndx ];
+                    }
+                }
+                m_releaseBarriers.resize( releaseCount );
+
+                index_t acquireCount = 0;
+                for( index_t ndx = 0; ndx < m_acquireBarriers.size(); ++ndx )
+                {
+                    if( m_acquireBarriers[ ndx ].hResouce != hResource )
+                    {
+                        m_acquireBarriers[ acquireCount++ ] = m_acquireBarriers[ ndx ];
+                    }
+                }
+                m_acquireBarriers.resize( acquireCount );
+
+                index_t flushedCount = 0;
+                for( index_t ndx = 0; ndx < m_flushedAcquires.size(); ++ndx )
+                {
+                    if( m_flushedAcquires[ ndx ].hResouce != hResource )
+                    {
+                        m_flushedAcquires[ flushedCount ] = m_flushedAcquires[ ndx ];
+                        m_acquirePoints[ flushedCount ]   = m_acquirePoints[ ndx ];
+                        flushedCount++;
+                    }
+                }
+                m_flushedAcquires.resize( flushedCount );
+                m_acquirePoints.resize( flushedCount );
+
+                index_t bufferAcquireCount = 0;
+                for( index_t ndx = 0; ndx < m_bufferAcquireBarriers.size(); ++ndx )
+                {
+                    if( m_bufferAcquireBarriers[ ndx ].hResouce != hResource )
+                    {
+                        m_bufferAcquireBarriers[ bufferAcquireCount++ ] = m_bufferAcquireBarriers[ ndx ];
+                    }
+                }
+                m_bufferAcquireBarriers.resize( bufferAcquireCount );
+
+                index_t bufferFlushedCount = 0;
+                for( index_t ndx = 0; ndx < m_flushedBufferAcquires.size(); ++ndx )
+                {
+                    if( m_flushedBufferAcquires[ ndx ].hResouce != hResource )
+                    {
+                        m_flushedBufferAcquires[ bufferFlushedCount ] = m_flushedBufferAcquires[ ndx ];
+                        m_bufferAcquirePoints[ bufferFlushedCount ]   = m_bufferAcquirePoints[ ndx ];
+                        bufferFlushedCount++;
+                    }
+                }
+                m_flushedBufferAcquires.resize( bufferFlushedCount );
+                m_bufferAcquirePoints.resize( bufferFlushedCount );
             }
 
             RESULT CopyContext::Create( Backend::IDevice* pDevice, RenderSystem* pSystem )
@@ -98,17 +567,291 @@ namespace BIGOS
                     return Results::FAIL;
                 }
 
+                Memory::IAllocator* pAllocator = m_pParent->GetDefaultAllocator();
+                m_freePages.SetAllocator( pAllocator );
+                m_activePages.SetAllocator( pAllocator );
+                m_pendingPages.SetAllocator( pAllocator );
+                m_bufferCopies.SetAllocator( pAllocator );
+                m_textureCopies.SetAllocator( pAllocator );
+                m_textureBarriers.SetAllocator( pAllocator );
+                m_releaseBarriers.SetAllocator( pAllocator );
+                m_postBarriers.SetAllocator( pAllocator );
+                m_acquireBarriers.SetAllocator( pAllocator );
+                m_flushedAcquires.SetAllocator( pAllocator );
+                m_acquirePoints.SetAllocator( pAllocator );
+                m_bufferPostBarriers.SetAllocator( pAllocator );
+                m_bufferAcquireBarriers.SetAllocator( pAllocator );
+                m_flushedBufferAcquires.SetAllocator( pAllocator );
+                m_bufferAcquirePoints.SetAllocator( pAllocator );
+
+                for( index_t ndx = 0; ndx < m_batches.size(); ++ndx )
+                {
+                    UploadBatch& batch   = m_batches[ ndx ];
+                    batch.hCommandPool   = Backend::CommandPoolHandle();
+                    batch.pCommandBuffer = nullptr;
+                    batch.inFlight       = BGS_FALSE;
+
+                    Backend::CommandPoolDesc poolDesc;
+                    poolDesc.pQueue = m_pQueue;
+                    if( BGS_FAILED( m_pDevice->CreateCommandPool( poolDesc, &batch.hCommandPool ) ) )
+                    {
+                        Destroy();
+                        return Results::FAIL;
+                    }
+
+                    Backend::CommandBufferDesc cmdBufferDesc;
+                    cmdBufferDesc.hCommandPool = batch.hCommandPool;
+                    cmdBufferDesc.level        = Backend::CommandBufferLevels::PRIMARY;
+                    cmdBufferDesc.pQueue       = m_pQueue;
+                    if( BGS_FAILED( m_pDevice->CreateCommandBuffer( cmdBufferDesc, &batch.pCommandBuffer ) ) )
+                    {
+                        Destroy();
+                        return Results::FAIL;
+                    }
+                }
+                m_nextBatch = 0;
+
                 return Results::OK;
             }
 
             void CopyContext::Destroy()
             {
+                // GPU may still copy from staging pages
+                for( index_t ndx = 0; ndx < m_batches.size(); ++ndx )
+                {
+                    UploadBatch& batch = m_batches[ ndx ];
+                    if( batch.inFlight )
+                    {
+                        m_pParent->GetSyncSystem()->Wait( batch.point );
+                        batch.inFlight = BGS_FALSE;
+                    }
+                    if( batch.pCommandBuffer != nullptr )
+                    {
+                        m_pDevice->DestroyCommandBuffer( &batch.pCommandBuffer );
+                    }
+                    if( batch.hCommandPool != Backend::CommandPoolHandle() )
+                    {
+                        m_pDevice->DestroyCommandPool( &batch.hCommandPool );
+                    }
+                }
+
+                StackArray<PageArray*, 3> pageArrays = { &m_freePages, &m_activePages, &m_pendingPages };
+                for( index_t arrNdx = 0; arrNdx < pageArrays.size(); ++arrNdx )
+                {
+                    PageArray& pages = *pageArrays[ arrNdx ];
+                    for( index_t ndx = 0; ndx < pages.size(); ++ndx )
+                    {
+                        DestroyPage( &pages[ ndx ] );
+                    }
+                    pages.clear();
+                    pages.shrink_to_fit();
+                }
+                m_bufferCopies.clear();
+                m_bufferCopies.shrink_to_fit();
+                m_textureCopies.clear();
+                m_textureCopies.shrink_to_fit();
+                m_textureBarriers.clear();
+                m_textureBarriers.shrink_to_fit();
+                m_releaseBarriers.clear();
+                m_releaseBarriers.shrink_to_fit();
+                m_postBarriers.clear();
+                m_postBarriers.shrink_to_fit();
+                m_acquireBarriers.clear();
+                m_acquireBarriers.shrink_to_fit();
+                m_flushedAcquires.clear();
+                m_flushedAcquires.shrink_to_fit();
+                m_acquirePoints.clear();
+                m_acquirePoints.shrink_to_fit();
+                m_bufferPostBarriers.clear();
+                m_bufferPostBarriers.shrink_to_fit();
+                m_bufferAcquireBarriers.clear();
+                m_bufferAcquireBarriers.shrink_to_fit();
+                m_flushedBufferAcquires.clear();
+                m_flushedBufferAcquires.shrink_to_fit();
+                m_bufferAcquirePoints.clear();
+                m_bufferAcquirePoints.shrink_to_fit();
+
                 if( m_pQueue != nullptr )
                 {
                     m_pDevice->DestroyQueue( &m_pQueue );
                 }
             }
 
+            RESULT CopyContext::AllocateStaging( uint64_t size, uint64_t alignment, StagingPage** ppPage, uint64_t* pOffset )
+            {
+                // Uploads are packed one after another into the page filled last
+                if( !m_activePages.empty() )
+                {
+                    StagingPage*   pPage  = m_activePages.back();
+                    const uint64_t offset = ( pPage->usedSize + alignment - 1 ) & ~( alignment - 1 );
+                    if( offset + size <= pPage->size )
+                    {
+                        pPage->usedSize = offset + size;
+                        *ppPage         = pPage;
+                        *pOffset        = offset;
+                        return Results::OK;
+                    }
+                }
+
+                RecyclePages();
+
+                StagingPage* pPage = nullptr;
+                if( ( size <= Config::Driver::Memory::STAGING_PAGE_SIZE ) && !m_freePages.empty() )
+                {
+                    pPage = m_freePages.back();
+                    m_freePages.pop_back();
+                }
+                else if( BGS_FAILED( CreatePage( size > Config::Driver::Memory::STAGING_PAGE_SIZE ? size : Config::Driver::Memory::STAGING_PAGE_SIZE,
+                                                 &pPage ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+                m_activePages.push_back( pPage );
+
+                // Fresh page, offset 0 satisfies any alignment
+                pPage->usedSize = size;
+                *ppPage         = pPage;
+                *pOffset        = 0;
+
+                return Results::OK;
+            }
+
+            void CopyContext::RecyclePages()
+            {
+                SyncSystem* pSyncSystem = m_pParent->GetSyncSystem();
+                for( index_t ndx = 0; ndx < m_pendingPages.size(); )
+                {
+                    StagingPage* pPage = m_pendingPages[ ndx ];
+                    if( !pSyncSystem->IsCompleted( pPage->point ) )
+                    {
+                        ++ndx;
+                        continue;
+                    }
+                    m_pendingPages[ ndx ] = m_pendingPages.back();
+                    m_pendingPages.pop_back();
+
+                    // Oversized pages are not kept, they would pin lots of upload memory after a single big upload
+                    if( pPage->size > Config::Driver::Memory::STAGING_PAGE_SIZE )
+                    {
+                        DestroyPage( &pPage );
+                    }
+                    else
+                    {
+                        pPage->usedSize = 0;
+                        m_freePages.push_back( pPage );
+                    }
+                }
+            }
+
+            void CopyContext::RecordBarriers( Backend::ICommandBuffer*           pCmdBuffer,
+                                              const Backend::BufferBarrierDesc*  pBufferBarriers,
+                                              index_t                            bufferBarrierCount,
+                                              const Backend::TextureBarrierDesc* pTextureBarriers,
+                                              index_t                            textureBarrierCount )
+            {
+                const index_t maxBufferBarrierCount  = Config::Driver::Synchronization::MAX_BUFFER_BARRIER_COUNT;
+                const index_t maxTextureBarrierCount = Config::Driver::Synchronization::MAX_TEXTURE_BARRIER_COUNT;
+                index_t       bufferNdx              = 0;
+                index_t       textureNdx             = 0;
+                while( ( bufferNdx < bufferBarrierCount ) || ( textureNdx < textureBarrierCount ) )
+                {
+                    const index_t bufferLeftCount  = bufferBarrierCount - bufferNdx;
+                    const index_t textureLeftCount = textureBarrierCount - textureNdx;
+                    const index_t bufferCount      = bufferLeftCount < maxBufferBarrierCount ? bufferLeftCount : maxBufferBarrierCount;
+                    const index_t textureCount     = textureLeftCount < maxTextureBarrierCount ? textureLeftCount : maxTextureBarrierCount;
+
+                    Backend::BarierDesc barrierDesc;
+                    barrierDesc.textureBarrierCount = static_cast<uint32_t>( textureCount );
+                    barrierDesc.pTextureBarriers    = textureCount > 0 ? pTextureBarriers + textureNdx : nullptr;
+                    barrierDesc.globalBarrierCount  = 0;
+                    barrierDesc.pGlobalBarriers     = nullptr;
+                    barrierDesc.bufferBarrierCount  = static_cast<uint32_t>( bufferCount );
+                    barrierDesc.pBufferBarriers     = bufferCount > 0 ? pBufferBarriers + bufferNdx : nullptr;
+                    pCmdBuffer->Barrier( barrierDesc );
+
+                    bufferNdx += bufferCount;
+                    textureNdx += textureCount;
+                }
+            }
+
+            RESULT CopyContext::CreatePage( uint64_t size, StagingPage** ppPage )
+            {
+                StagingPage* pPage = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetDefaultAllocator(), &pPage ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+                pPage->hResource = Backend::ResourceHandle();
+                pPage->pHost     = nullptr;
+                pPage->size      = size;
+                pPage->usedSize  = 0;
+
+                Backend::ResourceDesc buffDesc;
+                buffDesc.format          = Backend::Formats::UNKNOWN;
+                buffDesc.size.width      = static_cast<uint32_t>( size );
+                buffDesc.size.height     = 1;
+                buffDesc.size.depth      = 1;
+                buffDesc.arrayLayerCount = 1;
+                buffDesc.mipLevelCount   = 1;
+                buffDesc.resourceUsage   = BGS_FLAG( Backend::ResourceUsageFlagBits::TRANSFER_SRC );
+                buffDesc.resourceLayout  = Backend::ResourceLayouts::LINEAR;
+                buffDesc.resourceType    = Backend::ResourceTypes::BUFFER;
+                buffDesc.sampleCount     = Backend::SampleCount::COUNT_1;
+                buffDesc.sharingMode     = Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+                buffDesc.flags           = BGS_FLAG( Backend::ResourceFlagBits::PERSISTENT_MAP );
+                if( BGS_FAILED( m_pDevice->CreateResource( buffDesc, &pPage->hResource ) ) )
+                {
+                    DestroyPage( &pPage );
+                    return Results::FAIL;
+                }
+                if( BGS_FAILED( m_pParent->GetDeviceMemorySystem()->AllocateAndBind( pPage->hResource, Backend::MemoryHeapTypes::UPLOAD,
+                                                                                     Backend::MemoryHeapUsages::BUFFERS, &pPage->memory ) ) )
+                {
+                    DestroyPage( &pPage );
+                    return Results::NO_MEMORY;
+                }
+
+                Backend::MapResourceDesc mapDesc;
+                mapDesc.hResource          = pPage->hResource;
+                mapDesc.bufferRange.offset = 0;
+                mapDesc.bufferRange.size   = size;
+                void* pHost                = nullptr;
+                if( BGS_FAILED( m_pDevice->MapResource( mapDesc, &pHost ) ) )
+                {
+                    DestroyPage( &pPage );
+                    return Results::FAIL;
+                }
+                pPage->pHost = static_cast<byte_t*>( pHost );
+
+                m_stagingSize += size;
+                *ppPage = pPage;
+
+                return Results::OK;
+            }
+
+            void CopyContext::DestroyPage( StagingPage** ppPage )
+            {
+                StagingPage* pPage = *ppPage;
+                if( pPage->pHost != nullptr )
+                {
+                    Backend::MapResourceDesc mapDesc;
+                    mapDesc.hResource          = pPage->hResource;
+                    mapDesc.bufferRange.offset = 0;
+                    mapDesc.bufferRange.size   = pPage->size;
+                    m_pDevice->UnmapResource( mapDesc );
+                    m_stagingSize -= pPage->size;
+                }
+                if( pPage->hResource != Backend::ResourceHandle() )
+                {
+                    m_pDevice->DestroyResource( &pPage->hResource );
+                }
+                if( pPage->memory.hMemory != Backend::MemoryHandle() )
+                {
+                    m_pParent->GetDeviceMemorySystem()->Free( &pPage->memory );
+                }
+                Memory::FreeObject( m_pParent->GetDefaultAllocator(), ppPage );
+            }
+
         } // namespace Frontend
     } // namespace Driver
 } // namespace BIGOS
\ No newline at end of file
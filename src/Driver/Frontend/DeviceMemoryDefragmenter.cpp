@@ -0,0 +1,456 @@
+#include "Driver/Frontend/DeviceMemoryDefragmenter.h"
+
+#include "Core/Memory/Memory.h"
+#include "Driver/Backend/APICommon.h"
+#include "Driver/Frontend/Buffer.h"
+#include "Driver/Frontend/RenderSystem.h"
+#include "Driver/Frontend/Texture.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            // Every way an immutable buffer can be read
+            static constexpr Backend::PipelineStageFlags BUFFER_READ_STAGES =
+                BGS_FLAG( Backend::PipelineStageFlagBits::INPUT_ASSEMBLER ) | BGS_FLAG( Backend::PipelineStageFlagBits::VERTEX_SHADING ) |
+                BGS_FLAG( Backend::PipelineStageFlagBits::PIXEL_SHADING ) | BGS_FLAG( Backend::PipelineStageFlagBits::COMPUTE_SHADING ) |
+                BGS_FLAG( Backend::PipelineStageFlagBits::EXECUTE_INDIRECT ) | BGS_FLAG( Backend::PipelineStageFlagBits::TRANSFER );
+            static constexpr Backend::AccessFlags BUFFER_READ_ACCESS =
+                BGS_FLAG( Backend::AccessFlagBits::VERTEX_BUFFER ) | BGS_FLAG( Backend::AccessFlagBits::INDEX_BUFFER ) |
+                BGS_FLAG( Backend::AccessFlagBits::CONSTANT_BUFFER ) | BGS_FLAG( Backend::AccessFlagBits::INDIRECT_BUFFER ) |
+                BGS_FLAG( Backend::AccessFlagBits::SHADER_READ_ONLY ) | BGS_FLAG( Backend::AccessFlagBits::TRANSFER_SRC );
+
+            DeviceMemoryDefragmenter::DeviceMemoryDefragmenter()
+                : m_desc()
+                , m_pParent( nullptr )
+                , m_buffers()
+                , m_textures()
+                , m_moves()
+                , m_mutex()
+                , m_movedSize( 0 )
+                , m_generation( 0 )
+            {
+            }
+
+            RESULT DeviceMemoryDefragmenter::Update( const SyncPoint& framePoint, Backend::ICommandBuffer* pCmdBuffer )
+            {
+                BGS_ASSERT( pCmdBuffer != nullptr, "Command buffer (pCmdBuffer) must be a valid pointer." );
+                if( pCmdBuffer == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                SyncSystem*         pSyncSystem   = m_pParent->GetSyncSystem();
+                DeviceMemorySystem* pMemorySystem = m_pParent->GetDeviceMemorySystem();
+
+                bool_t isCopying = BGS_FALSE;
+                for( index_t ndx = 0; ndx < m_moves.size(); )
+                {
+                    Move& move = m_moves[ ndx ];
+                    if( ( move.state == MoveStates::COPYING ) && pSyncSystem->IsCompleted( move.point ) )
+                    {
+                        // Frames recorded from now on use new resources, old ones live until this frame is done
+                        if( move.pBuffer != nullptr )
+                        {
+                            move.pBuffer->SwapResources( move.pShadowBuffer );
+                        }
+                        else
+                        {
+                            move.pTexture->SwapResources( move.pShadowTexture );
+                        }
+                        move.state = MoveStates::RETIRING;
+                        move.point = framePoint;
+                        m_generation++;
+                    }
+                    else if( ( move.state == MoveStates::RETIRING ) && pSyncSystem->IsCompleted( move.point ) )
+                    {
+                        DestroyShadow( &move );
+                        m_moves[ ndx ] = m_moves.back();
+                        m_moves.pop_back();
+                        continue;
+                    }
+                    isCopying = isCopying || ( move.state == MoveStates::COPYING );
+                    ++ndx;
+                }
+
+                // New batch starts only after previous one has been copied, so one frame carries copies at a time
+                if( ( m_desc.maxBytesPerFrame == 0 ) || isCopying )
+                {
+                    return Results::OK;
+                }
+
+                const DeviceMemoryBlock* pBlock = pMemorySystem->BeginEvacuation( m_desc.maxBlockUsage );
+                if( pBlock == nullptr )
+                {
+                    return Results::OK;
+                }
+
+                uint64_t movedSize = 0;
+                for( index_t ndx = 0; ( ndx < m_buffers.size() ) && ( movedSize < m_desc.maxBytesPerFrame ); ++ndx )
+                {
+                    Buffer* pBuffer = m_buffers[ ndx ];
+                    if( ( pBuffer->m_memory.pBlock != pBlock ) || IsMoving( pBuffer ) )
+                    {
+                        continue;
+                    }
+                    if( BGS_FAILED( MoveBuffer( pBuffer, pCmdBuffer, framePoint ) ) )
+                    {
+                        break;
+                    }
+                    movedSize += pBuffer->m_memory.size;
+                }
+                if( movedSize > 0 )
+                {
+                    // New buffers are read by frames recorded after the swap
+                    Backend::GlobalBarrierDesc globalBarrier;
+                    globalBarrier.srcStage  = BGS_FLAG( Backend::PipelineStageFlagBits::TRANSFER );
+                    globalBarrier.srcAccess = BGS_FLAG( Backend::AccessFlagBits::TRANSFER_DST );
+                    globalBarrier.dstStage  = BUFFER_READ_STAGES;
+                    globalBarrier.dstAccess = BUFFER_READ_ACCESS;
+
+                    Backend::BarierDesc barrierDesc;
+                    barrierDesc.pTextureBarriers    = nullptr;
+                    barrierDesc.pBufferBarriers     = nullptr;
+                    barrierDesc.pGlobalBarriers     = &globalBarrier;
+                    barrierDesc.textureBarrierCount = 0;
+                    barrierDesc.bufferBarrierCount  = 0;
+                    barrierDesc.globalBarrierCount  = 1;
+                    pCmdBuffer->Barrier( barrierDesc );
+                }
+                for( index_t ndx = 0; ( ndx < m_textures.size() ) && ( movedSize < m_desc.maxBytesPerFrame ); ++ndx )
+                {
+                    Texture* pTexture = m_textures[ ndx ];
+                    if( ( pTexture->m_memory.pBlock != pBlock ) || IsMoving( pTexture ) ||
+                        ( pTexture->m_state.GetLayout() == Backend::TextureLayouts::UNDEFINED ) )
+                    {
+                        continue;
+                    }
+                    if( BGS_FAILED( MoveTexture( pTexture, pCmdBuffer, framePoint ) ) )
+                    {
+                        break;
+                    }
+                    movedSize += pTexture->m_memory.size;
+                }
+
+                if( movedSize == 0 )
+                {
+                    // Whatever is left in the block can not be moved, block is given up once old resources are gone
+                    if( m_moves.empty() )
+                    {
+                        pMemorySystem->CancelEvacuation();
+                    }
+                    return Results::OK;
+                }
+
+                m_movedSize += movedSize;
+
+                return Results::OK;
+            }
+
+            RESULT DeviceMemoryDefragmenter::Create( const DeviceMemoryDefragmenterDesc& desc, RenderSystem* pSystem )
+            {
+                BGS_ASSERT( pSystem != nullptr, "Render system (pSystem) must be a valid pointer." );
+                BGS_ASSERT( ( desc.maxBlockUsage > 0.0f ) && ( desc.maxBlockUsage <= 1.0f ),
+                            "Block usage (desc.maxBlockUsage) must be in range (0, 1]." );
+                m_pParent = pSystem;
+                m_desc    = desc;
+
+                m_buffers.SetAllocator( m_pParent->GetDefaultAllocator() );
+                m_textures.SetAllocator( m_pParent->GetDefaultAllocator() );
+                m_moves.SetAllocator( m_pParent->GetDefaultAllocator() );
+
+                return Results::OK;
+            }
+
+            void DeviceMemoryDefragmenter::Destroy()
+            {
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                for( index_t ndx = 0; ndx < m_moves.size(); ++ndx )
+                {
+                    m_pParent->GetSyncSystem()->Wait( m_moves[ ndx ].point );
+                    DestroyShadow( &m_moves[ ndx ] );
+                }
+                m_moves.clear();
+                m_moves.shrink_to_fit();
+                m_buffers.clear();
+                m_buffers.shrink_to_fit();
+                m_textures.clear();
+                m_textures.shrink_to_fit();
+            }
+
+            void DeviceMemoryDefragmenter::RegisterBuffer( Buffer* pBuffer )
+            {
+                BGS_ASSERT( pBuffer != nullptr, "Buffer (pBuffer) must be a valid pointer." );
+
+                std::lock_guard<Mutex> lock( m_mutex );
+                for( index_t ndx = 0; ndx < m_buffers.size(); ++ndx )
+                {
+                    if( m_buffers[ ndx ] == pBuffer )
+                    {
+                        return;
+                    }
+                }
+                m_buffers.push_back( pBuffer );
+            }
+
+            bool_t DeviceMemoryDefragmenter::UnregisterBuffer( Buffer* pBuffer )
+            {
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                for( index_t ndx = 0; ndx < m_moves.size(); ++ndx )
+                {
+                    Move& move = m_moves[ ndx ];
+                    if( move.pBuffer != pBuffer )
+                    {
+                        continue;
+                    }
+                    // Copy still reads the buffer, retiring move only holds old resources and finishes on its own
+                    if( move.state == MoveStates::COPYING )
+                    {
+                        m_pParent->GetSyncSystem()->Wait( move.point );
+                        DestroyShadow( &move );
+                        m_moves[ ndx ] = m_moves.back();
+                        m_moves.pop_back();
+                    }
+                    else
+                    {
+                        move.pBuffer = nullptr;
+                    }
+                    break;
+                }
+
+                for( index_t ndx = 0; ndx < m_buffers.size(); ++ndx )
+                {
+                    if( m_buffers[ ndx ] == pBuffer )
+                    {
+                        m_buffers[ ndx ] = m_buffers.back();
+                        m_buffers.pop_back();
+                        return BGS_TRUE;
+                    }
+                }
+
+                return BGS_FALSE;
+            }
+
+            void DeviceMemoryDefragmenter::RegisterTexture( Texture* pTexture )
+            {
+                BGS_ASSERT( pTexture != nullptr, "Texture (pTexture) must be a valid pointer." );
+
+                std::lock_guard<Mutex> lock( m_mutex );
+                for( index_t ndx = 0; ndx < m_textures.size(); ++ndx )
+                {
+                    if( m_textures[ ndx ] == pTexture )
+                    {
+                        return;
+                    }
+                }
+                m_textures.push_back( pTexture );
+            }
+
+            bool_t DeviceMemoryDefragmenter::UnregisterTexture( Texture* pTexture )
+            {
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                for( index_t ndx = 0; ndx < m_moves.size(); ++ndx )
+                {
+                    Move& move = m_moves[ ndx ];
+                    if( move.pTexture != pTexture )
+                    {
+                        continue;
+                    }
+                    if( move.state == MoveStates::COPYING )
+                    {
+                        m_pParent->GetSyncSystem()->Wait( move.point );
+                        DestroyShadow( &move );
+                        m_moves[ ndx ] = m_moves.back();
+                        m_moves.pop_back();
+                    }
+                    else
+                    {
+                        move.pTexture = nullptr;
+                    }
+                    break;
+                }
+
+                for( index_t ndx = 0; ndx < m_textures.size(); ++ndx )
+                {
+                    if( m_textures[ ndx ] == pTexture )
+                    {
+                        m_textures[ ndx ] = m_textures.back();
+                        m_textures.pop_back();
+                        return BGS_TRUE;
+                    }
+                }
+
+                return BGS_FALSE;
+            }
+
+            RESULT DeviceMemoryDefragmenter::MoveBuffer( Buffer* pBuffer, Backend::ICommandBuffer* pCmdBuffer, const SyncPoint& framePoint )
+            {
+                // Evacuated block takes no allocations, so new buffer lands in another block
+                Buffer* pShadow = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetDefaultAllocator(), &pShadow ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+                if( BGS_FAILED( pShadow->Create( pBuffer->m_desc, m_pParent ) ) )
+                {
+                    Memory::FreeObject( m_pParent->GetDefaultAllocator(), &pShadow );
+                    return Results::FAIL;
+                }
+
+                // Buffer is only read, so copy needs no barrier before it
+                Backend::CopyBufferDesc cpyDesc;
+                cpyDesc.hSrcBuffer = pBuffer->m_hResource;
+                cpyDesc.hDstBuffer = pShadow->m_hResource;
+                cpyDesc.srcOffset  = 0;
+                cpyDesc.dstOffset  = 0;
+                cpyDesc.size       = pBuffer->m_desc.size;
+                pCmdBuffer->CopyBuffer( cpyDesc );
+
+                Move move;
+                move.pBuffer        = pBuffer;
+                move.pShadowBuffer  = pShadow;
+                move.pTexture       = nullptr;
+                move.pShadowTexture = nullptr;
+                move.point          = framePoint;
+                move.state          = MoveStates::COPYING;
+                m_moves.push_back( move );
+
+                return Results::OK;
+            }
+
+            RESULT DeviceMemoryDefragmenter::MoveTexture( Texture* pTexture, Backend::ICommandBuffer* pCmdBuffer, const SyncPoint& framePoint )
+            {
+                Texture* pShadow = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetDefaultAllocator(), &pShadow ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+                if( BGS_FAILED( pShadow->Create( pTexture->m_desc, m_pParent ) ) )
+                {
+                    Memory::FreeObject( m_pParent->GetDefaultAllocator(), &pShadow );
+                    return Results::FAIL;
+                }
+
+                // Source waits for earlier work of its tracked state, both textures end in that state
+                const TextureDesc&   texDesc = pTexture->m_desc;
+                const ResourceState& state   = pTexture->m_state;
+
+                Backend::TextureBarrierDesc barriers[ 2 ];
+                barriers[ 0 ].hResouce                     = pTexture->m_hResource;
+                barriers[ 0 ].textureRange.components      = Backend::GetFormatComponents( texDesc.format );
+                barriers[ 0 ].textureRange.mipLevel        = 0;
+                barriers[ 0 ].textureRange.mipLevelCount   = texDesc.mipLevelCount;
+                barriers[ 0 ].textureRange.arrayLayer      = 0;
+                barriers[ 0 ].textureRange.arrayLayerCount = texDesc.arrayLayerCount;
+                barriers[ 0 ].srcStage                     = state.GetStage();
+                barriers[ 0 ].srcAccess                    = state.GetAccess();
+                barriers[ 0 ].srcLayout                    = state.GetLayout();
+                barriers[ 0 ].dstStage                     = BGS_FLAG( Backend::PipelineStageFlagBits::TRANSFER );
+                barriers[ 0 ].dstAccess                    = BGS_FLAG( Backend::AccessFlagBits::TRANSFER_SRC );
+                barriers[ 0 ].dstLayout                    = Backend::TextureLayouts::TRANSFER_SRC;
+                barriers[ 0 ].pSrcQueue                    = nullptr;
+                barriers[ 0 ].pDstQueue                    = nullptr;
+
+                barriers[ 1 ]           = barriers[ 0 ];
+                barriers[ 1 ].hResouce  = pShadow->m_hResource;
+                barriers[ 1 ].srcStage  = BGS_FLAG( Backend::PipelineStageFlagBits::NONE );
+                barriers[ 1 ].srcAccess = BGS_FLAG( Backend::AccessFlagBits::NONE );
+                barriers[ 1 ].srcLayout = Backend::TextureLayouts::UNDEFINED;
+                barriers[ 1 ].dstAccess = BGS_FLAG( Backend::AccessFlagBits::TRANSFER_DST );
+                barriers[ 1 ].dstLayout = Backend::TextureLayouts::TRANSFER_DST;
+
+                Backend::BarierDesc barrierDesc;
+                barrierDesc.pTextureBarriers    = barriers;
+                barrierDesc.pBufferBarriers     = nullptr;
+                barrierDesc.pGlobalBarriers     = nullptr;
+                barrierDesc.textureBarrierCount = 2;
+                barrierDesc.bufferBarrierCount  = 0;
+                barrierDesc.globalBarrierCount  = 0;
+                pCmdBuffer->Barrier( barrierDesc );
+
+                // One copy per subresource, mip level count in range is the total count as D3D12 needs it to compute subresource index
+                Backend::CopyTextureDesc cpyDesc;
+                cpyDesc.hSrcTexture = pTexture->m_hResource;
+                cpyDesc.hDstTexture = pShadow->m_hResource;
+                cpyDesc.srcOffset   = { 0, 0, 0 };
+                cpyDesc.dstOffset   = { 0, 0, 0 };
+                cpyDesc.srcRange    = barriers[ 0 ].textureRange;
+                for( uint32_t mipNdx = 0; mipNdx < texDesc.mipLevelCount; ++mipNdx )
+                {
+                    cpyDesc.size.width  = ( texDesc.size.width >> mipNdx ) > 0 ? texDesc.size.width >> mipNdx : 1;
+                    cpyDesc.size.height = ( texDesc.size.height >> mipNdx ) > 0 ? texDesc.size.height >> mipNdx : 1;
+                    cpyDesc.size.depth  = ( texDesc.size.depth >> mipNdx ) > 0 ? texDesc.size.depth >> mipNdx : 1;
+                    for( uint32_t layerNdx = 0; layerNdx < texDesc.arrayLayerCount; ++layerNdx )
+                    {
+                        cpyDesc.srcRange.mipLevel   = mipNdx;
+                        cpyDesc.srcRange.arrayLayer = layerNdx;
+                        cpyDesc.dstRange            = cpyDesc.srcRange;
+                        pCmdBuffer->CopyTexture( cpyDesc );
+                    }
+                }
+
+                barriers[ 0 ].srcStage  = BGS_FLAG( Backend::PipelineStageFlagBits::TRANSFER );
+                barriers[ 0 ].srcAccess = BGS_FLAG( Backend::AccessFlagBits::TRANSFER_SRC );
+                barriers[ 0 ].srcLayout = Backend::TextureLayouts::TRANSFER_SRC;
+                barriers[ 0 ].dstStage  = state.GetStage();
+                barriers[ 0 ].dstAccess = state.GetAccess();
+                barriers[ 0 ].dstLayout = state.GetLayout();
+
+                barriers[ 1 ].srcStage  = BGS_FLAG( Backend::PipelineStageFlagBits::TRANSFER );
+                barriers[ 1 ].srcAccess = BGS_FLAG( Backend::AccessFlagBits::TRANSFER_DST );
+                barriers[ 1 ].srcLayout = Backend::TextureLayouts::TRANSFER_DST;
+                barriers[ 1 ].dstStage  = state.GetStage();
+                barriers[ 1 ].dstAccess = state.GetAccess();
+                barriers[ 1 ].dstLayout = state.GetLayout();
+                pCmdBuffer->Barrier( barrierDesc );
+                pShadow->m_state = state;
+
+                Move move;
+                move.pBuffer        = nullptr;
+                move.pShadowBuffer  = nullptr;
+                move.pTexture       = pTexture;
+                move.pShadowTexture = pShadow;
+                move.point          = framePoint;
+                move.state          = MoveStates::COPYING;
+                m_moves.push_back( move );
+
+                return Results::OK;
+            }
+
+            void DeviceMemoryDefragmenter::DestroyShadow( Move* pMove )
+            {
+                if( pMove->pShadowBuffer != nullptr )
+                {
+                    pMove->pShadowBuffer->Destroy();
+                    Memory::FreeObject( m_pParent->GetDefaultAllocator(), &pMove->pShadowBuffer );
+                }
+                if( pMove->pShadowTexture != nullptr )
+                {
+                    pMove->pShadowTexture->Destroy();
+                    Memory::FreeObject( m_pParent->GetDefaultAllocator(), &pMove->pShadowTexture );
+                }
+            }
+
+            bool_t DeviceMemoryDefragmenter::IsMoving( const void* pObject ) const
+            {
+                for( index_t ndx = 0; ndx < m_moves.size(); ++ndx )
+                {
+                    if( ( m_moves[ ndx ].pBuffer == pObject ) || ( m_moves[ ndx ].pTexture == pObject ) )
+                    {
+                        return BGS_TRUE;
+                    }
+                }
+
+                return BGS_FALSE;
+            }
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
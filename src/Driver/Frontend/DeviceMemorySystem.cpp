@@ -0,0 +1,323 @@
+#include "Driver/Frontend/DeviceMemorySystem.h"
+
+#include "Core/Memory/Memory.h"
+#include "Driver/Frontend/RenderSystem.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            DeviceMemorySystem::DeviceMemorySystem()
+                : m_desc()
+                , m_pParent( nullptr )
+                , m_pools()
+                , m_mutex()
+                , m_pEvacuatedBlock( nullptr )
+                , m_allocatedSize( 0 )
+                , m_usedSize( 0 )
+                , m_deviceAllocationCount( 0 )
+            {
+            }
+
+            RESULT DeviceMemorySystem::Allocate( const Backend::AllocateMemoryDesc& desc, DeviceMemoryAllocation* pAllocation )
+            {
+                BGS_ASSERT( pAllocation != nullptr, "Allocation (pAllocation) must be a valid address." );
+                BGS_ASSERT( desc.size > 0, "Allocation size (desc.size) must be greater than 0." );
+                if( ( pAllocation == nullptr ) || ( desc.size == 0 ) )
+                {
+                    return Results::FAIL;
+                }
+
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                // Custom heaps differ by access flags, so they can not share blocks
+                const bool_t dedicated = ( desc.heapType == Backend::MemoryHeapTypes::CUSTOM ) || ( desc.size > m_desc.blockSize / 2 ) ||
+                                         ( desc.alignment > Config::Driver::Memory::DEVICE_MEMORY_BLOCK_ALIGNMENT );
+                if( dedicated )
+                {
+                    if( BGS_FAILED( m_pParent->GetDevice()->AllocateMemory( desc, &pAllocation->hMemory ) ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+                    pAllocation->offset    = 0;
+                    pAllocation->size      = desc.size;
+                    pAllocation->heapType  = desc.heapType;
+                    pAllocation->heapUsage = desc.heapUsage;
+                    pAllocation->pBlock    = nullptr;
+                    pAllocation->range     = Core::Memory::RangeAllocation();
+
+                    m_allocatedSize += desc.size;
+                    m_usedSize += desc.size;
+                    m_deviceAllocationCount++;
+
+                    return Results::OK;
+                }
+
+                BlockArray&        pool   = GetPool( desc.heapType, desc.heapUsage );
+                DeviceMemoryBlock* pBlock = nullptr;
+                for( index_t ndx = 0; ndx < pool.size(); ++ndx )
+                {
+                    if( pool[ ndx ]->isEvacuated )
+                    {
+                        continue;
+                    }
+                    if( BGS_SUCCESS( pool[ ndx ]->allocator.Allocate( desc.size, desc.alignment, &pAllocation->range ) ) )
+                    {
+                        pBlock = pool[ ndx ];
+                        break;
+                    }
+                }
+                if( pBlock == nullptr )
+                {
+                    if( BGS_FAILED( CreateBlock( desc.heapType, desc.heapUsage, &pBlock ) ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+                    pool.push_back( pBlock );
+                    if( BGS_FAILED( pBlock->allocator.Allocate( desc.size, desc.alignment, &pAllocation->range ) ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+                }
+
+                pAllocation->hMemory   = pBlock->hMemory;
+                pAllocation->offset    = pAllocation->range.offset;
+                pAllocation->size      = desc.size;
+                pAllocation->heapType  = desc.heapType;
+                pAllocation->heapUsage = desc.heapUsage;
+                pAllocation->pBlock    = pBlock;
+
+                m_usedSize += desc.size;
+
+                return Results::OK;
+            }
+
+            void DeviceMemorySystem::Free( DeviceMemoryAllocation* pAllocation )
+            {
+                BGS_ASSERT( pAllocation != nullptr, "Allocation (pAllocation) must be a valid address." );
+                if( ( pAllocation == nullptr ) || ( pAllocation->hMemory == Backend::MemoryHandle() ) )
+                {
+                    return;
+                }
+
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                DeviceMemoryBlock* pBlock = pAllocation->pBlock;
+                if( pBlock == nullptr )
+                {
+                    m_pParent->GetDevice()->FreeMemory( &pAllocation->hMemory );
+                    m_allocatedSize -= pAllocation->size;
+                    m_usedSize -= pAllocation->size;
+                    m_deviceAllocationCount--;
+                }
+                else
+                {
+                    pBlock->allocator.Free( &pAllocation->range );
+                    m_usedSize -= pAllocation->size;
+
+                    if( ( pBlock == m_pEvacuatedBlock ) && pBlock->allocator.IsEmpty() )
+                    {
+                        pBlock->isEvacuated = BGS_FALSE;
+                        m_pEvacuatedBlock   = nullptr;
+                    }
+
+                    // One empty block is kept per pool, so create - destroy loops do not hit the driver every time
+                    BlockArray& pool = GetPool( pAllocation->heapType, pAllocation->heapUsage );
+                    if( pBlock->allocator.IsEmpty() && ( pool.size() > 1 ) )
+                    {
+                        for( index_t ndx = 0; ndx < pool.size(); ++ndx )
+                        {
+                            if( pool[ ndx ] == pBlock )
+                            {
+                                pool[ ndx ] = pool.back();
+                                pool.pop_back();
+                                break;
+                            }
+                        }
+                        DestroyBlock( &pBlock );
+                    }
+                }
+
+                *pAllocation = DeviceMemoryAllocation();
+            }
+
+            RESULT DeviceMemorySystem::AllocateAndBind( Backend::ResourceHandle hResource, Backend::MEMORY_HEAP_TYPE heapType,
+                                                        Backend::MEMORY_HEAP_USAGE heapUsage, DeviceMemoryAllocation* pAllocation )
+            {
+                BGS_ASSERT( hResource != Backend::ResourceHandle(), "Resource (hResource) must be a valid handle." );
+                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
+
+                Backend::ResourceAllocationInfo allocInfo;
+                pAPIDevice->GetResourceAllocationInfo( hResource, &allocInfo );
+
+                Backend::AllocateMemoryDesc allocDesc;
+                allocDesc.size      = allocInfo.size;
+                allocDesc.alignment = allocInfo.alignment;
+                allocDesc.access    = 0;
+                allocDesc.heapType  = heapType;
+                allocDesc.heapUsage = heapUsage;
+                if( BGS_FAILED( Allocate( allocDesc, pAllocation ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                Backend::BindResourceMemoryDesc bindDesc;
+                bindDesc.hMemory      = pAllocation->hMemory;
+                bindDesc.hResource    = hResource;
+                bindDesc.memoryOffset = pAllocation->offset;
+                if( BGS_FAILED( pAPIDevice->BindResourceMemory( bindDesc ) ) )
+                {
+                    Free( pAllocation );
+                    return Results::FAIL;
+                }
+
+                return Results::OK;
+            }
+
+            DeviceMemoryBlock* DeviceMemorySystem::BeginEvacuation( float maxUsage )
+            {
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                if( m_pEvacuatedBlock != nullptr )
+                {
+                    return m_pEvacuatedBlock;
+                }
+
+                // Only default heaps, upload and readback resources are mapped and can not be moved behind the user's back
+                const uint32_t typeNdx  = BGS_ENUM_INDEX( Backend::MemoryHeapTypes::DEFAULT );
+                float          minUsage = maxUsage;
+                for( uint32_t usageNdx = 0; usageNdx < BGS_ENUM_COUNT( Backend::MemoryHeapUsages ); ++usageNdx )
+                {
+                    BlockArray& pool = m_pools[ typeNdx ][ usageNdx ];
+                    if( pool.size() < 2 )
+                    {
+                        continue;
+                    }
+                    for( index_t ndx = 0; ndx < pool.size(); ++ndx )
+                    {
+                        DeviceMemoryBlock* pBlock = pool[ ndx ];
+                        const float        usage  = static_cast<float>( pBlock->allocator.GetUsedSize() ) / pBlock->allocator.GetSize();
+                        if( !pBlock->isPinned && !pBlock->allocator.IsEmpty() && ( usage < minUsage ) )
+                        {
+                            minUsage          = usage;
+                            m_pEvacuatedBlock = pBlock;
+                        }
+                    }
+                }
+                if( m_pEvacuatedBlock != nullptr )
+                {
+                    m_pEvacuatedBlock->isEvacuated = BGS_TRUE;
+                }
+
+                return m_pEvacuatedBlock;
+            }
+
+            void DeviceMemorySystem::CancelEvacuation()
+            {
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                if( m_pEvacuatedBlock != nullptr )
+                {
+                    m_pEvacuatedBlock->isEvacuated = BGS_FALSE;
+                    m_pEvacuatedBlock->isPinned    = BGS_TRUE;
+                    m_pEvacuatedBlock              = nullptr;
+                }
+            }
+
+            RESULT DeviceMemorySystem::Create( const DeviceMemorySystemDesc& desc, RenderSystem* pSystem )
+            {
+                BGS_ASSERT( pSystem != nullptr, "Render system (pSystem) must be a valid pointer." );
+                BGS_ASSERT( desc.blockSize > 0, "Block size (desc.blockSize) must be greater than 0." );
+                if( desc.blockSize == 0 )
+                {
+                    return Results::FAIL;
+                }
+                m_pParent = pSystem;
+                m_desc    = desc;
+
+                for( uint32_t typeNdx = 0; typeNdx < BGS_ENUM_COUNT( Backend::MemoryHeapTypes ); ++typeNdx )
+                {
+                    for( uint32_t usageNdx = 0; usageNdx < BGS_ENUM_COUNT( Backend::MemoryHeapUsages ); ++usageNdx )
+                    {
+                        m_pools[ typeNdx ][ usageNdx ].SetAllocator( m_pParent->GetDefaultAllocator() );
+                    }
+                }
+
+                return Results::OK;
+            }
+
+            void DeviceMemorySystem::Destroy()
+            {
+                std::lock_guard<Mutex> lock( m_mutex );
+
+                for( uint32_t typeNdx = 0; typeNdx < BGS_ENUM_COUNT( Backend::MemoryHeapTypes ); ++typeNdx )
+                {
+                    for( uint32_t usageNdx = 0; usageNdx < BGS_ENUM_COUNT( Backend::MemoryHeapUsages ); ++usageNdx )
+                    {
+                        BlockArray& pool = m_pools[ typeNdx ][ usageNdx ];
+                        for( index_t ndx = 0; ndx < pool.size(); ++ndx )
+                        {
+                            BGS_ASSERT( pool[ ndx ]->allocator.IsEmpty(), "Device memory block is still in use." );
+                            DestroyBlock( &pool[ ndx ] );
+                        }
+                        pool.clear();
+                        pool.shrink_to_fit();
+                    }
+                }
+                BGS_ASSERT( m_deviceAllocationCount == 0, "Dedicated device memory allocations were not freed." );
+
+                m_pParent = nullptr;
+            }
+
+            RESULT DeviceMemorySystem::CreateBlock( Backend::MEMORY_HEAP_TYPE heapType, Backend::MEMORY_HEAP_USAGE heapUsage,
+                                                    DeviceMemoryBlock** ppBlock )
+            {
+                DeviceMemoryBlock* pBlock = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetDefaultAllocator(), &pBlock ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                Backend::AllocateMemoryDesc allocDesc;
+                allocDesc.size      = m_desc.blockSize;
+                allocDesc.alignment = Config::Driver::Memory::DEVICE_MEMORY_BLOCK_ALIGNMENT;
+                allocDesc.access    = 0;
+                allocDesc.heapType  = heapType;
+                allocDesc.heapUsage = heapUsage;
+                if( BGS_FAILED( m_pParent->GetDevice()->AllocateMemory( allocDesc, &pBlock->hMemory ) ) )
+                {
+                    Memory::FreeObject( m_pParent->GetDefaultAllocator(), &pBlock );
+                    return Results::NO_MEMORY;
+                }
+                if( BGS_FAILED( pBlock->allocator.Create( m_desc.blockSize, m_pParent->GetDefaultAllocator() ) ) )
+                {
+                    m_pParent->GetDevice()->FreeMemory( &pBlock->hMemory );
+                    Memory::FreeObject( m_pParent->GetDefaultAllocator(), &pBlock );
+                    return Results::NO_MEMORY;
+                }
+                pBlock->isEvacuated = BGS_FALSE;
+                pBlock->isPinned    = BGS_FALSE;
+
+                m_allocatedSize += m_desc.blockSize;
+                m_deviceAllocationCount++;
+                *ppBlock = pBlock;
+
+                return Results::OK;
+            }
+
+            void DeviceMemorySystem::DestroyBlock( DeviceMemoryBlock** ppBlock )
+            {
+                DeviceMemoryBlock* pBlock = *ppBlock;
+
+                m_allocatedSize -= pBlock->allocator.GetSize();
+                m_deviceAllocationCount--;
+                pBlock->allocator.Destroy();
+                m_pParent->GetDevice()->FreeMemory( &pBlock->hMemory );
+                Memory::FreeObject( m_pParent->GetDefaultAllocator(), ppBlock );
+            }
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
\ No newline at end of file
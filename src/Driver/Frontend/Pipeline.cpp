@@ -1,5 +1,6 @@
 #include "Driver/Frontend/Pipeline.h"
 
+#include "BIGOS/BigosEngine.h"
 #include "Core/Utils/String.h"
 #include "Driver/Backend/APICommon.h"
 #include "Driver/Frontend/RenderSystem.h"
@@ -325,11 +326,40 @@ namespace BIGOS
                 m_graphicsDesc.inputState.inputElementCount = inputElementCount;
                 m_graphicsDesc.inputState.pInputElements    = inputElements;
 
-                // Resource bindings
-                ShaderBindingInfo
-                        allStageResources[ Config::Driver::Binding::MAX_SHADER_RESOURCE_COUNT + Config::Driver::Binding::MAX_SAMPLER_COUNT ];
-                index_t allBindingCount               = 0;
-                ShaderBindingInfo* pAllStageResources = allStageResources;
+                // Resource bindings. Gathered in scratch memory of calling thread, released as soon as layouts are created.
+                Shader*                 stages[]        = { pVS, pPS, pDS, pHS, pGS };
+                static constexpr size_t stageCount      = sizeof( stages ) / sizeof( stages[ 0 ] );
+                index_t                 maxBindingCount = 0;
+                for( index_t ndx = 0; ndx < stageCount; ++ndx )
+                {
+                    if( stages[ ndx ] != nullptr )
+                    {
+                        maxBindingCount += stages[ ndx ]->GetCompiledShader()->bindingCount;
+                    }
+                }
+                BGS_ASSERT( maxBindingCount <= Config::Driver::Binding::MAX_SHADER_RESOURCE_COUNT + Config::Driver::Binding::MAX_SAMPLER_COUNT );
+
+                // Pipelines can be created from any thread, frame allocator is not thread safe
+                Memory::LinearAllocator* pScratchAllocator = m_pParent->GetParent()->GetMemorySystem().GetThreadScratchAllocator();
+                if( pScratchAllocator == nullptr )
+                {
+                    return Results::NO_MEMORY;
+                }
+                const Memory::LinearAllocatorMarker scratchMarker = pScratchAllocator->GetMarker();
+
+                ShaderBindingInfo*         pAllStageResources = nullptr;
+                Backend::BindingRangeDesc* pSrRanges          = nullptr;
+                if( maxBindingCount > 0 )
+                {
+                    const uint32_t allocCount = static_cast<uint32_t>( maxBindingCount );
+                    if( BGS_FAILED( BGS_ALLOCATE_ARRAY( pScratchAllocator, &pAllStageResources, allocCount, alignof( ShaderBindingInfo ) ) ) ||
+                        BGS_FAILED( BGS_ALLOCATE_ARRAY( pScratchAllocator, &pSrRanges, allocCount, alignof( Backend::BindingRangeDesc ) ) ) )
+                    {
+                        pScratchAllocator->FreeToMarker( scratchMarker );
+                        return Results::NO_MEMORY;
+                    }
+                }
+                index_t allBindingCount = 0;
 
                 AddNextStageBindings( pVS, &allBindingCount, &pAllStageResources );
                 if( pPS != nullptr )
@@ -349,13 +379,12 @@ namespace BIGOS
                     AddNextStageBindings( pGS, &allBindingCount, &pAllStageResources );
                 }
 
-                Backend::BindingRangeDesc srRanges[ Config::Driver::Binding::MAX_SHADER_RESOURCE_COUNT ];
                 Backend::BindingRangeDesc samplerRanges[ Config::Driver::Binding::MAX_SAMPLER_COUNT ];
                 uint32_t                  srCount      = 0;
                 uint32_t                  samplerCount = 0;
                 for( index_t ndx = 0; ndx < allBindingCount; ++ndx )
                 {
-                    const ShaderBindingInfo& binding = allStageResources[ ndx ];
+                    const ShaderBindingInfo& binding = pAllStageResources[ ndx ];
                     if( binding.type == Backend::BindingTypes::SAMPLER )
                     {
                         Backend::BindingRangeDesc& range = samplerRanges[ samplerCount++ ];
@@ -366,7 +395,7 @@ namespace BIGOS
                     }
                     else
                     {
-                        Backend::BindingRangeDesc& range = srRanges[ srCount++ ];
+                        Backend::BindingRangeDesc& range = pSrRanges[ srCount++ ];
                         range.baseBindingSlot            = binding.baseBindingSlot;
                         range.baseShaderRegister         = binding.baseShaderRegister;
                         range.bindingCount               = 1;
@@ -374,10 +403,12 @@ namespace BIGOS
                     }
                 }
                 Backend::BindingSetLayoutDesc srLayoutDesc;
-                srLayoutDesc.pBindingRanges    = srRanges;
+                srLayoutDesc.pBindingRanges    = pSrRanges;
                 srLayoutDesc.bindingRangeCount = srCount;
                 srLayoutDesc.visibility        = Backend::ShaderVisibilities::ALL_GRAPHICS;
-                if( BGS_FAILED( pAPIDevice->CreateBindingSetLayout( srLayoutDesc, &m_hShaderResourceLayout ) ) )
+                const RESULT srLayoutResult    = pAPIDevice->CreateBindingSetLayout( srLayoutDesc, &m_hShaderResourceLayout );
+                pScratchAllocator->FreeToMarker( scratchMarker );
+                if( BGS_FAILED( srLayoutResult ) )
                 {
                     return Results::FAIL;
                 }
@@ -1,19 +1,30 @@
 #include "Driver/Frontend/RenderSystem.h"
 
+#include "BIGOS/BigosEngine.h"
 #include "Core/Memory/IAllocator.h"
 #include "Core/Memory/Memory.h"
 #include "Driver/Backend/D3D12/D3D12Factory.h"
 #include "Driver/Backend/Vulkan/VulkanFactory.h"
+#include "Driver/Frontend/BindingObjectCache.h"
+#include "Driver/Frontend/BindlessTable.h"
 #include "Driver/Frontend/Buffer.h"
 #include "Driver/Frontend/Camera/Camera.h"
 #include "Driver/Frontend/Context.h"
+#include "Driver/Frontend/DeviceMemoryDefragmenter.h"
+#include "Driver/Frontend/DeviceMemorySystem.h"
 #include "Driver/Frontend/Pipeline.h"
 #include "Driver/Frontend/RenderPass.h"
 #include "Driver/Frontend/RenderTarget.h"
+#include "Driver/Frontend/ResidencyManager.h"
+#include "Driver/Frontend/Shader/AsyncShaderCompiler.h"
 #include "Driver/Frontend/Shader/Shader.h"
 #include "Driver/Frontend/Swapchain.h"
 #include "Driver/Frontend/SyncSystem.h"
 #include "Driver/Frontend/Texture.h"
+#include "Driver/Frontend/TextureStreamer.h"
+#include "Driver/Frontend/TransientBindingHeap.h"
+#include "Driver/Frontend/TransientResourcePool.h"
+#include "Driver/Frontend/UploadRingBuffer.h"
 #include "Shader/ShaderCompilerFactory.h"
 
 namespace BIGOS
@@ -33,10 +44,14 @@ namespace BIGOS
                 , m_pComputeContext( nullptr )
                 , m_pCopyContext( nullptr )
                 , m_pSyncSystem( nullptr )
+                , m_pDeviceMemorySystem( nullptr )
+                , m_pDefragmenter( nullptr )
+                , m_pBindingObjectCache( nullptr )
                 , m_cameras()
                 , m_pParent( nullptr )
                 , m_pShaderCompilerFactory( nullptr )
                 , m_pDefaultAllocator( nullptr )
+                , m_pObjectAllocator( nullptr )
                 , m_pCompiler( nullptr )
             {
             }
@@ -60,21 +75,45 @@ namespace BIGOS
                     return Results::FAIL;
                 }
 
+                HeapArray<byte_t> pipelineCacheData;
+                LoadPipelineCache( &pipelineCacheData );
+
+                Backend::IAdapter* pAdapter = m_adapters[ 0 ];
+                for( index_t ndx = 0; ndx < m_adapters.size(); ++ndx )
+                {
+                    if( m_adapters[ ndx ]->GetInfo().type == m_driverDesc.adapterType )
+                    {
+                        pAdapter = m_adapters[ ndx ];
+                        break;
+                    }
+                }
+
                 Backend::DeviceDesc deviceDesc;
-                deviceDesc.pAdapter = m_adapters[ 0 ];
+                deviceDesc.pAdapter           = pAdapter;
+                deviceDesc.pPipelineCacheData = pipelineCacheData.empty() ? nullptr : pipelineCacheData.data();
+                deviceDesc.pipelineCacheSize  = pipelineCacheData.size();
                 if( BGS_FAILED( m_pFactory->CreateDevice( deviceDesc, &m_pDevice ) ) )
                 {
                     FreeDriver();
                     return Results::FAIL;
                 }
 
-                if( BGS_FAILED( CreateContexts() ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &m_pBindingObjectCache ) ) )
                 {
+                    FreeDriver();
+                    return Results::NO_MEMORY;
+                }
+
+                BindingObjectCacheDesc cacheDesc;
+                cacheDesc.bucketCount = Config::Driver::Binding::BINDING_OBJECT_CACHE_BUCKET_COUNT;
+                if( BGS_FAILED( m_pBindingObjectCache->Create( cacheDesc, this ) ) )
+                {
+                    Memory::FreeObject( m_pDefaultAllocator, &m_pBindingObjectCache );
                     FreeDriver();
                     return Results::FAIL;
                 }
 
-                if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &m_pSyncSystem ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &m_pSyncSystem ) ) )
                 {
                     FreeDriver();
                     return Results::NO_MEMORY;
@@ -89,6 +128,44 @@ namespace BIGOS
                     return Results::FAIL;
                 }
 
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &m_pDeviceMemorySystem ) ) )
+                {
+                    FreeDriver();
+                    return Results::NO_MEMORY;
+                }
+
+                DeviceMemorySystemDesc memoryDesc;
+                memoryDesc.blockSize = Config::Driver::Memory::DEVICE_MEMORY_BLOCK_SIZE;
+                if( BGS_FAILED( m_pDeviceMemorySystem->Create( memoryDesc, this ) ) )
+                {
+                    Memory::FreeObject( m_pDefaultAllocator, &m_pDeviceMemorySystem );
+                    FreeDriver();
+                    return Results::FAIL;
+                }
+
+                // Copy context stages uploads in device memory and signals sync points, so it goes after both systems
+                if( BGS_FAILED( CreateContexts() ) )
+                {
+                    FreeDriver();
+                    return Results::FAIL;
+                }
+
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &m_pDefragmenter ) ) )
+                {
+                    FreeDriver();
+                    return Results::NO_MEMORY;
+                }
+
+                DeviceMemoryDefragmenterDesc defragDesc;
+                defragDesc.maxBytesPerFrame = Config::Driver::Memory::DEFRAGMENTATION_FRAME_BUDGET;
+                defragDesc.maxBlockUsage    = Config::Driver::Memory::DEFRAGMENTATION_BLOCK_USAGE;
+                if( BGS_FAILED( m_pDefragmenter->Create( defragDesc, this ) ) )
+                {
+                    Memory::FreeObject( m_pDefaultAllocator, &m_pDefragmenter );
+                    FreeDriver();
+                    return Results::FAIL;
+                }
+
                 return Results::OK;
             }
 
@@ -98,7 +175,7 @@ namespace BIGOS
                 BGS_ASSERT( *ppBuffer == nullptr, "There is a valid pointer at the given address. Buffer (*ppBuffer) must be nullptr." );
 
                 Buffer* pBuffer = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &pBuffer ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pBuffer ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -120,17 +197,52 @@ namespace BIGOS
                 BGS_ASSERT( *ppBuffer != nullptr, "Buffer (*ppBuffer) must be a valid pointer." );
 
                 Buffer* pBuffer = ( *ppBuffer );
+                BGS_ASSERT( pBuffer->m_bindlessEntries.empty(), "Buffer must be unregistered from bindless tables." );
+                m_pDefragmenter->UnregisterBuffer( pBuffer );
                 pBuffer->Destroy();
                 Memory::FreeObject( m_pDefaultAllocator, &pBuffer );
             }
 
+            RESULT RenderSystem::CreateUploadRingBuffer( const UploadRingBufferDesc& desc, UploadRingBuffer** ppRingBuffer )
+            {
+                BGS_ASSERT( ppRingBuffer != nullptr, "Upload ring buffer (ppRingBuffer) must be a valid address." );
+                BGS_ASSERT( *ppRingBuffer == nullptr,
+                            "There is a valid pointer at the given address. Upload ring buffer (*ppRingBuffer) must be nullptr." );
+
+                UploadRingBuffer* pRingBuffer = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pRingBuffer ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                if( BGS_FAILED( pRingBuffer->Create( desc, this ) ) )
+                {
+                    Memory::FreeObject( m_pDefaultAllocator, &pRingBuffer );
+                    return Results::FAIL;
+                }
+
+                ( *ppRingBuffer ) = pRingBuffer;
+
+                return Results::OK;
+            }
+
+            void RenderSystem::DestroyUploadRingBuffer( UploadRingBuffer** ppRingBuffer )
+            {
+                BGS_ASSERT( ppRingBuffer != nullptr, "Upload ring buffer (ppRingBuffer) must be a valid address." );
+                BGS_ASSERT( *ppRingBuffer != nullptr, "Upload ring buffer (*ppRingBuffer) must be a valid pointer." );
+
+                UploadRingBuffer* pRingBuffer = ( *ppRingBuffer );
+                pRingBuffer->Destroy();
+                Memory::FreeObject( m_pDefaultAllocator, &pRingBuffer );
+            }
+
             RESULT RenderSystem::CreateTexture( const TextureDesc& desc, Texture** ppTexture )
             {
                 BGS_ASSERT( ppTexture != nullptr, "Texture (ppTexture) must be a valid address." );
                 BGS_ASSERT( *ppTexture == nullptr, "There is a valid pointer at the given address. Texture (*ppTExture) must be nullptr." );
 
                 Texture* pTexture = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &pTexture ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pTexture ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -152,6 +264,8 @@ namespace BIGOS
                 BGS_ASSERT( *ppTexture != nullptr, "Texture (*ppTexture) must be a valid pointer." );
 
                 Texture* pTexture = ( *ppTexture );
+                BGS_ASSERT( pTexture->m_bindlessEntries.empty(), "Texture must be unregistered from bindless tables." );
+                m_pDefragmenter->UnregisterTexture( pTexture );
                 pTexture->Destroy();
                 Memory::FreeObject( m_pDefaultAllocator, &pTexture );
             }
@@ -163,7 +277,7 @@ namespace BIGOS
                             "There is a valid pointer at the given address. Render target (*ppRenderTarget) must be nullptr." );
 
                 RenderTarget* pRenderTarget = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &pRenderTarget ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pRenderTarget ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -189,6 +303,180 @@ namespace BIGOS
                 Memory::FreeObject( m_pDefaultAllocator, &pRenderTarget );
             }
 
+            RESULT RenderSystem::CreateTransientResourcePool( const TransientResourcePoolDesc& desc, TransientResourcePool** ppPool )
+            {
+                BGS_ASSERT( ppPool != nullptr, "Transient resource pool (ppPool) must be a valid address." );
+                BGS_ASSERT( *ppPool == nullptr, "There is a valid pointer at the given address. Transient resource pool (*ppPool) must be nullptr." );
+
+                TransientResourcePool* pPool = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pPool ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                if( BGS_FAILED( pPool->Create( desc, this ) ) )
+                {
+                    Memory::FreeObject( m_pDefaultAllocator, &pPool );
+                    return Results::FAIL;
+                }
+
+                ( *ppPool ) = pPool;
+
+                return Results::OK;
+            }
+
+            void RenderSystem::DestroyTransientResourcePool( TransientResourcePool** ppPool )
+            {
+                BGS_ASSERT( ppPool != nullptr, "Transient resource pool (ppPool) must be a valid address." );
+                BGS_ASSERT( *ppPool != nullptr, "Transient resource pool (*ppPool) must be a valid pointer." );
+
+                TransientResourcePool* pPool = ( *ppPool );
+                pPool->Destroy();
+                Memory::FreeObject( m_pDefaultAllocator, &pPool );
+            }
+
+            RESULT RenderSystem::CreateResidencyManager( const ResidencyManagerDesc& desc, ResidencyManager** ppManager )
+            {
+                BGS_ASSERT( ppManager != nullptr, "Residency manager (ppManager) must be a valid address." );
+                BGS_ASSERT( *ppManager == nullptr, "There is a valid pointer at the given address. Residency manager (*ppManager) must be nullptr." );
+
+                ResidencyManager* pManager = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pManager ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                if( BGS_FAILED( pManager->Create( desc, this ) ) )
+                {
+                    Memory::FreeObject( m_pDefaultAllocator, &pManager );
+                    return Results::FAIL;
+                }
+
+                ( *ppManager ) = pManager;
+
+                return Results::OK;
+            }
+
+            void RenderSystem::DestroyResidencyManager( ResidencyManager** ppManager )
+            {
+                BGS_ASSERT( ppManager != nullptr, "Residency manager (ppManager) must be a valid address." );
+                BGS_ASSERT( *ppManager != nullptr, "Residency manager (*ppManager) must be a valid pointer." );
+
+                ResidencyManager* pManager = ( *ppManager );
+                pManager->Destroy();
+                Memory::FreeObject( m_pDefaultAllocator, &pManager );
+            }
+
+            RESULT RenderSystem::CreateTextureStreamer( const TextureStreamerDesc& desc, TextureStreamer** ppStreamer )
+            {
+                BGS_ASSERT( ppStreamer != nullptr, "Texture streamer (ppStreamer) must be a valid address." );
+                BGS_ASSERT( *ppStreamer == nullptr,
+                            "There is a valid pointer at the given address. Texture streamer (*ppStreamer) must be nullptr." );
+
+                TextureStreamer* pStreamer = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pStreamer ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                if( BGS_FAILED( pStreamer->Create( desc, this ) ) )
+                {
+                    Memory::FreeObject( m_pDefaultAllocator, &pStreamer );
+                    return Results::FAIL;
+                }
+
+                ( *ppStreamer ) = pStreamer;
+
+                return Results::OK;
+            }
+
+            void RenderSystem::DestroyTextureStreamer( TextureStreamer** ppStreamer )
+            {
+                BGS_ASSERT( ppStreamer != nullptr, "Texture streamer (ppStreamer) must be a valid address." );
+                BGS_ASSERT( *ppStreamer != nullptr, "Texture streamer (*ppStreamer) must be a valid pointer." );
+
+                TextureStreamer* pStreamer = ( *ppStreamer );
+                pStreamer->Destroy();
+                Memory::FreeObject( m_pDefaultAllocator, &pStreamer );
+            }
+
+            RESULT RenderSystem::CreateBindlessTable( const BindlessTableDesc& desc, BindlessTable** ppTable )
+            {
+                BGS_ASSERT( ppTable != nullptr, "Bindless table (ppTable) must be a valid address." );
+                BGS_ASSERT( *ppTable == nullptr, "There is a valid pointer at the given address. Bindless table (*ppTable) must be nullptr." );
+
+                BindlessTable* pTable = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pTable ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                if( BGS_FAILED( pTable->Create( desc, this ) ) )
+                {
+                    Memory::FreeObject( m_pDefaultAllocator, &pTable );
+                    return Results::FAIL;
+                }
+
+                ( *ppTable ) = pTable;
+
+                return Results::OK;
+            }
+
+            void RenderSystem::DestroyBindlessTable( BindlessTable** ppTable )
+            {
+                BGS_ASSERT( ppTable != nullptr, "Bindless table (ppTable) must be a valid address." );
+                BGS_ASSERT( *ppTable != nullptr, "Bindless table (*ppTable) must be a valid pointer." );
+
+                BindlessTable* pTable = ( *ppTable );
+                pTable->Destroy();
+                Memory::FreeObject( m_pDefaultAllocator, &pTable );
+            }
+
+            RESULT RenderSystem::CreateTransientBindingHeap( const TransientBindingHeapDesc& desc, TransientBindingHeap** ppHeap )
+            {
+                BGS_ASSERT( ppHeap != nullptr, "Transient binding heap (ppHeap) must be a valid address." );
+                BGS_ASSERT( *ppHeap == nullptr,
+                            "There is a valid pointer at the given address. Transient binding heap (*ppHeap) must be nullptr." );
+
+                TransientBindingHeap* pHeap = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pHeap ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                if( BGS_FAILED( pHeap->Create( desc, this ) ) )
+                {
+                    Memory::FreeObject( m_pDefaultAllocator, &pHeap );
+                    return Results::FAIL;
+                }
+
+                ( *ppHeap ) = pHeap;
+
+                return Results::OK;
+            }
+
+            void RenderSystem::DestroyTransientBindingHeap( TransientBindingHeap** ppHeap )
+            {
+                BGS_ASSERT( ppHeap != nullptr, "Transient binding heap (ppHeap) must be a valid address." );
+                BGS_ASSERT( *ppHeap != nullptr, "Transient binding heap (*ppHeap) must be a valid pointer." );
+
+                TransientBindingHeap* pHeap = ( *ppHeap );
+                pHeap->Destroy();
+                Memory::FreeObject( m_pDefaultAllocator, &pHeap );
+            }
+
+            RESULT RenderSystem::GetMemoryBudget( Backend::MemoryBudgetInfo* pInfo )
+            {
+                BGS_ASSERT( pInfo != nullptr, "Memory budget info (pInfo) must be a valid address." );
+                BGS_ASSERT( m_pDevice != nullptr, "Driver has to be initialized before querying memory budget." );
+                if( ( pInfo == nullptr ) || ( m_pDevice == nullptr ) )
+                {
+                    return Results::FAIL;
+                }
+
+                return m_pDevice->QueryMemoryBudget( pInfo );
+            }
+
             RESULT RenderSystem::CreateRenderPass( const RenderPassDesc& desc, RenderPass** ppRenderPass )
             {
                 BGS_ASSERT( ppRenderPass != nullptr, "Render pass (ppRenderPass) must be a valid address." );
@@ -196,7 +484,7 @@ namespace BIGOS
                             "There is a valid pointer at the given address. Render target (*ppRenderPass) must be nullptr." );
 
                 RenderPass* pRenderPass = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &pRenderPass ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pRenderPass ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -228,7 +516,7 @@ namespace BIGOS
                 BGS_ASSERT( *ppShader == nullptr, "There is a valid pointer at the given address. Shader (*ppShader) must be nullptr." );
 
                 Shader* pShader = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &pShader ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pShader ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -254,13 +542,46 @@ namespace BIGOS
                 Memory::FreeObject( m_pDefaultAllocator, &pShader );
             }
 
+            RESULT RenderSystem::CreateAsyncShaderCompiler( const AsyncShaderCompilerDesc& desc, AsyncShaderCompiler** ppCompiler )
+            {
+                BGS_ASSERT( ppCompiler != nullptr, "Async shader compiler (ppCompiler) must be a valid address." );
+                BGS_ASSERT( *ppCompiler == nullptr,
+                            "There is a valid pointer at the given address. Async shader compiler (*ppCompiler) must be nullptr." );
+
+                AsyncShaderCompiler* pCompiler = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pCompiler ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                if( BGS_FAILED( pCompiler->Create( desc, this ) ) )
+                {
+                    Memory::FreeObject( m_pDefaultAllocator, &pCompiler );
+                    return Results::FAIL;
+                }
+
+                ( *ppCompiler ) = pCompiler;
+
+                return Results::OK;
+            }
+
+            void RenderSystem::DestroyAsyncShaderCompiler( AsyncShaderCompiler** ppCompiler )
+            {
+                BGS_ASSERT( ppCompiler != nullptr, "Async shader compiler (ppCompiler) must be a valid address." );
+                BGS_ASSERT( *ppCompiler != nullptr, "Async shader compiler (*ppCompiler) must be a valid pointer." );
+
+                AsyncShaderCompiler* pCompiler = ( *ppCompiler );
+                pCompiler->Destroy();
+                Memory::FreeObject( m_pDefaultAllocator, &pCompiler );
+            }
+
             RESULT RenderSystem::CreatePipeline( const GraphicsPipelineDesc& desc, Pipeline** ppPipeline )
             {
                 BGS_ASSERT( ppPipeline != nullptr, "Pipeline (ppPipeline) must be a valid address." );
                 BGS_ASSERT( *ppPipeline == nullptr, "There is a valid pointer at the given address. Pipeline (*ppPipeline) must be nullptr." );
 
                 Pipeline* pPipeline = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &pPipeline ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pPipeline ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -282,7 +603,7 @@ namespace BIGOS
                 BGS_ASSERT( *ppPipeline == nullptr, "There is a valid pointer at the given address. Pipeline (*ppPipeline) must be nullptr." );
 
                 Pipeline* pPipeline = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &pPipeline ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pPipeline ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -314,7 +635,7 @@ namespace BIGOS
                 BGS_ASSERT( *ppSwapchain == nullptr, "There is a valid pointer at the given address. Swapchain (*ppSwapchain) must be nullptr." );
 
                 Swapchain* pSwapchain = nullptr;
-                if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &pSwapchain ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pSwapchain ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -344,6 +665,12 @@ namespace BIGOS
             {
                 BGS_ASSERT( ppCamera != nullptr, "Camera (ppCamera) must be a valid address." );
 
+                // Fails only when MAX_CAMERA_COUNT cameras are registered
+                if( BGS_FAILED( m_cameras.reserve( m_cameras.size() + 1 ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+
                 Camera* pCamera = ( *ppCamera );
                 if( pCamera != nullptr )
                 {
@@ -363,7 +690,7 @@ namespace BIGOS
                 }
                 else
                 {
-                    if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &pCamera ) ) )
+                    if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pCamera ) ) )
                     {
                         return Results::NO_MEMORY;
                     }
@@ -414,6 +741,24 @@ namespace BIGOS
                 m_desc              = desc;
                 m_pDefaultAllocator = pAllocator;
                 m_pParent           = pEngine;
+                m_adapters.SetAllocator( m_pDefaultAllocator );
+                if( BGS_FAILED( m_cameras.Create( Config::Driver::Camera::MAX_CAMERA_COUNT ) ) )
+                {
+                    Destroy();
+                    return Results::NO_MEMORY;
+                }
+
+                // Small backend objects (resources, views, samplers...) are created and destroyed at high rate, keep them away from the
+                // general heap.
+                Memory::AllocatorDesc objectAllocatorDesc;
+                objectAllocatorDesc.type     = Memory::AllocatorTypes::POOL;
+                objectAllocatorDesc.capacity = 0;
+                objectAllocatorDesc.pParent  = &m_pParent->GetMemorySystem();
+                if( BGS_FAILED( m_pParent->GetMemorySystem().CreateAllocator( objectAllocatorDesc, &m_pObjectAllocator ) ) )
+                {
+                    Destroy();
+                    return Results::FAIL;
+                }
 
                 if( BGS_FAILED( CreateShaderCompilerFactory( desc.compilerFactoryDesc, &m_pShaderCompilerFactory ) ) )
                 {
@@ -437,16 +782,25 @@ namespace BIGOS
                 FreeDriver();
                 DestroyContexts();
 
-                for( index_t ndx = 0; ndx < m_cameras.size(); ++ndx )
+                // DestroyCamera() moves last camera in place of destroyed one
+                while( !m_cameras.empty() )
                 {
-                    DestroyCamera( &m_cameras[ ndx ] );
+                    Camera* pCamera = m_cameras.back();
+                    DestroyCamera( &pCamera );
                 }
+                m_cameras.Destroy();
 
                 if( m_pShaderCompilerFactory != nullptr )
                 {
                     DestroyShaderCompilerFactory( &m_pShaderCompilerFactory );
                 }
                 m_adapters.clear();
+                m_adapters.shrink_to_fit();
+
+                if( m_pObjectAllocator != nullptr )
+                {
+                    m_pParent->GetMemorySystem().DestroyAllocator( &m_pObjectAllocator );
+                }
 
                 m_pDefaultAllocator = nullptr;
                 m_pParent           = nullptr;
@@ -471,7 +825,7 @@ namespace BIGOS
                 if( apiType == Backend::APITypes::VULKAN )
                 {
                     Backend::VulkanFactory* pFactory = nullptr;
-                    if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &pFactory ) ) )
+                    if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pFactory ) ) )
                     {
                         return Results::NO_MEMORY;
                     }
@@ -487,7 +841,7 @@ namespace BIGOS
                 else if( apiType == Backend::APITypes::D3D12 )
                 {
                     Backend::D3D12Factory* pFactory = nullptr;
-                    if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &pFactory ) ) )
+                    if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pFactory ) ) )
                     {
                         return Results::NO_MEMORY;
                     }
@@ -546,7 +900,7 @@ namespace BIGOS
             {
                 BGS_ASSERT( m_pDevice != nullptr );
                 BGS_ASSERT( m_pGraphicsContext == nullptr );
-                if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &m_pGraphicsContext ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &m_pGraphicsContext ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -557,7 +911,7 @@ namespace BIGOS
                 }
 
                 BGS_ASSERT( m_pComputeContext == nullptr );
-                if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &m_pComputeContext ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &m_pComputeContext ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -569,7 +923,7 @@ namespace BIGOS
                 }
 
                 BGS_ASSERT( m_pCopyContext == nullptr );
-                if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &m_pCopyContext ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &m_pCopyContext ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -617,7 +971,7 @@ namespace BIGOS
                     return Results::OK;
                 }
 
-                if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &m_pShaderCompilerFactory ) ) )
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &m_pShaderCompilerFactory ) ) )
                 {
                     return Results::NO_MEMORY;
                 }
@@ -645,20 +999,94 @@ namespace BIGOS
                 }
             }
 
+            void RenderSystem::LoadPipelineCache( HeapArray<byte_t>* pData )
+            {
+                if( m_driverDesc.pPipelineCachePath == nullptr )
+                {
+                    return;
+                }
+
+                std::ifstream file( m_driverDesc.pPipelineCachePath, std::ios::binary | std::ios::ate );
+                if( !file.is_open() )
+                {
+                    return;
+                }
+
+                const std::streamoff size = file.tellg();
+                if( size <= 0 )
+                {
+                    return;
+                }
+
+                pData->resize( static_cast<size_t>( size ) );
+                file.seekg( 0, std::ios::beg );
+                if( !file.read( reinterpret_cast<char*>( pData->data() ), size ) )
+                {
+                    pData->clear();
+                }
+            }
+
+            void RenderSystem::SavePipelineCache()
+            {
+                if( ( m_driverDesc.pPipelineCachePath == nullptr ) || ( m_pDevice == nullptr ) )
+                {
+                    return;
+                }
+
+                uint64_t size = 0;
+                if( BGS_FAILED( m_pDevice->GetPipelineCacheData( nullptr, &size ) ) )
+                {
+                    return;
+                }
+
+                HeapArray<byte_t> data( static_cast<size_t>( size ) );
+                if( BGS_FAILED( m_pDevice->GetPipelineCacheData( data.data(), &size ) ) )
+                {
+                    return;
+                }
+
+                // Partially written file is rejected by device on next load
+                std::ofstream file( m_driverDesc.pPipelineCachePath, std::ios::binary | std::ios::trunc );
+                if( file.is_open() )
+                {
+                    file.write( reinterpret_cast<const char*>( data.data() ), static_cast<std::streamsize>( size ) );
+                }
+            }
+
             void RenderSystem::FreeDriver()
             {
                 // TODO: Wait all
+                if( m_pDefragmenter != nullptr )
+                {
+                    m_pDefragmenter->Destroy();
+                    Memory::FreeObject( m_pDefaultAllocator, &m_pDefragmenter );
+                }
+
+                DestroyContexts();
+
+                // Views of all buffers and textures have to be released by now
+                if( m_pBindingObjectCache != nullptr )
+                {
+                    m_pBindingObjectCache->Destroy();
+                    Memory::FreeObject( m_pDefaultAllocator, &m_pBindingObjectCache );
+                }
+
+                if( m_pDeviceMemorySystem != nullptr )
+                {
+                    m_pDeviceMemorySystem->Destroy();
+                    Memory::FreeObject( m_pDefaultAllocator, &m_pDeviceMemorySystem );
+                }
+
                 if( m_pSyncSystem != nullptr )
                 {
                     m_pSyncSystem->Destroy();
                     Memory::FreeObject( m_pDefaultAllocator, &m_pSyncSystem );
                 }
 
-                DestroyContexts();
-
                 // Free all the resources created on this device
                 if( m_pDevice != nullptr )
                 {
+                    SavePipelineCache();
                     m_pFactory->DestroyDevice( &m_pDevice );
                 }
 
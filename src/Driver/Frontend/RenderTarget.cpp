@@ -1,6 +1,7 @@
 #include "Driver/Frontend/RenderTarget.h"
 
 #include "Driver/Backend/APICommon.h"
+#include "Driver/Frontend/BindingObjectCache.h"
 #include "Driver/Frontend/RenderSystem.h"
 
 namespace BIGOS
@@ -13,7 +14,7 @@ namespace BIGOS
                 : m_desc()
                 , m_targetDesc()
                 , m_pParent( nullptr )
-                , m_hMemory()
+                , m_memory()
                 , m_hResource()
                 , m_hView()
                 , m_hSampleView()
@@ -23,9 +24,10 @@ namespace BIGOS
             RESULT RenderTarget::Create( const RenderTargetDesc& desc, RenderSystem* pSystem )
             {
                 BGS_ASSERT( pSystem != nullptr, "Render device (pSystem) must be a valid pointer." );
-                m_pParent                    = pSystem;
-                m_desc                       = desc;
-                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
+                m_pParent                      = pSystem;
+                m_desc                         = desc;
+                Backend::IDevice*   pAPIDevice = m_pParent->GetDevice();
+                BindingObjectCache* pViewCache = m_pParent->GetBindingObjectCache();
 
                 const bool isDepthStencil = Backend::IsDepthStencilFormat( m_desc.format ) || Backend::IsDepthFormat( m_desc.format );
 
@@ -38,6 +40,7 @@ namespace BIGOS
                 m_targetDesc.resourceType    = Backend::ResourceTypes::TEXTURE_2D;
                 m_targetDesc.resourceLayout  = Backend::ResourceLayouts::OPTIMAL;
                 m_targetDesc.sharingMode     = Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+                m_targetDesc.flags           = BGS_FLAG( Backend::ResourceFlagBits::NONE );
                 m_targetDesc.sampleCount     = m_desc.sampleCount;
                 if( isDepthStencil )
                 {
@@ -62,23 +65,8 @@ namespace BIGOS
                     return Results::FAIL;
                 }
 
-                Backend::ResourceAllocationInfo allocInf;
-                pAPIDevice->GetResourceAllocationInfo( m_hResource, &allocInf );
-                Backend::AllocateMemoryDesc allocDesc;
-                allocDesc.size      = allocInf.size;
-                allocDesc.alignment = allocInf.alignment;
-                allocDesc.heapType  = Backend::MemoryHeapTypes::DEFAULT;
-                allocDesc.heapUsage = Backend::MemoryHeapUsages::RENDER_TARGETS;
-                if( BGS_FAILED( pAPIDevice->AllocateMemory( allocDesc, &m_hMemory ) ) )
-                {
-                    Destroy();
-                    return Results::FAIL;
-                }
-                Backend::BindResourceMemoryDesc bindMemDesc;
-                bindMemDesc.hMemory      = m_hMemory;
-                bindMemDesc.hResource    = m_hResource;
-                bindMemDesc.memoryOffset = 0;
-                if( BGS_FAILED( pAPIDevice->BindResourceMemory( bindMemDesc ) ) )
+                if( BGS_FAILED( m_pParent->GetDeviceMemorySystem()->AllocateAndBind( m_hResource, Backend::MemoryHeapTypes::DEFAULT,
+                                                                                     Backend::MemoryHeapUsages::RENDER_TARGETS, &m_memory ) ) )
                 {
                     Destroy();
                     return Results::FAIL;
@@ -111,7 +99,7 @@ namespace BIGOS
                 viewDesc.range.arrayLayer      = 0;
                 viewDesc.range.arrayLayerCount = 1;
                 viewDesc.hResource             = m_hResource;
-                if( BGS_FAILED( pAPIDevice->CreateResourceView( viewDesc, &m_hView ) ) )
+                if( BGS_FAILED( pViewCache->CreateResourceView( viewDesc, &m_hView ) ) )
                 {
                     Destroy();
                     return Results::FAIL;
@@ -120,7 +108,7 @@ namespace BIGOS
                 if( m_desc.allowSampling )
                 {
                     viewDesc.usage = BGS_FLAG( Backend::ResourceViewUsageFlagBits::SAMPLED_TEXTURE );
-                    if( BGS_FAILED( pAPIDevice->CreateResourceView( viewDesc, &m_hSampleView ) ) )
+                    if( BGS_FAILED( pViewCache->CreateResourceView( viewDesc, &m_hSampleView ) ) )
                     {
                         Destroy();
                         return Results::FAIL;
@@ -132,24 +120,25 @@ namespace BIGOS
 
             void RenderTarget::Destroy()
             {
-                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
+                Backend::IDevice*   pAPIDevice = m_pParent->GetDevice();
+                BindingObjectCache* pViewCache = m_pParent->GetBindingObjectCache();
 
                 if( m_hSampleView != Backend::ResourceViewHandle() )
                 {
-                    pAPIDevice->DestroyResourceView( &m_hSampleView );
+                    pViewCache->ReleaseResourceView( &m_hSampleView );
                 }
                 if( m_hView != Backend::ResourceViewHandle() )
                 {
-                    pAPIDevice->DestroyResourceView( &m_hView );
-                }
-                if( m_hMemory != Backend::MemoryHandle() )
-                {
-                    pAPIDevice->FreeMemory( &m_hMemory );
+                    pViewCache->ReleaseResourceView( &m_hView );
                 }
                 if( m_hResource != Backend::ResourceHandle() )
                 {
                     pAPIDevice->DestroyResource( &m_hResource );
                 }
+                if( m_memory.hMemory != Backend::MemoryHandle() )
+                {
+                    m_pParent->GetDeviceMemorySystem()->Free( &m_memory );
+                }
             }
 
         } // namespace Frontend
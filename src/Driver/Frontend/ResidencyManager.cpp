@@ -0,0 +1,313 @@
+#include "Driver/Frontend/ResidencyManager.h"
+
+#include "Driver/Frontend/Buffer.h"
+#include "Driver/Frontend/DeviceMemoryDefragmenter.h"
+#include "Driver/Frontend/DeviceMemorySystem.h"
+#include "Driver/Frontend/RenderSystem.h"
+#include "Driver/Frontend/Texture.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+
+            ResidencyManager::ResidencyManager()
+                : m_desc()
+                , m_pParent( nullptr )
+                , m_entries()
+                , m_freeEntries()
+                , m_frames()
+                , m_firstFrame( 0 )
+                , m_frameCount( 0 )
+                , m_head( INVALID_POSITION )
+                , m_tail( INVALID_POSITION )
+                , m_frame( 1 )
+                , m_completedFrame( 0 )
+                , m_budget()
+                , m_residentSize( 0 )
+                , m_evictedSize( 0 )
+            {
+            }
+
+            RESULT ResidencyManager::AddBuffer( Buffer* pBuffer, index_t* pIndex )
+            {
+                BGS_ASSERT( pBuffer != nullptr, "Buffer (pBuffer) must be a valid pointer." );
+                if( pBuffer == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                return AddEntry( pBuffer, nullptr, pIndex );
+            }
+
+            RESULT ResidencyManager::AddTexture( Texture* pTexture, index_t* pIndex )
+            {
+                BGS_ASSERT( pTexture != nullptr, "Texture (pTexture) must be a valid pointer." );
+                if( pTexture == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                return AddEntry( nullptr, pTexture, pIndex );
+            }
+
+            void ResidencyManager::Remove( index_t ndx )
+            {
+                BGS_ASSERT( ndx < m_entries.size(), "Index (ndx) out of range." );
+                Entry& entry = m_entries[ ndx ];
+                if( entry.isResident )
+                {
+                    Unlink( ndx );
+                    m_residentSize -= entry.size;
+                }
+                entry.pBuffer    = nullptr;
+                entry.pTexture   = nullptr;
+                entry.isResident = BGS_FALSE;
+                m_freeEntries.push_back( ndx );
+            }
+
+            void ResidencyManager::MarkUsed( index_t ndx )
+            {
+                BGS_ASSERT( ndx < m_entries.size(), "Index (ndx) out of range." );
+                BGS_ASSERT( m_entries[ ndx ].isResident, "Evicted resource can not be used, make it resident first." );
+                m_entries[ ndx ].lastUsedFrame = m_frame;
+                if( m_head != ndx )
+                {
+                    Unlink( ndx );
+                    Link( ndx );
+                }
+            }
+
+            RESULT ResidencyManager::MakeResident( index_t ndx )
+            {
+                BGS_ASSERT( ndx < m_entries.size(), "Index (ndx) out of range." );
+                Entry& entry = m_entries[ ndx ];
+                if( entry.isResident )
+                {
+                    return Results::OK;
+                }
+
+                // Objects were destroyed in place, so they are created again from their own desc
+                DeviceMemoryDefragmenter* pDefragmenter = m_pParent->GetDefragmenter();
+                if( entry.pBuffer != nullptr )
+                {
+                    if( BGS_FAILED( entry.pBuffer->Create( entry.pBuffer->m_desc, m_pParent ) ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+                    entry.size = entry.pBuffer->m_memory.size;
+                    if( entry.isMovable )
+                    {
+                        pDefragmenter->RegisterBuffer( entry.pBuffer );
+                    }
+                }
+                else
+                {
+                    if( BGS_FAILED( entry.pTexture->Create( entry.pTexture->m_desc, m_pParent ) ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+                    entry.size = entry.pTexture->m_memory.size;
+                    if( entry.isMovable )
+                    {
+                        pDefragmenter->RegisterTexture( entry.pTexture );
+                    }
+                }
+
+                entry.isResident    = BGS_TRUE;
+                entry.lastUsedFrame = m_frame;
+                m_residentSize += entry.size;
+                Link( ndx );
+
+                return Results::OK;
+            }
+
+            RESULT ResidencyManager::Update( const SyncPoint& framePoint )
+            {
+                SyncSystem* pSyncSystem = m_pParent->GetSyncSystem();
+
+                // Points signal in order, so dropping oldest one only delays noticing it
+                if( m_frameCount == Config::Driver::Memory::MAX_RESIDENCY_FRAME_COUNT )
+                {
+                    m_firstFrame = ( m_firstFrame + 1 ) % Config::Driver::Memory::MAX_RESIDENCY_FRAME_COUNT;
+                    m_frameCount--;
+                }
+                FramePoint& frame = m_frames[ ( m_firstFrame + m_frameCount ) % Config::Driver::Memory::MAX_RESIDENCY_FRAME_COUNT ];
+                frame.frame       = m_frame;
+                frame.point       = framePoint;
+                m_frameCount++;
+                m_frame++;
+
+                while( m_frameCount > 0 )
+                {
+                    const FramePoint& oldest = m_frames[ m_firstFrame ];
+                    if( !pSyncSystem->IsCompleted( oldest.point ) )
+                    {
+                        break;
+                    }
+                    m_completedFrame = oldest.frame;
+                    m_firstFrame     = ( m_firstFrame + 1 ) % Config::Driver::Memory::MAX_RESIDENCY_FRAME_COUNT;
+                    m_frameCount--;
+                }
+
+                if( BGS_FAILED( m_pParent->GetMemoryBudget( &m_budget ) ) )
+                {
+                    return Results::FAIL;
+                }
+
+                const Backend::MemorySegmentBudget& local = m_budget.segments[ BGS_ENUM_INDEX( Backend::MemorySegmentTypes::LOCAL ) ];
+
+                const uint64_t limit = static_cast<uint64_t>( static_cast<double>( local.budget ) * static_cast<double>( m_desc.maxBudgetUsage ) );
+                if( m_residentSize <= limit )
+                {
+                    return Results::OK;
+                }
+
+                // Eviction is spread over frames, so a single spike does not drain everything at once
+                const uint64_t excess     = m_residentSize - limit;
+                const uint64_t maxEvicted = excess < m_desc.maxEvictionPerFrame ? excess : m_desc.maxEvictionPerFrame;
+                uint64_t       evicted    = 0;
+                index_t        ndx        = m_tail;
+                while( ( ndx != INVALID_POSITION ) && ( evicted < maxEvicted ) )
+                {
+                    const Entry& entry = m_entries[ ndx ];
+                    if( entry.lastUsedFrame > m_completedFrame )
+                    {
+                        break;
+                    }
+                    const index_t prev = entry.prev;
+                    evicted += entry.size;
+                    Evict( ndx );
+                    ndx = prev;
+                }
+
+                return Results::OK;
+            }
+
+            RESULT ResidencyManager::Create( const ResidencyManagerDesc& desc, RenderSystem* pSystem )
+            {
+                BGS_ASSERT( pSystem != nullptr, "Render system (pSystem) must be a valid pointer." );
+                BGS_ASSERT( ( desc.maxBudgetUsage > 0.0f ) && ( desc.maxBudgetUsage <= 1.0f ),
+                            "Budget usage (desc.maxBudgetUsage) must be in range (0, 1]." );
+                m_pParent = pSystem;
+                m_desc    = desc;
+
+                m_entries.SetAllocator( m_pParent->GetDefaultAllocator() );
+                m_freeEntries.SetAllocator( m_pParent->GetDefaultAllocator() );
+
+                return m_pParent->GetMemoryBudget( &m_budget );
+            }
+
+            void ResidencyManager::Destroy()
+            {
+                m_entries.clear();
+                m_entries.shrink_to_fit();
+                m_freeEntries.clear();
+                m_freeEntries.shrink_to_fit();
+
+                m_head         = INVALID_POSITION;
+                m_tail         = INVALID_POSITION;
+                m_residentSize = 0;
+            }
+
+            RESULT ResidencyManager::AddEntry( Buffer* pBuffer, Texture* pTexture, index_t* pIndex )
+            {
+                BGS_ASSERT( pIndex != nullptr, "Index (pIndex) must be a valid address." );
+                if( pIndex == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                index_t ndx = 0;
+                if( m_freeEntries.empty() )
+                {
+                    ndx = m_entries.size();
+                    m_entries.push_back( Entry() );
+                }
+                else
+                {
+                    ndx = m_freeEntries.back();
+                    m_freeEntries.pop_back();
+                }
+
+                Entry& entry        = m_entries[ ndx ];
+                entry.pBuffer       = pBuffer;
+                entry.pTexture      = pTexture;
+                entry.size          = ( pBuffer != nullptr ) ? pBuffer->m_memory.size : pTexture->m_memory.size;
+                entry.lastUsedFrame = m_frame;
+                entry.isResident    = BGS_TRUE;
+                entry.isMovable     = BGS_FALSE;
+                m_residentSize += entry.size;
+                Link( ndx );
+
+                *pIndex = ndx;
+
+                return Results::OK;
+            }
+
+            void ResidencyManager::Evict( index_t ndx )
+            {
+                Entry&                    entry         = m_entries[ ndx ];
+                DeviceMemoryDefragmenter* pDefragmenter = m_pParent->GetDefragmenter();
+
+                Unlink( ndx );
+                // Defragmenter waits for a copy that may still read the resource
+                if( entry.pBuffer != nullptr )
+                {
+                    entry.isMovable = pDefragmenter->UnregisterBuffer( entry.pBuffer );
+                    entry.pBuffer->Destroy();
+                }
+                else
+                {
+                    entry.isMovable = pDefragmenter->UnregisterTexture( entry.pTexture );
+                    entry.pTexture->Destroy();
+                    entry.pTexture->m_state = ResourceState();
+                }
+
+                entry.isResident = BGS_FALSE;
+                m_residentSize -= entry.size;
+                m_evictedSize += entry.size;
+            }
+
+            void ResidencyManager::Link( index_t ndx )
+            {
+                Entry& entry = m_entries[ ndx ];
+                entry.prev   = INVALID_POSITION;
+                entry.next   = m_head;
+                if( m_head != INVALID_POSITION )
+                {
+                    m_entries[ m_head ].prev = ndx;
+                }
+                m_head = ndx;
+                if( m_tail == INVALID_POSITION )
+                {
+                    m_tail = ndx;
+                }
+            }
+
+            void ResidencyManager::Unlink( index_t ndx )
+            {
+                const Entry& entry = m_entries[ ndx ];
+                if( entry.prev != INVALID_POSITION )
+                {
+                    m_entries[ entry.prev ].next = entry.next;
+                }
+                else
+                {
+                    m_head = entry.next;
+                }
+                if( entry.next != INVALID_POSITION )
+                {
+                    m_entries[ entry.next ].prev = entry.prev;
+                }
+                else
+                {
+                    m_tail = entry.prev;
+                }
+            }
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
@@ -0,0 +1,263 @@
+#include "Driver/Frontend/Shader/AsyncShaderCompiler.h"
+
+#include "Core/Memory/IAllocator.h"
+#include "Core/Memory/Memory.h"
+#include "Driver/Frontend/RenderSystem.h"
+#include "Driver/Frontend/Shader/IShaderCompiler.h"
+#include "Driver/Frontend/Shader/Shader.h"
+#include "ShaderCompilerFactory.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+
+            AsyncShaderCompiler::AsyncShaderCompiler()
+                : m_desc()
+                , m_pParent( nullptr )
+                , m_jobs()
+                , m_freeJobs()
+                , m_pendingJobs()
+                , m_pendingHead( 0 )
+                , m_workers()
+                , m_compilers()
+                , m_mutex()
+                , m_pendingCondition()
+                , m_doneCondition()
+                , m_isStopping( BGS_FALSE )
+            {
+            }
+
+            RESULT AsyncShaderCompiler::CompileShader( const ShaderDesc& desc, index_t* pIndex )
+            {
+                BGS_ASSERT( pIndex != nullptr, "Index (pIndex) must be a valid address." );
+                BGS_ASSERT( desc.source.pSourceCode != nullptr, "Shader source (desc.source.pSourceCode) must be a valid pointer." );
+                if( ( pIndex == nullptr ) || ( desc.source.pSourceCode == nullptr ) )
+                {
+                    return Results::FAIL;
+                }
+
+                Shader* pShader = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetDefaultAllocator(), &pShader ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+                pShader->SetCompileDesc( desc, m_pParent );
+
+                Job job;
+                job.pShader = pShader;
+                job.result  = Results::FAIL;
+                job.isUsed  = BGS_TRUE;
+                job.isDone  = BGS_FALSE;
+                {
+                    std::lock_guard<Mutex> lock( m_mutex );
+                    index_t                ndx;
+                    if( m_freeJobs.empty() )
+                    {
+                        ndx = m_jobs.size();
+                        m_jobs.push_back( job );
+                    }
+                    else
+                    {
+                        ndx = m_freeJobs.back();
+                        m_freeJobs.pop_back();
+                        m_jobs[ ndx ] = job;
+                    }
+                    m_pendingJobs.push_back( ndx );
+                    *pIndex = ndx;
+                }
+                m_pendingCondition.notify_one();
+
+                return Results::OK;
+            }
+
+            bool_t AsyncShaderCompiler::IsReady( index_t ndx )
+            {
+                std::lock_guard<Mutex> lock( m_mutex );
+                BGS_ASSERT( ( ndx < m_jobs.size() ) && m_jobs[ ndx ].isUsed, "Index (ndx) must be returned by CompileShader()." );
+
+                return m_jobs[ ndx ].isDone;
+            }
+
+            RESULT AsyncShaderCompiler::GetShader( index_t ndx, Shader** ppShader )
+            {
+                BGS_ASSERT( ppShader != nullptr, "Shader (ppShader) must be a valid address." );
+                BGS_ASSERT( *ppShader == nullptr, "There is a valid pointer at the given address. Shader (*ppShader) must be nullptr." );
+                if( ( ppShader == nullptr ) || ( *ppShader != nullptr ) )
+                {
+                    return Results::FAIL;
+                }
+
+                Shader* pShader = nullptr;
+                RESULT  result  = Results::FAIL;
+                {
+                    std::unique_lock<Mutex> lock( m_mutex );
+                    BGS_ASSERT( ( ndx < m_jobs.size() ) && m_jobs[ ndx ].isUsed, "Index (ndx) must be returned by CompileShader()." );
+                    if( ( ndx >= m_jobs.size() ) || !m_jobs[ ndx ].isUsed )
+                    {
+                        return Results::NOT_FOUND;
+                    }
+                    while( !m_jobs[ ndx ].isDone )
+                    {
+                        m_doneCondition.wait( lock );
+                    }
+
+                    Job& job = m_jobs[ ndx ];
+                    pShader  = job.pShader;
+                    result   = job.result;
+
+                    job.pShader = nullptr;
+                    job.isUsed  = BGS_FALSE;
+                    m_freeJobs.push_back( ndx );
+                }
+
+                if( BGS_SUCCESS( result ) )
+                {
+                    result = pShader->CreateBackendShader();
+                }
+                if( BGS_FAILED( result ) )
+                {
+                    pShader->Destroy();
+                    Memory::FreeObject( m_pParent->GetDefaultAllocator(), &pShader );
+                    return Results::FAIL;
+                }
+
+                *ppShader = pShader;
+
+                return Results::OK;
+            }
+
+            RESULT AsyncShaderCompiler::Create( const AsyncShaderCompilerDesc& desc, RenderSystem* pSystem )
+            {
+                BGS_ASSERT( pSystem != nullptr, "Render system (pSystem) must be a valid pointer." );
+                if( pSystem == nullptr )
+                {
+                    return Results::FAIL;
+                }
+                m_desc    = desc;
+                m_pParent = pSystem;
+                m_jobs.SetAllocator( m_pParent->GetDefaultAllocator() );
+                m_freeJobs.SetAllocator( m_pParent->GetDefaultAllocator() );
+
+                uint32_t workerCount = m_desc.workerCount;
+                if( workerCount == 0 )
+                {
+                    // Can return 0, if it is not known
+                    workerCount = std::thread::hardware_concurrency();
+                    workerCount = workerCount > 0 ? workerCount : 1;
+                }
+
+                ShaderCompilerFactory* pFactory = m_pParent->GetShaderCompilerFactory();
+                ShaderCompilerDesc     compDesc;
+                compDesc.type = m_pParent->GetDefaultCompiler()->GetDesc().type;
+                for( uint32_t ndx = 0; ndx < workerCount; ++ndx )
+                {
+                    IShaderCompiler* pCompiler = nullptr;
+                    if( BGS_FAILED( pFactory->CreateWorkerCompiler( compDesc, &pCompiler ) ) )
+                    {
+                        Destroy();
+                        return Results::FAIL;
+                    }
+                    m_compilers.push_back( pCompiler );
+                }
+
+                m_isStopping = BGS_FALSE;
+                for( index_t ndx = 0; ndx < m_compilers.size(); ++ndx )
+                {
+                    m_workers.push_back( std::thread( &AsyncShaderCompiler::CompileShaders, this, m_compilers[ ndx ] ) );
+                }
+
+                return Results::OK;
+            }
+
+            void AsyncShaderCompiler::Destroy()
+            {
+                {
+                    std::lock_guard<Mutex> lock( m_mutex );
+                    m_isStopping = BGS_TRUE;
+                }
+                m_pendingCondition.notify_all();
+                for( index_t ndx = 0; ndx < m_workers.size(); ++ndx )
+                {
+                    if( m_workers[ ndx ].joinable() )
+                    {
+                        m_workers[ ndx ].join();
+                    }
+                }
+                m_workers.clear();
+
+                // Shaders not taken by GetShader() are destroyed, whether they were compiled or not
+                for( index_t ndx = 0; ndx < m_jobs.size(); ++ndx )
+                {
+                    Job& job = m_jobs[ ndx ];
+                    if( job.isUsed )
+                    {
+                        job.pShader->Destroy();
+                        Memory::FreeObject( m_pParent->GetDefaultAllocator(), &job.pShader );
+                        job.isUsed = BGS_FALSE;
+                    }
+                }
+
+                ShaderCompilerFactory* pFactory = m_pParent->GetShaderCompilerFactory();
+                for( index_t ndx = 0; ndx < m_compilers.size(); ++ndx )
+                {
+                    pFactory->DestroyWorkerCompiler( &m_compilers[ ndx ] );
+                }
+
+                m_compilers.clear();
+                m_pendingJobs.clear();
+                m_pendingHead = 0;
+                m_jobs.clear();
+                m_freeJobs.clear();
+                m_jobs.shrink_to_fit();
+                m_freeJobs.shrink_to_fit();
+            }
+
+            void AsyncShaderCompiler::CompileShaders( IShaderCompiler* pCompiler )
+            {
+                for( ;; )
+                {
+                    index_t ndx;
+                    Shader* pShader = nullptr;
+                    {
+                        std::unique_lock<Mutex> lock( m_mutex );
+                        while( !m_isStopping && m_pendingJobs.empty() )
+                        {
+                            m_pendingCondition.wait( lock );
+                        }
+                        if( m_isStopping )
+                        {
+                            return;
+                        }
+                        ndx     = m_pendingJobs[ m_pendingHead++ ];
+                        pShader = m_jobs[ ndx ].pShader;
+                        // Consumed front is dropped when queue runs empty or gets bigger than the rest, so pop is O(1) amortized
+                        if( m_pendingHead == m_pendingJobs.size() )
+                        {
+                            m_pendingJobs.clear();
+                            m_pendingHead = 0;
+                        }
+                        else if( m_pendingHead * 2 > m_pendingJobs.size() )
+                        {
+                            m_pendingJobs.erase( m_pendingJobs.begin(), m_pendingJobs.begin() + m_pendingHead );
+                            m_pendingHead = 0;
+                        }
+                    }
+
+                    // Shader is not touched by other threads until job is done
+                    const RESULT result = pShader->Compile( pCompiler );
+
+                    {
+                        std::lock_guard<Mutex> lock( m_mutex );
+                        m_jobs[ ndx ].result = result;
+                        m_jobs[ ndx ].isDone = BGS_TRUE;
+                    }
+                    m_doneCondition.notify_all();
+                }
+            }
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
@@ -2,6 +2,7 @@
 
 #include "Core/Memory/IAllocator.h"
 #include "Core/Memory/Memory.h"
+#include "Core/Utils/Hash.h"
 #include "Core/Utils/String.h"
 #include "Driver/Frontend/RenderSystem.h"
 #include "Platform/Platform.h"
@@ -175,6 +176,7 @@ namespace BIGOS
                 , m_pUtils( nullptr )
                 , m_pCompiler( nullptr )
                 , m_libraryHandle( nullptr )
+                , m_versionHash( Core::Utils::Hash::SEED )
             {
             }
 
@@ -245,6 +247,14 @@ namespace BIGOS
                     return Results::FAIL;
                 }
 
+                // Cached output skips compilation entirely, arguments at this point cover everything passed to compiler
+                ShaderCache* pCache = m_pParent->GetShaderCache();
+                const hash_t key    = GetCacheKey( desc, compArgs, argCnt );
+                if( BGS_SUCCESS( pCache->Load( key, ppOutput ) ) )
+                {
+                    return Results::OK;
+                }
+
                 IDxcBlobEncoding* pSrc = nullptr;
                 if( FAILED( m_pUtils->CreateBlob( desc.source.pSourceCode, desc.source.sourceSize, CP_UTF8, &pSrc ) ) )
                 {
@@ -324,7 +334,7 @@ namespace BIGOS
                     const uint32_t allocSize = static_cast<uint32_t>( pBlob->GetBufferSize() + sizeof( ShaderCompilerOutput ) + bindingsBufferSize +
                                                                       inputBindingBufferSize );
                     byte_t*        pMem      = nullptr;
-                    if( BGS_FAILED( Core::Memory::AllocateBytes( m_pParent->GetParent()->GetDefaultAllocator(), &pMem, allocSize ) ) )
+                    if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetDefaultAllocator(), &pMem, allocSize ) ) )
                     {
                         RELEASE_COM_PTR( pBlob );
                         return Results::NO_MEMORY;
@@ -364,6 +374,7 @@ namespace BIGOS
                 RELEASE_COM_PTR( pRes );
                 RELEASE_COM_PTR( pSrc );
                 RELEASE_COM_PTR( pBlob );
+                pCache->Store( key, *pOutput );
                 *ppOutput = pOutput;
 
                 return Results::OK;
@@ -416,6 +427,8 @@ namespace BIGOS
                     return Results::FAIL;
                 }
 
+                m_versionHash = QueryVersionHash();
+
                 return Results::OK;
             }
 
@@ -430,6 +443,61 @@ namespace BIGOS
                 m_libraryHandle = nullptr;
             }
 
+            hash_t DXCompiler::QueryVersionHash()
+            {
+                hash_t hash = Core::Utils::Hash::SEED;
+
+                IDxcVersionInfo* pVersionInfo = nullptr;
+                if( FAILED( m_pCompiler->QueryInterface( IID_PPV_ARGS( &pVersionInfo ) ) ) )
+                {
+                    return hash;
+                }
+
+                UINT32 version[ 2 ] = { 0, 0 };
+                if( SUCCEEDED( pVersionInfo->GetVersion( &version[ 0 ], &version[ 1 ] ) ) )
+                {
+                    hash = Core::Utils::Hash::FNV1a( version, sizeof( version ), hash );
+                }
+
+                // Commit info tells apart builds with the same version number
+                IDxcVersionInfo2* pVersionInfo2 = nullptr;
+                if( SUCCEEDED( pVersionInfo->QueryInterface( IID_PPV_ARGS( &pVersionInfo2 ) ) ) )
+                {
+                    UINT32 commitCount = 0;
+                    char*  pCommitHash = nullptr;
+                    if( SUCCEEDED( pVersionInfo2->GetCommitInfo( &commitCount, &pCommitHash ) ) )
+                    {
+                        hash = Core::Utils::Hash::FNV1a( &commitCount, sizeof( commitCount ), hash );
+                        if( pCommitHash != nullptr )
+                        {
+                            hash = Core::Utils::Hash::FNV1a( pCommitHash, Core::Utils::String::Length( pCommitHash ), hash );
+                            CoTaskMemFree( pCommitHash );
+                        }
+                    }
+                    RELEASE_COM_PTR( pVersionInfo2 );
+                }
+                RELEASE_COM_PTR( pVersionInfo );
+
+                return hash;
+            }
+
+            hash_t DXCompiler::GetCacheKey( const CompileShaderDesc& desc, const wchar_t* const* ppArgs, uint32_t argCount ) const
+            {
+                hash_t hash = Core::Utils::Hash::FNV1a( desc.source.pSourceCode, desc.source.sourceSize, m_versionHash );
+                for( uint32_t ndx = 0; ndx < argCount; ++ndx )
+                {
+                    // Terminator included, so argument boundaries change the key
+                    hash = Core::Utils::Hash::FNV1a( ppArgs[ ndx ], ( Core::Utils::String::Length( ppArgs[ ndx ] ) + 1 ) * sizeof( wchar_t ), hash );
+                }
+                // DXIL output has no argument of its own and reflection changes content of output
+                hash = Core::Utils::Hash::FNV1a( &desc.outputFormat, sizeof( desc.outputFormat ), hash );
+                hash = Core::Utils::Hash::FNV1a( &desc.model, sizeof( desc.model ), hash );
+                hash = Core::Utils::Hash::FNV1a( &desc.type, sizeof( desc.type ), hash );
+                hash = Core::Utils::Hash::FNV1a( &desc.reflect, sizeof( desc.reflect ), hash );
+
+                return hash;
+            }
+
             ShaderBindingArray DXCompiler::GetDXILReflection( IDxcResult* pRes )
             {
                 ShaderBindingArray bindingArray;
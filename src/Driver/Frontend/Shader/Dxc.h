@@ -34,11 +34,15 @@ namespace BIGOS
                 ShaderInputBindingArray GetDXILInputReflection( IDxcResult* pRes );
                 ShaderInputBindingArray GetSPIRVInputReflection( void* pSrc, uint32_t srcSize );
 
+                hash_t QueryVersionHash();
+                hash_t GetCacheKey( const CompileShaderDesc& desc, const wchar_t* const* ppArgs, uint32_t argCount ) const;
+
             private:
                 ShaderCompilerFactory* m_pParent;
                 IDxcUtils*             m_pUtils;
                 IDxcCompiler3*         m_pCompiler;
                 LibraryHandle          m_libraryHandle;
+                hash_t                 m_versionHash; // Part of every shader cache key, so updated compiler never returns stale byte code
                 // TODO:
             };
         } // namespace Frontend
@@ -38,33 +38,13 @@ namespace BIGOS
             RESULT Shader::Create( const ShaderDesc& desc, RenderSystem* pSystem )
             {
                 BGS_ASSERT( pSystem != nullptr, "Render device (pSystem) must be a valid pointer." );
-                m_pParent                      = pSystem;
-                m_type                         = desc.type;
-                Backend::IDevice*   pAPIDevice = m_pParent->GetDevice();
-                IShaderCompiler*    pCompiler  = m_pParent->GetDefaultCompiler();
-                const SHADER_FORMAT outputFormat =
-                    m_pParent->GetDriverDesc().apiType == Backend::APITypes::D3D12 ? ShaderFormats::DXIL : ShaderFormats::SPIRV;
-                m_pEntryPoint = GetShaderMainFromType( m_type );
-
-                m_compileDesc.type               = m_type;
-                m_compileDesc.argCount           = 0;
-                m_compileDesc.ppArgs             = nullptr;
-                m_compileDesc.outputFormat       = outputFormat;
-                m_compileDesc.model              = ShaderModels::SHADER_MODEL_6_5;
-                m_compileDesc.reflect            = BGS_TRUE;
-                m_compileDesc.compileDebug       = BGS_TRUE;
-                m_compileDesc.pEntryPoint        = m_pEntryPoint;
-                m_compileDesc.source.pSourceCode = desc.source.pSourceCode;
-                m_compileDesc.source.sourceSize  = desc.source.sourceSize;
-                if( BGS_FAILED( pCompiler->Compile( m_compileDesc, &m_pCompiledShader ) ) )
+                SetCompileDesc( desc, pSystem );
+                if( BGS_FAILED( Compile( m_pParent->GetDefaultCompiler() ) ) )
                 {
                     return Results::FAIL;
                 }
 
-                Backend::ShaderDesc shaderDesc;
-                shaderDesc.pByteCode = m_pCompiledShader->pByteCode;
-                shaderDesc.codeSize  = m_pCompiledShader->byteCodeSize;
-                if( BGS_FAILED( pAPIDevice->CreateShader( shaderDesc, &m_hShader ) ) )
+                if( BGS_FAILED( CreateBackendShader() ) )
                 {
                     Destroy();
                     return Results::FAIL;
@@ -87,6 +67,41 @@ namespace BIGOS
                 }
             }
 
+            void Shader::SetCompileDesc( const ShaderDesc& desc, RenderSystem* pSystem )
+            {
+                m_pParent = pSystem;
+                m_type    = desc.type;
+                const SHADER_FORMAT outputFormat =
+                    m_pParent->GetDriverDesc().apiType == Backend::APITypes::D3D12 ? ShaderFormats::DXIL : ShaderFormats::SPIRV;
+                m_pEntryPoint = GetShaderMainFromType( m_type );
+
+                m_compileDesc.type               = m_type;
+                m_compileDesc.argCount           = 0;
+                m_compileDesc.ppArgs             = nullptr;
+                m_compileDesc.outputFormat       = outputFormat;
+                m_compileDesc.model              = ShaderModels::SHADER_MODEL_6_5;
+                m_compileDesc.reflect            = BGS_TRUE;
+                m_compileDesc.compileDebug       = BGS_TRUE;
+                m_compileDesc.pEntryPoint        = m_pEntryPoint;
+                m_compileDesc.source.pSourceCode = desc.source.pSourceCode;
+                m_compileDesc.source.sourceSize  = desc.source.sourceSize;
+            }
+
+            RESULT Shader::Compile( IShaderCompiler* pCompiler )
+            {
+                // Compiler outputs are allocated from render system allocator, so any compiler can destroy them
+                return pCompiler->Compile( m_compileDesc, &m_pCompiledShader );
+            }
+
+            RESULT Shader::CreateBackendShader()
+            {
+                Backend::ShaderDesc shaderDesc;
+                shaderDesc.pByteCode = m_pCompiledShader->pByteCode;
+                shaderDesc.codeSize  = m_pCompiledShader->byteCodeSize;
+
+                return m_pParent->GetDevice()->CreateShader( shaderDesc, &m_hShader );
+            }
+
             SHADER_LANGUAGE Shader::DetectShaderLanguage( const String& shaderCode )
             {
                 if( std::regex_search(
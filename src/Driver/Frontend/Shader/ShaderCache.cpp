@@ -0,0 +1,278 @@
+#include "ShaderCache.h"
+
+#include "Core/Memory/IAllocator.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Utils/Hash.h"
+#include "Core/Utils/String.h"
+#include "Driver/Frontend/RenderSystem.h"
+#include "ShaderCompilerFactory.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            static constexpr uint32_t SHADER_CACHE_MAGIC = 0x53434742; // "BGCS"
+
+            ShaderCache::ShaderCache()
+                : m_pParent( nullptr )
+                , m_directory()
+                , m_entries()
+            {
+            }
+
+            RESULT ShaderCache::Load( hash_t key, ShaderCompilerOutput** ppOutput )
+            {
+                BGS_ASSERT( ppOutput != nullptr, "Shader compiler output (ppOutput) must be a valid address." );
+                BGS_ASSERT( *ppOutput == nullptr, "There is a pointer at the given address. Shader compiler output (*ppOutput) must be nullptr." );
+                if( ( ppOutput == nullptr ) || ( *ppOutput != nullptr ) )
+                {
+                    return Results::FAIL;
+                }
+
+                {
+                    std::lock_guard<Mutex> lock( m_mutex );
+                    const index_t          ndx = FindEntry( key );
+                    if( ( ndx < m_entries.size() ) && ( m_entries[ ndx ].key == key ) )
+                    {
+                        return CreateOutput( m_entries[ ndx ], ppOutput );
+                    }
+                }
+
+                // Disk is read without lock, so threads compiling other shaders are not blocked by it
+                Entry entry;
+                if( m_directory.empty() || BGS_FAILED( ReadFile( key, &entry ) ) )
+                {
+                    return Results::NOT_FOUND;
+                }
+
+                std::lock_guard<Mutex> lock( m_mutex );
+                const index_t          ndx = FindEntry( key );
+                if( ( ndx < m_entries.size() ) && ( m_entries[ ndx ].key == key ) )
+                {
+                    return CreateOutput( m_entries[ ndx ], ppOutput );
+                }
+                m_entries.insert( m_entries.begin() + ndx, std::move( entry ) );
+
+                return CreateOutput( m_entries[ ndx ], ppOutput );
+            }
+
+            void ShaderCache::Store( hash_t key, const ShaderCompilerOutput& output )
+            {
+                const size_t bindingsSize      = output.bindingCount * sizeof( ShaderBindingInfo );
+                const size_t inputBindingsSize = output.inputBindingCount * sizeof( ShaderInputBindingInfo );
+
+                Entry entry;
+                entry.key               = key;
+                entry.byteCodeSize      = output.byteCodeSize;
+                entry.bindingCount      = output.bindingCount;
+                entry.inputBindingCount = output.inputBindingCount;
+                entry.data.resize( output.byteCodeSize + bindingsSize + inputBindingsSize );
+
+                byte_t* pData = entry.data.data();
+                Memory::Copy( output.pByteCode, output.byteCodeSize, pData, output.byteCodeSize );
+                pData += output.byteCodeSize;
+                if( bindingsSize > 0 )
+                {
+                    Memory::Copy( output.pBindings, bindingsSize, pData, bindingsSize );
+                    pData += bindingsSize;
+                }
+                if( inputBindingsSize > 0 )
+                {
+                    Memory::Copy( output.pInputBindings, inputBindingsSize, pData, inputBindingsSize );
+                }
+
+                {
+                    std::lock_guard<Mutex> lock( m_mutex );
+                    const index_t          ndx = FindEntry( key );
+                    if( ( ndx < m_entries.size() ) && ( m_entries[ ndx ].key == key ) )
+                    {
+                        // Other thread compiled the same shader meanwhile
+                        return;
+                    }
+                    m_entries.insert( m_entries.begin() + ndx, entry );
+                }
+
+                if( !m_directory.empty() )
+                {
+                    WriteFile( entry );
+                }
+            }
+
+            RESULT ShaderCache::Create( const char* pDirectory, ShaderCompilerFactory* pFactory )
+            {
+                BGS_ASSERT( pFactory != nullptr, "Shader compiler factory (pFactory) must be a valid pointer." );
+                if( pFactory == nullptr )
+                {
+                    return Results::FAIL;
+                }
+                m_pParent = pFactory;
+
+                if( pDirectory != nullptr )
+                {
+                    // Cache still works in memory, if directory cannot be created
+                    std::error_code error;
+                    std::filesystem::create_directories( pDirectory, error );
+                    if( !error )
+                    {
+                        m_directory = pDirectory;
+                    }
+                }
+
+                return Results::OK;
+            }
+
+            void ShaderCache::Destroy()
+            {
+                m_entries.clear();
+                m_entries.shrink_to_fit();
+                m_directory.clear();
+                m_pParent = nullptr;
+            }
+
+            index_t ShaderCache::FindEntry( hash_t key ) const
+            {
+                index_t first = 0;
+                index_t count = m_entries.size();
+                while( count > 0 )
+                {
+                    const index_t half = count / 2;
+                    if( m_entries[ first + half ].key < key )
+                    {
+                        first += half + 1;
+                        count -= half + 1;
+                    }
+                    else
+                    {
+                        count = half;
+                    }
+                }
+
+                return first;
+            }
+
+            RESULT ShaderCache::CreateOutput( const Entry& entry, ShaderCompilerOutput** ppOutput )
+            {
+                // Same layout as compiler output: output struct, byte code, bindings and input bindings in one allocation
+                const size_t allocSize = sizeof( ShaderCompilerOutput ) + entry.data.size();
+                byte_t*      pMem      = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_BYTES( m_pParent->GetParent()->GetDefaultAllocator(), &pMem, allocSize ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                ShaderCompilerOutput* pOutput = reinterpret_cast<ShaderCompilerOutput*>( pMem );
+                pMem += sizeof( ShaderCompilerOutput );
+                Memory::Copy( entry.data.data(), entry.data.size(), pMem, entry.data.size() );
+
+                pOutput->pByteCode         = pMem;
+                pOutput->byteCodeSize      = entry.byteCodeSize;
+                pOutput->pBindings         = reinterpret_cast<ShaderBindingInfo*>( pMem + entry.byteCodeSize );
+                pOutput->bindingCount      = entry.bindingCount;
+                pOutput->pInputBindings    = reinterpret_cast<ShaderInputBindingInfo*>( pMem + entry.byteCodeSize +
+                                                                                         entry.bindingCount * sizeof( ShaderBindingInfo ) );
+                pOutput->inputBindingCount = entry.inputBindingCount;
+                if( entry.bindingCount == 0 )
+                {
+                    pOutput->pBindings = nullptr;
+                }
+                if( entry.inputBindingCount == 0 )
+                {
+                    pOutput->pInputBindings = nullptr;
+                }
+
+                *ppOutput = pOutput;
+
+                return Results::OK;
+            }
+
+            RESULT ShaderCache::ReadFile( hash_t key, Entry* pEntry )
+            {
+                std::ifstream file( GetFilePath( key ), std::ios::binary );
+                if( !file.is_open() )
+                {
+                    return Results::NOT_FOUND;
+                }
+
+                FileHeader header;
+                if( !file.read( reinterpret_cast<char*>( &header ), sizeof( header ) ) )
+                {
+                    return Results::FAIL;
+                }
+                if( ( header.magic != SHADER_CACHE_MAGIC ) || ( header.version != Config::Driver::Shader::SHADER_CACHE_VERSION ) ||
+                    ( header.key != key ) )
+                {
+                    return Results::FAIL;
+                }
+
+                const uint64_t dataSize = static_cast<uint64_t>( header.byteCodeSize ) + header.bindingCount * sizeof( ShaderBindingInfo ) +
+                                          header.inputBindingCount * sizeof( ShaderInputBindingInfo );
+                pEntry->data.resize( static_cast<size_t>( dataSize ) );
+                if( !file.read( reinterpret_cast<char*>( pEntry->data.data() ), static_cast<std::streamsize>( dataSize ) ) )
+                {
+                    return Results::FAIL;
+                }
+                // Truncated or damaged files are compiled again and overwritten
+                if( Core::Utils::Hash::FNV1a( pEntry->data.data(), pEntry->data.size() ) != header.dataHash )
+                {
+                    return Results::FAIL;
+                }
+
+                pEntry->key               = key;
+                pEntry->byteCodeSize      = header.byteCodeSize;
+                pEntry->bindingCount      = header.bindingCount;
+                pEntry->inputBindingCount = header.inputBindingCount;
+
+                return Results::OK;
+            }
+
+            void ShaderCache::WriteFile( const Entry& entry )
+            {
+                FileHeader header;
+                Memory::Set( &header, 0, sizeof( header ) );
+                header.magic             = SHADER_CACHE_MAGIC;
+                header.version           = Config::Driver::Shader::SHADER_CACHE_VERSION;
+                header.key               = entry.key;
+                header.dataHash          = Core::Utils::Hash::FNV1a( entry.data.data(), entry.data.size() );
+                header.byteCodeSize      = entry.byteCodeSize;
+                header.bindingCount      = entry.bindingCount;
+                header.inputBindingCount = entry.inputBindingCount;
+
+                // Written under temporary name, so other process never reads half written file
+                const String path     = GetFilePath( entry.key );
+                const String tempPath = path + ".tmp";
+                bool_t       written  = BGS_FALSE;
+                {
+                    std::ofstream file( tempPath, std::ios::binary | std::ios::trunc );
+                    if( !file.is_open() )
+                    {
+                        return;
+                    }
+                    file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+                    file.write( reinterpret_cast<const char*>( entry.data.data() ), static_cast<std::streamsize>( entry.data.size() ) );
+                    written = file.good();
+                }
+
+                std::error_code error;
+                if( written )
+                {
+                    std::filesystem::rename( tempPath, path, error );
+                }
+                if( !written || error )
+                {
+                    std::filesystem::remove( tempPath, error );
+                }
+            }
+
+            String ShaderCache::GetFilePath( hash_t key ) const
+            {
+                char name[ 24 ];
+                Core::Utils::String::Format( name, "/%016llx.bin", static_cast<unsigned long long>( key ) );
+
+                return m_directory + name;
+            }
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Driver/Frontend/RenderSystemTypes.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            // Content addressed store of compiled shaders. Compiler computes key from everything that affects its output and cache
+            // keeps byte code together with reflection, in memory and optionally as one file per key in a directory. Thread safe.
+            class ShaderCache final
+            {
+                friend class ShaderCompilerFactory;
+
+            public:
+                ShaderCache();
+                ~ShaderCache() = default;
+
+                // Output is allocated the same way as compiler output, so compiler DestroyOutput() frees it. NOT_FOUND on miss
+                RESULT Load( hash_t key, ShaderCompilerOutput** ppOutput );
+                void   Store( hash_t key, const ShaderCompilerOutput& output );
+
+            protected:
+                RESULT Create( const char* pDirectory, ShaderCompilerFactory* pFactory );
+                void   Destroy();
+
+            private:
+                struct Entry
+                {
+                    hash_t            key;
+                    uint32_t          byteCodeSize;
+                    uint32_t          bindingCount;
+                    uint32_t          inputBindingCount;
+                    HeapArray<byte_t> data; // Byte code, bindings and input bindings one after another
+                };
+
+                struct FileHeader
+                {
+                    uint32_t magic;
+                    uint32_t version;
+                    hash_t   key;
+                    hash_t   dataHash;
+                    uint32_t byteCodeSize;
+                    uint32_t bindingCount;
+                    uint32_t inputBindingCount;
+                    uint32_t reserved;
+                };
+
+                using EntryArray = HeapArray<Entry>;
+
+                // Returns position of first entry with key not less than given one, entries are sorted by key
+                index_t FindEntry( hash_t key ) const;
+                RESULT  CreateOutput( const Entry& entry, ShaderCompilerOutput** ppOutput );
+                RESULT  ReadFile( hash_t key, Entry* pEntry );
+                void    WriteFile( const Entry& entry );
+                String  GetFilePath( hash_t key ) const;
+
+            private:
+                ShaderCompilerFactory* m_pParent;
+                String                 m_directory; // Empty keeps cache in memory only
+                EntryArray             m_entries;
+                Mutex                  m_mutex;
+            };
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
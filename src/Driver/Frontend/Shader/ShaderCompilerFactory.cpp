@@ -16,6 +16,7 @@ namespace BIGOS
 
             ShaderCompilerFactory::ShaderCompilerFactory()
                 : m_compilers()
+                , m_shaderCache()
                 , m_pParent( nullptr )
             {
             }
@@ -32,7 +33,7 @@ namespace BIGOS
                 if( desc.type == CompilerTypes::DXC )
                 {
                     DXCompiler* pDxc = nullptr;
-                    if( BGS_FAILED( Memory::AllocateObject( m_pParent->GetDefaultAllocator(), &pDxc ) ) )
+                    if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetDefaultAllocator(), &pDxc ) ) )
                     {
                         return Results::NO_MEMORY;
                     }
@@ -88,6 +89,56 @@ namespace BIGOS
                 }
             }
 
+            RESULT ShaderCompilerFactory::CreateWorkerCompiler( const ShaderCompilerDesc& desc, IShaderCompiler** ppCompiler )
+            {
+                BGS_ASSERT( ppCompiler != nullptr, "Shader compiler (ppCompiler) must be a valid address." );
+                BGS_ASSERT( *ppCompiler == nullptr, "There is a pointer at the given address. Shader compiler (*ppCompiler) must be nullptr." );
+                if( ( ppCompiler == nullptr ) || ( *ppCompiler != nullptr ) )
+                {
+                    return Results::FAIL;
+                }
+
+                if( desc.type != CompilerTypes::DXC )
+                {
+                    // TODO: Implement with glsl support
+                    return Results::NOT_FOUND;
+                }
+
+                DXCompiler* pDxc = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetDefaultAllocator(), &pDxc ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+
+                if( BGS_FAILED( pDxc->Create( desc, this ) ) )
+                {
+                    Memory::FreeObject( m_pParent->GetDefaultAllocator(), &pDxc );
+                    return Results::FAIL;
+                }
+
+                *ppCompiler = pDxc;
+
+                return Results::OK;
+            }
+
+            void ShaderCompilerFactory::DestroyWorkerCompiler( IShaderCompiler** ppCompiler )
+            {
+                BGS_ASSERT( ppCompiler != nullptr, "Shader compiler (ppCompiler) must be a valid address." );
+                BGS_ASSERT( *ppCompiler != nullptr, "Shader compiler (*ppCompiler) must be a valid pointer." );
+                if( ( ppCompiler == nullptr ) || ( *ppCompiler == nullptr ) )
+                {
+                    return;
+                }
+
+                if( ( *ppCompiler )->GetDesc().type == CompilerTypes::DXC )
+                {
+                    DXCompiler* pDxc = static_cast<DXCompiler*>( *ppCompiler );
+                    pDxc->Destroy();
+                    Memory::FreeObject( m_pParent->GetDefaultAllocator(), &pDxc );
+                }
+                *ppCompiler = nullptr;
+            }
+
             RESULT ShaderCompilerFactory::Create( const ShaderCompilerFactoryDesc& desc, RenderSystem* pRenderSystem )
             {
                 BGS_ASSERT( pRenderSystem != nullptr, "Render system (pRenderSystem) must be a valid pointer." );
@@ -102,6 +153,11 @@ namespace BIGOS
                 // Setting array to null
                 Memory::Set( m_compilers, 0, sizeof( ShaderCompilerPtr ) * BGS_ENUM_COUNT( CompilerTypes ) );
 
+                if( BGS_FAILED( m_shaderCache.Create( m_desc.pShaderCachePath, this ) ) )
+                {
+                    return Results::FAIL;
+                }
+
                 return Results::OK;
             }
 
@@ -117,6 +173,8 @@ namespace BIGOS
 
                 // Setting array to null
                 Memory::Set( m_compilers, 0, sizeof( ShaderCompilerPtr ) * BGS_ENUM_COUNT( CompilerTypes ) );
+
+                m_shaderCache.Destroy();
             }
 
         } // namespace Frontend
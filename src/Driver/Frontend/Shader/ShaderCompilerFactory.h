@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Driver/Frontend/RenderSystemTypes.h"
+#include "ShaderCache.h"
 
 namespace BIGOS
 {
@@ -24,7 +25,13 @@ namespace BIGOS
                 RESULT CreateCompiler( const ShaderCompilerDesc& desc, IShaderCompiler** ppCompiler );
                 void   DestroyCompiler( IShaderCompiler** ppCompiler );
 
+                // Worker compilers are not shared through GetCompiler(), each has its own compiler instance, so it can be used on its
+                // own thread next to others. Shader cache is still shared
+                RESULT CreateWorkerCompiler( const ShaderCompilerDesc& desc, IShaderCompiler** ppCompiler );
+                void   DestroyWorkerCompiler( IShaderCompiler** ppCompiler );
+
                 RenderSystem* GetParent() { return m_pParent; }
+                ShaderCache*  GetShaderCache() { return &m_shaderCache; }
 
             protected:
                 RESULT Create( const ShaderCompilerFactoryDesc& desc, RenderSystem* pRenderSystem );
@@ -33,6 +40,7 @@ namespace BIGOS
             private:
                 ShaderCompilerFactoryDesc m_desc;
                 CompilerArray             m_compilers;
+                ShaderCache               m_shaderCache;
                 RenderSystem*             m_pParent;
             };
         } // namespace Frontend
@@ -175,6 +175,8 @@ namespace BIGOS
                 cpyBBBarrier.dstLayout    = cpyBBLayout;
                 cpyBBBarrier.hResouce     = m_pSwapchain->GetBackBuffers()[ bufferNdx ].hBackBuffer;
                 cpyBBBarrier.textureRange = { BGS_FLAG( Backend::TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+                cpyBBBarrier.pSrcQueue    = nullptr;
+                cpyBBBarrier.pDstQueue    = nullptr;
 
                 // Present back buffer barrier
                 Backend::TextureBarrierDesc presBBBarrier;
@@ -186,6 +188,8 @@ namespace BIGOS
                 presBBBarrier.dstLayout    = Backend::TextureLayouts::PRESENT;
                 presBBBarrier.hResouce     = m_pSwapchain->GetBackBuffers()[ bufferNdx ].hBackBuffer;
                 presBBBarrier.textureRange = { BGS_FLAG( Backend::TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+                presBBBarrier.pSrcQueue    = nullptr;
+                presBBBarrier.pDstQueue    = nullptr;
 
                 if( BGS_FAILED( pAPIDevice->ResetCommandPool( m_hCmdPools[ bufferNdx ] ) ) )
                 {
@@ -211,6 +215,8 @@ namespace BIGOS
                     cpyRTBarrier.dstLayout    = cpyRTLayout;
                     cpyRTBarrier.hResouce     = pRenderTarget->GetResource();
                     cpyRTBarrier.textureRange = { BGS_FLAG( Backend::TextureComponentFlagBits::COLOR ), 0, 1, 0, 1 };
+                    cpyRTBarrier.pSrcQueue    = nullptr;
+                    cpyRTBarrier.pDstQueue    = nullptr;
                     m_pCmdBuffers[ bufferNdx ]->Barrier( { &cpyRTBarrier, nullptr, nullptr, 1, 0, 0 } );
                     pRenderTarget->SetState( newRTState );
                 }
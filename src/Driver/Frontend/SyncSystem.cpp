@@ -20,11 +20,37 @@ namespace BIGOS
                 PerContextData&        contextData = m_contextData[ BGS_ENUM_INDEX( ctxType ) ];
                 std::lock_guard<Mutex> lock( contextData.mutex );
 
-                uint64_t  value = contextData.counter.fetch_add( 1 );
-                SyncPoint point( value, ctxType, pName );
-                contextData.syncPoints.emplace_back( point );
+                SyncPointArray& ring  = contextData.syncPoints;
+                uint64_t        value = contextData.counter.fetch_add( 1 );
+                SyncPoint       point( value, ctxType, pName );
+                if( contextData.pointCount == ring.size() )
+                {
+                    // Completed points make room before ring grows
+                    uint64_t fenceVal = 0;
+                    if( BGS_SUCCESS( m_pParent->GetDevice()->GetFenceValue( contextData.hFence, &fenceVal ) ) )
+                    {
+                        CleanupCompletedPoints( contextData, fenceVal );
+                    }
+                }
+                if( contextData.pointCount < ring.size() )
+                {
+                    ring[ ( contextData.firstPoint + contextData.pointCount ) % ring.size() ] = point;
+                    contextData.pointCount++;
+                }
+                else if( ( contextData.firstPoint == 0 ) && BGS_SUCCESS( ring.reserve( ring.size() + 1 ) ) )
+                {
+                    // Ring does not wrap, so it grows at its end and keeps creation order
+                    ring.push_back( point );
+                    contextData.pointCount++;
+                }
+                else if( contextData.pointCount > 0 )
+                {
+                    // Ring is full of pending points. They are tracked only to be waited for in Destroy() and values grow, so the
+                    // newest point covers the one it replaces
+                    ring[ ( contextData.firstPoint + contextData.pointCount - 1 ) % ring.size() ] = point;
+                }
 
-                return contextData.syncPoints.back();
+                return point;
             }
 
             RESULT SyncSystem::Signal( const SyncPoint& point )
@@ -45,18 +71,50 @@ namespace BIGOS
                 waitDesc.pFences     = &contextData.hFence;
                 waitDesc.pWaitValues = &waitVal;
                 waitDesc.waitAll     = BGS_TRUE;
-                return m_pParent->GetDevice()->WaitForFences( waitDesc, MAX_UINT64 );
+                const RESULT res     = m_pParent->GetDevice()->WaitForFences( waitDesc, MAX_UINT64 );
+                if( BGS_SUCCESS( res ) )
+                {
+                    CleanupCompletedPoints( point.GetContextType() );
+                }
+
+                return res;
+            }
+
+            bool_t SyncSystem::IsCompleted( const SyncPoint& point )
+            {
+                PerContextData& contextData = m_contextData[ BGS_ENUM_INDEX( point.GetContextType() ) ];
+
+                uint64_t fenceVal = 0;
+                if( BGS_FAILED( m_pParent->GetDevice()->GetFenceValue( contextData.hFence, &fenceVal ) ) )
+                {
+                    return BGS_FALSE;
+                }
+
+                if( fenceVal < point.GetValue() )
+                {
+                    return BGS_FALSE;
+                }
+
+                std::lock_guard<Mutex> lock( contextData.mutex );
+                CleanupCompletedPoints( contextData, fenceVal );
+
+                return BGS_TRUE;
             }
 
             RESULT SyncSystem::Wait( const HeapArray<SyncPoint>& points )
+            {
+                return Wait( points.data(), points.size() );
+            }
+
+            RESULT SyncSystem::Wait( const SyncPoint* pPoints, index_t pointCount )
             {
                 StackArray<uint64_t, BGS_ENUM_COUNT( ContextTypes )> maxVals   = { 0, 0, 0 };
                 StackArray<bool_t, BGS_ENUM_COUNT( ContextTypes )>   hasPoints = { BGS_FALSE, BGS_FALSE, BGS_FALSE };
 
                 // Getting max values for each context type
-                for( index_t ndx = 0; ndx < points.size(); ++ndx )
+                for( index_t ndx = 0; ndx < pointCount; ++ndx )
                 {
-                    const SyncPoint& point   = points[ ndx ];
+                    const SyncPoint& point   = pPoints[ ndx ];
                     CONTEXT_TYPE     ctxType = point.GetContextType();
                     if( point.GetValue() > maxVals[ BGS_ENUM_INDEX( ctxType ) ] )
                     {
@@ -117,8 +175,15 @@ namespace BIGOS
                 {
                     PerContextData& contextData = m_contextData[ ndx ];
                     contextData.hFence          = Backend::FenceHandle();
-                    contextData.syncPoints.reserve( m_desc.syncPointCount );
                     contextData.counter.store( 1 );
+                    contextData.firstPoint = 0;
+                    contextData.pointCount = 0;
+                    if( BGS_FAILED( contextData.syncPoints.Create( Config::Driver::Synchronization::MAX_SYNC_POINT_COUNT ) ) )
+                    {
+                        Destroy();
+                        return Results::NO_MEMORY;
+                    }
+                    contextData.syncPoints.reserve( m_desc.syncPointCount );
                     if( BGS_FAILED( pAPIDevice->CreateFence( fenceDesc, &contextData.hFence ) ) )
                     {
                         Destroy();
@@ -135,11 +200,13 @@ namespace BIGOS
                 for( index_t ndx = 0; ndx < m_contextData.size(); ++ndx )
                 {
                     PerContextData& contextData = m_contextData[ ndx ];
-                    Wait( contextData.syncPoints );
+                    // Slots of completed points are waited for too, they return at once
+                    Wait( contextData.syncPoints.data(), contextData.syncPoints.size() );
                     if( contextData.hFence != Backend::FenceHandle() )
                     {
                         m_pParent->GetDevice()->DestroyFence( &contextData.hFence );
                     }
+                    contextData.syncPoints.Destroy();
                 }
             }
 
@@ -149,24 +216,26 @@ namespace BIGOS
                 std::lock_guard<Mutex> lock( contextData.mutex );
 
                 uint64_t fenceVal = 0;
-                m_pParent->GetDevice()->GetFenceValue( contextData.hFence, &fenceVal );
-
-                SyncPoint* pPoints = contextData.syncPoints.data();
-                index_t    cnt     = contextData.syncPoints.size();
-                uint32_t   newCnt  = 0;
-                for( index_t ndx = 0; ndx < cnt; ++ndx )
+                if( BGS_SUCCESS( m_pParent->GetDevice()->GetFenceValue( contextData.hFence, &fenceVal ) ) )
                 {
-                    if( pPoints[ ndx ].GetValue() > fenceVal )
-                    {
-                        if( newCnt != ndx )
-                        {
-                            pPoints[ newCnt ] = pPoints[ ndx ];
-                        }
-                        newCnt++;
-                    }
+                    CleanupCompletedPoints( contextData, fenceVal );
                 }
+            }
 
-                contextData.syncPoints.resize( newCnt );
+            void SyncSystem::CleanupCompletedPoints( PerContextData& contextData, uint64_t fenceVal )
+            {
+                // Points are created with growing values, so completed ones are at the front of the ring
+                const SyncPointArray& ring = contextData.syncPoints;
+                while( ( contextData.pointCount > 0 ) && ( ring[ contextData.firstPoint ].GetValue() <= fenceVal ) )
+                {
+                    contextData.firstPoint = ( contextData.firstPoint + 1 ) % ring.size();
+                    contextData.pointCount--;
+                }
+                // Empty ring starts at the beginning again, so it can grow
+                if( contextData.pointCount == 0 )
+                {
+                    contextData.firstPoint = 0;
+                }
             }
 
         } // namespace Frontend
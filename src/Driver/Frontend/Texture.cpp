@@ -2,6 +2,8 @@
 
 #include "Driver/Frontend/Texture.h"
 
+#include "Driver/Frontend/BindingObjectCache.h"
+#include "Driver/Frontend/BindlessTable.h"
 #include "Driver/Frontend/RenderSystem.h"
 
 namespace BIGOS
@@ -73,22 +75,27 @@ namespace BIGOS
 
             Texture::Texture()
                 : m_desc()
+                , m_state()
                 , m_pParent( nullptr )
-                , m_hMemory()
+                , m_memory()
                 , m_hResource()
                 , m_hSampleAccess()
                 , m_hStorageAccess()
+                , m_bindlessEntries()
             {
             }
 
             RESULT Texture::Create( const TextureDesc& desc, RenderSystem* pSystem )
             {
                 BGS_ASSERT( pSystem != nullptr, "Render device (pDevice) must be a valid pointer." );
-                m_pParent                    = pSystem;
-                m_desc                       = desc;
-                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
-
-                Backend::ResourceUsageFlags usage = BGS_FLAG( Backend::ResourceUsageFlagBits::TRANSFER_DST );
+                m_pParent                      = pSystem;
+                m_desc                         = desc;
+                Backend::IDevice*   pAPIDevice = m_pParent->GetDevice();
+                BindingObjectCache* pViewCache = m_pParent->GetBindingObjectCache();
+
+                // Transfer source allows defragmenter to move texture
+                Backend::ResourceUsageFlags usage =
+                    BGS_FLAG( Backend::ResourceUsageFlagBits::TRANSFER_DST ) | BGS_FLAG( Backend::ResourceUsageFlagBits::TRANSFER_SRC );
                 if( m_desc.usage & BGS_FLAG( TextureUsageFlagBits::SAMPLED ) )
                 {
                     usage |= BGS_FLAG( Backend::ResourceUsageFlagBits::SAMPLED_TEXTURE );
@@ -109,28 +116,14 @@ namespace BIGOS
                 texDesc.resourceType    = MapTextureTypeToResourceType( m_desc.type );
                 texDesc.sampleCount     = m_desc.sampleCount;
                 texDesc.sharingMode     = BIGOS::Driver::Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+                texDesc.flags           = BGS_FLAG( BIGOS::Driver::Backend::ResourceFlagBits::NONE );
                 if( BGS_FAILED( pAPIDevice->CreateResource( texDesc, &m_hResource ) ) )
                 {
                     return Results::FAIL;
                 }
 
-                Backend::ResourceAllocationInfo allocInf;
-                pAPIDevice->GetResourceAllocationInfo( m_hResource, &allocInf );
-                Backend::AllocateMemoryDesc allocDesc;
-                allocDesc.size      = allocInf.size;
-                allocDesc.alignment = allocInf.alignment;
-                allocDesc.heapType  = Backend::MemoryHeapTypes::DEFAULT;
-                allocDesc.heapUsage = Backend::MemoryHeapUsages::TEXTURES;
-                if( BGS_FAILED( pAPIDevice->AllocateMemory( allocDesc, &m_hMemory ) ) )
-                {
-                    Destroy();
-                    return Results::FAIL;
-                }
-                Backend::BindResourceMemoryDesc bindMemDesc;
-                bindMemDesc.hMemory      = m_hMemory;
-                bindMemDesc.hResource    = m_hResource;
-                bindMemDesc.memoryOffset = 0;
-                if( BGS_FAILED( pAPIDevice->BindResourceMemory( bindMemDesc ) ) )
+                if( BGS_FAILED( m_pParent->GetDeviceMemorySystem()->AllocateAndBind( m_hResource, Backend::MemoryHeapTypes::DEFAULT,
+                                                                                     Backend::MemoryHeapUsages::TEXTURES, &m_memory ) ) )
                 {
                     Destroy();
                     return Results::FAIL;
@@ -148,7 +141,7 @@ namespace BIGOS
                 if( m_desc.usage & BGS_FLAG( TextureUsageFlagBits::SAMPLED ) )
                 {
                     viewDesc.usage = BGS_FLAG( Backend::ResourceViewUsageFlagBits::SAMPLED_TEXTURE );
-                    if( BGS_FAILED( pAPIDevice->CreateResourceView( viewDesc, &m_hSampleAccess ) ) )
+                    if( BGS_FAILED( pViewCache->CreateResourceView( viewDesc, &m_hSampleAccess ) ) )
                     {
                         Destroy();
                         return Results::FAIL;
@@ -157,35 +150,67 @@ namespace BIGOS
                 if( m_desc.usage & BGS_FLAG( TextureUsageFlagBits::SAMPLED ) )
                 {
                     viewDesc.usage = BGS_FLAG( Backend::ResourceViewUsageFlagBits::SAMPLED_TEXTURE );
-                    if( BGS_FAILED( pAPIDevice->CreateResourceView( viewDesc, &m_hStorageAccess ) ) )
+                    if( BGS_FAILED( pViewCache->CreateResourceView( viewDesc, &m_hStorageAccess ) ) )
                     {
                         Destroy();
                         return Results::FAIL;
                     }
                 }
+                UpdateBindlessEntries();
 
                 return Results::OK;
             }
 
             void Texture::Destroy()
             {
-                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
+                Backend::IDevice*   pAPIDevice = m_pParent->GetDevice();
+                BindingObjectCache* pViewCache = m_pParent->GetBindingObjectCache();
 
                 if( m_hSampleAccess != Backend::ResourceViewHandle() )
                 {
-                    pAPIDevice->DestroyResourceView( &m_hSampleAccess );
+                    pViewCache->ReleaseResourceView( &m_hSampleAccess );
                 }
                 if( m_hStorageAccess != Backend::ResourceViewHandle() )
                 {
-                    pAPIDevice->DestroyResourceView( &m_hStorageAccess );
+                    pViewCache->ReleaseResourceView( &m_hStorageAccess );
                 }
                 if( m_hResource != Backend::ResourceHandle() )
                 {
                     pAPIDevice->DestroyResource( &m_hResource );
                 }
-                if( m_hMemory != Backend::MemoryHandle() )
+                if( m_memory.hMemory != Backend::MemoryHandle() )
+                {
+                    m_pParent->GetDeviceMemorySystem()->Free( &m_memory );
+                }
+            }
+
+            void Texture::SwapResources( Texture* pOther )
+            {
+                BGS_ASSERT( pOther != nullptr, "Texture (pOther) must be a valid pointer." );
+
+                std::swap( m_desc, pOther->m_desc );
+                std::swap( m_state, pOther->m_state );
+                std::swap( m_memory, pOther->m_memory );
+                std::swap( m_hResource, pOther->m_hResource );
+                std::swap( m_hSampleAccess, pOther->m_hSampleAccess );
+                std::swap( m_hStorageAccess, pOther->m_hStorageAccess );
+                QueueBindlessRewrites();
+                pOther->QueueBindlessRewrites();
+            }
+
+            void Texture::UpdateBindlessEntries()
+            {
+                for( index_t ndx = 0; ndx < m_bindlessEntries.size(); ++ndx )
+                {
+                    m_bindlessEntries[ ndx ].pTable->RewriteEntry( this, m_bindlessEntries[ ndx ] );
+                }
+            }
+
+            void Texture::QueueBindlessRewrites()
+            {
+                for( index_t ndx = 0; ndx < m_bindlessEntries.size(); ++ndx )
                 {
-                    pAPIDevice->FreeMemory( &m_hMemory );
+                    m_bindlessEntries[ ndx ].pTable->QueueRewrite( m_bindlessEntries[ ndx ] );
                 }
             }
 
@@ -0,0 +1,563 @@
+#include "Driver/Frontend/TextureStreamer.h"
+
+#include "Core/Memory/Memory.h"
+#include "Driver/Backend/APICommon.h"
+#include "Driver/Frontend/Context.h"
+#include "Driver/Frontend/RenderSystem.h"
+#include "Driver/Frontend/Texture.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            // Streamed textures are only sampled
+            static constexpr Backend::PipelineStageFlags SHADER_STAGES = BGS_FLAG( Backend::PipelineStageFlagBits::VERTEX_SHADING ) |
+                                                                         BGS_FLAG( Backend::PipelineStageFlagBits::PIXEL_SHADING ) |
+                                                                         BGS_FLAG( Backend::PipelineStageFlagBits::COMPUTE_SHADING );
+
+            static Size3D GetMipSize( const Size3D& size, uint32_t mip )
+            {
+                Size3D mipSize;
+                mipSize.width  = ( size.width >> mip ) > 0 ? size.width >> mip : 1;
+                mipSize.height = ( size.height >> mip ) > 0 ? size.height >> mip : 1;
+                mipSize.depth  = ( size.depth >> mip ) > 0 ? size.depth >> mip : 1;
+
+                return mipSize;
+            }
+
+            static uint64_t GetSubresourceSize( const TextureDesc& desc, uint32_t mip )
+            {
+                const Size3D mipSize = GetMipSize( desc.size, mip );
+
+                return static_cast<uint64_t>( Backend::GetBigosFormatSize( desc.format ) ) * mipSize.width * mipSize.height * mipSize.depth;
+            }
+
+            static uint64_t GetChainSize( const TextureDesc& desc, uint32_t firstMip )
+            {
+                uint64_t size = 0;
+                for( uint32_t mipNdx = firstMip; mipNdx < desc.mipLevelCount; ++mipNdx )
+                {
+                    size += GetSubresourceSize( desc, mipNdx ) * desc.arrayLayerCount;
+                }
+
+                return size;
+            }
+
+            TextureStreamer::TextureStreamer()
+                : m_desc()
+                , m_pParent( nullptr )
+                , m_textures()
+                , m_freeTextures()
+                , m_candidates()
+                , m_requests()
+                , m_results()
+                , m_loadMutex()
+                , m_loadCondition()
+                , m_thread()
+                , m_isStopping( BGS_FALSE )
+                , m_residentSize( 0 )
+                , m_generation( 0 )
+            {
+            }
+
+            RESULT TextureStreamer::AddTexture( const StreamingTextureDesc& desc, index_t* pIndex )
+            {
+                BGS_ASSERT( pIndex != nullptr, "Index (pIndex) must be a valid address." );
+                BGS_ASSERT( desc.loader != nullptr, "Mip loader (desc.loader) must be a valid function." );
+                BGS_ASSERT( desc.textureDesc.usage & BGS_FLAG( TextureUsageFlagBits::SAMPLED ), "Only sampled textures can be streamed." );
+                BGS_ASSERT( ( desc.tailMipCount > 0 ) && ( desc.tailMipCount <= desc.textureDesc.mipLevelCount ),
+                            "Tail mip count (desc.tailMipCount) must be in range (0, desc.textureDesc.mipLevelCount]." );
+                if( ( pIndex == nullptr ) || ( desc.loader == nullptr ) || ( desc.tailMipCount == 0 ) ||
+                    ( desc.tailMipCount > desc.textureDesc.mipLevelCount ) )
+                {
+                    return Results::FAIL;
+                }
+
+                index_t ndx = 0;
+                if( m_freeTextures.empty() )
+                {
+                    ndx = m_textures.size();
+                    m_textures.push_back( StreamingTexture() );
+                    m_textures.back().serial = 0;
+                }
+                else
+                {
+                    ndx = m_freeTextures.back();
+                    m_freeTextures.pop_back();
+                }
+
+                // Nothing is resident yet, first update requests the tail
+                StreamingTexture& tex = m_textures[ ndx ];
+                tex.desc              = desc;
+                tex.pTexture          = nullptr;
+                tex.pNewTexture       = nullptr;
+                tex.point             = SyncPoint();
+                tex.tailMip           = desc.textureDesc.mipLevelCount - desc.tailMipCount;
+                tex.residentMip       = desc.textureDesc.mipLevelCount;
+                tex.targetMip         = tex.residentMip;
+                tex.screenSize        = 0.0f;
+                tex.state             = StreamingStates::IDLE;
+                tex.isUsed            = BGS_TRUE;
+                tex.isFlushed         = BGS_FALSE;
+
+                *pIndex = ndx;
+
+                return Results::OK;
+            }
+
+            void TextureStreamer::RemoveTexture( index_t ndx )
+            {
+                BGS_ASSERT( ndx < m_textures.size(), "Index (ndx) out of range." );
+                StreamingTexture& tex   = m_textures[ ndx ];
+                SyncSystem*       pSync = m_pParent->GetSyncSystem();
+
+                // Upload still writes new texture
+                if( tex.state == StreamingStates::UPLOADING )
+                {
+                    if( !tex.isFlushed )
+                    {
+                        m_pParent->GetCopyContext()->FlushUploads( &tex.point );
+                    }
+                    pSync->Wait( tex.point );
+                }
+                else if( ( tex.state == StreamingStates::ACQUIRING ) || ( tex.state == StreamingStates::RETIRING ) )
+                {
+                    pSync->Wait( tex.point );
+                }
+
+                DestroyTexture( &tex.pNewTexture );
+                DestroyTexture( &tex.pTexture );
+                tex.desc.loader = nullptr;
+                tex.state       = StreamingStates::IDLE;
+                tex.isUsed      = BGS_FALSE;
+                tex.serial++;
+                m_freeTextures.push_back( ndx );
+            }
+
+            RESULT TextureStreamer::Update( const SyncPoint& framePoint, Backend::ICommandBuffer* pCmdBuffer )
+            {
+                BGS_ASSERT( pCmdBuffer != nullptr, "Command buffer (pCmdBuffer) must be a valid pointer." );
+                if( pCmdBuffer == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                SyncSystem* pSync = m_pParent->GetSyncSystem();
+
+                // Textures whose upload is done are acquired by this frame and swapped in once it is finished, so frames still in
+                // flight reading rewritten bindless entries never see texture before its acquire. Old resources live until frames
+                // recorded before the swap are finished
+                for( index_t ndx = 0; ndx < m_textures.size(); ++ndx )
+                {
+                    StreamingTexture& tex = m_textures[ ndx ];
+                    if( !tex.isUsed )
+                    {
+                        continue;
+                    }
+                    if( ( tex.state == StreamingStates::UPLOADING ) && tex.isFlushed && pSync->IsCompleted( tex.point ) )
+                    {
+                        tex.point = framePoint;
+                        tex.state = StreamingStates::ACQUIRING;
+                    }
+                    else if( ( tex.state == StreamingStates::ACQUIRING ) && pSync->IsCompleted( tex.point ) )
+                    {
+                        // Object of ready texture is kept, it may be registered in bindless tables
+                        if( tex.pTexture != nullptr )
+                        {
+                            tex.pTexture->SwapResources( tex.pNewTexture );
+                            tex.state = StreamingStates::RETIRING;
+                        }
+                        else
+                        {
+                            tex.pTexture    = tex.pNewTexture;
+                            tex.pNewTexture = nullptr;
+                            tex.state       = StreamingStates::IDLE;
+                        }
+                        tex.residentMip = tex.targetMip;
+                        tex.point       = framePoint;
+                        m_generation++;
+                    }
+                    else if( ( tex.state == StreamingStates::RETIRING ) && pSync->IsCompleted( tex.point ) )
+                    {
+                        DestroyTexture( &tex.pNewTexture );
+                        tex.state = StreamingStates::IDLE;
+                    }
+                }
+                // Copy queue released uploaded textures, graphics queue takes them before they are swapped in. Acquires of uploads
+                // finished since the checks above are recorded too, those textures just wait for a later frame
+                if( BGS_FAILED( m_pParent->GetCopyContext()->AcquireCompletedUploads( pCmdBuffer ) ) )
+                {
+                    return Results::FAIL;
+                }
+
+                LoadResultArray results;
+                {
+                    std::lock_guard<Mutex> lock( m_loadMutex );
+                    results.swap( m_results );
+                }
+                for( index_t ndx = 0; ndx < results.size(); ++ndx )
+                {
+                    const LoadResult& result = results[ ndx ];
+                    StreamingTexture& tex    = m_textures[ result.ndx ];
+                    if( !tex.isUsed || ( tex.serial != result.serial ) || ( tex.state != StreamingStates::LOADING ) )
+                    {
+                        continue;
+                    }
+                    // Failed loads are requested again by following updates
+                    if( BGS_FAILED( result.result ) || BGS_FAILED( UploadMips( result.ndx, result ) ) )
+                    {
+                        tex.targetMip = tex.residentMip;
+                        tex.state     = StreamingStates::IDLE;
+                    }
+                }
+
+                // Tail mips are always loaded, textures missing most mips go first among the others
+                m_residentSize = 0;
+                m_candidates.clear();
+                for( index_t ndx = 0; ndx < m_textures.size(); ++ndx )
+                {
+                    StreamingTexture& tex = m_textures[ ndx ];
+                    if( !tex.isUsed )
+                    {
+                        continue;
+                    }
+                    m_residentSize += GetUsedSize( tex );
+                    if( tex.state != StreamingStates::IDLE )
+                    {
+                        continue;
+                    }
+                    if( tex.pTexture == nullptr )
+                    {
+                        RequestMips( ndx, tex.tailMip );
+                        m_residentSize += GetChainSize( tex.desc.textureDesc, tex.tailMip );
+                        continue;
+                    }
+                    const uint32_t wantedMip = GetWantedMip( tex );
+                    if( wantedMip >= tex.residentMip )
+                    {
+                        continue;
+                    }
+                    index_t pos = m_candidates.size();
+                    m_candidates.push_back( ndx );
+                    const uint32_t missingMips = tex.residentMip - wantedMip;
+                    while( pos > 0 )
+                    {
+                        const StreamingTexture& prev = m_textures[ m_candidates[ pos - 1 ] ];
+                        if( prev.residentMip - GetWantedMip( prev ) >= missingMips )
+                        {
+                            break;
+                        }
+                        m_candidates[ pos ] = m_candidates[ pos - 1 ];
+                        --pos;
+                    }
+                    m_candidates[ pos ] = ndx;
+                }
+
+                uint64_t loadSize = 0;
+                for( index_t ndx = 0; ndx < m_candidates.size(); ++ndx )
+                {
+                    StreamingTexture& tex       = m_textures[ m_candidates[ ndx ] ];
+                    const uint32_t    wantedMip = GetWantedMip( tex );
+                    const uint64_t    newSize   = GetChainSize( tex.desc.textureDesc, wantedMip );
+                    if( ( loadSize > 0 ) && ( loadSize + newSize > m_desc.maxLoadPerFrame ) )
+                    {
+                        break;
+                    }
+                    // Old texture stays until the new one replaces it, so both count against budget meanwhile
+                    if( m_residentSize + newSize > m_desc.memoryBudget )
+                    {
+                        ShrinkUnwanted();
+                        break;
+                    }
+                    RequestMips( m_candidates[ ndx ], wantedMip );
+                    m_residentSize += newSize;
+                    loadSize += newSize;
+                }
+
+                bool_t isUploading = BGS_FALSE;
+                for( index_t ndx = 0; ndx < m_textures.size(); ++ndx )
+                {
+                    const StreamingTexture& tex = m_textures[ ndx ];
+                    isUploading = isUploading || ( tex.isUsed && ( tex.state == StreamingStates::UPLOADING ) && !tex.isFlushed );
+                }
+                if( isUploading )
+                {
+                    SyncPoint uploadPoint;
+                    if( BGS_FAILED( m_pParent->GetCopyContext()->FlushUploads( &uploadPoint ) ) )
+                    {
+                        return Results::FAIL;
+                    }
+                    for( index_t ndx = 0; ndx < m_textures.size(); ++ndx )
+                    {
+                        StreamingTexture& tex = m_textures[ ndx ];
+                        if( tex.isUsed && ( tex.state == StreamingStates::UPLOADING ) && !tex.isFlushed )
+                        {
+                            tex.point     = uploadPoint;
+                            tex.isFlushed = BGS_TRUE;
+                        }
+                    }
+                }
+
+                return Results::OK;
+            }
+
+            Backend::ResourceHandle TextureStreamer::GetResource( index_t ndx ) const
+            {
+                const Texture* pTexture = m_textures[ ndx ].pTexture;
+
+                return ( pTexture != nullptr ) ? pTexture->m_hResource : Backend::ResourceHandle();
+            }
+
+            Backend::ResourceViewHandle TextureStreamer::GetSampledView( index_t ndx ) const
+            {
+                const Texture* pTexture = m_textures[ ndx ].pTexture;
+
+                return ( pTexture != nullptr ) ? pTexture->m_hSampleAccess : Backend::ResourceViewHandle();
+            }
+
+            RESULT TextureStreamer::Create( const TextureStreamerDesc& desc, RenderSystem* pSystem )
+            {
+                BGS_ASSERT( pSystem != nullptr, "Render system (pSystem) must be a valid pointer." );
+                BGS_ASSERT( desc.maxLoadPerFrame > 0, "Load size (desc.maxLoadPerFrame) must be greater than 0." );
+                m_pParent = pSystem;
+                m_desc    = desc;
+
+                m_textures.SetAllocator( m_pParent->GetDefaultAllocator() );
+                m_freeTextures.SetAllocator( m_pParent->GetDefaultAllocator() );
+                m_candidates.SetAllocator( m_pParent->GetDefaultAllocator() );
+
+                m_isStopping = BGS_FALSE;
+                m_thread     = std::thread( &TextureStreamer::LoadMips, this );
+
+                return Results::OK;
+            }
+
+            void TextureStreamer::Destroy()
+            {
+                {
+                    std::lock_guard<Mutex> lock( m_loadMutex );
+                    m_isStopping = BGS_TRUE;
+                }
+                m_loadCondition.notify_all();
+                if( m_thread.joinable() )
+                {
+                    m_thread.join();
+                }
+
+                for( index_t ndx = 0; ndx < m_textures.size(); ++ndx )
+                {
+                    if( m_textures[ ndx ].isUsed )
+                    {
+                        RemoveTexture( ndx );
+                    }
+                }
+
+                m_requests.clear();
+                m_results.clear();
+                m_textures.clear();
+                m_textures.shrink_to_fit();
+                m_freeTextures.clear();
+                m_freeTextures.shrink_to_fit();
+                m_candidates.clear();
+                m_candidates.shrink_to_fit();
+            }
+
+            void TextureStreamer::LoadMips()
+            {
+                for( ;; )
+                {
+                    LoadRequest request;
+                    {
+                        std::unique_lock<Mutex> lock( m_loadMutex );
+                        while( !m_isStopping && m_requests.empty() )
+                        {
+                            m_loadCondition.wait( lock );
+                        }
+                        if( m_isStopping )
+                        {
+                            return;
+                        }
+                        request = m_requests.front();
+                        m_requests.erase( m_requests.begin() );
+                    }
+
+                    const TextureDesc& texDesc = request.textureDesc;
+
+                    LoadResult result;
+                    result.ndx    = request.ndx;
+                    result.serial = request.serial;
+                    result.result = Results::OK;
+                    result.data.resize( static_cast<size_t>( GetChainSize( texDesc, request.firstMip ) ) );
+
+                    uint64_t offset = 0;
+                    for( uint32_t mipNdx = request.firstMip; ( mipNdx < texDesc.mipLevelCount ) && BGS_SUCCESS( result.result ); ++mipNdx )
+                    {
+                        const uint64_t size = GetSubresourceSize( texDesc, mipNdx );
+                        for( uint32_t layerNdx = 0; layerNdx < texDesc.arrayLayerCount; ++layerNdx )
+                        {
+                            result.result = request.loader( mipNdx, layerNdx, result.data.data() + offset, size );
+                            if( BGS_FAILED( result.result ) )
+                            {
+                                break;
+                            }
+                            offset += size;
+                        }
+                    }
+
+                    std::lock_guard<Mutex> lock( m_loadMutex );
+                    m_results.push_back( std::move( result ) );
+                }
+            }
+
+            void TextureStreamer::RequestMips( index_t ndx, uint32_t targetMip )
+            {
+                StreamingTexture& tex = m_textures[ ndx ];
+                tex.targetMip         = targetMip;
+                tex.state             = StreamingStates::LOADING;
+
+                // Whole new chain is read, copying resident mips would transition texture that frames still sample
+                LoadRequest request;
+                request.loader      = tex.desc.loader;
+                request.textureDesc = tex.desc.textureDesc;
+                request.ndx         = ndx;
+                request.serial      = tex.serial;
+                request.firstMip    = targetMip;
+                {
+                    std::lock_guard<Mutex> lock( m_loadMutex );
+                    m_requests.push_back( request );
+                }
+                m_loadCondition.notify_one();
+            }
+
+            RESULT TextureStreamer::UploadMips( index_t ndx, const LoadResult& result )
+            {
+                StreamingTexture&  tex      = m_textures[ ndx ];
+                const TextureDesc& fullDesc = tex.desc.textureDesc;
+
+                TextureDesc newDesc   = fullDesc;
+                newDesc.size          = GetMipSize( fullDesc.size, tex.targetMip );
+                newDesc.mipLevelCount = fullDesc.mipLevelCount - tex.targetMip;
+
+                Texture* pNewTexture = nullptr;
+                if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pParent->GetDefaultAllocator(), &pNewTexture ) ) )
+                {
+                    return Results::NO_MEMORY;
+                }
+                if( BGS_FAILED( pNewTexture->Create( newDesc, m_pParent ) ) )
+                {
+                    Memory::FreeObject( m_pParent->GetDefaultAllocator(), &pNewTexture );
+                    return Results::FAIL;
+                }
+
+                CopyContext*      pCopyContext = m_pParent->GetCopyContext();
+                TextureUploadDesc uploadDesc;
+                uploadDesc.pTexture                     = pNewTexture;
+                uploadDesc.textureRange.components      = BGS_FLAG( Backend::TextureComponentFlagBits::COLOR );
+                uploadDesc.textureRange.mipLevelCount   = newDesc.mipLevelCount;
+                uploadDesc.textureRange.arrayLayerCount = newDesc.arrayLayerCount;
+                uploadDesc.textureOffset                = { 0, 0, 0 };
+                uploadDesc.format                       = newDesc.format;
+                uploadDesc.finalLayout                  = Backend::TextureLayouts::SHADER_READ_ONLY;
+                uploadDesc.finalStage                   = SHADER_STAGES;
+                uploadDesc.finalAccess                  = BGS_FLAG( Backend::AccessFlagBits::SHADER_READ_ONLY );
+
+                uint64_t offset = 0;
+                for( uint32_t mipNdx = 0; mipNdx < newDesc.mipLevelCount; ++mipNdx )
+                {
+                    uploadDesc.textureRange.mipLevel = mipNdx;
+                    uploadDesc.size                  = GetMipSize( newDesc.size, mipNdx );
+                    for( uint32_t layerNdx = 0; layerNdx < newDesc.arrayLayerCount; ++layerNdx )
+                    {
+                        uploadDesc.textureRange.arrayLayer = layerNdx;
+                        uploadDesc.pData                   = result.data.data() + offset;
+                        if( BGS_FAILED( pCopyContext->UploadTexture( uploadDesc ) ) )
+                        {
+                            // Uploads recorded so far still reference the texture, it is released with the next flush
+                            pCopyContext->FlushUploads( &tex.point );
+                            m_pParent->GetSyncSystem()->Wait( tex.point );
+                            DestroyTexture( &pNewTexture );
+                            return Results::NO_MEMORY;
+                        }
+                        offset += GetSubresourceSize( newDesc, mipNdx );
+                    }
+                }
+
+                pNewTexture->SetState( ResourceState( uploadDesc.finalStage, uploadDesc.finalAccess, uploadDesc.finalLayout ) );
+                tex.pNewTexture = pNewTexture;
+                tex.state       = StreamingStates::UPLOADING;
+                tex.isFlushed   = BGS_FALSE;
+
+                return Results::OK;
+            }
+
+            void TextureStreamer::ShrinkUnwanted()
+            {
+                // Memory comes back once smaller textures replace current ones
+                for( index_t ndx = 0; ndx < m_textures.size(); ++ndx )
+                {
+                    StreamingTexture& tex = m_textures[ ndx ];
+                    if( tex.isUsed && ( tex.state == StreamingStates::IDLE ) && ( tex.pTexture != nullptr ) )
+                    {
+                        const uint32_t wantedMip = GetWantedMip( tex );
+                        if( wantedMip > tex.residentMip )
+                        {
+                            RequestMips( ndx, wantedMip );
+                        }
+                    }
+                }
+            }
+
+            void TextureStreamer::DestroyTexture( Texture** ppTexture )
+            {
+                if( *ppTexture != nullptr )
+                {
+                    BGS_ASSERT( ( *ppTexture )->m_bindlessEntries.empty(), "Texture must be unregistered from bindless tables." );
+                    m_pParent->GetCopyContext()->DropAcquires( ( *ppTexture )->GetResource() );
+                    ( *ppTexture )->Destroy();
+                    Memory::FreeObject( m_pParent->GetDefaultAllocator(), ppTexture );
+                }
+            }
+
+            uint32_t TextureStreamer::GetWantedMip( const StreamingTexture& texture ) const
+            {
+                if( texture.screenSize <= 0.0f )
+                {
+                    return texture.tailMip;
+                }
+
+                // Smallest mip still covering screen size
+                const Size3D&  size    = texture.desc.textureDesc.size;
+                const uint32_t maxSize = size.width > size.height ? size.width : size.height;
+                uint32_t       mip     = 0;
+                while( ( mip < texture.tailMip ) && ( static_cast<float>( maxSize >> ( mip + 1 ) ) >= texture.screenSize ) )
+                {
+                    ++mip;
+                }
+
+                return mip;
+            }
+
+            uint64_t TextureStreamer::GetUsedSize( const StreamingTexture& texture ) const
+            {
+                uint64_t size = 0;
+                if( texture.pTexture != nullptr )
+                {
+                    size += GetChainSize( texture.pTexture->m_desc, 0 );
+                }
+                if( texture.pNewTexture != nullptr )
+                {
+                    size += GetChainSize( texture.pNewTexture->m_desc, 0 );
+                }
+                if( texture.state == StreamingStates::LOADING )
+                {
+                    size += GetChainSize( texture.desc.textureDesc, texture.targetMip );
+                }
+
+                return size;
+            }
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
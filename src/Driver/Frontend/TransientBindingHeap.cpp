@@ -0,0 +1,191 @@
+#include "Driver/Frontend/TransientBindingHeap.h"
+
+#include "Driver/Frontend/RenderSystem.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+
+            TransientBindingHeap::TransientBindingHeap()
+                : m_desc()
+                , m_pParent( nullptr )
+                , m_hHeap()
+                , m_size( 0 )
+                , m_alignment( 1 )
+                , m_head( 0 )
+                , m_tail( 0 )
+                , m_frames()
+                , m_firstFrame( 0 )
+                , m_frameCount( 0 )
+            {
+            }
+
+            RESULT TransientBindingHeap::Allocate( Backend::BindingSetLayoutHandle hLayout, uint64_t* pBaseOffset )
+            {
+                BGS_ASSERT( pBaseOffset != nullptr, "Base offset (pBaseOffset) must be a valid address." );
+                BGS_ASSERT( hLayout != Backend::BindingSetLayoutHandle(), "Binding set layout (hLayout) must be a valid handle." );
+                if( ( pBaseOffset == nullptr ) || ( hLayout == Backend::BindingSetLayoutHandle() ) )
+                {
+                    return Results::FAIL;
+                }
+
+                uint64_t size = 0;
+                m_pParent->GetDevice()->GetBindingSetLayoutSize( hLayout, &size );
+                BGS_ASSERT( size <= m_size, "Binding set does not fit in the heap." );
+                if( size > m_size )
+                {
+                    return Results::FAIL;
+                }
+
+                // Set never crosses end of the heap, tail of the heap is skipped instead
+                const uint64_t wrapBase = m_head - m_head % m_size;
+                uint64_t       offset   = ( ( m_head - wrapBase ) + m_alignment - 1 ) & ~( m_alignment - 1 );
+                uint64_t       start    = wrapBase + offset;
+                if( offset + size > m_size )
+                {
+                    offset = 0;
+                    start  = wrapBase + m_size;
+                }
+
+                if( start + size - m_tail > m_size )
+                {
+                    RetireCompletedFrames();
+                }
+                while( start + size - m_tail > m_size )
+                {
+                    if( BGS_FAILED( RetireOldestFrame() ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+                }
+
+                m_head       = start + size;
+                *pBaseOffset = offset;
+
+                return Results::OK;
+            }
+
+            RESULT TransientBindingHeap::EndFrame( const SyncPoint& point )
+            {
+                if( m_frameCount == Config::Driver::Binding::MAX_TRANSIENT_BINDING_FRAME_COUNT )
+                {
+                    if( BGS_FAILED( RetireOldestFrame() ) )
+                    {
+                        return Results::FAIL;
+                    }
+                }
+
+                FrameMarker& frame = m_frames[ ( m_firstFrame + m_frameCount ) % Config::Driver::Binding::MAX_TRANSIENT_BINDING_FRAME_COUNT ];
+                frame.endPos       = m_head;
+                frame.point        = point;
+                m_frameCount++;
+
+                return Results::OK;
+            }
+
+            RESULT TransientBindingHeap::Create( const TransientBindingHeapDesc& desc, RenderSystem* pSystem )
+            {
+                BGS_ASSERT( pSystem != nullptr, "Render system (pSystem) must be a valid pointer." );
+                BGS_ASSERT( desc.bindingCount > 0, "Binding count (desc.bindingCount) must be greater than 0." );
+                if( desc.bindingCount == 0 )
+                {
+                    return Results::FAIL;
+                }
+                m_pParent                    = pSystem;
+                m_desc                       = desc;
+                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
+
+                // Heap fits given number of the biggest bindings it can hold
+                const Backend::DeviceLimits& limits      = pAPIDevice->GetLimits();
+                uint64_t                     bindingSize = limits.samplerBindingSize;
+                if( desc.type == Backend::BindingHeapTypes::SHADER_RESOURCE )
+                {
+                    const uint64_t sizes[] = { limits.sampledTextureBindingSize,     limits.storageTextureBindingSize,
+                                               limits.constantTexelBufferBindingSize, limits.storageTexelBufferBindingSize,
+                                               limits.constantBufferBindingSize,      limits.readOnlyStorageBufferBindingSize,
+                                               limits.readWriteStorageBufferBindingSize };
+
+                    bindingSize = 0;
+                    for( index_t ndx = 0; ndx < sizeof( sizes ) / sizeof( sizes[ 0 ] ); ++ndx )
+                    {
+                        bindingSize = sizes[ ndx ] > bindingSize ? sizes[ ndx ] : bindingSize;
+                    }
+                }
+                m_size      = desc.bindingCount * bindingSize;
+                m_alignment = limits.bindingSetAlignment > 0 ? limits.bindingSetAlignment : 1;
+                BGS_ASSERT( ( m_alignment & ( m_alignment - 1 ) ) == 0, "Binding set alignment must be the power of 2." );
+
+                Backend::BindingHeapDesc heapDesc;
+                heapDesc.bindingCount = desc.bindingCount;
+                heapDesc.type         = desc.type;
+                if( BGS_FAILED( pAPIDevice->CreateBindingHeap( heapDesc, &m_hHeap ) ) )
+                {
+                    return Results::FAIL;
+                }
+
+                m_head       = 0;
+                m_tail       = 0;
+                m_firstFrame = 0;
+                m_frameCount = 0;
+
+                return Results::OK;
+            }
+
+            void TransientBindingHeap::Destroy()
+            {
+                // GPU may still read sets of frames in flight
+                while( m_frameCount > 0 )
+                {
+                    if( BGS_FAILED( RetireOldestFrame() ) )
+                    {
+                        break;
+                    }
+                }
+
+                if( m_hHeap != Backend::BindingHeapHandle() )
+                {
+                    m_pParent->GetDevice()->DestroyBindingHeap( &m_hHeap );
+                }
+            }
+
+            void TransientBindingHeap::RetireCompletedFrames()
+            {
+                SyncSystem* pSyncSystem = m_pParent->GetSyncSystem();
+                while( m_frameCount > 0 )
+                {
+                    const FrameMarker& frame = m_frames[ m_firstFrame ];
+                    if( !pSyncSystem->IsCompleted( frame.point ) )
+                    {
+                        break;
+                    }
+                    m_tail       = frame.endPos;
+                    m_firstFrame = ( m_firstFrame + 1 ) % Config::Driver::Binding::MAX_TRANSIENT_BINDING_FRAME_COUNT;
+                    m_frameCount--;
+                }
+            }
+
+            RESULT TransientBindingHeap::RetireOldestFrame()
+            {
+                if( m_frameCount == 0 )
+                {
+                    return Results::NOT_FOUND;
+                }
+
+                const FrameMarker& frame = m_frames[ m_firstFrame ];
+                if( BGS_FAILED( m_pParent->GetSyncSystem()->Wait( frame.point ) ) )
+                {
+                    return Results::FAIL;
+                }
+                m_tail       = frame.endPos;
+                m_firstFrame = ( m_firstFrame + 1 ) % Config::Driver::Binding::MAX_TRANSIENT_BINDING_FRAME_COUNT;
+                m_frameCount--;
+
+                return Results::OK;
+            }
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
@@ -0,0 +1,375 @@
+#include "Driver/Frontend/TransientResourcePool.h"
+
+#include "BIGOS/BigosEngine.h"
+#include "Driver/Backend/APICommon.h"
+#include "Driver/Frontend/RenderSystem.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+            static Backend::PipelineStageFlags GetUsageStages( Backend::ResourceUsageFlags usage )
+            {
+                Backend::PipelineStageFlags stages = BGS_FLAG( Backend::PipelineStageFlagBits::NONE );
+                if( usage & BGS_FLAG( Backend::ResourceUsageFlagBits::COLOR_RENDER_TARGET ) )
+                {
+                    stages |= BGS_FLAG( Backend::PipelineStageFlagBits::RENDER_TARGET );
+                }
+                if( usage & BGS_FLAG( Backend::ResourceUsageFlagBits::DEPTH_STENCIL_TARGET ) )
+                {
+                    stages |= BGS_FLAG( Backend::PipelineStageFlagBits::DEPTH_STENCIL );
+                }
+                if( usage & ( BGS_FLAG( Backend::ResourceUsageFlagBits::SAMPLED_TEXTURE ) |
+                              BGS_FLAG( Backend::ResourceUsageFlagBits::STORAGE_TEXTURE ) ) )
+                {
+                    stages |= BGS_FLAG( Backend::PipelineStageFlagBits::PIXEL_SHADING ) |
+                              BGS_FLAG( Backend::PipelineStageFlagBits::COMPUTE_SHADING );
+                }
+                if( usage & ( BGS_FLAG( Backend::ResourceUsageFlagBits::TRANSFER_SRC ) |
+                              BGS_FLAG( Backend::ResourceUsageFlagBits::TRANSFER_DST ) ) )
+                {
+                    stages |= BGS_FLAG( Backend::PipelineStageFlagBits::TRANSFER );
+                }
+
+                return stages;
+            }
+
+            static Backend::AccessFlags GetUsageWrites( Backend::ResourceUsageFlags usage )
+            {
+                Backend::AccessFlags access = BGS_FLAG( Backend::AccessFlagBits::NONE );
+                if( usage & BGS_FLAG( Backend::ResourceUsageFlagBits::COLOR_RENDER_TARGET ) )
+                {
+                    access |= BGS_FLAG( Backend::AccessFlagBits::RENDER_TARGET );
+                }
+                if( usage & BGS_FLAG( Backend::ResourceUsageFlagBits::DEPTH_STENCIL_TARGET ) )
+                {
+                    access |= BGS_FLAG( Backend::AccessFlagBits::DEPTH_STENCIL_WRITE );
+                }
+                if( usage & BGS_FLAG( Backend::ResourceUsageFlagBits::STORAGE_TEXTURE ) )
+                {
+                    access |= BGS_FLAG( Backend::AccessFlagBits::SHADER_READ_WRITE );
+                }
+                if( usage & BGS_FLAG( Backend::ResourceUsageFlagBits::TRANSFER_DST ) )
+                {
+                    access |= BGS_FLAG( Backend::AccessFlagBits::TRANSFER_DST );
+                }
+
+                return access;
+            }
+
+            TransientResourcePool::TransientResourcePool()
+                : m_desc()
+                , m_pParent( nullptr )
+                , m_textures()
+                , m_memory()
+                , m_heapSize( 0 )
+                , m_unaliasedSize( 0 )
+                , m_compiled( BGS_FALSE )
+            {
+            }
+
+            RESULT TransientResourcePool::AddTexture( const TransientTextureDesc& desc, index_t* pIndex )
+            {
+                BGS_ASSERT( pIndex != nullptr, "Index (pIndex) must be a valid address." );
+                BGS_ASSERT( !m_compiled, "Textures can not be added to compiled pool, reset it first." );
+                BGS_ASSERT( m_textures.size() < m_desc.maxTextureCount, "Texture count exceeds pool limit (%d).", m_desc.maxTextureCount );
+                BGS_ASSERT( desc.firstPass <= desc.lastPass, "First pass (desc.firstPass) must not be after last pass (desc.lastPass)." );
+                BGS_ASSERT( desc.size.depth == 1, "Only 2D textures can be transient." );
+                if( ( pIndex == nullptr ) || m_compiled || ( m_textures.size() >= m_desc.maxTextureCount ) || ( desc.firstPass > desc.lastPass ) )
+                {
+                    return Results::FAIL;
+                }
+
+                TransientTexture tex;
+                tex.desc          = desc;
+                tex.hResource     = Backend::ResourceHandle();
+                tex.heapUsage     = ( desc.usage & ( BGS_FLAG( Backend::ResourceUsageFlagBits::COLOR_RENDER_TARGET ) |
+                                                 BGS_FLAG( Backend::ResourceUsageFlagBits::DEPTH_STENCIL_TARGET ) ) )
+                                        ? Backend::MemoryHeapUsages::RENDER_TARGETS
+                                        : Backend::MemoryHeapUsages::TEXTURES;
+                tex.size          = 0;
+                tex.alignment     = 0;
+                tex.offset        = 0;
+                tex.aliasedStages = BGS_FLAG( Backend::PipelineStageFlagBits::NONE );
+                tex.aliasedWrites = BGS_FLAG( Backend::AccessFlagBits::NONE );
+                m_textures.push_back( tex );
+
+                *pIndex = m_textures.size() - 1;
+
+                return Results::OK;
+            }
+
+            RESULT TransientResourcePool::Compile()
+            {
+                BGS_ASSERT( !m_compiled, "Pool has been already compiled." );
+                if( m_compiled )
+                {
+                    return Results::FAIL;
+                }
+                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
+
+                // Resources are created up front, placement needs their real size and alignment
+                for( index_t ndx = 0; ndx < m_textures.size(); ++ndx )
+                {
+                    TransientTexture& tex = m_textures[ ndx ];
+
+                    Backend::ResourceDesc resDesc;
+                    resDesc.format          = tex.desc.format;
+                    resDesc.size            = tex.desc.size;
+                    resDesc.mipLevelCount   = tex.desc.mipLevelCount;
+                    resDesc.arrayLayerCount = tex.desc.arrayLayerCount;
+                    resDesc.resourceType    = Backend::ResourceTypes::TEXTURE_2D;
+                    resDesc.resourceLayout  = Backend::ResourceLayouts::OPTIMAL;
+                    resDesc.resourceUsage   = tex.desc.usage;
+                    resDesc.sharingMode     = Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+                    resDesc.sampleCount     = tex.desc.sampleCount;
+                    resDesc.flags           = BGS_FLAG( Backend::ResourceFlagBits::NONE );
+                    if( tex.desc.usage & BGS_FLAG( Backend::ResourceUsageFlagBits::DEPTH_STENCIL_TARGET ) )
+                    {
+                        resDesc.depthStencilClrValue = { 1.0f, 0 };
+                    }
+                    else
+                    {
+                        resDesc.colorClrValue = { 1.0f, 1.0f, 1.0f, 1.0f };
+                    }
+                    if( BGS_FAILED( pAPIDevice->CreateResource( resDesc, &tex.hResource ) ) )
+                    {
+                        Release();
+                        return Results::FAIL;
+                    }
+
+                    Backend::ResourceAllocationInfo allocInfo;
+                    pAPIDevice->GetResourceAllocationInfo( tex.hResource, &allocInfo );
+                    tex.size      = allocInfo.size;
+                    tex.alignment = allocInfo.alignment;
+                    m_unaliasedSize += allocInfo.size;
+                }
+
+                // Placement lists live only during compilation, so they are taken from scratch memory of calling thread
+                Memory::LinearAllocator* pScratchAllocator = m_pParent->GetParent()->GetMemorySystem().GetThreadScratchAllocator();
+                if( pScratchAllocator == nullptr )
+                {
+                    Release();
+                    return Results::NO_MEMORY;
+                }
+                const Memory::LinearAllocatorMarker scratchMarker = pScratchAllocator->GetMarker();
+                const RESULT                        result        = AllocateHeaps( pScratchAllocator );
+                pScratchAllocator->FreeToMarker( scratchMarker );
+                if( BGS_FAILED( result ) )
+                {
+                    Release();
+                    return result;
+                }
+
+                for( index_t ndx = 0; ndx < m_textures.size(); ++ndx )
+                {
+                    TransientTexture&             tex    = m_textures[ ndx ];
+                    const DeviceMemoryAllocation& memory = m_memory[ BGS_ENUM_INDEX( tex.heapUsage ) ];
+
+                    Backend::BindResourceMemoryDesc bindDesc;
+                    bindDesc.hMemory      = memory.hMemory;
+                    bindDesc.hResource    = tex.hResource;
+                    bindDesc.memoryOffset = memory.offset + tex.offset;
+                    if( BGS_FAILED( pAPIDevice->BindResourceMemory( bindDesc ) ) )
+                    {
+                        Release();
+                        return Results::FAIL;
+                    }
+
+                    // Texture itself is included, its previous frame use is aliased as well
+                    for( index_t otherNdx = 0; otherNdx < m_textures.size(); ++otherNdx )
+                    {
+                        const TransientTexture& other = m_textures[ otherNdx ];
+                        if( ( other.heapUsage == tex.heapUsage ) && ( other.offset < tex.offset + tex.size ) &&
+                            ( tex.offset < other.offset + other.size ) )
+                        {
+                            tex.aliasedStages |= GetUsageStages( other.desc.usage );
+                            tex.aliasedWrites |= GetUsageWrites( other.desc.usage );
+                        }
+                    }
+                }
+
+                m_compiled = BGS_TRUE;
+
+                return Results::OK;
+            }
+
+            RESULT TransientResourcePool::Reset( const SyncPoint& lastUsePoint )
+            {
+                // Default point means textures were never used
+                if( ( lastUsePoint.GetContextType() != ContextTypes::_MAX_ENUM ) &&
+                    BGS_FAILED( m_pParent->GetSyncSystem()->Wait( lastUsePoint ) ) )
+                {
+                    return Results::FAIL;
+                }
+                Release();
+
+                return Results::OK;
+            }
+
+            void TransientResourcePool::Release()
+            {
+                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
+
+                for( index_t ndx = 0; ndx < m_textures.size(); ++ndx )
+                {
+                    if( m_textures[ ndx ].hResource != Backend::ResourceHandle() )
+                    {
+                        pAPIDevice->DestroyResource( &m_textures[ ndx ].hResource );
+                    }
+                }
+                m_textures.clear();
+
+                for( uint32_t usageNdx = 0; usageNdx < BGS_ENUM_COUNT( Backend::MemoryHeapUsages ); ++usageNdx )
+                {
+                    if( m_memory[ usageNdx ].hMemory != Backend::MemoryHandle() )
+                    {
+                        m_pParent->GetDeviceMemorySystem()->Free( &m_memory[ usageNdx ] );
+                    }
+                }
+
+                m_heapSize      = 0;
+                m_unaliasedSize = 0;
+                m_compiled      = BGS_FALSE;
+            }
+
+            void TransientResourcePool::GetAliasingBarrier( index_t ndx, const ResourceState& dstState, Backend::TextureBarrierDesc* pBarrier ) const
+            {
+                BGS_ASSERT( m_compiled, "Pool must be compiled before its textures are used." );
+                BGS_ASSERT( ndx < m_textures.size(), "Texture index (ndx) is out of range." );
+                BGS_ASSERT( pBarrier != nullptr, "Barrier (pBarrier) must be a valid address." );
+                const TransientTexture& tex = m_textures[ ndx ];
+
+                // Content is discarded, but writes of aliasing textures still have to land before the new ones
+                pBarrier->srcStage                     = tex.aliasedStages;
+                pBarrier->srcAccess                    = tex.aliasedWrites;
+                pBarrier->srcLayout                    = Backend::TextureLayouts::UNDEFINED;
+                pBarrier->dstStage                     = dstState.GetStage();
+                pBarrier->dstAccess                    = dstState.GetAccess();
+                pBarrier->dstLayout                    = dstState.GetLayout();
+                pBarrier->hResouce                     = tex.hResource;
+                pBarrier->textureRange.components      = Backend::GetFormatComponents( tex.desc.format );
+                pBarrier->textureRange.mipLevel        = 0;
+                pBarrier->textureRange.mipLevelCount   = tex.desc.mipLevelCount;
+                pBarrier->textureRange.arrayLayer      = 0;
+                pBarrier->textureRange.arrayLayerCount = tex.desc.arrayLayerCount;
+                pBarrier->pSrcQueue                    = nullptr;
+                pBarrier->pDstQueue                    = nullptr;
+            }
+
+            RESULT TransientResourcePool::Create( const TransientResourcePoolDesc& desc, RenderSystem* pSystem )
+            {
+                BGS_ASSERT( pSystem != nullptr, "Render system (pSystem) must be a valid pointer." );
+                BGS_ASSERT( desc.maxTextureCount > 0, "Max texture count (desc.maxTextureCount) must be greater than 0." );
+                if( desc.maxTextureCount == 0 )
+                {
+                    return Results::FAIL;
+                }
+                m_pParent = pSystem;
+                m_desc    = desc;
+
+                m_textures.SetAllocator( m_pParent->GetDefaultAllocator() );
+                m_textures.reserve( m_desc.maxTextureCount );
+
+                return Results::OK;
+            }
+
+            void TransientResourcePool::Destroy()
+            {
+                Release();
+                m_textures.shrink_to_fit();
+            }
+
+            RESULT TransientResourcePool::AllocateHeaps( Memory::LinearAllocator* pScratchAllocator )
+            {
+                // Biggest textures go first, smaller ones fill gaps left between them
+                ScratchIndexArray order( pScratchAllocator );
+                ScratchIndexArray placed( pScratchAllocator );
+                order.reserve( m_textures.size() );
+                placed.reserve( m_textures.size() );
+                for( index_t ndx = 0; ndx < m_textures.size(); ++ndx )
+                {
+                    index_t pos = order.size();
+                    order.push_back( ndx );
+                    while( ( pos > 0 ) && ( m_textures[ order[ pos - 1 ] ].size < m_textures[ ndx ].size ) )
+                    {
+                        order[ pos ] = order[ pos - 1 ];
+                        --pos;
+                    }
+                    order[ pos ] = ndx;
+                }
+
+                for( uint32_t usageNdx = 0; usageNdx < BGS_ENUM_COUNT( Backend::MemoryHeapUsages ); ++usageNdx )
+                {
+                    const Backend::MEMORY_HEAP_USAGE heapUsage = static_cast<Backend::MEMORY_HEAP_USAGE>( usageNdx );
+
+                    uint64_t heapSize  = 0;
+                    uint64_t alignment = 1;
+                    placed.clear();
+                    for( index_t ndx = 0; ndx < order.size(); ++ndx )
+                    {
+                        TransientTexture& tex = m_textures[ order[ ndx ] ];
+                        if( tex.heapUsage != heapUsage )
+                        {
+                            continue;
+                        }
+                        tex.offset = PlaceTexture( order[ ndx ], placed );
+                        placed.push_back( order[ ndx ] );
+
+                        heapSize  = tex.offset + tex.size > heapSize ? tex.offset + tex.size : heapSize;
+                        alignment = tex.alignment > alignment ? tex.alignment : alignment;
+                    }
+                    if( heapSize == 0 )
+                    {
+                        continue;
+                    }
+
+                    Backend::AllocateMemoryDesc allocDesc;
+                    allocDesc.size      = heapSize;
+                    allocDesc.alignment = alignment;
+                    allocDesc.access    = 0;
+                    allocDesc.heapType  = Backend::MemoryHeapTypes::DEFAULT;
+                    allocDesc.heapUsage = heapUsage;
+                    if( BGS_FAILED( m_pParent->GetDeviceMemorySystem()->Allocate( allocDesc, &m_memory[ usageNdx ] ) ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+                    m_heapSize += heapSize;
+                }
+
+                return Results::OK;
+            }
+
+            uint64_t TransientResourcePool::PlaceTexture( index_t ndx, const ScratchIndexArray& placed )
+            {
+                const TransientTexture& tex    = m_textures[ ndx ];
+                uint64_t                offset = 0;
+
+                // Texture is pushed past every live texture it collides with, until it lands in a free gap
+                bool_t moved = BGS_TRUE;
+                while( moved )
+                {
+                    moved = BGS_FALSE;
+                    for( index_t placedNdx = 0; placedNdx < placed.size(); ++placedNdx )
+                    {
+                        const TransientTexture& other = m_textures[ placed[ placedNdx ] ];
+                        if( ( other.desc.lastPass < tex.desc.firstPass ) || ( other.desc.firstPass > tex.desc.lastPass ) )
+                        {
+                            continue;
+                        }
+                        if( ( offset < other.offset + other.size ) && ( other.offset < offset + tex.size ) )
+                        {
+                            offset = ( other.offset + other.size + tex.alignment - 1 ) & ~( tex.alignment - 1 );
+                            moved  = BGS_TRUE;
+                        }
+                    }
+                }
+
+                return offset;
+            }
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
@@ -0,0 +1,279 @@
+#include "Driver/Frontend/UploadRingBuffer.h"
+
+#include "Core/Memory/Memory.h"
+#include "Driver/Frontend/RenderSystem.h"
+
+namespace BIGOS
+{
+    namespace Driver
+    {
+        namespace Frontend
+        {
+
+            UploadRingBuffer::UploadRingBuffer()
+                : m_desc()
+                , m_pParent( nullptr )
+                , m_memory()
+                , m_hResource()
+                , m_pHost( nullptr )
+                , m_head( 0 )
+                , m_tail( 0 )
+                , m_flushedPos( 0 )
+                , m_frames()
+                , m_firstFrame( 0 )
+                , m_frameCount( 0 )
+            {
+            }
+
+            RESULT UploadRingBuffer::Allocate( uint64_t size, uint64_t alignment, UploadAllocation* pAllocation )
+            {
+                BGS_ASSERT( pAllocation != nullptr, "Allocation (pAllocation) must be a valid address." );
+                BGS_ASSERT( ( size > 0 ) && ( size <= m_desc.size ), "Allocation size (size) must be in range (0, ring size]." );
+                BGS_ASSERT( ( alignment & ( alignment - 1 ) ) == 0, "Alignment must be the power of 2." );
+                if( ( pAllocation == nullptr ) || ( size == 0 ) || ( size > m_desc.size ) )
+                {
+                    return Results::FAIL;
+                }
+                if( alignment == 0 )
+                {
+                    alignment = 1;
+                }
+
+                // Allocation never crosses end of the buffer, tail of the buffer is skipped instead
+                const uint64_t wrapBase = m_head - m_head % m_desc.size;
+                uint64_t       offset   = ( ( m_head - wrapBase ) + alignment - 1 ) & ~( alignment - 1 );
+                uint64_t       start    = wrapBase + offset;
+                if( offset + size > m_desc.size )
+                {
+                    offset = 0;
+                    start  = wrapBase + m_desc.size;
+                }
+
+                if( start + size - m_tail > m_desc.size )
+                {
+                    RetireCompletedFrames();
+                }
+                while( start + size - m_tail > m_desc.size )
+                {
+                    // Only frames still in flight can give space back, current frame filled whole ring otherwise
+                    if( BGS_FAILED( RetireOldestFrame() ) )
+                    {
+                        return Results::NO_MEMORY;
+                    }
+                }
+
+                m_head = start + size;
+
+                pAllocation->hResource = m_hResource;
+                pAllocation->pHost     = m_pHost + offset;
+                pAllocation->offset    = offset;
+                pAllocation->size      = size;
+
+                return Results::OK;
+            }
+
+            RESULT UploadRingBuffer::Upload( const void* pData, uint64_t size, uint64_t alignment, UploadAllocation* pAllocation )
+            {
+                BGS_ASSERT( pData != nullptr, "Data (pData) must be a valid pointer." );
+                if( pData == nullptr )
+                {
+                    return Results::FAIL;
+                }
+
+                const RESULT result = Allocate( size, alignment, pAllocation );
+                if( BGS_FAILED( result ) )
+                {
+                    return result;
+                }
+                Memory::StreamCopy( pData, static_cast<size_t>( size ), pAllocation->pHost, static_cast<size_t>( size ) );
+
+                return Results::OK;
+            }
+
+            RESULT UploadRingBuffer::Flush()
+            {
+                if( m_head == m_flushedPos )
+                {
+                    return Results::OK;
+                }
+
+                // Whole ring at most, older allocations were recycled already. Range wraps at most once
+                const uint64_t begin       = ( m_head - m_flushedPos > m_desc.size ) ? m_head - m_desc.size : m_flushedPos;
+                const uint64_t beginOffset = begin % m_desc.size;
+                const uint64_t endOffset   = ( m_head - 1 ) % m_desc.size + 1;
+                if( begin / m_desc.size == ( m_head - 1 ) / m_desc.size )
+                {
+                    if( BGS_FAILED( FlushRange( beginOffset, endOffset - beginOffset ) ) )
+                    {
+                        return Results::FAIL;
+                    }
+                }
+                else
+                {
+                    if( BGS_FAILED( FlushRange( beginOffset, m_desc.size - beginOffset ) ) || BGS_FAILED( FlushRange( 0, endOffset ) ) )
+                    {
+                        return Results::FAIL;
+                    }
+                }
+                m_flushedPos = m_head;
+
+                return Results::OK;
+            }
+
+            RESULT UploadRingBuffer::EndFrame( const SyncPoint& point )
+            {
+                if( m_frameCount == Config::Driver::Memory::MAX_UPLOAD_RING_FRAME_COUNT )
+                {
+                    if( BGS_FAILED( RetireOldestFrame() ) )
+                    {
+                        return Results::FAIL;
+                    }
+                }
+
+                FrameMarker& frame = m_frames[ ( m_firstFrame + m_frameCount ) % Config::Driver::Memory::MAX_UPLOAD_RING_FRAME_COUNT ];
+                frame.endPos       = m_head;
+                frame.point        = point;
+                m_frameCount++;
+
+                return Results::OK;
+            }
+
+            RESULT UploadRingBuffer::Create( const UploadRingBufferDesc& desc, RenderSystem* pSystem )
+            {
+                BGS_ASSERT( pSystem != nullptr, "Render system (pSystem) must be a valid pointer." );
+                BGS_ASSERT( desc.size > 0, "Ring size (desc.size) must be greater than 0." );
+                if( desc.size == 0 )
+                {
+                    return Results::FAIL;
+                }
+                m_pParent                    = pSystem;
+                m_desc                       = desc;
+                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
+
+                Backend::ResourceDesc buffDesc;
+                buffDesc.format          = Backend::Formats::UNKNOWN;
+                buffDesc.size.width      = static_cast<uint32_t>( m_desc.size );
+                buffDesc.size.height     = 1;
+                buffDesc.size.depth      = 1;
+                buffDesc.arrayLayerCount = 1;
+                buffDesc.mipLevelCount   = 1;
+                buffDesc.resourceUsage   = m_desc.usage;
+                buffDesc.resourceLayout  = Backend::ResourceLayouts::LINEAR;
+                buffDesc.resourceType    = Backend::ResourceTypes::BUFFER;
+                buffDesc.sampleCount     = Backend::SampleCount::COUNT_1;
+                buffDesc.sharingMode     = Backend::ResourceSharingModes::EXCLUSIVE_ACCESS;
+                buffDesc.flags           = BGS_FLAG( Backend::ResourceFlagBits::PERSISTENT_MAP );
+                if( BGS_FAILED( pAPIDevice->CreateResource( buffDesc, &m_hResource ) ) )
+                {
+                    return Results::FAIL;
+                }
+
+                if( BGS_FAILED( m_pParent->GetDeviceMemorySystem()->AllocateAndBind( m_hResource, Backend::MemoryHeapTypes::UPLOAD,
+                                                                                     Backend::MemoryHeapUsages::BUFFERS, &m_memory ) ) )
+                {
+                    Destroy();
+                    return Results::FAIL;
+                }
+
+                // Mapped once for the whole lifetime, upload heaps allow resource to stay mapped while GPU reads it
+                Backend::MapResourceDesc mapDesc;
+                mapDesc.hResource          = m_hResource;
+                mapDesc.bufferRange.offset = 0;
+                mapDesc.bufferRange.size   = m_desc.size;
+                void* pHost                = nullptr;
+                if( BGS_FAILED( pAPIDevice->MapResource( mapDesc, &pHost ) ) )
+                {
+                    Destroy();
+                    return Results::FAIL;
+                }
+                m_pHost = static_cast<byte_t*>( pHost );
+
+                m_head       = 0;
+                m_tail       = 0;
+                m_flushedPos = 0;
+                m_firstFrame = 0;
+                m_frameCount = 0;
+
+                return Results::OK;
+            }
+
+            void UploadRingBuffer::Destroy()
+            {
+                Backend::IDevice* pAPIDevice = m_pParent->GetDevice();
+
+                // GPU may still read from frames in flight
+                while( m_frameCount > 0 )
+                {
+                    if( BGS_FAILED( RetireOldestFrame() ) )
+                    {
+                        break;
+                    }
+                }
+
+                if( m_pHost != nullptr )
+                {
+                    Backend::MapResourceDesc mapDesc;
+                    mapDesc.hResource          = m_hResource;
+                    mapDesc.bufferRange.offset = 0;
+                    mapDesc.bufferRange.size   = m_desc.size;
+                    pAPIDevice->UnmapResource( mapDesc );
+                    m_pHost = nullptr;
+                }
+                if( m_hResource != Backend::ResourceHandle() )
+                {
+                    pAPIDevice->DestroyResource( &m_hResource );
+                }
+                if( m_memory.hMemory != Backend::MemoryHandle() )
+                {
+                    m_pParent->GetDeviceMemorySystem()->Free( &m_memory );
+                }
+            }
+
+            void UploadRingBuffer::RetireCompletedFrames()
+            {
+                SyncSystem* pSyncSystem = m_pParent->GetSyncSystem();
+                while( m_frameCount > 0 )
+                {
+                    const FrameMarker& frame = m_frames[ m_firstFrame ];
+                    if( !pSyncSystem->IsCompleted( frame.point ) )
+                    {
+                        break;
+                    }
+                    m_tail       = frame.endPos;
+                    m_firstFrame = ( m_firstFrame + 1 ) % Config::Driver::Memory::MAX_UPLOAD_RING_FRAME_COUNT;
+                    m_frameCount--;
+                }
+            }
+
+            RESULT UploadRingBuffer::RetireOldestFrame()
+            {
+                if( m_frameCount == 0 )
+                {
+                    return Results::NOT_FOUND;
+                }
+
+                const FrameMarker& frame = m_frames[ m_firstFrame ];
+                if( BGS_FAILED( m_pParent->GetSyncSystem()->Wait( frame.point ) ) )
+                {
+                    return Results::FAIL;
+                }
+                m_tail       = frame.endPos;
+                m_firstFrame = ( m_firstFrame + 1 ) % Config::Driver::Memory::MAX_UPLOAD_RING_FRAME_COUNT;
+                m_frameCount--;
+
+                return Results::OK;
+            }
+
+            RESULT UploadRingBuffer::FlushRange( uint64_t offset, uint64_t size )
+            {
+                Backend::MapResourceDesc mapDesc;
+                mapDesc.hResource          = m_hResource;
+                mapDesc.bufferRange.offset = offset;
+                mapDesc.bufferRange.size   = size;
+
+                return m_pParent->GetDevice()->FlushRange( mapDesc );
+            }
+
+        } // namespace Frontend
+    } // namespace Driver
+} // namespace BIGOS
\ No newline at end of file
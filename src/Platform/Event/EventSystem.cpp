@@ -69,6 +69,7 @@ namespace BIGOS
             void EventSystem::Destroy()
             {
                 m_handlers.clear();
+                m_handlers.shrink_to_fit();
                 m_pParent = nullptr;
             }
 
@@ -29,7 +29,7 @@ namespace BIGOS
             }
 
             Window* pWindow = nullptr;
-            if( BGS_FAILED( Memory::AllocateObject( m_pDefaultAllocator, &pWindow ) ) )
+            if( BGS_FAILED( BGS_ALLOCATE_OBJECT( m_pDefaultAllocator, &pWindow ) ) )
             {
                 return Results::NO_MEMORY;
             }